@@ -0,0 +1,105 @@
+// Copyright 2026 Victor Smirnov
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compares arena::Map (chained buckets, FNV) with arena::SwissMap
+// (open addressing, wyhash) on insertion and lookup of integer and
+// Varchar keys.
+
+#include <memoria/core/arena/map.hpp>
+#include <memoria/core/arena/swiss_map.hpp>
+#include <memoria/core/arena/string.hpp>
+
+#include <memoria/core/tools/time.hpp>
+#include <memoria/core/strings/format.hpp>
+
+#include <vector>
+#include <random>
+
+using namespace memoria;
+
+namespace {
+
+using VarcharCtr = arena::ArenaDataTypeContainer<Varchar>;
+
+template <typename MapT, typename Keys, typename MakeKey>
+void run(const char* name, const Keys& keys, MakeKey&& make_key)
+{
+    arena::ArenaAllocator arena(1024 * 1024);
+    auto map = arena.allocate_object_untagged<MapT>();
+
+    int64_t t0 = getTimeInMillis();
+    for (size_t c = 0; c < keys.size(); c++) {
+        map->put(arena, make_key(arena, keys[c]), c, nullptr);
+    }
+    int64_t t1 = getTimeInMillis();
+
+    uint64_t sum{};
+    size_t runs = 10;
+    for (size_t r = 0; r < runs; r++) {
+        for (const auto& key: keys) {
+            auto vv = map->get(key, nullptr);
+            sum += vv ? *vv : 0;
+        }
+    }
+    int64_t t2 = getTimeInMillis();
+
+    double put_ns = (t1 - t0) * 1000000.0 / keys.size();
+    double get_ns = (t2 - t1) * 1000000.0 / (keys.size() * runs);
+
+    println(
+        "  {:<10} put: {:.1f} ns/key, get: {:.1f} ns/key, checksum: {}",
+        name, put_ns, get_ns, sum / runs
+    );
+}
+
+}
+
+int main()
+{
+    std::mt19937_64 rng(12345);
+
+    for (size_t size: {10000ull, 100000ull, 1000000ull})
+    {
+        std::vector<int64_t> ints;
+        std::vector<U8String> strings;
+        std::vector<U8StringView> views;
+
+        for (size_t c = 0; c < size; c++) {
+            ints.push_back(rng());
+            strings.push_back(format_u8("Key_{}_{}", c, rng() % 1000000));
+        }
+
+        for (const auto& str: strings) {
+            views.push_back(str);
+        }
+
+        println("{} int64 keys:", size);
+        auto int_key = [](arena::ArenaAllocator&, int64_t key) {
+            return key;
+        };
+        run<arena::Map<int64_t, uint64_t>>("Map", ints, int_key);
+        run<arena::SwissMap<int64_t, uint64_t>>("SwissMap", ints, int_key);
+
+        println("{} Varchar keys:", size);
+        auto str_key = [](arena::ArenaAllocator& arena, U8StringView key) {
+            return arena::RelativePtr<VarcharCtr>(
+                arena.allocate_tagged_object<VarcharCtr>(ShortTypeCode::of<Varchar>(), key)
+            );
+        };
+        run<arena::Map<arena::RelativePtr<VarcharCtr>, uint64_t>>("Map", views, str_key);
+        run<arena::SwissMap<arena::RelativePtr<VarcharCtr>, uint64_t>>("SwissMap", views, str_key);
+    }
+
+    return 0;
+}
@@ -0,0 +1,207 @@
+// Copyright 2026 Victor Smirnov
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compares DSL VM programs scanning a chunked column against the
+// equivalent C++ loops: filtered sum written element by element, and
+// the same scan using the VM's native span opcodes.
+
+#include <memoria/dsl/vm/interpreter.hpp>
+
+#include <memoria/core/tools/time.hpp>
+#include <memoria/core/strings/format.hpp>
+
+#include <vector>
+#include <random>
+
+using namespace memoria;
+using namespace memoria::dsl::vm;
+
+namespace {
+
+using OC = OpCode;
+
+constexpr uint8_t CURSOR = 0;
+constexpr uint8_t COLUMN = 0;
+
+// sum(v for v in column if v >= threshold), one value per iteration
+Program make_filtered_sum()
+{
+    ProgramBuilder bb(1);
+    uint8_t threshold = bb.arg(0);
+
+    uint8_t sum = bb.reg(), idx = bb.reg(), len = bb.reg(), val = bb.reg();
+    uint8_t tmp = bb.reg(), one = bb.reg(), zero = bb.reg(), ok = bb.reg();
+    uint8_t col = bb.span();
+
+    auto chunk = bb.label(), elem = bb.label(), skip = bb.label();
+    auto next = bb.label(), done = bb.label();
+
+    bb.load_i(sum, 0);
+    bb.load_i(one, 1);
+    bb.load_i(zero, 0);
+    bb.emit(OC::CSEEK, ok, zero, CURSOR);
+    bb.jf(ok, done);
+
+    bb.bind(chunk);
+    bb.emit(OC::CCOLI, col, CURSOR, COLUMN);
+    bb.emit(OC::SLEN, len, col);
+    bb.load_i(idx, 0);
+
+    bb.bind(elem);
+    bb.emit(OC::LTI, tmp, idx, len);
+    bb.jf(tmp, next);
+    bb.emit(OC::SGETI, val, col, idx);
+    bb.emit(OC::LTI, tmp, val, threshold);
+    bb.jt(tmp, skip);
+    bb.emit(OC::ADDI, sum, sum, val);
+    bb.bind(skip);
+    bb.emit(OC::ADDI, idx, idx, one);
+    bb.jmp(elem);
+
+    bb.bind(next);
+    bb.emit(OC::CNEXT, ok, 0, CURSOR);
+    bb.jt(ok, chunk);
+
+    bb.bind(done);
+    bb.emit(OC::RET, sum);
+
+    return bb.build();
+}
+
+// count(v for v in column if v >= threshold), one chunk per iteration
+Program make_chunked_count()
+{
+    ProgramBuilder bb(1);
+    uint8_t threshold = bb.arg(0);
+
+    uint8_t cnt = bb.reg(), zero = bb.reg(), ok = bb.reg();
+    uint8_t col = bb.span();
+
+    auto chunk = bb.label(), done = bb.label();
+
+    bb.load_i(cnt, 0);
+    bb.load_i(zero, 0);
+    bb.emit(OC::CSEEK, ok, zero, CURSOR);
+    bb.jf(ok, done);
+
+    bb.bind(chunk);
+    bb.emit(OC::CCOLI, col, CURSOR, COLUMN);
+    bb.emit(OC::SCNTGEI, cnt, col, threshold);
+    bb.emit(OC::CNEXT, ok, 0, CURSOR);
+    bb.jt(ok, chunk);
+
+    bb.bind(done);
+    bb.emit(OC::RET, cnt);
+
+    return bb.build();
+}
+
+int64_t native_filtered_sum(VMCursor& cursor, int64_t threshold)
+{
+    int64_t sum{};
+    if (cursor.seek(0))
+    {
+        do {
+            auto col = cursor.column_i64(COLUMN);
+            for (size_t c = 0; c < col.size(); c++) {
+                if (col[c] >= threshold) {
+                    sum += col[c];
+                }
+            }
+        }
+        while (cursor.next_chunk());
+    }
+    return sum;
+}
+
+int64_t native_count(VMCursor& cursor, int64_t threshold)
+{
+    int64_t cnt{};
+    if (cursor.seek(0))
+    {
+        do {
+            auto col = cursor.column_i64(COLUMN);
+            for (size_t c = 0; c < col.size(); c++) {
+                cnt += col[c] >= threshold;
+            }
+        }
+        while (cursor.next_chunk());
+    }
+    return cnt;
+}
+
+template <typename Fn>
+void measure(const char* name, size_t rows, size_t runs, Fn&& fn)
+{
+    int64_t result{};
+    int64_t t0 = getTimeInMillis();
+    for (size_t c = 0; c < runs; c++) {
+        result += fn();
+    }
+    int64_t t1 = getTimeInMillis();
+
+    double ns_per_row = (t1 - t0) * 1000000.0 / (rows * runs);
+    println("  {:<24} {} in {} ({:.2f} ns/row)", name, result / runs, FormatTime(t1 - t0), ns_per_row);
+}
+
+}
+
+int main()
+{
+    size_t rows = 10000000;
+    size_t runs = 5;
+    int64_t threshold = 500;
+
+    std::mt19937_64 rng(12345);
+    std::vector<int64_t> values;
+    for (size_t c = 0; c < rows; c++) {
+        values.push_back(rng() % 1000);
+    }
+
+    Program filtered_sum = make_filtered_sum();
+    Program chunked_count = make_chunked_count();
+
+    println("Filtered sum program:\n{}", filtered_sum.disassemble());
+
+    Interpreter interpreter;
+    Value args[] = {Value::of_int(threshold)};
+
+    for (size_t chunk_size: {256, 4096})
+    {
+        ColumnarCursor cursor(rows, chunk_size);
+        cursor.add_column(Span<const int64_t>(values.data(), values.size()));
+
+        VMCursor* cursors[] = {&cursor};
+
+        println("{} rows, chunk size {}:", rows, chunk_size);
+
+        measure("C++ filtered sum", rows, runs, [&]{
+            return native_filtered_sum(cursor, threshold);
+        });
+
+        measure("VM filtered sum", rows, runs, [&]{
+            return interpreter.run(filtered_sum, args, cursors).i;
+        });
+
+        measure("C++ count", rows, runs, [&]{
+            return native_count(cursor, threshold);
+        });
+
+        measure("VM count (SCNTGEI)", rows, runs, [&]{
+            return interpreter.run(chunked_count, args, cursors).i;
+        });
+    }
+
+    return 0;
+}
@@ -0,0 +1,259 @@
+// Copyright 2026 Victor Smirnov
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Random lookups in a set container with regular and huge page backed
+// store memory. Reports lookup latency and data TLB misses per lookup,
+// when the kernel lets us read hardware counters.
+//
+// Usage: huge_pages_lookup [entries] [lookups] [file]
+
+#include <memoria/api/store/swmr_store_api.hpp>
+#include <memoria/api/store/memory_store_api.hpp>
+#include <memoria/api/set/set_api.hpp>
+
+#include <memoria/core/memory/huge_pages.hpp>
+#include <memoria/core/memory/malloc.hpp>
+#include <memoria/core/tools/random.hpp>
+#include <memoria/core/tools/time.hpp>
+#include <memoria/core/strings/format.hpp>
+#include <memoria/memoria.hpp>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <cstdlib>
+#include <vector>
+
+#ifdef MMA_LINUX
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace memoria;
+
+namespace {
+
+using CtrType = Set<Varchar>;
+using CtrID   = ApiProfileCtrID<CoreApiProfile>;
+
+// Counts data TLB load misses of the calling thread
+class DTLBMissCounter {
+    int fd_{-1};
+public:
+    DTLBMissCounter()
+    {
+#ifdef MMA_LINUX
+        perf_event_attr attr{};
+        attr.size   = sizeof(attr);
+        attr.type   = PERF_TYPE_HW_CACHE;
+        attr.config = PERF_COUNT_HW_CACHE_DTLB |
+                     (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                     (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        attr.disabled       = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv     = 1;
+
+        fd_ = static_cast<int>(::syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+    }
+
+    ~DTLBMissCounter() noexcept
+    {
+#ifdef MMA_LINUX
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+#endif
+    }
+
+    bool is_available() const {
+        return fd_ >= 0;
+    }
+
+    void start()
+    {
+#ifdef MMA_LINUX
+        if (fd_ >= 0) {
+            ::ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+            ::ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    uint64_t stop()
+    {
+        uint64_t value{};
+#ifdef MMA_LINUX
+        if (fd_ >= 0) {
+            ::ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+            if (::read(fd_, &value, sizeof(value)) != sizeof(value)) {
+                value = 0;
+            }
+        }
+#endif
+        return value;
+    }
+};
+
+U8String make_key(uint64_t num) {
+    return format_u8("Lookup key {:016}", num);
+}
+
+template <typename SnapshotPtrT>
+void fill(SnapshotPtrT snp, const CtrID& ctr_id, size_t entries)
+{
+    auto ctr = create(snp, CtrType(), ctr_id);
+    for (size_t c = 0; c < entries; c++) {
+        ctr->upsert(make_key(c * 2));
+    }
+}
+
+template <typename SnapshotPtrT>
+void lookup(const char* mode, SnapshotPtrT snp, const CtrID& ctr_id, const std::vector<U8String>& keys)
+{
+    auto ctr = find<CtrType>(snp, ctr_id);
+
+    // Warm up the page cache and page tables
+    for (const auto& key: keys) {
+        ctr->contains(key);
+    }
+
+    DTLBMissCounter counter;
+
+    size_t found{};
+    counter.start();
+    int64_t t0 = getTimeInMillis();
+
+    for (const auto& key: keys) {
+        found += ctr->contains(key);
+    }
+
+    int64_t t1 = getTimeInMillis();
+    uint64_t misses = counter.stop();
+
+    double ns_per_lookup = (t1 - t0) * 1000000.0 / keys.size();
+
+    if (counter.is_available()) {
+        println(
+            "{:<16} lookups: {}, found: {}, {:.1f} ns/lookup, {:.2f} dTLB misses/lookup",
+            mode, keys.size(), found, ns_per_lookup, static_cast<double>(misses) / keys.size()
+        );
+    }
+    else {
+        println(
+            "{:<16} lookups: {}, found: {}, {:.1f} ns/lookup, dTLB misses: n/a",
+            mode, keys.size(), found, ns_per_lookup
+        );
+    }
+}
+
+void run_mapped(const char* mode, const U8String& file, size_t entries, const std::vector<U8String>& keys, bool huge_pages)
+{
+    boost::filesystem::remove(file.data());
+
+    CtrID ctr_id = CtrID::make_random();
+
+    auto store = create_swmr_store(file, SWMRParams(256).use_huge_pages(huge_pages));
+    {
+        auto snp = store->begin();
+        fill(snp, ctr_id, entries);
+        snp->commit();
+    }
+
+    lookup(mode, store->open(), ctr_id, keys);
+    store->close();
+
+    boost::filesystem::remove(file.data());
+}
+
+void run_raw(const char* mode, Span<uint8_t> buffer, size_t entries, const std::vector<U8String>& keys, bool huge_pages)
+{
+    CtrID ctr_id = CtrID::make_random();
+
+    auto store = create_lite_raw_swmr_store(buffer, SWMRParams().use_huge_pages(huge_pages));
+    {
+        auto snp = store->begin();
+        fill(snp, ctr_id, entries);
+        snp->commit();
+    }
+
+    lookup(mode, store->open(), ctr_id, keys);
+    store->close();
+}
+
+void run_memory(const char* mode, size_t entries, const std::vector<U8String>& keys, bool huge_pages)
+{
+    CtrID ctr_id = CtrID::make_random();
+
+    auto store = create_memory_store();
+    store->set_huge_page_blocks(huge_pages);
+
+    auto snp = store->master()->branch();
+    fill(snp, ctr_id, entries);
+    snp->commit();
+
+    lookup(mode, store->master(), ctr_id, keys);
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    InitMemoriaExplicit();
+
+    size_t entries = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    size_t lookups = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1000000;
+    U8String file  = argc > 3 ? U8String(argv[3]) : U8String("huge_pages_lookup.mma2");
+
+    // Raw stores have fixed size buffers
+    size_t raw_buffer_size = 1024ull * 1024 * 1024;
+
+    try {
+        std::vector<U8String> keys;
+        keys.reserve(lookups);
+        for (size_t c = 0; c < lookups; c++) {
+            keys.push_back(make_key(getBIRandomG(entries * 2)));
+        }
+
+        run_mapped("mapped", file, entries, keys, false);
+        run_mapped("mapped-thp", file, entries, keys, true);
+
+        {
+            auto buffer = allocate_system_zeroed<uint8_t>(raw_buffer_size);
+            run_raw("raw", Span<uint8_t>(buffer.get(), raw_buffer_size), entries, keys, false);
+        }
+
+        {
+            HugePageBuffer buffer(raw_buffer_size);
+            run_raw("raw-huge", buffer.span(), entries, keys, true);
+        }
+
+        run_memory("memory", entries, keys, false);
+        run_memory("memory-huge", entries, keys, true);
+
+        auto stats = HugePageArenaAllocator::instance().stats();
+        println("Huge page arenas: {}, allocated: {:.1f} MB", stats.arenas, stats.allocated / 1048576.0);
+    }
+    catch (const MemoriaError& ee) {
+        ee.describe(std::cout);
+        return 1;
+    }
+    catch (const MemoriaThrowable& ee) {
+        ee.dump(std::cout);
+        return 1;
+    }
+
+    return 0;
+}
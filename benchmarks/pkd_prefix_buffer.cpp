@@ -0,0 +1,166 @@
+// Copyright 2026 Victor Smirnov
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compares leaf fan-out and lookup speed of the prefix-coded packed
+// buffer against the plain variable-length layout (offsets + bytes)
+// for typical key sets.
+
+#include <memoria/core/packed/datatype_buffer/packed_prefix_coded_buffer.hpp>
+#include <memoria/core/packed/tools/packed_struct_ptrs.hpp>
+
+#include <memoria/core/tools/time.hpp>
+#include <memoria/core/strings/format.hpp>
+
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <random>
+
+using namespace memoria;
+
+using Buffer   = PackedPrefixCodedBuffer;
+using ViewType = typename Buffer::ViewType;
+
+namespace {
+
+std::vector<std::string> make_paths(std::mt19937_64& rng, size_t size)
+{
+    const char* roots[] = {"/usr/share/doc/", "/usr/lib/x86_64-linux-gnu/", "/home/user/projects/memoria/"};
+
+    std::vector<std::string> keys;
+    for (size_t c = 0; c < size; c++) {
+        keys.push_back(format_u8("{}pkg-{:03}/src/module-{:04}/file-{}.cpp", roots[rng() % 3], rng() % 200, rng() % 1000, rng() % 100).to_std_string());
+    }
+    return keys;
+}
+
+std::vector<std::string> make_urls(std::mt19937_64& rng, size_t size)
+{
+    const char* hosts[] = {"https://www.example.com/", "https://api.example.org/v2/", "http://cdn.example.net/static/"};
+
+    std::vector<std::string> keys;
+    for (size_t c = 0; c < size; c++) {
+        keys.push_back(format_u8("{}catalog/{}/item?id={}&page={}", hosts[rng() % 3], rng() % 50, rng() % 1000000, rng() % 20).to_std_string());
+    }
+    return keys;
+}
+
+std::vector<std::string> make_composite(std::mt19937_64& rng, size_t size)
+{
+    std::vector<std::string> keys;
+    for (size_t c = 0; c < size; c++) {
+        keys.push_back(format_u8("tenant:{:05}|table:{:03}|row:{:010}", rng() % 100, rng() % 30, rng() % 10000000000ull).to_std_string());
+    }
+    return keys;
+}
+
+ViewType as_view(const std::string& str) {
+    return ViewType(ptr_cast<const uint8_t>(str.data()), str.size());
+}
+
+// Number of sorted keys (from the beginning) that fit into a leaf
+// of the given size when stored as plain offsets + bytes.
+size_t plain_fanout(const std::vector<std::string>& keys, size_t budget)
+{
+    size_t bytes = sizeof(psize_t);
+    for (size_t c = 0; c < keys.size(); c++)
+    {
+        bytes += sizeof(psize_t) + keys[c].size();
+        if (bytes > budget) {
+            return c;
+        }
+    }
+    return keys.size();
+}
+
+// The same for the prefix-coded buffer, by binary search over prefix length.
+size_t prefix_fanout(const std::vector<ViewType>& views, size_t budget)
+{
+    auto buf = MakeSharedPackedStructByBlock<Buffer>(budget * 4);
+
+    size_t lo = 0, hi = views.size();
+    while (lo < hi)
+    {
+        size_t mid = (lo + hi + 1) / 2;
+        size_t size = buf->block_size_for_insert(0, Span<const ViewType>(views.data(), mid));
+        if (size <= budget) {
+            lo = mid;
+        }
+        else {
+            hi = mid - 1;
+        }
+    }
+
+    return lo;
+}
+
+void run(const char* name, std::vector<std::string> keys)
+{
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+    std::vector<ViewType> views;
+    for (auto& key: keys) {
+        views.push_back(as_view(key));
+    }
+
+    println("{}: {} keys", name, keys.size());
+
+    for (size_t budget: {4096, 8192, 16384})
+    {
+        size_t plain  = plain_fanout(keys, budget);
+        size_t prefix = prefix_fanout(views, budget);
+        println("  leaf {:5}: plain fan-out {:5}, prefix-coded fan-out {:5} ({:.2f}x)", budget, plain, prefix, (double)prefix / plain);
+    }
+
+    auto buf = MakeSharedPackedStructByBlock<Buffer>(64 * 1024 * 1024);
+    buf->append(Span<const ViewType>(views.data(), views.size()));
+
+    std::mt19937_64 rng(0);
+    std::vector<size_t> probes;
+    for (size_t c = 0; c < 1000000; c++) {
+        probes.push_back(rng() % views.size());
+    }
+
+    int64_t t0 = getTimeInMillis();
+    size_t found{};
+    for (size_t idx: probes) {
+        found += buf->find_ge(views[idx]) == idx;
+    }
+    int64_t t1 = getTimeInMillis();
+
+    size_t total{};
+    for (size_t c = 0; c < 10; c++) {
+        buf->for_each([&](size_t, ViewType value){
+            total += value.size();
+        });
+    }
+    int64_t t2 = getTimeInMillis();
+
+    println("  find_ge: {} lookups ({} found) in {}, scan: {} bytes in {}", probes.size(), found, FormatTime(t1 - t0), total, FormatTime(t2 - t1));
+}
+
+}
+
+int main()
+{
+    std::mt19937_64 rng(12345);
+    size_t size = 100000;
+
+    run("Paths", make_paths(rng, size));
+    run("URLs", make_urls(rng, size));
+    run("Composite keys", make_composite(rng, size));
+
+    return 0;
+}
@@ -0,0 +1,129 @@
+// Copyright 2026 Victor Smirnov
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Skewed load: a burst of CPU-heavy migratable tasks is sent to
+// reactor 0 only. Reports task latency, from submission to completion,
+// and which reactors have run the tasks. Compare runs with and
+// without --work-stealing:
+//
+//   reactor_work_stealing -t 4 --work-stealing false
+//   reactor_work_stealing -t 4 --work-stealing true
+
+#include <memoria/reactor/reactor.hpp>
+#include <memoria/reactor/application.hpp>
+
+#include <memoria/memoria_core.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+using namespace memoria;
+using namespace memoria::reactor;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Spins for the given time, yielding every slice_us so
+// that a started task may be resumed by another reactor.
+int spin(uint64_t work_us, uint64_t slice_us)
+{
+    auto t0 = Clock::now();
+    auto slice_start = t0;
+
+    volatile uint64_t acc{};
+    while (Clock::now() - t0 < std::chrono::microseconds(work_us))
+    {
+        for (int c = 0; c < 64; c++) {
+            acc = acc * 31 + c;
+        }
+
+        if (Clock::now() - slice_start >= std::chrono::microseconds(slice_us)) {
+            boost::this_fiber::yield();
+            slice_start = Clock::now();
+        }
+    }
+
+    return engine().cpu();
+}
+
+}
+
+int main(int argc, char** argv, char** envp)
+{
+    InitMemoriaCoreExplicit();
+
+    boost::program_options::options_description options;
+    options.add_options()
+        ("tasks", boost::program_options::value<size_t>()->default_value(2000), "Number of tasks in the burst")
+        ("work-us", boost::program_options::value<uint64_t>()->default_value(500), "CPU time per task, in microseconds")
+        ("slice-us", boost::program_options::value<uint64_t>()->default_value(100), "Time between yields within a task, in microseconds");
+
+    return Application::run_e(
+        options, argc, argv, envp,
+        [&]() -> int
+    {
+        ShutdownOnScopeExit hh;
+
+        size_t tasks     = app().options()["tasks"].as<size_t>();
+        uint64_t work_us  = app().options()["work-us"].as<uint64_t>();
+        uint64_t slice_us = app().options()["slice-us"].as<uint64_t>();
+
+        std::vector<int64_t> latencies(tasks);
+        std::vector<size_t> per_cpu(engine().cpu_num());
+
+        auto t0 = Clock::now();
+
+        std::vector<boost::fibers::fiber> fibers;
+        for (size_t c = 0; c < tasks; c++)
+        {
+            fibers.push_back(in_fiber(FiberStackClass::SMALL, [&, c]{
+                auto ts = Clock::now();
+                int cpu = engine().run_migratable_at(0, [=]{
+                    return spin(work_us, slice_us);
+                });
+
+                latencies[c] = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - ts).count();
+                per_cpu[cpu]++;
+            }));
+        }
+
+        for (auto& ff: fibers) {
+            ff.join();
+        }
+
+        auto total_ms = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - t0).count();
+
+        std::sort(latencies.begin(), latencies.end());
+        auto pct = [&](double p) {
+            return latencies[std::min(latencies.size() - 1, static_cast<size_t>(latencies.size() * p))];
+        };
+
+        engine().println(
+            "Reactors: {}, work stealing: {}, tasks: {}, total: {} ms",
+            engine().cpu_num(), app().is_work_stealing(), tasks, total_ms
+        );
+        engine().println(
+            "Latency, us: p50 {}, p99 {}, max {}",
+            pct(0.5), pct(0.99), latencies.back()
+        );
+
+        for (size_t c = 0; c < per_cpu.size(); c++) {
+            engine().println("Tasks finished on reactor {}: {}", c, per_cpu[c]);
+        }
+
+        return 0;
+    });
+}
@@ -0,0 +1,142 @@
+// Copyright 2026 Victor Smirnov
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Ships commits of a leader SWMR store to a follower over a local pipe
+// and reports the follower's apply throughput and replication lag.
+
+#include <memoria/api/store/swmr_store_api.hpp>
+#include <memoria/api/set/set_api.hpp>
+#include <memoria/store/swmr/common/swmr_store_replication.hpp>
+
+#include <memoria/core/tools/time.hpp>
+#include <memoria/core/strings/format.hpp>
+#include <memoria/memoria.hpp>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+using namespace memoria;
+
+int main()
+{
+    InitMemoriaExplicit();
+
+    using CtrType = Set<Varchar>;
+    using CtrID = ApiProfileCtrID<CoreApiProfile>;
+
+    U8String leader_file = "leader.mma2";
+    U8String follower_file = "follower.mma2";
+
+    size_t commits = 1000;
+    size_t batch = 1000;
+
+    try {
+        boost::filesystem::remove(leader_file.data());
+        boost::filesystem::remove(follower_file.data());
+
+        CtrID ctr_id = CtrID::make_random();
+
+        {
+            auto store = create_swmr_store(leader_file, 1024 * 4);
+            auto snp = store->begin();
+            create(snp, CtrType(), ctr_id);
+            snp->commit();
+            store->close();
+        }
+
+        boost::filesystem::copy_file(leader_file.data(), follower_file.data());
+
+        auto leader = open_swmr_store(leader_file);
+        auto follower = open_swmr_store(follower_file, SWMRParams().open_follower());
+
+        int fds[2];
+        if (::pipe(fds)) {
+            println("Can't create a pipe");
+            return 1;
+        }
+
+        std::vector<int64_t> lags;
+        int64_t apply_time{};
+
+        std::thread follower_thread([&]{
+            std::vector<uint8_t> record;
+            while (read_replication_record(fds[0], record))
+            {
+                int64_t t0 = getTimeInMillis();
+                while (!follower->apply_replication_record(to_span(record))) {
+                    std::this_thread::yield();
+                }
+                apply_time += getTimeInMillis() - t0;
+                lags.push_back(follower->replication_status().lag_ms);
+            }
+        });
+
+        leader->set_replication_sink([&](Span<const uint8_t> record){
+            write_replication_record(fds[1], record);
+        });
+
+        int64_t t0 = getTimeInMillis();
+        for (size_t cc = 0; cc < commits; cc++)
+        {
+            auto snp = leader->begin();
+            auto ctr = find<CtrType>(snp, ctr_id);
+            for (size_t bb = 0; bb < batch; bb++) {
+                ctr->upsert(format_u8("Entry {} of commit {}", bb, cc));
+            }
+            snp->commit();
+        }
+        int64_t t1 = getTimeInMillis();
+
+        leader->set_replication_sink(SWMRReplicationSinkFn{});
+        ::close(fds[1]);
+        follower_thread.join();
+        ::close(fds[0]);
+
+        auto status = follower->replication_status();
+
+        std::sort(lags.begin(), lags.end());
+        auto pct = [&](double p) {
+            return lags.size() ? lags[std::min(lags.size() - 1, static_cast<size_t>(lags.size() * p))] : 0;
+        };
+
+        println("Commits: {}, leader time: {} ms", commits, t1 - t0);
+        println(
+            "Records: {}, bytes: {:.1f} MB, apply: {} ms, {:.1f} MB/s",
+            status.records, status.bytes / 1048576.0, apply_time,
+            apply_time ? status.bytes / 1048576.0 * 1000.0 / apply_time : 0.0
+        );
+        println("Lag, ms: p50 {}, p99 {}, max {}", pct(0.5), pct(0.99), lags.size() ? lags.back() : 0);
+
+        auto f_ctr = find<CtrType>(follower->open(), ctr_id);
+        println("Follower entries: {}", f_ctr->size());
+
+        leader->close();
+        follower->close();
+    }
+    catch (const MemoriaError& ee) {
+        ee.describe(std::cout);
+        return 1;
+    }
+    catch (const MemoriaThrowable& ee) {
+        ee.dump(std::cout);
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,139 @@
+// Copyright 2026 Victor Smirnov
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Encode/decode throughput of per-value and batch variable length
+// integer codecs, with every kernel set the CPU supports.
+
+#include <memoria/core/tools/varint_batch.hpp>
+#include <memoria/core/tools/i7_codec.hpp>
+#include <memoria/core/bignum/uint64_codec.hpp>
+
+#include <memoria/core/tools/time.hpp>
+#include <memoria/core/strings/format.hpp>
+
+#include <vector>
+#include <random>
+
+using namespace memoria;
+
+namespace {
+
+constexpr size_t ROUNDS = 100;
+
+// Lengths and prefix sizes, mostly below 128.
+std::vector<uint64_t> make_small(std::mt19937_64& rng, size_t size)
+{
+    std::vector<uint64_t> values;
+    for (size_t c = 0; c < size; c++) {
+        values.push_back(rng() % 100);
+    }
+    return values;
+}
+
+// One value in eight is long.
+std::vector<uint64_t> make_mixed(std::mt19937_64& rng, size_t size)
+{
+    std::vector<uint64_t> values;
+    for (size_t c = 0; c < size; c++) {
+        values.push_back(rng() % 8 ? rng() % 100 : rng() % (1ull << 40));
+    }
+    return values;
+}
+
+const char* isa_name(VarintBatchISA isa)
+{
+    switch (isa) {
+        case VarintBatchISA::AVX2:  return "avx2";
+        case VarintBatchISA::SSE42: return "sse4.2";
+        default: return "scalar";
+    }
+}
+
+template <typename Codec>
+void run(const char* name, const Codec& codec, const std::vector<uint64_t>& values)
+{
+    std::vector<uint8_t> buffer(values.size() * 10);
+    std::vector<uint64_t> decoded(values.size());
+
+    size_t length{};
+    int64_t t0 = getTimeInMillis();
+    for (size_t r = 0; r < ROUNDS; r++)
+    {
+        length = 0;
+        for (uint64_t value: values) {
+            length += codec.encode(buffer.data(), value, length);
+        }
+    }
+    int64_t t1 = getTimeInMillis();
+
+    for (size_t r = 0; r < ROUNDS; r++)
+    {
+        for (size_t c = 0, pos = 0; c < values.size(); c++) {
+            pos += codec.decode(buffer.data(), decoded[c], pos);
+        }
+    }
+    int64_t t2 = getTimeInMillis();
+
+    double total = static_cast<double>(values.size() * ROUNDS);
+    auto mvps = [&](int64_t ms) {
+        return ms ? total / ms / 1000.0 : 0.0;
+    };
+
+    println("{}: {} bytes per value", name, static_cast<double>(length) / values.size());
+    println("  {:<8} encode {:8.1f} Mv/s, decode {:8.1f} Mv/s", "single", mvps(t1 - t0), mvps(t2 - t1));
+
+    for (auto isa: {VarintBatchISA::SCALAR, VarintBatchISA::SSE42, VarintBatchISA::AVX2})
+    {
+        if (set_varint_batch_isa(isa) != isa) {
+            continue;
+        }
+
+        int64_t t0 = getTimeInMillis();
+        for (size_t r = 0; r < ROUNDS; r++) {
+            codec.encode_n(buffer.data(), values.data(), values.size(), 0);
+        }
+        int64_t t1 = getTimeInMillis();
+
+        for (size_t r = 0; r < ROUNDS; r++) {
+            codec.decode_n(buffer.data(), decoded.data(), decoded.size(), 0);
+        }
+        int64_t t2 = getTimeInMillis();
+
+        if (decoded != values) {
+            println("  {}: decoded values mismatch", isa_name(isa));
+        }
+
+        println("  {:<8} encode {:8.1f} Mv/s, decode {:8.1f} Mv/s", isa_name(isa), mvps(t1 - t0), mvps(t2 - t1));
+    }
+
+    set_varint_batch_isa(VarintBatchISA::AVX2);
+}
+
+}
+
+int main()
+{
+    std::mt19937_64 rng(12345);
+    size_t size = 1000000;
+
+    auto small = make_small(rng, size);
+    auto mixed = make_mixed(rng, size);
+
+    run("I7, small", I7Codec<uint8_t, uint64_t>(), small);
+    run("I7, mixed", I7Codec<uint8_t, uint64_t>(), mixed);
+    run("ValueCodec<uint64_t>, small", ValueCodec<uint64_t>(), small);
+    run("ValueCodec<uint64_t>, mixed", ValueCodec<uint64_t>(), mixed);
+
+    return 0;
+}
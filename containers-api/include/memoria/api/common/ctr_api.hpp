@@ -86,6 +86,16 @@ enum class ChunkDumpMode {
     HEADER, LEAF, PATH
 };
 
+// Fingered descents since the finger has been enabled. A hit starts
+// below the root, `levels` counts tree levels actually descended and
+// `full_levels` the ones a descent from the root would have taken.
+struct FingerStat {
+    uint64_t descents{};
+    uint64_t hits{};
+    uint64_t levels{};
+    uint64_t full_levels{};
+};
+
 template <typename MyType, typename Profile>
 struct ChunkIteratorBase {
     virtual ~ChunkIteratorBase() = default;
@@ -108,6 +118,12 @@ struct ChunkIteratorBase {
     virtual ChunkPtr prev(CtrSizeT num = 1) const = 0;
     virtual ChunkPtr prev_chunk() const = 0;
 
+    // Number of leaves to prefetch ahead of a sequential next_chunk()
+    // scan. The setting is inherited by the chunks returned from
+    // next_chunk(). Zero disables read-ahead.
+    virtual void set_read_ahead(size_t depth) = 0;
+    virtual size_t read_ahead() const = 0;
+
     virtual void dump(ChunkDumpMode mode = ChunkDumpMode::HEADER, std::ostream& out = std::cout) const = 0;
 
     virtual void dump_leaf() const {
@@ -0,0 +1,287 @@
+// Copyright 2026 Victor Smirnov
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memoria/api/common/scan_kernels.hpp>
+
+#include <memoria/api/map/map_api.hpp>
+#include <memoria/api/vector/vector_api.hpp>
+#include <memoria/api/multimap/multimap_api.hpp>
+
+#include <memoria/core/hermes/hermes.hpp>
+
+namespace memoria::scan {
+
+// Vectorized scans over container chunks. A scan is defined by a filter
+// column with a predicate, and a projection column to aggregate. Columns
+// are functions mapping a chunk to a span of its leaf's data: see `keys`
+// and `values` below, custom projections may be used as well.
+//
+// Scans start from a positioned chunk, so leaves before the range are
+// skipped by the tree search: seek_entry() descends by branch-level
+// sizes, Map::find() descends by branch-level key maxes.
+
+struct KeysColumn {
+    template <typename ChunkT>
+    auto operator()(const ChunkT& chunk) const {
+        return chunk.keys().raw_span();
+    }
+};
+
+struct ValuesColumn {
+    template <typename ChunkT>
+    auto operator()(const ChunkT& chunk) const {
+        return chunk.values().raw_span();
+    }
+};
+
+constexpr KeysColumn keys{};
+constexpr ValuesColumn values{};
+
+template <typename ChunkT, typename Column>
+using ColumnT = typename std::invoke_result_t<Column, const ChunkT&>::value_type;
+
+
+// Calls fn(chunk, from, to) for each leaf chunk starting from the
+// chunk's current entry, for up to `limit` entries. The function
+// returns false to stop the scan.
+template <typename ChunkT, typename Fn>
+void for_each_chunk(IterSharedPtr<ChunkT> chunk, uint64_t limit, Fn&& fn)
+{
+    if (!is_valid_chunk(chunk)) {
+        return;
+    }
+
+    size_t from = chunk->entry_offset_in_chunk();
+    while (limit > 0)
+    {
+        size_t to = std::min<uint64_t>(chunk->chunk_size(), from + limit);
+        if (from < to)
+        {
+            if (!fn(*chunk, from, to)) {
+                return;
+            }
+
+            limit -= to - from;
+        }
+
+        chunk = chunk->next_chunk();
+        if (!is_valid_chunk(chunk)) {
+            return;
+        }
+
+        from = 0;
+    }
+}
+
+
+// Aggregates `projection` over up to `limit` entries from the chunk's
+// current position where `pred` holds for `filter`.
+template <typename ChunkT, typename Filter, typename Pred, typename Projection>
+Aggregate<ColumnT<ChunkT, Projection>> filter_aggregate(
+        IterSharedPtr<ChunkT> chunk,
+        uint64_t limit,
+        Filter filter,
+        const Pred& pred,
+        Projection projection
+)
+{
+    Aggregate<ColumnT<ChunkT, Projection>> agg;
+    SelectionVector sel;
+
+    for_each_chunk(std::move(chunk), limit, [&](const ChunkT& ch, size_t from, size_t to){
+        select(filter(ch), from, to, pred, sel);
+        agg.add(projection(ch), sel);
+        return true;
+    });
+
+    return agg;
+}
+
+// Same as above, without a filter.
+template <typename ChunkT, typename Projection>
+Aggregate<ColumnT<ChunkT, Projection>> aggregate(
+        IterSharedPtr<ChunkT> chunk,
+        uint64_t limit,
+        Projection projection
+)
+{
+    Aggregate<ColumnT<ChunkT, Projection>> agg;
+
+    for_each_chunk(std::move(chunk), limit, [&](const ChunkT& ch, size_t from, size_t to){
+        agg.add(projection(ch), from, to);
+        return true;
+    });
+
+    return agg;
+}
+
+template <typename ChunkT, typename Filter, typename Pred>
+uint64_t filter_count(IterSharedPtr<ChunkT> chunk, uint64_t limit, Filter filter, const Pred& pred)
+{
+    uint64_t cnt{};
+
+    for_each_chunk(std::move(chunk), limit, [&](const ChunkT& ch, size_t from, size_t to){
+        cnt += count(filter(ch), from, to, pred);
+        return true;
+    });
+
+    return cnt;
+}
+
+
+// Vector elements in [from, to) satisfying the predicate.
+template <typename DataType, typename Profile, typename Pred>
+auto vector_aggregate(
+        const ICtrApi<Vector<DataType>, Profile>& ctr,
+        uint64_t from,
+        uint64_t to,
+        const Pred& pred
+)
+{
+    uint64_t size = ctr.size();
+    to = std::min(to, size);
+    from = std::min(from, to);
+
+    return filter_aggregate(ctr.seek_entry(from), to - from, keys, pred, keys);
+}
+
+
+// Aggregates `projection` over Map entries with keys in [from, to).
+// Keys are sorted, so no selection is needed: the range boundary is
+// only searched for in the last chunk.
+template <typename Key, typename Value, typename Profile, typename Projection>
+auto map_range_aggregate(
+        const ICtrApi<Map<Key, Value>, Profile>& ctr,
+        const DTTViewType<Key>& from,
+        const DTTViewType<Key>& to,
+        Projection projection
+)
+{
+    using ChunkT = MapChunk<Key, Value, Profile>;
+    Aggregate<ColumnT<ChunkT, Projection>> agg;
+
+    if (!(from < to)) {
+        return agg;
+    }
+
+    for_each_chunk(ctr.find(from), std::numeric_limits<uint64_t>::max(), [&](const ChunkT& ch, size_t start, size_t end) {
+        auto kk = keys(ch);
+        if (kk[end - 1] < to) {
+            agg.add(projection(ch), start, end);
+            return true;
+        }
+
+        size_t bound = std::lower_bound(kk.begin() + start, kk.begin() + end, to) - kk.begin();
+        agg.add(projection(ch), start, bound);
+        return false;
+    });
+
+    return agg;
+}
+
+
+// Hermes form of an Aggregate: a map of count, sum, min and max, so
+// scan results can be returned from HRPC endpoints. Integers are widened
+// to BigInt/UBigInt, floating point values to Double. min and max are
+// omitted for empty aggregates.
+
+constexpr NamedCode AGGREGATE_COUNT = NamedCode(1, "count");
+constexpr NamedCode AGGREGATE_SUM   = NamedCode(2, "sum");
+constexpr NamedCode AGGREGATE_MIN   = NamedCode(3, "min");
+constexpr NamedCode AGGREGATE_MAX   = NamedCode(4, "max");
+
+template <typename T>
+using AggregateDT = std::conditional_t<
+    std::is_floating_point_v<T>,
+    Double,
+    std::conditional_t<std::is_signed_v<T>, BigInt, UBigInt>
+>;
+
+template <typename T>
+hermes::Object to_hermes(hermes::HermesCtr& ctr, const Aggregate<T>& agg)
+{
+    using DT = AggregateDT<T>;
+    using ViewT = DTTViewType<DT>;
+
+    auto map = ctr.make_object_map();
+
+    map.put_t<UBigInt>(AGGREGATE_COUNT, agg.count);
+    map.put_t<DT>(AGGREGATE_SUM, static_cast<ViewT>(agg.sum));
+
+    if (!agg.empty()) {
+        map.put_t<DT>(AGGREGATE_MIN, static_cast<ViewT>(agg.min));
+        map.put_t<DT>(AGGREGATE_MAX, static_cast<ViewT>(agg.max));
+    }
+
+    return map.as_object();
+}
+
+template <typename T>
+Aggregate<T> aggregate_from_hermes(const hermes::Object& obj)
+{
+    using DT = AggregateDT<T>;
+
+    auto map = obj.as_object_map();
+
+    Aggregate<T> agg;
+    agg.count = map.expect(AGGREGATE_COUNT).template convert_to<UBigInt>().template as_data_object<UBigInt>().value_t();
+    agg.sum = map.expect(AGGREGATE_SUM).template convert_to<DT>().template as_data_object<DT>().value_t();
+
+    if (!agg.empty()) {
+        agg.min = map.expect(AGGREGATE_MIN).template convert_to<DT>().template as_data_object<DT>().value_t();
+        agg.max = map.expect(AGGREGATE_MAX).template convert_to<DT>().template as_data_object<DT>().value_t();
+    }
+
+    return agg;
+}
+
+
+// Values of the Multimap key satisfying the predicate.
+template <typename Key, typename Value, typename Profile, typename Pred>
+auto multimap_values_aggregate(
+        const ICtrApi<Multimap<Key, Value>, Profile>& ctr,
+        const DTTViewType<Key>& key,
+        const Pred& pred
+)
+{
+    Aggregate<DTTViewType<Value>> agg;
+    SelectionVector sel;
+
+    auto ii = ctr.find_key(key);
+    if (!is_valid_chunk(ii) || !ii->is_found(key)) {
+        return agg;
+    }
+
+    auto vv = ii->values_chunk();
+    while (is_valid_chunk(vv))
+    {
+        // Values span of a Multimap chunk is already
+        // limited to the current key's values.
+        auto column = vv->values().raw_span();
+        if (column.empty()) {
+            break;
+        }
+
+        select(column, 0, column.size(), pred, sel);
+        agg.add(column, sel);
+
+        vv = vv->next(column.size());
+    }
+
+    return agg;
+}
+
+}
@@ -0,0 +1,89 @@
+// Copyright 2026 Victor Smirnov
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memoria/api/common/ctr_scan.hpp>
+
+#include <memoria/hrpc/hrpc.hpp>
+
+namespace memoria::scan {
+
+// HRPC endpoints for container scans. Request parameters define the
+// range to scan, the result is an Aggregate in its Hermes form (see
+// to_hermes()). Endpoints get the container to scan from a resolver
+// function, so they don't depend on how containers are located.
+//
+// This header needs the HRPC runtime API, it is not included by ctr_scan.hpp.
+
+constexpr NamedCode SCAN_FROM = NamedCode(1, "from");
+constexpr NamedCode SCAN_TO   = NamedCode(2, "to");
+
+template <typename T>
+hrpc::Response aggregate_response(const Aggregate<T>& agg)
+{
+    auto rs = hrpc::Response::ok();
+    auto ctr = rs.object().ctr();
+    rs.set_result(to_hermes(ctr, agg));
+    return rs;
+}
+
+// Aggregates Vector elements at positions [from, to).
+template <typename DataType, typename Profile>
+hrpc::Response vector_scan(const ICtrApi<Vector<DataType>, Profile>& ctr, const hrpc::Request& rq)
+{
+    auto params = rq.parameters();
+    uint64_t from = params.expect(SCAN_FROM).to_i64();
+    uint64_t to   = params.expect(SCAN_TO).to_i64();
+
+    using T = DTTViewType<DataType>;
+    return aggregate_response(vector_aggregate(ctr, from, to, AcceptAll<T>{}));
+}
+
+// Aggregates Map values with keys in [from, to).
+template <typename Key, typename Value, typename Profile>
+hrpc::Response map_range_scan(const ICtrApi<Map<Key, Value>, Profile>& ctr, const hrpc::Request& rq)
+{
+    auto params = rq.parameters();
+    DTTViewType<Key> from = params.expect(SCAN_FROM).template convert_to<Key>().template as_data_object<Key>().value_t();
+    DTTViewType<Key> to   = params.expect(SCAN_TO).template convert_to<Key>().template as_data_object<Key>().value_t();
+
+    return aggregate_response(map_range_aggregate(ctr, from, to, values));
+}
+
+
+// Endpoint handlers for the scans above. The resolver maps the request
+// to a container pointer, it may throw if there is no such container.
+
+template <typename Resolver>
+hrpc::st::RequestHandlerFn vector_scan_endpoint(Resolver resolver)
+{
+    return [=](PoolSharedPtr<hrpc::st::Context> context) {
+        auto rq = context->request();
+        auto ctr = resolver(rq);
+        return vector_scan(*ctr, rq);
+    };
+}
+
+template <typename Resolver>
+hrpc::st::RequestHandlerFn map_range_scan_endpoint(Resolver resolver)
+{
+    return [=](PoolSharedPtr<hrpc::st::Context> context) {
+        auto rq = context->request();
+        auto ctr = resolver(rq);
+        return map_range_scan(*ctr, rq);
+    };
+}
+
+}
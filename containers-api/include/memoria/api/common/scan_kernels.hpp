@@ -0,0 +1,242 @@
+// Copyright 2026 Victor Smirnov
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memoria/core/types.hpp>
+#include <memoria/core/tools/span.hpp>
+
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <type_traits>
+
+namespace memoria::scan {
+
+// Batch kernels over column spans of arithmetic types. Loops are
+// branch-free where possible, so the compiler can vectorize them.
+
+// Row numbers within a chunk that passed a filter, in ascending order.
+class SelectionVector {
+    std::vector<uint32_t> rows_;
+    size_t size_{};
+
+public:
+    SelectionVector() = default;
+
+    size_t size() const {return size_;}
+    bool empty() const {return size_ == 0;}
+
+    uint32_t operator[](size_t idx) const {return rows_[idx];}
+
+    Span<const uint32_t> span() const {
+        return Span<const uint32_t>(rows_.data(), size_);
+    }
+
+    void clear() {
+        size_ = 0;
+    }
+
+    // Returns a buffer for at least `capacity` rows. Kernels write
+    // rows speculatively and set the actual size afterwards.
+    uint32_t* prepare(size_t capacity)
+    {
+        if (rows_.size() < capacity) {
+            rows_.resize(capacity);
+        }
+        return rows_.data();
+    }
+
+    void set_size(size_t size) {
+        size_ = size;
+    }
+};
+
+
+template <typename T>
+struct AcceptAll {
+    bool operator()(const T&) const {return true;}
+};
+
+// [from, to)
+template <typename T>
+struct Between {
+    T from;
+    T to;
+
+    bool operator()(const T& value) const {
+        return (value >= from) & (value < to);
+    }
+};
+
+template <typename T>
+struct GreaterEq {
+    T value;
+    bool operator()(const T& vv) const {return vv >= value;}
+};
+
+template <typename T>
+struct Less {
+    T value;
+    bool operator()(const T& vv) const {return vv < value;}
+};
+
+template <typename T>
+struct Equals {
+    T value;
+    bool operator()(const T& vv) const {return vv == value;}
+};
+
+
+// Rows [from, to) of the column satisfying the predicate.
+template <typename T, typename Pred>
+void select(Span<const T> column, size_t from, size_t to, const Pred& pred, SelectionVector& sel)
+{
+    uint32_t* rows = sel.prepare(to - from);
+    const T* data = column.data();
+
+    size_t cnt{};
+    for (size_t c = from; c < to; c++) {
+        rows[cnt] = c;
+        cnt += pred(data[c]);
+    }
+
+    sel.set_size(cnt);
+}
+
+// Narrows an existing selection with a predicate over another column.
+template <typename T, typename Pred>
+void refine(Span<const T> column, const Pred& pred, SelectionVector& sel)
+{
+    uint32_t* rows = sel.prepare(sel.size());
+    const T* data = column.data();
+
+    size_t cnt{};
+    for (size_t c = 0; c < sel.size(); c++) {
+        uint32_t row = rows[c];
+        rows[cnt] = row;
+        cnt += pred(data[row]);
+    }
+
+    sel.set_size(cnt);
+}
+
+template <typename T, typename Pred>
+size_t count(Span<const T> column, size_t from, size_t to, const Pred& pred)
+{
+    const T* data = column.data();
+
+    size_t cnt{};
+    for (size_t c = from; c < to; c++) {
+        cnt += pred(data[c]);
+    }
+
+    return cnt;
+}
+
+
+template <typename T>
+using SumT = std::conditional_t<
+    std::is_floating_point_v<T>,
+    double,
+    std::conditional_t<std::is_signed_v<T>, int64_t, uint64_t>
+>;
+
+template <typename T>
+SumT<T> sum(Span<const T> column, size_t from, size_t to)
+{
+    const T* data = column.data();
+
+    SumT<T> sum{};
+    for (size_t c = from; c < to; c++) {
+        sum += data[c];
+    }
+
+    return sum;
+}
+
+template <typename T>
+SumT<T> sum(Span<const T> column, const SelectionVector& sel)
+{
+    const T* data = column.data();
+
+    SumT<T> sum{};
+    for (size_t c = 0; c < sel.size(); c++) {
+        sum += data[sel[c]];
+    }
+
+    return sum;
+}
+
+
+// Count, sum, min and max of a column in one pass.
+template <typename T>
+struct Aggregate {
+    uint64_t count{};
+    SumT<T> sum{};
+    T min{std::numeric_limits<T>::max()};
+    T max{std::numeric_limits<T>::lowest()};
+
+    bool empty() const {
+        return count == 0;
+    }
+
+    void add(Span<const T> column, size_t from, size_t to)
+    {
+        const T* data = column.data();
+
+        SumT<T> ss{};
+        T mn = min, mx = max;
+        for (size_t c = from; c < to; c++) {
+            T vv = data[c];
+            ss += vv;
+            mn = std::min(mn, vv);
+            mx = std::max(mx, vv);
+        }
+
+        count += to - from;
+        sum += ss;
+        min = mn;
+        max = mx;
+    }
+
+    void add(Span<const T> column, const SelectionVector& sel)
+    {
+        const T* data = column.data();
+
+        SumT<T> ss{};
+        T mn = min, mx = max;
+        for (size_t c = 0; c < sel.size(); c++) {
+            T vv = data[sel[c]];
+            ss += vv;
+            mn = std::min(mn, vv);
+            mx = std::max(mx, vv);
+        }
+
+        count += sel.size();
+        sum += ss;
+        min = mn;
+        max = mx;
+    }
+
+    void merge(const Aggregate& other)
+    {
+        count += other.count;
+        sum += other.sum;
+        min = std::min(min, other.min);
+        max = std::max(max, other.max);
+    }
+};
+
+}
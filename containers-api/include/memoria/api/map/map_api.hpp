@@ -87,6 +87,8 @@ struct ICtrApi<Map<Key, Value>, Profile>: public CtrReferenceable<Profile> {
 
     using CtrInputBuffer = typename ApiTypes::CtrInputBuffer;
 
+    using DiffConsumerFn = std::function<bool (const KeyView&, const Optional<ValueView>&, const Optional<ValueView>&)>;
+
     virtual void remove(CtrSizeT from, CtrSizeT to) MEMORIA_READ_ONLY_API
 
     virtual void remove_from(CtrSizeT from) MEMORIA_READ_ONLY_API
@@ -97,6 +99,26 @@ struct ICtrApi<Map<Key, Value>, Profile>: public CtrReferenceable<Profile> {
     virtual bool remove_key(const KeyView& key) MEMORIA_READ_ONLY_API
 
     virtual ChunkIteratorPtr find(const KeyView& key) const = 0;
+
+    // Opt-in finger for point operations (find, upsert_key, remove_key).
+    // The container keeps the tree path of the last operation, and the
+    // next one starts from the lowest node of the path covering the key
+    // instead of from the root. Pays off for time-ordered inserts and
+    // sorted merges. Other updates of the container drop the path.
+    // Lookups update the finger too, so an instance with the finger
+    // enabled must not be read from several threads concurrently.
+    virtual void set_finger_enabled(bool enabled) = 0;
+    virtual bool is_finger_enabled() const = 0;
+    virtual FingerStat finger_stat() const = 0;
+
+    // Entries changed between `from` version of the container (usually
+    // the same container in an older snapshot) and this one, in key
+    // order: consumer(key, old_value, new_value). The old value is empty
+    // for added entries, the new one for removed. Subtrees shared by both
+    // versions are skipped without being read. The consumer returns false
+    // to stop.
+    virtual void diff(CtrSharedPtr<ICtrApi> from, const DiffConsumerFn& consumer) const = 0;
+
     virtual ChunkIteratorPtr append(CtrBatchInputFn<CtrInputBuffer> producer) MEMORIA_READ_ONLY_API
 
     virtual ChunkIteratorPtr prepend(CtrBatchInputFn<CtrInputBuffer> producer) MEMORIA_READ_ONLY_API
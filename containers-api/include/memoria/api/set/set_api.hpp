@@ -47,6 +47,11 @@ struct ICtrApi<Set<Key>, Profile>: public ICtrApi<Collection<Key>, Profile> {
 
     virtual bool contains(const KeyView& key)  = 0;
 
+    // Opt-in finger for point operations, see ICtrApi<Map>.
+    virtual void set_finger_enabled(bool enabled) = 0;
+    virtual bool is_finger_enabled() const = 0;
+    virtual FingerStat finger_stat() const = 0;
+
     virtual bool remove(const KeyView& key) MEMORIA_READ_ONLY_API
 
     virtual bool upsert(const KeyView& key) MEMORIA_READ_ONLY_API
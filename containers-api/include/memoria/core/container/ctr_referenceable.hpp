@@ -93,6 +93,7 @@ struct CtrReferenceableBase {
     virtual void drop()    MEMORIA_READ_ONLY_API
     virtual void cleanup() MEMORIA_READ_ONLY_API
     virtual void flush()   MEMORIA_READ_ONLY_API
+    virtual void compact() MEMORIA_READ_ONLY_API
 
     virtual void check(const CheckResultConsumerFn& fn) = 0;
 
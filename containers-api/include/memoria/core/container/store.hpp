@@ -28,12 +28,19 @@
 #include <memoria/core/tools/result.hpp>
 #include <memoria/core/memory/object_pool.hpp>
 #include <memoria/core/tools/checks.hpp>
+#include <memoria/core/tools/span.hpp>
 
 #include <memory>
 #include <typeinfo>
 
 namespace memoria {
 
+// Block placement hint passed by containers to the store's block allocator.
+// Stores that are not aware of placement may ignore it.
+enum class BlockAllocationHint: int32_t {
+    NONE, BRANCH, LEAF
+};
+
 template <typename Profile>
 struct IStoreBase: IStoreApiBase<ApiProfile<Profile>> {
 
@@ -59,10 +66,22 @@ struct IStoreBase: IStoreApiBase<ApiProfile<Profile>> {
 
     virtual SharedBlockConstPtr getBlock(const BlockID& id) = 0;
 
+    // Read-ahead hint: the blocks are likely to be requested soon.
+    // Mapped stores may ask the kernel to page them in, block device
+    // stores may start asynchronous reads. Default is no-op.
+    virtual void prefetch_blocks(Span<const BlockID> block_ids) {}
 
     virtual SharedBlockPtr createBlock(int32_t initial_size, const CtrID& ctr_id) = 0;
     virtual SharedBlockPtr cloneBlock(const SharedBlockConstPtr& block, const CtrID& ctr_id) = 0;
 
+    virtual SharedBlockPtr createBlock(int32_t initial_size, const CtrID& ctr_id, BlockAllocationHint) {
+        return createBlock(initial_size, ctr_id);
+    }
+
+    virtual SharedBlockPtr cloneBlock(const SharedBlockConstPtr& block, const CtrID& ctr_id, BlockAllocationHint) {
+        return cloneBlock(block, ctr_id);
+    }
+
     virtual BlockID newId() = 0;
     virtual SnapshotID snaphsot_Id() const = 0;
 
@@ -122,6 +141,13 @@ struct IStoreBase: IStoreApiBase<ApiProfile<Profile>> {
     virtual bool is_allocated(const BlockID& block_id) {
         return true;
     }
+
+    // Container checker asks if the subtree rooted at the block still
+    // needs checking. Stores checking many snapshots at once return
+    // false for subtrees shared with an already checked snapshot.
+    virtual bool check_subtree(const BlockID& block_id) {
+        return true;
+    }
 };
 
 
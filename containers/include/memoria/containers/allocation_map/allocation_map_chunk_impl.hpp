@@ -163,6 +163,14 @@ public:
         return Base::ctr().ctr_prev_leaf(this);
     }
 
+    virtual void set_read_ahead(size_t depth) {
+        Base::set_read_ahead_depth(depth);
+    }
+
+    virtual size_t read_ahead() const {
+        return Base::read_ahead_depth();
+    }
+
     void reset_state() noexcept
     {
         Base::reset_state();
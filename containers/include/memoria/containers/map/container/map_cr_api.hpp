@@ -27,6 +27,7 @@
 
 #include <memoria/core/tools/optional.hpp>
 
+#include <concepts>
 #include <vector>
 
 namespace memoria {
@@ -70,6 +71,9 @@ MEMORIA_V1_CONTAINER_PART_BEGIN(map::CtrRApiName)
     template <typename ShuttleTypes>
     using FindShuttle = bt::FindForwardShuttle<ShuttleTypes, KeysPath, ChunkImplT>;
 
+    using typename Base::BlockID;
+    using typename Base::TreeNodeConstPtr;
+
     using typename Base::BranchNodeExtData;
     using typename Base::LeafNodeExtData;
     using typename Base::ContainerTypeName;
@@ -100,7 +104,7 @@ MEMORIA_V1_CONTAINER_PART_BEGIN(map::CtrRApiName)
 
     IterSharedPtr<ChunkImplT> ctr_map_find(const KeyView& k) const
     {
-        return self().ctr_descend(
+        return self().template ctr_descend_fingered<KeysPath>(
             TypeTag<ChunkImplT>{},
             bt::ShuttleTag<FindShuttle>{},
             k, 0, SearchType::GE
@@ -113,6 +117,128 @@ MEMORIA_V1_CONTAINER_PART_BEGIN(map::CtrRApiName)
         return self().ctr_map_find(key);
     }
 
+    virtual void set_finger_enabled(bool enabled) {
+        self().ctr_set_finger_enabled(enabled);
+    }
+
+    virtual bool is_finger_enabled() const {
+        return self().ctr_is_finger_enabled();
+    }
+
+    virtual FingerStat finger_stat() const {
+        return self().ctr_finger_stat();
+    }
+
+    using DiffConsumerFn = typename ICtrApi<Map<Key, Value>, ApiProfileT>::DiffConsumerFn;
+
+    virtual void diff(CtrSharedPtr<ICtrApi<Map<Key, Value>, ApiProfileT>> from, const DiffConsumerFn& consumer) const
+    {
+        static_assert(std::equality_comparable<ValueView>, "Map::diff() requires values with operator==");
+
+        auto& self = this->self();
+
+        auto from_ctr = dynamic_cast<const MyType*>(from.get());
+        if (!from_ctr) {
+            MEMORIA_MAKE_GENERIC_ERROR("Containers of different types can't be compared").do_throw();
+        }
+
+        self.ctr_diff_leaves(*from_ctr, [&](const auto& mine, const auto& theirs) {
+            DiffLeafCursor ii(self, mine);
+            DiffLeafCursor jj(*from_ctr, theirs);
+
+            bool proceed = true;
+            while (proceed && (ii.valid() || jj.valid()))
+            {
+                if (!jj.valid() || (ii.valid() && ii.key() < jj.key()))
+                {
+                    proceed = consumer(ii.key(), Optional<ValueView>{}, ii.value());
+                    ii.next();
+                }
+                else if (!ii.valid() || jj.key() < ii.key())
+                {
+                    proceed = consumer(jj.key(), jj.value(), Optional<ValueView>{});
+                    jj.next();
+                }
+                else {
+                    if (!(jj.value() == ii.value())) {
+                        proceed = consumer(ii.key(), jj.value(), ii.value());
+                    }
+
+                    ii.next();
+                    jj.next();
+                }
+            }
+        });
+    }
+
+private:
+    template <typename LeafPath>
+    struct DiffLeafStructFn {
+        template <typename LeafNodeSO>
+        auto treeNode(const LeafNodeSO& node) {
+            return node.template substream<LeafPath>();
+        }
+    };
+
+    // Entries of a list of leaves in key order
+    class DiffLeafCursor {
+        const MyType& ctr_;
+        const std::vector<BlockID>& leaves_;
+        size_t leaf_idx_{};
+        size_t pos_{};
+        size_t size_{};
+        TreeNodeConstPtr leaf_;
+
+    public:
+        DiffLeafCursor(const MyType& ctr, const std::vector<BlockID>& leaves):
+            ctr_(ctr), leaves_(leaves)
+        {
+            load_leaf();
+        }
+
+        bool valid() const {
+            return pos_ < size_;
+        }
+
+        KeyView key() const {
+            return ctr_.leaf_dispatcher().dispatch(leaf_, DiffLeafStructFn<KeysPath>{}).access(0, pos_);
+        }
+
+        ValueView value() const {
+            return ctr_.leaf_dispatcher().dispatch(leaf_, DiffLeafStructFn<ValuesPath>{}).access(0, pos_);
+        }
+
+        void next()
+        {
+            if (++pos_ >= size_) {
+                leaf_idx_++;
+                load_leaf();
+            }
+        }
+
+    private:
+        void load_leaf()
+        {
+            pos_  = 0;
+            size_ = 0;
+
+            // Skip empty leaves
+            while (leaf_idx_ < leaves_.size())
+            {
+                leaf_ = ctr_.ctr_get_block(leaves_[leaf_idx_]);
+                size_ = ctr_.leaf_dispatcher().dispatch(leaf_, DiffLeafStructFn<KeysPath>{}).size();
+
+                if (size_) {
+                    break;
+                }
+
+                leaf_idx_++;
+            }
+        }
+    };
+
+public:
+
 MEMORIA_V1_CONTAINER_PART_END
 
 #define M_TYPE      MEMORIA_V1_CONTAINER_TYPE(map::CtrRApiName)
@@ -77,11 +77,13 @@ MEMORIA_V1_CONTAINER_PART_BEGIN(map::CtrWApiName)
 
       if (iter->is_found(key))
       {
-        self.ctr_update_map_entry(std::move(iter), value);
+        auto ii = self.ctr_update_map_entry(std::move(iter), value);
+        self.ctr_update_finger(ii->path());
         return true;
       }
       else {
-        self.ctr_insert_map_entry(std::move(iter), key, value);
+        auto ii = self.ctr_insert_map_entry(std::move(iter), key, value);
+        self.ctr_update_finger(ii->path());
         return false;
       }
     }
@@ -95,7 +97,8 @@ MEMORIA_V1_CONTAINER_PART_BEGIN(map::CtrWApiName)
 
       if (iter->is_found(key))
       {
-        self.ctr_remove_map_entry(std::move(iter));
+        self.ctr_remove_map_entry(iter);
+        self.ctr_update_finger(iter->path());
         return true;
       }
 
@@ -226,17 +229,17 @@ MEMORIA_V1_CONTAINER_PART_BEGIN(map::CtrWApiName)
     }
 
     template <typename IterT>
-    void ctr_insert_map_entry(IterT&& iter, KeyView key, ValueView value) {
-      self().ctr_insert_entry(
+    auto ctr_insert_map_entry(IterT&& iter, KeyView key, ValueView value) {
+      return self().ctr_insert_entry(
           std::move(iter),
           map::KeyValueEntry<KeyView, ValueView, CtrSizeT>(key, value)
       );
     }
 
     template <typename IterT>
-    void ctr_update_map_entry(IterT&& iter, ValueView value)
+    auto ctr_update_map_entry(IterT&& iter, ValueView value)
     {
-      self().template ctr_update_entry2<ValuesPath>(std::move(iter), map::ValueBuffer<ValueView>(value));
+      return self().template ctr_update_entry2<ValuesPath>(std::move(iter), map::ValueBuffer<ValueView>(value));
     }
 
 
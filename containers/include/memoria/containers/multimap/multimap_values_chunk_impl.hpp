@@ -233,6 +233,14 @@ public:
         return prev(prefix);
     }
 
+    virtual void set_read_ahead(size_t depth) {
+        Base::set_read_ahead_depth(depth);
+    }
+
+    virtual size_t read_ahead() const {
+        return Base::read_ahead_depth();
+    }
+
     virtual ChunkPtr read_to(HermesDTBuffer<Value>& buffer, CtrSizeT num) const {
         return ChunkPtr{};
     }
@@ -98,7 +98,7 @@ public:
 
     IterSharedPtr<CollectionChunkImplT> ctr_set_find(const KeyView& k) const
     {
-        return self().ctr_descend(
+        return self().template ctr_descend_fingered<EntriesPath>(
             TypeTag<CollectionChunkImplT>{},
             bt::ShuttleTag<FindShuttle>{},
             k, 0, SearchType::GE
@@ -111,6 +111,18 @@ public:
         return self().ctr_set_find(key);
     }
 
+    void set_finger_enabled(bool enabled) {
+        self().ctr_set_finger_enabled(enabled);
+    }
+
+    bool is_finger_enabled() const {
+        return self().ctr_is_finger_enabled();
+    }
+
+    FingerStat finger_stat() const {
+        return self().ctr_finger_stat();
+    }
+
 
 
     /**
@@ -129,11 +129,12 @@ public:
             return true;
         }
         else {
-            self().ctr_insert_entry(
+            auto ii = self().ctr_insert_entry(
                 std::move(iter),
                 set::KeyEntry<KeyView, CtrSizeT>(k)
             );
 
+            self().ctr_update_finger(ii->path());
             return false;
         }
     }
@@ -151,6 +152,7 @@ public:
             auto idx = iter->iter_leaf_position();
             self.ctr_remove_entry(iter->path(), idx);
 
+            self.ctr_update_finger(iter->path());
             return true;
         }
 
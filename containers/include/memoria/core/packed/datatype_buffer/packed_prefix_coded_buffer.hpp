@@ -0,0 +1,654 @@
+// Copyright 2026 Victor Smirnov
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <memoria/core/packed/tools/packed_allocator.hpp>
+
+#include <memoria/core/tools/i7_codec.hpp>
+#include <memoria/core/tools/arena_buffer.hpp>
+#include <memoria/core/tools/span.hpp>
+#include <memoria/core/tools/bitmap.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace memoria {
+
+// Sorted array of byte strings stored with front coding.
+//
+// Entries are grouped into runs of restart_interval() elements. Every entry
+// is described by the (shared, suffix_length) pair, where `shared` is the
+// length of the prefix it has in common with the previous entry. A run is
+// stored as I7(headers_length), the I7-encoded pairs of all its entries,
+// then the suffixes, so headers of a run are decoded in one batch. The
+// first entry of a run (restart point) always has shared == 0 and can be
+// read in place. Offsets of runs are kept in a separate block, so lookups
+// binary-search restart points without decoding anything and then scan at
+// most one run.
+//
+// Unlike the plain VLE dimension of PackedDataTypeBuffer, entries can't be
+// returned as views into the block. Values are decoded into a caller-provided
+// buffer instead.
+class PackedPrefixCodedBuffer: public PackedAllocator {
+    using Base = PackedAllocator;
+public:
+    using MyType    = PackedPrefixCodedBuffer;
+    using AtomType  = uint8_t;
+    using ViewType  = Span<const AtomType>;
+
+    static constexpr uint32_t VERSION = 1;
+    static constexpr size_t DEFAULT_RESTART_INTERVAL = 16;
+
+    enum {METADATA = 0, RESTARTS, DATA, STRUCTS_NUM__};
+
+    class Metadata {
+        psize_t size_;
+        psize_t data_size_;
+        psize_t restart_interval_;
+        psize_t reserved_;
+    public:
+        size_t size() const {return size_;}
+        void set_size(size_t size) {size_ = size;}
+
+        size_t data_size() const {return data_size_;}
+        void set_data_size(size_t size) {data_size_ = size;}
+
+        size_t restart_interval() const {return restart_interval_;}
+        void set_restart_interval(size_t val) {restart_interval_ = val;}
+
+        const psize_t& size0() const {return size_;}
+        psize_t& size0() {return size_;}
+
+        const psize_t& data_size0() const {return data_size_;}
+        psize_t& data_size0() {return data_size_;}
+
+        const psize_t& restart_interval0() const {return restart_interval_;}
+        psize_t& restart_interval0() {return restart_interval_;}
+    };
+
+    using Base::block_size;
+    using Base::get;
+
+    PackedPrefixCodedBuffer() = default;
+
+    static size_t empty_size() {
+        return base_size(0, 0);
+    }
+
+    // Allocator block size needed to hold `runs` restart points
+    // and `data_size` bytes of encoded entries.
+    static size_t base_size(size_t runs, size_t data_size)
+    {
+        size_t metadata_length = PackedAllocatable::round_up_bytes(sizeof(Metadata));
+        size_t restarts_length = PackedAllocatable::round_up_bytes(runs * sizeof(psize_t));
+        size_t data_length     = PackedAllocatable::round_up_bytes(data_size);
+
+        return PackedAllocator::block_size(metadata_length + restarts_length + data_length, STRUCTS_NUM__);
+    }
+
+    void init_bs(size_t) {
+        return init();
+    }
+
+    void init()
+    {
+        Base::init(empty_size(), STRUCTS_NUM__);
+
+        Metadata* meta = allocate<Metadata>(METADATA);
+        meta->set_size(0);
+        meta->set_data_size(0);
+        meta->set_restart_interval(DEFAULT_RESTART_INTERVAL);
+    }
+
+    void set_restart_interval(size_t interval)
+    {
+        if (MMA_UNLIKELY(size() > 0)) {
+            MEMORIA_MAKE_GENERIC_ERROR("Restart interval can be changed only for an empty buffer").do_throw();
+        }
+
+        if (MMA_UNLIKELY(interval == 0)) {
+            MEMORIA_MAKE_GENERIC_ERROR("Restart interval must be positive").do_throw();
+        }
+
+        metadata().set_restart_interval(interval);
+    }
+
+    Metadata& metadata() {
+        return *get<Metadata>(METADATA);
+    }
+
+    const Metadata& metadata() const {
+        return *get<Metadata>(METADATA);
+    }
+
+    size_t size() const {
+        return metadata().size();
+    }
+
+    size_t data_size() const {
+        return metadata().data_size();
+    }
+
+    size_t restart_interval() const {
+        return metadata().restart_interval();
+    }
+
+    size_t restarts() const {
+        return div_up(size(), restart_interval());
+    }
+
+    const psize_t* restart_offsets() const {
+        return get<psize_t>(RESTARTS);
+    }
+
+    const AtomType* data() const {
+        return get<AtomType>(DATA);
+    }
+
+    // Restart points are stored in full, so they are accessible in place.
+    ViewType restart_value(size_t run) const
+    {
+        const AtomType* dd = data();
+        size_t pos = restart_offsets()[run];
+
+        size_t headers_length{}, shared{}, length{};
+        pos += DecodeI7(dd, headers_length, pos);
+
+        size_t suffixes = pos + headers_length;
+
+        pos += DecodeI7(dd, shared, pos);
+        DecodeI7(dd, length, pos);
+
+        return ViewType(dd + suffixes, length);
+    }
+
+    void access(size_t idx, ArenaBuffer<AtomType>& value) const
+    {
+        size_t interval = restart_interval();
+
+        RunCursor cursor;
+        cursor.open(*this, idx / interval);
+
+        for (size_t c = cursor.start(); c <= idx; c++) {
+            cursor.next(value);
+        }
+    }
+
+    // Sequential scan, decodes every entry exactly once.
+    template <typename Fn>
+    void for_each(Fn&& fn) const {
+        for_each_from_run(0, std::forward<Fn>(fn));
+    }
+
+    // Index of the first entry that is not less than `key`, size() if none.
+    size_t find_ge(ViewType key) const
+    {
+        size_t size = this->size();
+        if (MMA_UNLIKELY(size == 0)) {
+            return 0;
+        }
+
+        // First run whose restart point is greater than the key.
+        size_t lo = 0;
+        size_t hi = restarts();
+        while (lo < hi)
+        {
+            size_t mid = (lo + hi) / 2;
+            if (compare(restart_value(mid), key) <= 0) {
+                lo = mid + 1;
+            }
+            else {
+                hi = mid;
+            }
+        }
+
+        if (lo == 0) {
+            return 0;
+        }
+
+        RunCursor cursor;
+        cursor.open(*this, lo - 1);
+
+        ArenaBuffer<AtomType> value;
+        size_t end = cursor.start() + cursor.entries();
+
+        for (size_t c = cursor.start(); c < end; c++)
+        {
+            cursor.next(value);
+            if (compare(value.span(), key) >= 0) {
+                return c;
+            }
+        }
+
+        return end;
+    }
+
+    bool contains(ViewType key) const
+    {
+        size_t idx = find_ge(key);
+        if (idx < size())
+        {
+            ArenaBuffer<AtomType> value;
+            access(idx, value);
+            return compare(value.span(), key) == 0;
+        }
+
+        return false;
+    }
+
+    // Values must keep the buffer sorted.
+    void insert(size_t idx, Span<const ViewType> values) {
+        splice(idx, idx, values);
+    }
+
+    void insert(size_t idx, ViewType value) {
+        splice(idx, idx, Span<const ViewType>(&value, 1));
+    }
+
+    void append(Span<const ViewType> values) {
+        splice(size(), size(), values);
+    }
+
+    void remove(size_t start, size_t end) {
+        splice(start, end, Span<const ViewType>());
+    }
+
+    // Allocator block size this buffer will need after the insertion.
+    // Used to check if the insertion fits into the enclosing block.
+    size_t block_size_for_insert(size_t idx, Span<const ViewType> values) const
+    {
+        Tail tail;
+        size_t run = collect_tail(idx, idx, values, tail);
+
+        size_t prefix_length = run < restarts() ? restart_offsets()[run] : data_size();
+        size_t runs = div_up(run * restart_interval() + tail.size(), restart_interval());
+
+        return base_size(runs, prefix_length + encoded_length(tail));
+    }
+
+    void split_to(MyType* other, size_t idx)
+    {
+        if (MMA_UNLIKELY(other->size() > 0)) {
+            MEMORIA_MAKE_GENERIC_ERROR("Split target must be empty").do_throw();
+        }
+
+        Tail tail;
+        for_each([&](size_t c, ViewType value){
+            if (c >= idx) {
+                tail.add(value);
+            }
+        });
+
+        std::vector<ViewType> views;
+        tail.views(views);
+
+        other->append(Span<const ViewType>(views.data(), views.size()));
+        remove(idx, size());
+    }
+
+    void merge_with(MyType* other) const
+    {
+        Tail tail;
+        for_each([&](size_t, ViewType value){
+            tail.add(value);
+        });
+
+        std::vector<ViewType> views;
+        tail.views(views);
+
+        other->append(Span<const ViewType>(views.data(), views.size()));
+    }
+
+    void check() const
+    {
+        size_t runs = restarts();
+
+        size_t restarts_length = element_size(RESTARTS);
+        if (restarts_length < runs * sizeof(psize_t)) {
+            MEMORIA_MAKE_GENERIC_ERROR("Restarts block is too small: {} for {} runs", restarts_length, runs).do_throw();
+        }
+
+        const psize_t* offsets = restart_offsets();
+
+        RunCursor cursor;
+        ArenaBuffer<AtomType> prev;
+        ArenaBuffer<AtomType> value;
+
+        size_t pos = 0;
+        for (size_t run = 0; run < runs; run++)
+        {
+            if (offsets[run] != pos) {
+                MEMORIA_MAKE_GENERIC_ERROR("Restart point {} offset mismatch: {} {}", run, offsets[run], pos).do_throw();
+            }
+
+            cursor.open(*this, run);
+
+            if (cursor.decoded_headers_length() != cursor.headers_length()) {
+                MEMORIA_MAKE_GENERIC_ERROR(
+                    "Run {} headers length mismatch: {} {}", run, cursor.decoded_headers_length(), cursor.headers_length()
+                ).do_throw();
+            }
+
+            if (cursor.shared(0) != 0) {
+                MEMORIA_MAKE_GENERIC_ERROR("Restart point {} has non-zero shared prefix: {}", run, cursor.shared(0)).do_throw();
+            }
+
+            size_t end = cursor.start() + cursor.entries();
+            for (size_t c = cursor.start(); c < end; c++)
+            {
+                cursor.next(value);
+
+                if (c > 0 && compare(prev.span(), value.span()) > 0) {
+                    MEMORIA_MAKE_GENERIC_ERROR("Entries are not sorted at {}", c).do_throw();
+                }
+
+                prev = value;
+            }
+
+            pos = cursor.position();
+        }
+
+        if (pos != data_size()) {
+            MEMORIA_MAKE_GENERIC_ERROR("Data size mismatch: {} {}", pos, data_size()).do_throw();
+        }
+    }
+
+    static int32_t compare(ViewType one, ViewType two)
+    {
+        size_t len = std::min(one.size(), two.size());
+        int32_t res = len ? std::memcmp(one.data(), two.data(), len) : 0;
+
+        if (res) {
+            return res;
+        }
+
+        return one.size() < two.size() ? -1 : (one.size() > two.size() ? 1 : 0);
+    }
+
+    template <typename SerializationData>
+    void serialize(SerializationData& buf) const
+    {
+        Base::serialize(buf);
+
+        auto& meta = this->metadata();
+        FieldFactory<psize_t>::serialize(buf, meta.size0());
+        FieldFactory<psize_t>::serialize(buf, meta.data_size0());
+        FieldFactory<psize_t>::serialize(buf, meta.restart_interval0());
+
+        FieldFactory<psize_t>::serialize(buf, restart_offsets(), restarts());
+        FieldFactory<AtomType>::serialize(buf, data(), data_size());
+    }
+
+    template <typename DeserializationData>
+    void deserialize(DeserializationData& buf)
+    {
+        Base::deserialize(buf);
+
+        auto& meta = this->metadata();
+        FieldFactory<psize_t>::deserialize(buf, meta.size0());
+        FieldFactory<psize_t>::deserialize(buf, meta.data_size0());
+        FieldFactory<psize_t>::deserialize(buf, meta.restart_interval0());
+
+        FieldFactory<psize_t>::deserialize(buf, get<psize_t>(RESTARTS), restarts());
+        FieldFactory<AtomType>::deserialize(buf, get<AtomType>(DATA), data_size());
+    }
+
+private:
+
+    // Decoded entries starting from a restart point.
+    struct Tail {
+        ArenaBuffer<AtomType> bytes;
+        std::vector<size_t> ends;
+
+        size_t size() const {
+            return ends.size();
+        }
+
+        ViewType get(size_t idx) const
+        {
+            size_t start = idx ? ends[idx - 1] : 0;
+            return ViewType(bytes.data() + start, ends[idx] - start);
+        }
+
+        void add(ViewType value)
+        {
+            bytes.insert(bytes.end(), value.begin(), value.end());
+            ends.push_back(bytes.size());
+        }
+
+        void views(std::vector<ViewType>& views) const
+        {
+            for (size_t c = 0; c < ends.size(); c++) {
+                views.push_back(get(c));
+            }
+        }
+    };
+
+    // Decodes entries of a run. Headers of the whole run are decoded
+    // in one batch, then suffixes are applied entry by entry.
+    class RunCursor {
+        const AtomType* data_{};
+        std::vector<size_t> headers_;
+        size_t start_{};
+        size_t entries_{};
+        size_t idx_{};
+        size_t pos_{};
+        size_t headers_length_{};
+        size_t decoded_headers_length_{};
+    public:
+        void open(const MyType& buffer, size_t run)
+        {
+            size_t interval = buffer.restart_interval();
+
+            data_    = buffer.data();
+            start_   = run * interval;
+            entries_ = std::min(interval, buffer.size() - start_);
+            idx_     = 0;
+
+            size_t pos = buffer.restart_offsets()[run];
+            pos += DecodeI7(data_, headers_length_, pos);
+
+            headers_.resize(entries_ * 2);
+            decoded_headers_length_ = DecodeI7N(data_, headers_.data(), headers_.size(), pos);
+
+            pos_ = pos + headers_length_;
+        }
+
+        size_t start() const {return start_;}
+        size_t entries() const {return entries_;}
+
+        size_t shared(size_t idx) const {
+            return headers_[idx * 2];
+        }
+
+        size_t headers_length() const {return headers_length_;}
+        size_t decoded_headers_length() const {return decoded_headers_length_;}
+
+        // Position right after the last decoded suffix.
+        size_t position() const {return pos_;}
+
+        void next(ArenaBuffer<AtomType>& value)
+        {
+            size_t shared = headers_[idx_ * 2];
+            size_t length = headers_[idx_ * 2 + 1];
+            idx_++;
+
+            value.resize(shared);
+            value.insert(value.end(), data_ + pos_, data_ + pos_ + length);
+
+            pos_ += length;
+        }
+    };
+
+    template <typename Fn>
+    void for_each_from_run(size_t run, Fn&& fn) const
+    {
+        RunCursor cursor;
+        ArenaBuffer<AtomType> value;
+
+        for (size_t runs = restarts(); run < runs; run++)
+        {
+            cursor.open(*this, run);
+
+            size_t end = cursor.start() + cursor.entries();
+            for (size_t c = cursor.start(); c < end; c++)
+            {
+                cursor.next(value);
+                fn(c, value.span());
+            }
+        }
+    }
+
+    // Decodes everything from the restart point preceding `start` up to the
+    // end of the buffer, replacing entries [start, end) with `values`.
+    // Returns the run the tail starts from.
+    size_t collect_tail(size_t start, size_t end, Span<const ViewType> values, Tail& tail) const
+    {
+        size_t size     = this->size();
+        size_t interval = restart_interval();
+        size_t run      = start / interval;
+
+        if (MMA_UNLIKELY(start > end || end > size)) {
+            MEMORIA_MAKE_GENERIC_ERROR("Invalid range: {} {} for size {}", start, end, size).do_throw();
+        }
+
+        bool inserted = false;
+        auto insert_values = [&]{
+            for (const ViewType& vv: values) {
+                tail.add(vv);
+            }
+            inserted = true;
+        };
+
+        for_each_from_run(run, [&](size_t c, ViewType value){
+            if (c == start) {
+                insert_values();
+            }
+
+            if (c < start || c >= end) {
+                tail.add(value);
+            }
+        });
+
+        if (!inserted) {
+            insert_values();
+        }
+
+        return run;
+    }
+
+    static size_t common_prefix(ViewType one, ViewType two)
+    {
+        size_t len = std::min(one.size(), two.size());
+        size_t c = 0;
+        while (c < len && one[c] == two[c]) {
+            c++;
+        }
+        return c;
+    }
+
+    // (shared, suffix_length) pairs of the tail's run [from, from + count).
+    // Returns their encoded length.
+    static size_t run_headers(const Tail& tail, size_t from, size_t count, std::vector<size_t>& headers)
+    {
+        headers.resize(count * 2);
+
+        size_t length{};
+        for (size_t c = 0; c < count; c++)
+        {
+            ViewType value = tail.get(from + c);
+            size_t shared = c ? common_prefix(tail.get(from + c - 1), value) : 0;
+            size_t suffix = value.size() - shared;
+
+            headers[c * 2]     = shared;
+            headers[c * 2 + 1] = suffix;
+
+            length += GetI7ValueLength(shared) + GetI7ValueLength(suffix);
+        }
+
+        return length;
+    }
+
+    size_t encoded_length(const Tail& tail) const
+    {
+        size_t interval = restart_interval();
+        std::vector<size_t> headers;
+        size_t length{};
+
+        for (size_t from = 0; from < tail.size(); from += interval)
+        {
+            size_t count = std::min(interval, tail.size() - from);
+            size_t headers_length = run_headers(tail, from, count, headers);
+
+            length += GetI7ValueLength(headers_length) + headers_length;
+
+            for (size_t c = 0; c < count; c++) {
+                length += headers[c * 2 + 1];
+            }
+        }
+
+        return length;
+    }
+
+    void splice(size_t start, size_t end, Span<const ViewType> values)
+    {
+        Tail tail;
+        size_t run = collect_tail(start, end, values, tail);
+
+        size_t interval = restart_interval();
+        size_t prefix_length = run < restarts() ? restart_offsets()[run] : data_size();
+        size_t new_size = run * interval + tail.size();
+        size_t new_runs = div_up(new_size, interval);
+        size_t new_data_size = prefix_length + encoded_length(tail);
+
+        resize_block(RESTARTS, new_runs * sizeof(psize_t));
+        resize_block(DATA, new_data_size);
+
+        psize_t* offsets = get<psize_t>(RESTARTS);
+        AtomType* dd = get<AtomType>(DATA);
+
+        std::vector<size_t> headers;
+
+        size_t pos = prefix_length;
+        for (size_t from = 0; from < tail.size(); from += interval)
+        {
+            size_t count = std::min(interval, tail.size() - from);
+            size_t headers_length = run_headers(tail, from, count, headers);
+
+            offsets[run + from / interval] = pos;
+
+            pos += EncodeI7(dd, headers_length, pos);
+            pos += EncodeI7N(dd, headers.data(), headers.size(), pos);
+
+            for (size_t c = 0; c < count; c++)
+            {
+                ViewType value = tail.get(from + c);
+                size_t shared = headers[c * 2];
+                size_t suffix = headers[c * 2 + 1];
+
+                MemCpyBuffer(value.data() + shared, dd + pos, suffix);
+                pos += suffix;
+            }
+        }
+
+        auto& meta = metadata();
+        meta.set_size(new_size);
+        meta.set_data_size(new_data_size);
+    }
+};
+
+}
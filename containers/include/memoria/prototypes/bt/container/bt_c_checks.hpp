@@ -167,6 +167,16 @@ void M_TYPE::ctr_check_tree_structure(
 {
     auto& self = the_self();
 
+    if (!self.store().check_subtree(node->id()))
+    {
+        // Shared subtree, already checked. Only the link
+        // from the new parent needs checking here.
+        if (!node->is_root()) {
+            self.tree_dispatcher().dispatchTree(parent, node, CheckTypedNodeContentFn(self), parent_idx, fn);
+        }
+        return;
+    }
+
     bool allocated = self.store().is_allocated(node->id());
     if (!allocated) {
         fn(CheckSeverity::ERROR, make_string_document("Node {} is not marked as allocated in the store", node->id()));
@@ -23,6 +23,8 @@
 #include <memoria/core/container/macros.hpp>
 
 #include <limits>
+#include <algorithm>
+#include <type_traits>
 
 namespace memoria {
 
@@ -36,12 +38,29 @@ public:
     using typename Base::TreePathT;
     using typename Base::BlockIteratorStatePtr;
     using typename Base::ShuttleTypes;
+    using typename Base::BlockID;
 
     using LeafStreamsStructList = typename Types::LeafStreamsStructList;
 
     template <typename LeafPath>
     using TargetType = typename Types::template TargetType<LeafPath>;
 
+protected:
+    // Finger: the tree path of the last keyed point operation, kept
+    // when enabled with ctr_set_finger_enabled(). The next fingered
+    // descent starts from the lowest node of this path whose key range
+    // covers the target, so consecutive operations on close keys climb
+    // only as far as needed instead of descending from the root.
+    //
+    // Any node update resets the finger (see ctr_cow_clone_path()),
+    // including COW path clones, because the cached nodes may be
+    // replaced, split or merged. Point operations capture the updated
+    // path of their own iterator afterwards.
+    mutable TreePathT finger_;
+    mutable FingerStat finger_stat_;
+    bool finger_enabled_{};
+
+public:
     MEMORIA_V1_DECLARE_NODE_FN(SizesFn, size_sums);
     Position sizes() const
     {
@@ -64,6 +83,90 @@ public:
         return ctr_descend(state_tag, shuttle);
     }
 
+    void ctr_set_finger_enabled(bool enabled)
+    {
+        finger_enabled_ = enabled;
+        finger_.clear();
+        finger_stat_ = FingerStat{};
+    }
+
+    bool ctr_is_finger_enabled() const {
+        return finger_enabled_;
+    }
+
+    FingerStat ctr_finger_stat() const {
+        return finger_stat_;
+    }
+
+    void ctr_reset_finger() const
+    {
+        if (MMA_UNLIKELY(finger_.size())) {
+            finger_.clear();
+        }
+    }
+
+    void ctr_update_finger(const TreePathT& path) const
+    {
+        if (finger_enabled_) {
+            finger_ = path;
+        }
+    }
+
+    // Keyed descent starting from the finger if it's enabled. Only for
+    // MAX-ordered keys: FindMax shuttles carry no state between levels,
+    // so descending from the middle of the tree ends at the same leaf
+    // position as descending from the root. Keys are in column 0.
+    template <typename LeafPath, typename StateTypeT, template <typename> class ShuttleT, typename KeyT, typename... Args>
+    IterSharedPtr<StateTypeT> ctr_descend_fingered(
+            TypeTag<StateTypeT> state_tag,
+            bt::ShuttleTag<ShuttleT>,
+            const KeyT& key,
+            Args&&... args
+    ) const
+    {
+        static_assert(
+            Types::template KeyOrderingType<LeafPath> == DTOrdering::MAX,
+            "Fingered descent requires MAX-ordered keys"
+        );
+
+        ShuttleT<ShuttleTypes> shuttle(key, std::forward<Args>(args)...);
+        if (!finger_enabled_) {
+            return ctr_descend(state_tag, shuttle);
+        }
+
+        auto& self = this->self();
+
+        finger_stat_.descents++;
+
+        size_t level = ctr_finger_level<LeafPath>(key);
+        if (level < finger_.size() && shuttle.is_simple_ride())
+        {
+            IterSharedPtr<StateTypeT> state = self.make_block_iterator_state(state_tag);
+            state->path() = finger_;
+
+            shuttle.set_descending(true);
+            ctr_descend_path(state->path(), level, shuttle);
+            shuttle.finish(*state);
+
+            finger_ = state->path();
+
+            finger_stat_.hits++;
+            finger_stat_.levels += level + 1;
+            finger_stat_.full_levels += finger_.size();
+
+            return state;
+        }
+        else {
+            auto state = ctr_descend(state_tag, shuttle);
+            finger_ = state->path();
+
+            finger_stat_.levels += finger_.size();
+            finger_stat_.full_levels += finger_.size();
+
+            return state;
+        }
+    }
+
     template <typename StateTypeT>
     IterSharedPtr<StateTypeT> ctr_next_leaf(const StateTypeT* current) const
     {
@@ -74,6 +177,7 @@ public:
         auto tmp = current->prepare_next_leaf();
         if (self.ctr_get_next_node(state->path(), 0)) {
             state->on_next_leaf(tmp);
+            self.ctr_read_ahead(*state);
             return std::move(state);
         }
         else {
@@ -92,6 +196,7 @@ public:
 
         if (self.ctr_get_prev_node(state->path(), 0)) {
             state->on_prev_leaf(tmp);
+            state->read_ahead_state().reset_window();
             return std::move(state);
         }
         else {
@@ -100,6 +205,61 @@ public:
     }
 
 
+    // Called after each forward leaf step. Once the scan looks sequential,
+    // keeps up to `depth` next siblings of the current leaf prefetched.
+    // The window grows with the length of the sequential run and is
+    // refilled when half of it has been consumed. Only siblings within
+    // the current parent are considered, so no extra blocks are read to
+    // find the IDs.
+    template <typename StateTypeT>
+    void ctr_read_ahead(StateTypeT& state) const
+    {
+        auto& self = this->self();
+        auto& ra = state.read_ahead_state();
+
+        using ReadAheadStateT = std::decay_t<decltype(ra)>;
+
+        ra.sequential_leaves++;
+
+        const TreePathT& path = state.path();
+        if (ra.depth == 0 || ra.sequential_leaves < ReadAheadStateT::MIN_SEQUENTIAL_LEAVES || path.size() < 2) {
+            return;
+        }
+
+        const TreeNodeConstPtr& parent = path[1];
+        size_t leaf_idx = self.ctr_get_child_idx(parent, path.leaf()->id());
+
+        if (ra.parent_id != parent->id())
+        {
+            ra.parent_id = parent->id();
+            ra.limit = leaf_idx + 1;
+        }
+        else if (ra.limit < leaf_idx + 1) {
+            ra.limit = leaf_idx + 1;
+        }
+
+        size_t window = std::min(ra.depth, ra.sequential_leaves);
+        if (ra.limit - (leaf_idx + 1) > window / 2) {
+            return;
+        }
+
+        size_t parent_size = self.ctr_get_node_size(parent, 0);
+        size_t end = std::min(leaf_idx + 1 + window, parent_size);
+
+        if (ra.limit < end)
+        {
+            BlockID ids[ReadAheadStateT::MAX_DEPTH];
+            size_t cnt{};
+
+            for (size_t c = ra.limit; c < end; c++) {
+                ids[cnt++] = self.ctr_get_child_id(parent, c);
+            }
+
+            self.store().prefetch_blocks(Span<const BlockID>(ids, cnt));
+            ra.limit = end;
+        }
+    }
+
     template <typename ShuttleTypes>
     void ctr_ride_uptree(const TreePathT& path, bt::UptreeShuttle<ShuttleTypes>& shuttle, size_t level = 0) const
     {
@@ -120,6 +280,97 @@ public:
 
 private:
 
+    template <typename LeafPath>
+    struct FingerLeafCoversFn {
+        template <typename NodeSO, typename KeyT>
+        bool treeNode(const NodeSO& node, const KeyT& key, bool leftmost, bool rightmost)
+        {
+            auto keys = node.template substream<LeafPath>();
+            size_t size = keys.size();
+
+            if (size) {
+                return (leftmost || !(key < keys.access(0, 0))) &&
+                       (rightmost || !(keys.access(0, size - 1) < key));
+            }
+
+            return leftmost && rightmost;
+        }
+    };
+
+    template <typename LeafPath>
+    struct FingerBranchCoversFn {
+        template <typename NodeSO, typename KeyT>
+        bool treeNode(const NodeSO& node, const KeyT& key, bool leftmost, bool rightmost)
+        {
+            using BranchPath = typename NodeSO::template BuildBranchPath<LeafPath>;
+            size_t column = NodeSO::template translateLeafIndexToBranchIndex<LeafPath>(0);
+
+            auto keys = node.template substream<BranchPath>();
+            size_t size = keys.size();
+
+            // Branch keys are maximums of children, so the node's own
+            // minimum is not known. A key above the first child's maximum
+            // is above anything in the left sibling subtree.
+            return (leftmost || keys.access(column, 0) < key) &&
+                   (rightmost || !(keys.access(column, size - 1) < key));
+        }
+    };
+
+    // Lowest level of the finger whose node covers the key,
+    // finger_.size() if there is no such level.
+    template <typename LeafPath, typename KeyT>
+    size_t ctr_finger_level(const KeyT& key) const
+    {
+        auto& self = this->self();
+
+        size_t height = finger_.size();
+        if (height == 0 || finger_.root()->id() != self.root()) {
+            return height;
+        }
+
+        // Nodes at levels >= leftmost_level (rightmost_level) are
+        // on the left (right) edge of the tree, and unbounded there.
+        size_t leftmost_level  = height - 1;
+        size_t rightmost_level = height - 1;
+
+        for (size_t ll = height - 1; ll > 0; ll--)
+        {
+            const TreeNodeConstPtr& parent = finger_[ll];
+            const BlockID& child_id = finger_[ll - 1]->id();
+
+            bool left  = leftmost_level == ll && self.ctr_get_child_id(parent, 0) == child_id;
+            bool right = rightmost_level == ll && self.ctr_get_child_id(parent, self.ctr_get_node_size(parent, 0) - 1) == child_id;
+
+            leftmost_level  -= left;
+            rightmost_level -= right;
+
+            if (!left && !right) {
+                break;
+            }
+        }
+
+        for (size_t ll = 0; ll < height; ll++)
+        {
+            const TreeNodeConstPtr& node = finger_[ll];
+            bool leftmost  = ll >= leftmost_level;
+            bool rightmost = ll >= rightmost_level;
+
+            bool covers;
+            if (ll == 0) {
+                covers = self.leaf_dispatcher().dispatch(node, FingerLeafCoversFn<LeafPath>(), key, leftmost, rightmost);
+            }
+            else {
+                covers = self.branch_dispatcher().dispatch(node, FingerBranchCoversFn<LeafPath>(), key, leftmost, rightmost);
+            }
+
+            if (covers) {
+                return ll;
+            }
+        }
+
+        return height;
+    }
+
     template <typename StateTypeT, typename ShuttleTypesT>
     IterSharedPtr<StateTypeT> ctr_descend(
             TypeTag<StateTypeT> state_tag,
@@ -135,6 +386,14 @@ private:
             bt::ForwardShuttleBase<ShuttleTypesT>& shuttle
     ) const;
 
+    // Descends from path[level] down to the leaf, updating the path.
+    template <typename ShuttleTypesT>
+    void ctr_descend_path(
+            TreePathT& path,
+            size_t level,
+            bt::ForwardShuttleBase<ShuttleTypesT>& shuttle
+    ) const;
+
 public:
 
 
@@ -395,40 +654,55 @@ typename M_TYPE::BlockIteratorStatePtr M_TYPE::ctr_descend(
 
     if (node.isSet())
     {
-        while (level > 0)
-        {
-            path.set(level, node);
+        path.set(level, node);
+        ctr_descend_path(path, level, shuttle);
 
-            auto result = self.branch_dispatcher().dispatch(node, shuttle, 0);
-            size_t idx = result.position();
+        shuttle.finish(*state);
+    }
 
-            if (MMA_UNLIKELY(!result.is_found()))
-            {
-                --idx;
-                self.branch_dispatcher().dispatch(node, shuttle, WalkCmd::FIX_TARGET, 0, idx);
-            }
+    return std::move(state);
+}
 
-            if (!shuttle.is_simple_ride()) {
-                self.branch_dispatcher().dispatch(node, shuttle, WalkCmd::PREFIXES, 0, idx);
-            }
 
-            auto child = self.ctr_get_node_child(node, idx);
-            node = child;
+M_PARAMS
+template <typename ShuttleTypesT>
+void M_TYPE::ctr_descend_path(
+        TreePathT& path,
+        size_t level,
+        bt::ForwardShuttleBase<ShuttleTypesT>& shuttle
+) const
+{
+    auto& self = the_self();
 
-            --level;
-        }
-        path.set(level, node);
+    TreeNodeConstPtr node = path[level];
+
+    while (level > 0)
+    {
+        auto result = self.branch_dispatcher().dispatch(node, shuttle, 0);
+        size_t idx = result.position();
 
-        self.leaf_dispatcher().dispatch(node, shuttle);
+        if (MMA_UNLIKELY(!result.is_found()))
+        {
+            --idx;
+            self.branch_dispatcher().dispatch(node, shuttle, WalkCmd::FIX_TARGET, 0, idx);
+        }
 
         if (!shuttle.is_simple_ride()) {
-            self.leaf_dispatcher().dispatch(node, shuttle, WalkCmd::LAST_LEAF);
+            self.branch_dispatcher().dispatch(node, shuttle, WalkCmd::PREFIXES, 0, idx);
         }
 
-        shuttle.finish(*state);
+        auto child = self.ctr_get_node_child(node, idx);
+        node = child;
+
+        --level;
+        path.set(level, node);
     }
 
-    return std::move(state);
+    self.leaf_dispatcher().dispatch(node, shuttle);
+
+    if (!shuttle.is_simple_ride()) {
+        self.leaf_dispatcher().dispatch(node, shuttle, WalkCmd::LAST_LEAF);
+    }
 }
 
 
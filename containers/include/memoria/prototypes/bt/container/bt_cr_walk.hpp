@@ -24,6 +24,11 @@
 #include <memoria/profiles/common/container_operations.hpp>
 #include <memoria/prototypes/bt/bt_names.hpp>
 
+#include <memoria/core/flat_map/flat_hash_map.hpp>
+
+#include <algorithm>
+#include <vector>
+
 namespace memoria {
 
 MEMORIA_V1_CONTAINER_PART_BEGIN(bt::WalkRName)
@@ -114,6 +119,100 @@ private:
         self.ctr_end_node(node, walker);
     }
 
+public:
+
+    // Walks this and other version of the container (e.g. the same
+    // container in another snapshot) top-down, level by level, dropping
+    // subtrees with the same root block in both versions without reading
+    // them. Leaves left on both sides are passed to the fn in key order.
+    // Visited nodes are proportional to the changes times tree height.
+    // Equal block IDs imply equal content only under CoW, without it
+    // both trees are walked in full.
+    template <typename Fn>
+    void ctr_diff_leaves(const MyType& other, Fn&& fn) const
+    {
+        auto& self = this->self();
+
+        auto my_root    = self.ctr_get_root_node();
+        auto other_root = other.ctr_get_root_node();
+
+        size_t my_level    = my_root->level();
+        size_t other_level = other_root->level();
+
+        std::vector<BlockID> mine;
+        std::vector<BlockID> theirs;
+
+        for (size_t level = std::max(my_level, other_level);; level--)
+        {
+            if (level == my_level) {
+                mine.push_back(my_root->id());
+            }
+
+            if (level == other_level) {
+                theirs.push_back(other_root->id());
+            }
+
+            if constexpr (ProfileTraits<Profile>::IsCoW) {
+                ctr_drop_shared_blocks(mine, theirs);
+            }
+
+            if (level == 0) {
+                break;
+            }
+            else if (mine.empty() && theirs.empty() && level <= std::min(my_level, other_level)) {
+                return;
+            }
+
+            mine   = self.ctr_diff_children(mine);
+            theirs = other.ctr_diff_children(theirs);
+        }
+
+        fn(mine, theirs);
+    }
+
+    std::vector<BlockID> ctr_diff_children(const std::vector<BlockID>& nodes) const
+    {
+        auto& self = this->self();
+
+        std::vector<BlockID> children;
+        for (const auto& node_id: nodes)
+        {
+            auto node = self.ctr_get_block(node_id);
+            self.ctr_for_all_ids(node, [&](const BlockID& child_id) {
+                children.push_back(child_id);
+            });
+        }
+
+        return children;
+    }
+
+private:
+    static void ctr_drop_shared_blocks(std::vector<BlockID>& mine, std::vector<BlockID>& theirs)
+    {
+        if (mine.empty() || theirs.empty()) {
+            return;
+        }
+
+        ska::flat_hash_set<BlockID> their_ids(theirs.begin(), theirs.end());
+        ska::flat_hash_set<BlockID> shared;
+
+        for (const auto& id: mine) {
+            if (their_ids.find(id) != their_ids.end()) {
+                shared.insert(id);
+            }
+        }
+
+        if (shared.size())
+        {
+            auto is_shared = [&](const BlockID& id) {
+                return shared.find(id) != shared.end();
+            };
+
+            mine.erase(std::remove_if(mine.begin(), mine.end(), is_shared), mine.end());
+            theirs.erase(std::remove_if(theirs.begin(), theirs.end(), is_shared), theirs.end());
+        }
+    }
+
 MEMORIA_V1_CONTAINER_PART_END
 
 
@@ -431,14 +431,25 @@ MEMORIA_V1_CONTAINER_PART_BEGIN(bt::BaseWName)
 
 
     template <typename Node>
-    TreeNodePtr ctr_create_node_fn(int32_t size) const
+    TreeNodePtr ctr_create_node_fn(int32_t size, bool leaf) const
     {
         auto& self = this->self();
-        auto node = static_cast_block<TreeNodePtr>(self.store().createBlock(size, self.name()));
+        auto hint = leaf ? BlockAllocationHint::LEAF : BlockAllocationHint::BRANCH;
+        auto node = static_cast_block<TreeNodePtr>(self.store().createBlock(size, self.name(), hint));
         node->header().block_type_hash() = Node::NodeType::hash();
+        ctr_set_cache_group(node);
         return node;
     }
 
+    // Blocks written by older versions have no group, so it's
+    // also (re)set when a block is cloned or updated in place.
+    static void ctr_set_cache_group(const TreeNodePtr& node)
+    {
+        node->header().basic_header().cache_traits().set_group(
+            node->is_leaf() ? BlockCachingGroup::LEAF : BlockCachingGroup::INTERNAL
+        );
+    }
+
 
     MEMORIA_V1_CONST_STATIC_FN_WRAPPER_RTN(CreateNodeFn, ctr_create_node_fn, TreeNodePtr);
     TreeNodePtr createNonRootNode(int16_t level, bool leaf, int32_t size = -1) const
@@ -455,7 +466,8 @@ MEMORIA_V1_CONTAINER_PART_BEGIN(bt::BaseWName)
         auto node = self.default_dispatcher().dispatch2(
             leaf,
             CreateNodeFn(self),
-            size
+            size,
+            leaf
         );
 
         node->header().ctr_type_hash() = self.hash();
@@ -493,7 +505,7 @@ MEMORIA_V1_CONTAINER_PART_BEGIN(bt::BaseWName)
 
         auto node = self.node_dispatcher().dispatch2(
             leaf,
-            CreateNodeFn(self), size
+            CreateNodeFn(self), size, leaf
         );
 
         node->header().ctr_type_hash() = self.hash();
@@ -50,6 +50,9 @@ MEMORIA_V1_CONTAINER_PART_BEGIN(bt::CoWOpsWName)
     {
         auto& self = this->self();
 
+        // Called before any node update
+        self.ctr_reset_finger();
+
         size_t path_size = path.size();
 
         if (level < path_size && !self.ctr_is_mutable_node(path[level].as_immutable()))
@@ -98,8 +101,10 @@ MEMORIA_V1_CONTAINER_PART_BEGIN(bt::CoWOpsWName)
     {
         auto& self = this->self();
 
-        auto new_block_tmp = self.store().cloneBlock(src, self.name());
+        auto hint = src->is_leaf() ? BlockAllocationHint::LEAF : BlockAllocationHint::BRANCH;
+        auto new_block_tmp = self.store().cloneBlock(src, self.name(), hint);
         TreeNodePtr new_block = new_block_tmp;
+        self.ctr_set_cache_group(new_block);
 
         // FIXME: This code looks identical with
         // ctr_cow_ref_children_after_merge
@@ -225,6 +230,31 @@ public:
     }
 
 
+    // Relocates leaves not owned by the current snapshot through the
+    // regular CoW path. Leaves are visited in key order, so the store
+    // may place them into contiguous runs of blocks.
+    void compact()
+    {
+        auto& self = this->self();
+
+        if (!self.store().isActive()) {
+            MEMORIA_MAKE_GENERIC_ERROR("Snapshot must be in active state to compact containers").do_throw();
+        }
+
+        auto root = self.ctr_get_root_node();
+        TreePathT path = TreePathT::build(root, root->level() + 1);
+
+        for (size_t ll = path.size() - 1; ll > 0; ll--) {
+            path.set(ll - 1, self.ctr_get_node_child(path[ll], 0));
+        }
+
+        do {
+            self.ctr_cow_clone_path(path, 0);
+        }
+        while (self.ctr_get_next_node(path, 0));
+    }
+
+
     void ctr_remove_redundant_root(TreePathT& path, size_t level)
     {
         auto& self = this->self();
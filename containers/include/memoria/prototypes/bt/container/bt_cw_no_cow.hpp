@@ -38,6 +38,8 @@ MEMORIA_V1_CONTAINER_PART_BEGIN(bt::NoCoWOpsWName)
     using typename Base::ApiProfileT;
 
     void ctr_cow_clone_path(TreePathT& path, size_t level) const {
+        // Called before any node update
+        self().ctr_reset_finger();
     }
 
     void ctr_ref_block(const TreeNodeConstPtr& block_id) {
@@ -60,12 +62,14 @@ MEMORIA_V1_CONTAINER_PART_BEGIN(bt::NoCoWOpsWName)
 
     void ctr_update_block_guard(const TreeNodePtr& node)
     {
-        return node.update();
+        node.update();
+        self().ctr_set_cache_group(node);
     }
 
     void ctr_update_block_guard(const TreeNodeConstPtr& node)
     {
-        return node.update();
+        node.update();
+        self().ctr_set_cache_group(node.as_mutable());
     }
 
     bool is_cascade_tree_removal() const {
@@ -152,6 +156,11 @@ MEMORIA_V1_CONTAINER_PART_BEGIN(bt::NoCoWOpsWName)
 
 
 
+    void compact() {
+        // Blocks are updated in-place, nothing to relocate.
+    }
+
+
     void ctr_remove_redundant_root(TreePathT& path, size_t level)
     {
         auto& self = this->self();
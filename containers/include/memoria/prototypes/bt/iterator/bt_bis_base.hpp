@@ -22,9 +22,40 @@
 #include <memoria/prototypes/bt/tools/bt_tools_tree_path.hpp>
 
 #include <iostream>
+#include <algorithm>
 
 namespace memoria {
 
+namespace bt {
+
+// Per-scan read-ahead state. Sequential traversal is detected by counting
+// consecutive next-leaf steps; once detected, the IDs of the upcoming
+// siblings are taken from the parent branch node and handed to the store
+// as a prefetch hint.
+template <typename BlockID>
+struct ReadAheadState {
+    static constexpr size_t DEFAULT_DEPTH = 8;
+    static constexpr size_t MAX_DEPTH = 64;
+    static constexpr size_t MIN_SEQUENTIAL_LEAVES = 2;
+
+    // Zero disables read-ahead.
+    size_t depth{DEFAULT_DEPTH};
+    size_t sequential_leaves{};
+
+    // Parent node the window belongs to and the first child index
+    // that has not been prefetched yet.
+    BlockID parent_id{};
+    size_t limit{};
+
+    void reset_window() {
+        sequential_leaves = 0;
+        parent_id = BlockID{};
+        limit = 0;
+    }
+};
+
+}
+
 MEMORIA_V1_BT_ITERATOR_BASE_CLASS_NO_CTOR_BEGIN(BTBlockIteratorStateBase)
 public:
     using Container = typename Base::Container;
@@ -42,9 +73,12 @@ public:
 
     using TreePathT = TreePath<TreeNodeConstPtr>;
 
+    using ReadAheadStateT = bt::ReadAheadState<typename Container::BlockID>;
+
 private:
 
     TreePathT path_;
+    ReadAheadStateT read_ahead_;
 
 public:
     BTBlockIteratorStateBase():
@@ -54,25 +88,47 @@ public:
 
     BTBlockIteratorStateBase(const ThisType& other):
         Base(other),
-        path_(other.path_)
+        path_(other.path_),
+        read_ahead_(other.read_ahead_)
     {}
 
     void prepare_ride(const ThisType& other) {
         path_ = other.path_;
+        read_ahead_ = other.read_ahead_;
     }
 
 
     void reset_state() {
         path_.reset_state();
+        read_ahead_ = ReadAheadStateT{};
         Base::reset_state();
     }
 
     void assign(const ThisType& other)
     {
         path_ = other.path_;
+        read_ahead_ = other.read_ahead_;
         Base::assign(other);
     }
 
+    ReadAheadStateT& read_ahead_state() {
+        return read_ahead_;
+    }
+
+    const ReadAheadStateT& read_ahead_state() const {
+        return read_ahead_;
+    }
+
+    void set_read_ahead_depth(size_t depth)
+    {
+        read_ahead_.depth = std::min(depth, ReadAheadStateT::MAX_DEPTH);
+        read_ahead_.reset_window();
+    }
+
+    size_t read_ahead_depth() const {
+        return read_ahead_.depth;
+    }
+
     TreePathT& path() {
         return path_;
     }
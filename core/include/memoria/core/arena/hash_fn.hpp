@@ -16,6 +16,7 @@
 #pragma once
 
 #include <memoria/core/linked/common/linked_hash.hpp>
+#include <memoria/core/linked/common/fast_hash.hpp>
 
 #include <memoria/core/arena/arena.hpp>
 #include <memoria/core/arena/relative_ptr.hpp>
@@ -95,6 +96,90 @@ public:
 };
 
 
+
+// Faster alternative to DefaultHashFn, used by SwissMap. Slot positions
+// in serialized maps depend on it, so it must not be changed.
+template <typename T>
+class FastHashFn;
+
+namespace detail {
+
+template <typename T>
+uint64_t fast_hash_bits(const T& value) noexcept
+{
+    static_assert(sizeof(T) <= sizeof(uint64_t), "");
+    uint64_t bits{};
+    std::memcpy(&bits, &value, sizeof(T));
+    return fast_hash_u64(bits);
+}
+
+}
+
+#define MMA_ARENA_FAST_HASH_FN(Type)        \
+template <>                                 \
+class FastHashFn<Type> {                    \
+public:                                     \
+    uint64_t operator()(const Type& value) const {\
+        return detail::fast_hash_bits(value);\
+    }                                       \
+}
+
+MMA_ARENA_FAST_HASH_FN(uint8_t);
+MMA_ARENA_FAST_HASH_FN(int8_t);
+
+MMA_ARENA_FAST_HASH_FN(uint16_t);
+MMA_ARENA_FAST_HASH_FN(int16_t);
+
+MMA_ARENA_FAST_HASH_FN(uint32_t);
+MMA_ARENA_FAST_HASH_FN(int32_t);
+
+MMA_ARENA_FAST_HASH_FN(uint64_t);
+MMA_ARENA_FAST_HASH_FN(int64_t);
+
+MMA_ARENA_FAST_HASH_FN(bool);
+MMA_ARENA_FAST_HASH_FN(char);
+MMA_ARENA_FAST_HASH_FN(char16_t);
+MMA_ARENA_FAST_HASH_FN(char32_t);
+
+MMA_ARENA_FAST_HASH_FN(float);
+MMA_ARENA_FAST_HASH_FN(double);
+
+
+// Stored keys must hash the same bytes as their views do.
+template <typename Type>
+class FastHashFn<RelativePtr<Type>> {
+public:
+    uint64_t operator()(const RelativePtr<Type>& ptr) const
+    {
+        WyHasher hasher;
+        ptr->hash_to(hasher);
+        return hasher.hash();
+    }
+};
+
+template <typename Type>
+class FastHashFn<Type*> {
+public:
+    uint64_t operator()(const Type* ptr) const
+    {
+        WyHasher hasher;
+        ptr->hash_to(hasher);
+        return hasher.hash();
+    }
+};
+
+template <>
+class FastHashFn<U8StringView> {
+public:
+    uint64_t operator()(const U8StringView& str) const
+    {
+        WyHasher hasher;
+        hasher.append(Span<const uint8_t>(ptr_cast<const uint8_t>(str.data()), str.size()));
+        return hasher.hash();
+    }
+};
+
+
 template <typename Type>
 class DefaultEqualToFn {
 public:
@@ -95,10 +95,10 @@ public:
         return view() == str->view();
     }
 
-    void hash_to(FNVHasher<8>& hasher) const noexcept {
-        for (auto ch: view()) {
-            hasher.append(ch);
-        }
+    template <typename Hasher>
+    void hash_to(Hasher& hasher) const noexcept {
+        auto vv = view();
+        hasher.append(Span<const uint8_t>(ptr_cast<const uint8_t>(vv.data()), vv.size()));
     }
 
     void stringify(std::ostream& out,
@@ -0,0 +1,531 @@
+// Copyright 2026 Victor Smirnov
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memoria/core/types.hpp>
+
+#include <memoria/core/arena/arena.hpp>
+#include <memoria/core/arena/relative_ptr.hpp>
+#include <memoria/core/arena/hash_fn.hpp>
+#include <memoria/core/arena/vector.hpp>
+
+#include <memoria/core/hermes/traits.hpp>
+
+#include <memoria/core/reflection/reflection.hpp>
+
+#include <cstring>
+#include <functional>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define MMA_ARENA_SWISS_MAP_SSE2
+#endif
+
+namespace memoria {
+namespace arena {
+
+// Open-addressing hash map with the same interface as arena::Map.
+//
+// Slots are split into groups of 16. Each slot has a control byte: EMPTY,
+// DELETED or the 7 upper bits of the key's hash (H2). Lookup probes groups
+// starting from the one selected by the lower hash bits (H1), matching H2
+// against all control bytes of a group at once, and stops at the first
+// group having an EMPTY slot. Keys are compared only for H2 matches.
+//
+// Control bytes, keys and values are three arena arrays addressed by
+// relative pointers, so the map is position-independent. Slot positions
+// depend on FastHashFn.
+template <
+    typename Key,
+    typename Value
+>
+class SwissMap {
+
+    using KeyHolder     = Key;
+    using ValueHolder   = Value;
+
+    template <typename K>
+    using Hash = FastHashFn<K>;
+
+    using KeyEqual = DefaultEqualToFn<KeyHolder>;
+
+    static constexpr size_t GROUP_SIZE   = 16;
+    static constexpr uint8_t CTRL_EMPTY   = 0x80;
+    static constexpr uint8_t CTRL_DELETED = 0xFE;
+
+    uint64_t size_;
+    uint64_t capacity_;
+    // Full and DELETED slots
+    uint64_t used_;
+
+    RelativePtr<uint8_t> ctrl_;
+    RelativePtr<KeyHolder> keys_;
+    RelativePtr<ValueHolder> values_;
+
+public:
+    SwissMap() noexcept :
+        size_(), capacity_(), used_()
+    {}
+
+    class Iterator {
+        const SwissMap* map_;
+        size_t idx_;
+    public:
+        Iterator(const SwissMap* map, size_t idx) noexcept:
+            map_(map), idx_(idx)
+        {}
+
+        const SwissMap* map() const {
+            return map_;
+        }
+
+        bool operator==(const Iterator& other) const {
+            return map_ == other.map_ && idx_ == other.idx_;
+        }
+
+        bool operator!=(const Iterator& other) const {
+            return map_ != other.map_ || idx_ != other.idx_;
+        }
+
+        bool next() noexcept
+        {
+            idx_ = map_->next_full(idx_ + 1);
+            return idx_ < map_->capacity_;
+        }
+
+        const KeyHolder& key() const {
+            return map_->keys_.get()[idx_];
+        }
+
+        const ValueHolder& value() const {
+            return map_->values_.get()[idx_];
+        }
+    };
+
+    friend class Iterator;
+
+    uint64_t size() const {
+        return size_;
+    }
+
+    uint64_t capacity() const {
+        return capacity_;
+    }
+
+    Iterator begin() const noexcept {
+        return Iterator(this, size_ ? next_full(0) : capacity_);
+    }
+
+    Iterator end() const noexcept {
+        return Iterator(this, capacity_);
+    }
+
+    template <typename KeyArg>
+    const ValueHolder* get(const KeyArg& key, LWMemHolder* mem_holder) const
+    {
+        if (size_)
+        {
+            Hash<KeyArg> hh;
+            size_t slot = find_slot(key, hh(key), mem_holder);
+            if (slot < capacity_) {
+                return &values_.get()[slot];
+            }
+        }
+
+        return nullptr;
+    }
+
+    void put(ArenaAllocator& arena, const Key& key, const Value& value, LWMemHolder* mem_holder)
+    {
+        if (MMA_UNLIKELY(capacity_ == 0)) {
+            allocate_table(arena, GROUP_SIZE);
+        }
+
+        Hash<Key> hh;
+        uint64_t hash = hh(key);
+
+        size_t slot = find_slot(key, hash, mem_holder);
+        if (slot < capacity_) {
+            values_.get()[slot] = value;
+            return;
+        }
+
+        if (used_ + 1 > max_load(capacity_))
+        {
+            // Grow if the table is really full, otherwise
+            // just clean up DELETED slots.
+            size_t new_capacity = size_ + 1 > max_load(capacity_) / 2 ? capacity_ * 2 : capacity_;
+            rehash(arena, new_capacity);
+        }
+
+        insert_new(key, value, hash);
+    }
+
+    template <typename KeyArg>
+    void remove(ArenaAllocator& arena, const KeyArg& key, LWMemHolder* mem_holder)
+    {
+        if (MMA_UNLIKELY(!size_)) {
+            return;
+        }
+
+        Hash<KeyArg> hh;
+        size_t slot = find_slot(key, hh(key), mem_holder);
+        if (slot == capacity_) {
+            return;
+        }
+
+        uint8_t* ctrl = ctrl_.get();
+
+        // Groups are aligned, so if the slot's group has an EMPTY slot,
+        // the group has never been full, and no probe sequence passes
+        // through it. The slot may be released then.
+        if (match_empty(ctrl + slot / GROUP_SIZE * GROUP_SIZE)) {
+            ctrl[slot] = CTRL_EMPTY;
+            used_--;
+        }
+        else {
+            ctrl[slot] = CTRL_DELETED;
+        }
+
+        detail::CopyHelper<KeyHolder>::set_default(keys_.get()[slot]);
+        detail::CopyHelper<ValueHolder>::set_default(values_.get()[slot]);
+
+        size_--;
+
+        if (size_ == 0) {
+            ctrl_.reset();
+            keys_.reset();
+            values_.reset();
+            capacity_ = 0;
+            used_ = 0;
+        }
+        else if (capacity_ > GROUP_SIZE && size_ < capacity_ / 8) {
+            rehash(arena, capacity_ / 2);
+        }
+    }
+
+    template <typename Fn>
+    void for_each(Fn&& fn) const
+    {
+        Iterator ii = begin();
+        Iterator end = this->end();
+
+        while (ii != end) {
+            fn(ii.key(), ii.value());
+            ii.next();
+        }
+    }
+
+    void check_typed_map(hermes::CheckStructureState& state) const {
+        check_map(state, [&](const KeyHolder&, const ValueHolder& value){
+            state.check_ptr(value, MA_SRC);
+        });
+    }
+
+    void check_object_map(hermes::CheckStructureState& state) const {
+        check_map(state, [&](const KeyHolder& key, const ValueHolder& value){
+            state.check_ptr(key.get(), MA_SRC);
+            state.check_ptr(value, MA_SRC);
+        });
+    }
+
+    void check_map(
+            hermes::CheckStructureState& state,
+            std::function<void(const KeyHolder&, const ValueHolder&)> entry_checker
+    ) const
+    {
+        state.mark_as_processed(this);
+        state.check_and_set_tagged(this, sizeof(SwissMap), MA_SRC);
+
+        if (capacity_)
+        {
+            if (ctrl_.is_null() || keys_.is_null() || values_.is_null()) {
+                MEMORIA_MAKE_GENERIC_ERROR("SwissMap arrays must not be null for a non-empty map").do_throw();
+            }
+
+            if (capacity_ < GROUP_SIZE || (capacity_ & (capacity_ - 1))) {
+                MEMORIA_MAKE_GENERIC_ERROR("Invalid SwissMap capacity: {}", capacity_).do_throw();
+            }
+
+            state.check_unique_and_mark_as_processed(ctrl_.get(), MA_SRC);
+            state.check_and_set(ctrl_.get(), capacity_, MA_SRC);
+
+            state.check_alignment<KeyHolder>(keys_.get(), MA_SRC);
+            state.check_unique_and_mark_as_processed(keys_.get(), MA_SRC);
+            state.check_and_set(keys_.get(), capacity_ * sizeof(KeyHolder), MA_SRC);
+
+            state.check_alignment<ValueHolder>(values_.get(), MA_SRC);
+            state.check_unique_and_mark_as_processed(values_.get(), MA_SRC);
+            state.check_and_set(values_.get(), capacity_ * sizeof(ValueHolder), MA_SRC);
+
+            const uint8_t* ctrl = ctrl_.get();
+            uint64_t full{}, used{};
+
+            for (size_t c = 0; c < capacity_; c++)
+            {
+                if (is_full(ctrl[c]))
+                {
+                    full++;
+                    used++;
+                    entry_checker(keys_.get()[c], values_.get()[c]);
+                }
+                else if (ctrl[c] == CTRL_DELETED) {
+                    used++;
+                }
+                else if (ctrl[c] != CTRL_EMPTY) {
+                    MEMORIA_MAKE_GENERIC_ERROR("Invalid SwissMap control byte {} at {}", ctrl[c], c).do_throw();
+                }
+            }
+
+            if (full != size_ || used != used_) {
+                MEMORIA_MAKE_GENERIC_ERROR(
+                    "SwissMap counters mismatch: size {}/{}, used {}/{}",
+                    size_, full, used_, used
+                ).do_throw();
+            }
+        }
+        else {
+            if (ctrl_.is_not_null() || keys_.is_not_null() || values_.is_not_null()) {
+                MEMORIA_MAKE_GENERIC_ERROR("SwissMap arrays must be null for an empty map").do_throw();
+            }
+        }
+    }
+
+    void dump_state() const
+    {
+        println("SwissMap[{}, {}, {}]{{", size_, used_, capacity_);
+
+        const uint8_t* ctrl = ctrl_.get();
+        for (size_t c = 0; c < capacity_; c++)
+        {
+            if (is_full(ctrl[c])) {
+                println("\t{}: [{}, {}]", c, keys_.get()[c], values_.get()[c]);
+            }
+            else if (ctrl[c] == CTRL_DELETED) {
+                println("\t{}: deleted", c);
+            }
+        }
+
+        println("}}");
+    }
+
+    SwissMap* deep_copy_to(
+            ShortTypeCode tag,
+            hermes::DeepCopyState& dedup) const
+    {
+        auto& dst = dedup.arena();
+        SwissMap* existing = dedup.resolve(dst, this);
+        if (MMA_LIKELY((bool)existing)) {
+            return existing;
+        }
+        else {
+            auto map = dst.get_resolver_for(dst.template allocate_tagged_object<SwissMap>(tag));
+            dedup.map(dst, this, map.get(dst));
+
+            map.get(dst)->size_ = size_;
+            map.get(dst)->capacity_ = capacity_;
+            map.get(dst)->used_ = used_;
+
+            if (capacity_)
+            {
+                auto ctrl = dst.get_resolver_for(dst.template allocate_untagged_array<uint8_t>(capacity_));
+                std::memcpy(ctrl.get(dst), ctrl_.get(), capacity_);
+                map.get(dst)->ctrl_ = ctrl.get(dst);
+
+                auto keys = dst.get_resolver_for(dst.template allocate_untagged_array<KeyHolder>(capacity_));
+                map.get(dst)->keys_ = keys.get(dst);
+
+                auto values = dst.get_resolver_for(dst.template allocate_untagged_array<ValueHolder>(capacity_));
+                map.get(dst)->values_ = values.get(dst);
+
+                memoria::detail::DeepCopyHelper<KeyHolder>::deep_copy_to(keys, keys_.get(), capacity_, dedup);
+                memoria::detail::DeepCopyHelper<ValueHolder>::deep_copy_to(values, values_.get(), capacity_, dedup);
+            }
+
+            return map.get(dst);
+        }
+    }
+
+private:
+    static bool is_full(uint8_t ctrl) noexcept {
+        return (ctrl & 0x80) == 0;
+    }
+
+    static uint8_t h2_of(uint64_t hash) noexcept {
+        return hash >> 57;
+    }
+
+    static uint64_t h1_of(uint64_t hash) noexcept {
+        return hash;
+    }
+
+    static size_t max_load(size_t capacity) noexcept {
+        return capacity - capacity / 8;
+    }
+
+#ifdef MMA_ARENA_SWISS_MAP_SSE2
+    static uint32_t match(const uint8_t* group, uint8_t h2) noexcept
+    {
+        __m128i ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(static_cast<char>(h2))));
+    }
+
+    static uint32_t match_empty(const uint8_t* group) noexcept {
+        return match(group, CTRL_EMPTY);
+    }
+
+    // EMPTY or DELETED, both have the high bit set.
+    static uint32_t match_free(const uint8_t* group) noexcept
+    {
+        __m128i ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+        return _mm_movemask_epi8(ctrl);
+    }
+#else
+    static uint32_t match(const uint8_t* group, uint8_t h2) noexcept
+    {
+        uint32_t mask{};
+        for (size_t c = 0; c < GROUP_SIZE; c++) {
+            mask |= static_cast<uint32_t>(group[c] == h2) << c;
+        }
+        return mask;
+    }
+
+    static uint32_t match_empty(const uint8_t* group) noexcept {
+        return match(group, CTRL_EMPTY);
+    }
+
+    static uint32_t match_free(const uint8_t* group) noexcept
+    {
+        uint32_t mask{};
+        for (size_t c = 0; c < GROUP_SIZE; c++) {
+            mask |= static_cast<uint32_t>(group[c] >> 7) << c;
+        }
+        return mask;
+    }
+#endif
+
+    // Returns capacity_ if the key is not found.
+    template <typename KeyArg>
+    size_t find_slot(const KeyArg& key, uint64_t hash, LWMemHolder* mem_holder) const
+    {
+        const uint8_t* ctrl = ctrl_.get();
+        const KeyHolder* keys = keys_.get();
+
+        uint8_t h2 = h2_of(hash);
+        size_t groups_mask = capacity_ / GROUP_SIZE - 1;
+        size_t group = h1_of(hash) & groups_mask;
+
+        KeyEqual eq;
+
+        // Triangular probing visits each group once
+        // for power of 2 number of groups.
+        for (size_t probe = 0; probe <= groups_mask; probe++)
+        {
+            const uint8_t* group_ctrl = ctrl + group * GROUP_SIZE;
+            for (uint32_t mask = match(group_ctrl, h2); mask; mask &= mask - 1)
+            {
+                size_t slot = group * GROUP_SIZE + __builtin_ctz(mask);
+                if (eq(key, keys[slot], mem_holder)) {
+                    return slot;
+                }
+            }
+
+            if (match_empty(group_ctrl)) {
+                break;
+            }
+
+            group = (group + probe + 1) & groups_mask;
+        }
+
+        return capacity_;
+    }
+
+    size_t find_free_slot(uint64_t hash) const noexcept
+    {
+        const uint8_t* ctrl = ctrl_.get();
+
+        size_t groups_mask = capacity_ / GROUP_SIZE - 1;
+        size_t group = h1_of(hash) & groups_mask;
+
+        for (size_t probe = 0; ; probe++)
+        {
+            uint32_t mask = match_free(ctrl + group * GROUP_SIZE);
+            if (mask) {
+                return group * GROUP_SIZE + __builtin_ctz(mask);
+            }
+
+            group = (group + probe + 1) & groups_mask;
+        }
+    }
+
+    size_t next_full(size_t idx) const noexcept
+    {
+        const uint8_t* ctrl = ctrl_.get();
+        while (idx < capacity_ && !is_full(ctrl[idx])) {
+            idx++;
+        }
+        return idx;
+    }
+
+    void insert_new(const Key& key, const Value& value, uint64_t hash)
+    {
+        size_t slot = find_free_slot(hash);
+
+        uint8_t* ctrl = ctrl_.get();
+        if (ctrl[slot] == CTRL_EMPTY) {
+            used_++;
+        }
+
+        ctrl[slot] = h2_of(hash);
+        keys_.get()[slot] = key;
+        values_.get()[slot] = value;
+
+        size_++;
+    }
+
+    void allocate_table(ArenaAllocator& arena, size_t capacity)
+    {
+        uint8_t* ctrl = arena.template allocate_untagged_array<uint8_t>(capacity);
+        std::memset(ctrl, CTRL_EMPTY, capacity);
+
+        ctrl_ = ctrl;
+        keys_ = arena.template allocate_untagged_array<KeyHolder>(capacity);
+        values_ = arena.template allocate_untagged_array<ValueHolder>(capacity);
+
+        capacity_ = capacity;
+        size_ = 0;
+        used_ = 0;
+    }
+
+    void rehash(ArenaAllocator& arena, size_t new_capacity)
+    {
+        const uint8_t* ctrl = ctrl_.get();
+        const KeyHolder* keys = keys_.get();
+        const ValueHolder* values = values_.get();
+        size_t capacity = capacity_;
+
+        allocate_table(arena, new_capacity);
+
+        Hash<Key> hh;
+        for (size_t c = 0; c < capacity; c++)
+        {
+            if (is_full(ctrl[c])) {
+                insert_new(keys[c], values[c], hh(keys[c]));
+            }
+        }
+    }
+};
+
+}}
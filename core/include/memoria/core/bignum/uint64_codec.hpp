@@ -17,6 +17,7 @@
 
 #include <memoria/core/strings/string.hpp>
 #include <memoria/core/tools/bitmap.hpp>
+#include <memoria/core/tools/varint_batch.hpp>
 
 namespace memoria {
 
@@ -115,6 +116,22 @@ public:
         }
     }
 
+    // Batch versions of decode()/encode() for `n` consecutive values.
+    // Return the number of bytes read/written.
+    size_t decode_n(const T* buffer, V* values, size_t n, size_t idx) const
+    {
+        return varint_decode_n(buffer, values, n, idx, UpperBound, 1, [&](const T* buf, V& value, size_t pos){
+            return decode(buf, value, pos);
+        });
+    }
+
+    size_t encode_n(T* buffer, const V* values, size_t n, size_t idx) const
+    {
+        return varint_encode_n(buffer, values, n, idx, UpperBound - 1, 1, [&](T* buf, const V& value, size_t pos){
+            return encode(buf, value, pos);
+        });
+    }
+
     void move(T* buffer, size_t from, size_t to, size_t size) const
     {
         CopyBuffer(buffer + from, buffer + to, size);
@@ -16,18 +16,16 @@
 #pragma once
 
 #include <memoria/core/hermes/map/map_common.hpp>
+#include <memoria/core/arena/swiss_map.hpp>
 
 namespace memoria {
 namespace hermes {
 
+// Open addressing with SIMD-probed control bytes, see arena::SwissMap.
 template <typename KeyDT>
-class TypedMapData<KeyDT, Object, FSEKeySubtype, true>: public arena::Map<DTTViewType<KeyDT>, arena::EmbeddingRelativePtr<void>> {
-    using Base = arena::Map<DTTViewType<KeyDT>, arena::EmbeddingRelativePtr<void>>;
+class TypedMapData<KeyDT, Object, FSEKeySubtype, true>: public arena::SwissMap<DTTViewType<KeyDT>, arena::EmbeddingRelativePtr<void>> {
 public:
     TypedMapData() {}
-    TypedMapData(uint64_t capacity):
-        Base(capacity)
-    {}
 };
 
 
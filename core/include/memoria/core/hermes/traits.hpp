@@ -156,10 +156,12 @@ struct TypeHash<hermes::Array<T>>: HasU64Value<
         >
 > {};
 
+// Maps with fixed-size keys are stored as arena::SwissMap. 106 was
+// the code of their former arena::Map layout, it must not be reused.
 template <typename Key>
 struct TypeHash<hermes::Map<Key, hermes::Object>>: HasU64Value<
         HashHelper<
-            106,
+            107,
             TypeHashV<Key>,
             TypeHashV<hermes::Object>
         >
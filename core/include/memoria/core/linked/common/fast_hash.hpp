@@ -0,0 +1,129 @@
+// Copyright 2026 Victor Smirnov
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memoria/core/types.hpp>
+#include <memoria/core/tools/span.hpp>
+
+#include <cstring>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace memoria {
+
+// wyhash-style 64-bit hashing: input is consumed in 64-bit words,
+// each folded into the state with a 64x64->128 multiplication.
+// Not a cryptographic hash. Hash-ordered arena structures depend on it,
+// so the function must stay stable between versions.
+
+namespace detail {
+
+constexpr uint64_t WY_P0 = 0xa0761d6478bd642full;
+constexpr uint64_t WY_P1 = 0xe7037ed1a0b428dbull;
+constexpr uint64_t WY_P2 = 0x8ebc6af09c88c6e3ull;
+constexpr uint64_t WY_P3 = 0x589965cc75374cc3ull;
+
+inline uint64_t wymix(uint64_t a, uint64_t b) noexcept
+{
+#if defined(__SIZEOF_INT128__)
+    __uint128_t r = static_cast<__uint128_t>(a) * b;
+    return static_cast<uint64_t>(r) ^ static_cast<uint64_t>(r >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    uint64_t hi;
+    uint64_t lo = _umul128(a, b, &hi);
+    return lo ^ hi;
+#else
+    uint64_t ha = a >> 32, hb = b >> 32, la = (uint32_t)a, lb = (uint32_t)b;
+    uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    uint64_t t = rl + (rm0 << 32);
+    uint64_t c = t < rl;
+    uint64_t lo = t + (rm1 << 32);
+    c += lo < t;
+    uint64_t hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+    return lo ^ hi;
+#endif
+}
+
+inline uint64_t wyread64(const uint8_t* ptr) noexcept
+{
+    uint64_t value;
+    std::memcpy(&value, ptr, sizeof(value));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    value = __builtin_bswap64(value);
+#endif
+    return value;
+}
+
+}
+
+// Hash of a single 64-bit value.
+inline uint64_t fast_hash_u64(uint64_t value) noexcept {
+    return detail::wymix(value ^ detail::WY_P0, value ^ detail::WY_P1);
+}
+
+
+// Streaming hasher with the same interface as FNVHasher<8>. Byte-wise
+// and bulk appends of the same data produce the same hash.
+class WyHasher {
+    uint64_t state_{detail::WY_P3};
+    uint64_t buffer_{};
+    uint64_t length_{};
+
+public:
+    WyHasher() noexcept {}
+
+    void append(uint8_t value) noexcept
+    {
+        buffer_ |= static_cast<uint64_t>(value) << ((length_ & 7) * 8);
+        if ((++length_ & 7) == 0) {
+            mix(buffer_);
+            buffer_ = 0;
+        }
+    }
+
+    void append(Span<const uint8_t> data) noexcept
+    {
+        const uint8_t* ptr = data.data();
+        size_t size = data.size();
+        size_t c = 0;
+
+        for (; c < size && (length_ & 7); c++) {
+            append(ptr[c]);
+        }
+
+        size_t words_end = c + ((size - c) & ~size_t(7));
+        length_ += words_end - c;
+        for (; c < words_end; c += 8) {
+            mix(detail::wyread64(ptr + c));
+        }
+
+        for (; c < size; c++) {
+            append(ptr[c]);
+        }
+    }
+
+    uint64_t hash() const noexcept {
+        return detail::wymix(state_ ^ buffer_ ^ detail::WY_P2, length_ ^ detail::WY_P1);
+    }
+
+private:
+    void mix(uint64_t word) noexcept {
+        state_ = detail::wymix(word ^ detail::WY_P0, state_ ^ detail::WY_P1);
+    }
+};
+
+}
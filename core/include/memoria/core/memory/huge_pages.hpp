@@ -0,0 +1,399 @@
+// Copyright 2026 Victor Smirnov
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memoria/core/config.hpp>
+#include <memoria/core/tools/result.hpp>
+#include <memoria/core/tools/span.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+
+#ifdef MMA_POSIX
+#include <sys/mman.h>
+#endif
+
+#ifdef MMA_LINUX
+#include <sys/vfs.h>
+#include <linux/magic.h>
+#endif
+
+namespace memoria {
+
+static constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+// Asks the kernel to back the range with transparent huge pages.
+// Only whole huge pages inside the range are affected. This is
+// a hint only, errors are ignored.
+inline void advise_huge_pages(void* ptr, size_t size) noexcept
+{
+#ifdef MADV_HUGEPAGE
+    uintptr_t start = (reinterpret_cast<uintptr_t>(ptr) + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+    uintptr_t end   = (reinterpret_cast<uintptr_t>(ptr) + size) & ~(HUGE_PAGE_SIZE - 1);
+
+    if (start < end) {
+        ::madvise(reinterpret_cast<void*>(start), end - start, MADV_HUGEPAGE);
+    }
+#endif
+}
+
+// Returns hugetlbfs page size if the file is on hugetlbfs, zero otherwise.
+// Mappings of such files must be aligned to this size.
+inline size_t hugetlbfs_page_size(int fd) noexcept
+{
+#ifdef MMA_LINUX
+    struct statfs fs;
+    if (::fstatfs(fd, &fs) == 0 && fs.f_type == HUGETLBFS_MAGIC) {
+        return static_cast<size_t>(fs.f_bsize);
+    }
+#endif
+    return 0;
+}
+
+namespace detail {
+
+// Maps anonymous memory aligned to HUGE_PAGE_SIZE. Explicit huge pages
+// are tried first, then transparent ones.
+inline void* map_huge_page_memory(size_t size)
+{
+#ifdef MMA_POSIX
+#ifdef MAP_HUGETLB
+    void* ptr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (ptr != MAP_FAILED) {
+        return ptr;
+    }
+#endif
+
+    void* raw = ::mmap(nullptr, size + HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) {
+        MEMORIA_MAKE_GENERIC_ERROR("Can't map {} bytes of huge page memory", size).do_throw();
+    }
+
+    uintptr_t addr    = reinterpret_cast<uintptr_t>(raw);
+    uintptr_t aligned = (addr + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+
+    if (aligned > addr) {
+        ::munmap(raw, aligned - addr);
+    }
+
+    uintptr_t tail = aligned + size;
+    uintptr_t end  = addr + size + HUGE_PAGE_SIZE;
+    if (end > tail) {
+        ::munmap(reinterpret_cast<void*>(tail), end - tail);
+    }
+
+    advise_huge_pages(reinterpret_cast<void*>(aligned), size);
+    return reinterpret_cast<void*>(aligned);
+#else
+    void* ptr = ::aligned_alloc(HUGE_PAGE_SIZE, size);
+    if (!ptr) {
+        MEMORIA_MAKE_GENERIC_ERROR("Can't allocate {} bytes of huge page memory", size).do_throw();
+    }
+    return ptr;
+#endif
+}
+
+inline void unmap_huge_page_memory(void* ptr, size_t size) noexcept
+{
+#ifdef MMA_POSIX
+    ::munmap(ptr, size);
+#else
+    ::free(ptr);
+#endif
+}
+
+}
+
+
+// A buffer of whole huge pages, for raw stores and the like.
+class HugePageBuffer {
+    uint8_t* data_{};
+    size_t size_{};
+public:
+    HugePageBuffer() = default;
+
+    HugePageBuffer(size_t size):
+        size_((size + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1))
+    {
+        data_ = static_cast<uint8_t*>(detail::map_huge_page_memory(size_));
+    }
+
+    HugePageBuffer(const HugePageBuffer&) = delete;
+    HugePageBuffer& operator=(const HugePageBuffer&) = delete;
+
+    HugePageBuffer(HugePageBuffer&& other) noexcept:
+        data_(other.data_), size_(other.size_)
+    {
+        other.data_ = nullptr;
+        other.size_ = 0;
+    }
+
+    HugePageBuffer& operator=(HugePageBuffer&& other) noexcept
+    {
+        if (this != &other) {
+            reset();
+            data_ = other.data_;
+            size_ = other.size_;
+            other.data_ = nullptr;
+            other.size_ = 0;
+        }
+        return *this;
+    }
+
+    ~HugePageBuffer() noexcept {
+        reset();
+    }
+
+    void reset() noexcept
+    {
+        if (data_) {
+            detail::unmap_huge_page_memory(data_, size_);
+            data_ = nullptr;
+            size_ = 0;
+        }
+    }
+
+    uint8_t* data() const noexcept {return data_;}
+    size_t size() const noexcept {return size_;}
+
+    Span<uint8_t> span() const noexcept {
+        return Span<uint8_t>(data_, size_);
+    }
+};
+
+
+// Carves memory blocks out of huge page arenas. Each arena serves one
+// power-of-two size class. Requests larger than MAX_CLASS_SIZE, and
+// pointers not belonging to any arena, are passed to malloc/free, so
+// free() accepts memory from both. Arenas are kept for the lifetime
+// of the allocator, freed blocks are reused by later allocations.
+//
+// Size classes have their own locks. Arena membership is looked up
+// without locking in an insert-only hash table of arena bases, so
+// frees of malloc'ed memory don't lock at all. When MAX_ARENAS are
+// in use, new blocks are taken from malloc too.
+class HugePageArenaAllocator {
+public:
+    static constexpr size_t ARENA_SIZE     = HUGE_PAGE_SIZE;
+    static constexpr size_t MIN_CLASS_LOG2 = 6;
+    static constexpr size_t MAX_CLASS_LOG2 = 19;
+    static constexpr size_t MAX_CLASS_SIZE = size_t(1) << MAX_CLASS_LOG2;
+    static constexpr size_t MAX_ARENAS     = 16384;
+
+    struct Stats {
+        size_t arenas;
+        size_t allocated;
+        size_t free;
+    };
+
+private:
+    static constexpr size_t CLASSES = MAX_CLASS_LOG2 - MIN_CLASS_LOG2 + 1;
+
+    // At most half full, so probe sequences stay short
+    static constexpr size_t ARENA_SLOTS_LOG2 = 15;
+    static constexpr size_t ARENA_SLOTS      = size_t(1) << ARENA_SLOTS_LOG2;
+    static_assert(ARENA_SLOTS >= MAX_ARENAS * 2, "Arena table is too small");
+
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    struct alignas(64) SizeClass {
+        mutable std::mutex mutex;
+        FreeBlock* free_list{};
+        uint8_t* bump{};
+        uint8_t* bump_end{};
+
+        size_t allocated{};
+        size_t free{};
+    };
+
+    SizeClass classes_[CLASSES];
+
+    // Arena bases are ARENA_SIZE-aligned, the low bits of
+    // a slot hold the arena's size class + 1. Zero is empty.
+    std::unique_ptr<std::atomic<uintptr_t>[]> arena_slots_;
+    std::atomic<size_t> arenas_{};
+
+public:
+    HugePageArenaAllocator():
+        arena_slots_(new std::atomic<uintptr_t>[ARENA_SLOTS]{})
+    {}
+
+    HugePageArenaAllocator(const HugePageArenaAllocator&) = delete;
+    HugePageArenaAllocator& operator=(const HugePageArenaAllocator&) = delete;
+
+    ~HugePageArenaAllocator() noexcept
+    {
+        for (size_t c = 0; c < ARENA_SLOTS; c++)
+        {
+            uintptr_t slot = arena_slots_[c].load(std::memory_order_relaxed);
+            if (slot) {
+                detail::unmap_huge_page_memory(reinterpret_cast<void*>(slot & ~(ARENA_SIZE - 1)), ARENA_SIZE);
+            }
+        }
+    }
+
+    // Never destroyed: blocks may be freed by other
+    // static objects' destructors.
+    static HugePageArenaAllocator& instance()
+    {
+        static HugePageArenaAllocator* allocator = new HugePageArenaAllocator();
+        return *allocator;
+    }
+
+    void* allocate(size_t size)
+    {
+        if (MMA_UNLIKELY(size > MAX_CLASS_SIZE)) {
+            return ::malloc(size);
+        }
+
+        uint32_t cls = size_class(size);
+        size_t block_size = size_t(1) << (cls + MIN_CLASS_LOG2);
+
+        SizeClass& sc = classes_[cls];
+        std::lock_guard<std::mutex> lock(sc.mutex);
+
+        if (sc.free_list)
+        {
+            FreeBlock* blk = sc.free_list;
+            sc.free_list = blk->next;
+            sc.free -= block_size;
+            sc.allocated += block_size;
+            return blk;
+        }
+
+        if (sc.bump == sc.bump_end)
+        {
+            uint8_t* arena = static_cast<uint8_t*>(detail::map_huge_page_memory(ARENA_SIZE));
+            if (MMA_UNLIKELY(!register_arena(arena, cls)))
+            {
+                detail::unmap_huge_page_memory(arena, ARENA_SIZE);
+                return ::malloc(size);
+            }
+
+            sc.bump     = arena;
+            sc.bump_end = arena + ARENA_SIZE;
+        }
+
+        void* ptr = sc.bump;
+        sc.bump += block_size;
+        sc.allocated += block_size;
+        return ptr;
+    }
+
+    void free(void* ptr) noexcept
+    {
+        if (MMA_UNLIKELY(!ptr)) {
+            return;
+        }
+
+        int32_t cls = arena_class(ptr);
+        if (cls >= 0)
+        {
+            size_t block_size = size_t(1) << (cls + MIN_CLASS_LOG2);
+            SizeClass& sc = classes_[cls];
+
+            std::lock_guard<std::mutex> lock(sc.mutex);
+
+            FreeBlock* blk = static_cast<FreeBlock*>(ptr);
+            blk->next = sc.free_list;
+            sc.free_list = blk;
+
+            sc.allocated -= block_size;
+            sc.free += block_size;
+        }
+        else {
+            ::free(ptr);
+        }
+    }
+
+    Stats stats() const
+    {
+        Stats stats{arenas_.load(std::memory_order_acquire), 0, 0};
+
+        for (const SizeClass& sc: classes_)
+        {
+            std::lock_guard<std::mutex> lock(sc.mutex);
+            stats.allocated += sc.allocated;
+            stats.free += sc.free;
+        }
+
+        return stats;
+    }
+
+private:
+    static uint32_t size_class(size_t size) noexcept
+    {
+        size_t log2 = MIN_CLASS_LOG2;
+        while ((size_t(1) << log2) < size) {
+            log2++;
+        }
+        return static_cast<uint32_t>(log2 - MIN_CLASS_LOG2);
+    }
+
+    static size_t arena_slot(uintptr_t base) noexcept {
+        return ((base / ARENA_SIZE) * 0x9E3779B97F4A7C15ull) >> (64 - ARENA_SLOTS_LOG2);
+    }
+
+    bool register_arena(uint8_t* arena, uint32_t cls) noexcept
+    {
+        if (arenas_.fetch_add(1, std::memory_order_relaxed) >= MAX_ARENAS)
+        {
+            arenas_.fetch_sub(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        uintptr_t value = reinterpret_cast<uintptr_t>(arena) | (cls + 1);
+        for (size_t slot = arena_slot(reinterpret_cast<uintptr_t>(arena));; slot = (slot + 1) & (ARENA_SLOTS - 1))
+        {
+            uintptr_t expected{};
+            if (arena_slots_[slot].compare_exchange_strong(expected, value, std::memory_order_release, std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+    }
+
+    // Size class of the arena containing the pointer, -1 if
+    // the pointer is not from an arena.
+    int32_t arena_class(void* ptr) const noexcept
+    {
+        if (!arenas_.load(std::memory_order_acquire)) {
+            return -1;
+        }
+
+        uintptr_t base = reinterpret_cast<uintptr_t>(ptr) & ~(ARENA_SIZE - 1);
+        for (size_t slot = arena_slot(base);; slot = (slot + 1) & (ARENA_SLOTS - 1))
+        {
+            uintptr_t value = arena_slots_[slot].load(std::memory_order_acquire);
+            if (!value) {
+                return -1;
+            }
+            else if ((value & ~(ARENA_SIZE - 1)) == base) {
+                return static_cast<int32_t>(value & (ARENA_SIZE - 1)) - 1;
+            }
+        }
+    }
+};
+
+// Deleter-compatible counterpart of HugePageArenaAllocator::allocate()
+static inline void free_huge_page_block(void* ptr) noexcept {
+    HugePageArenaAllocator::instance().free(ptr);
+}
+
+}
@@ -38,6 +38,32 @@ struct ThrowingCheckResultConsumer {
     }
 };
 
+struct StoreCheckProgress {
+    uint64_t tasks_total{};
+    uint64_t tasks_done{};
+    uint64_t blocks{};
+    uint64_t bytes{};
+    uint64_t elapsed_ms{};
+};
+
+using StoreCheckProgressFn = std::function<void (const StoreCheckProgress&)>;
+
+// Parameters of the parallel store checker. The result consumer is
+// called from worker threads, but never concurrently.
+struct StoreCheckOptions {
+    // 0 means std::thread::hardware_concurrency()
+    size_t threads{};
+
+    // Limit on block data read by all workers together,
+    // bytes per second. 0 means no limit.
+    uint64_t max_read_rate{};
+
+    // Called on the calling thread every progress_interval_ms
+    // and once at the end of each phase.
+    StoreCheckProgressFn progress_fn;
+    uint64_t progress_interval_ms{1000};
+};
+
 template <typename... Args>
 hermes::HermesCtr make_string_document(const char* fmt, Args&&... args)
 {
@@ -22,6 +22,9 @@
 
 #include <memoria/core/types.hpp>
 #include <memoria/core/tools/bitmap.hpp>
+#include <memoria/core/tools/varint_batch.hpp>
+
+#include <type_traits>
 
 namespace memoria {
 
@@ -75,6 +78,45 @@ size_t DecodeExint(const T* buffer, V& value, size_t start)
     return byte_length + 1;
 }
 
+// Batch versions of EncodeExint/DecodeExint for `n` consecutive values.
+// Only zeros have single-byte codes here, so runs of them take the
+// vectorized path. Return the number of bytes written/read.
+template <typename T, typename V>
+size_t EncodeExintN(T* buffer, const V* values, size_t n, size_t start)
+{
+    if constexpr (sizeof(T) == 1 && std::is_integral_v<V>)
+    {
+        return varint_encode_n(reinterpret_cast<uint8_t*>(buffer), values, n, start, 1, 0, [](uint8_t* buf, V value, size_t pos){
+            return EncodeExint(buf, value, pos);
+        });
+    }
+    else {
+        size_t pos = start;
+        for (size_t c = 0; c < n; c++) {
+            pos += EncodeExint(buffer, values[c], pos);
+        }
+        return pos - start;
+    }
+}
+
+template <typename T, typename V>
+size_t DecodeExintN(const T* buffer, V* values, size_t n, size_t start)
+{
+    if constexpr (sizeof(T) == 1 && std::is_integral_v<V>)
+    {
+        return varint_decode_n(reinterpret_cast<const uint8_t*>(buffer), values, n, start, 1, 0, [](const uint8_t* buf, V& value, size_t pos){
+            return DecodeExint(buf, value, pos);
+        });
+    }
+    else {
+        size_t pos = start;
+        for (size_t c = 0; c < n; c++) {
+            pos += DecodeExint(buffer, values[c], pos);
+        }
+        return pos - start;
+    }
+}
+
 template <typename T, typename V>
 struct ExintCodec {
 
@@ -114,6 +156,16 @@ struct ExintCodec {
         return EncodeExint(buffer, value, idx);
     }
 
+    size_t decode_n(const T* buffer, V* values, size_t n, size_t idx) const
+    {
+        return DecodeExintN(buffer, values, n, idx);
+    }
+
+    size_t encode_n(T* buffer, const V* values, size_t n, size_t idx) const
+    {
+        return EncodeExintN(buffer, values, n, idx);
+    }
+
     void move(T* buffer, size_t from, size_t to, size_t size) const
     {
         CopyBuffer(buffer + from, buffer + to, size);
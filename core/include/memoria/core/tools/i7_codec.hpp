@@ -18,6 +18,9 @@
 
 #include <memoria/core/types.hpp>
 #include <memoria/core/tools/bitmap.hpp>
+#include <memoria/core/tools/varint_batch.hpp>
+
+#include <type_traits>
 
 namespace memoria {
 
@@ -90,6 +93,44 @@ size_t DecodeI7(const T* buffer, V& value, size_t start)
     }
 }
 
+// Batch versions of EncodeI7/DecodeI7 for `n` consecutive values.
+// Return the number of bytes written/read.
+template <typename T, typename V>
+size_t EncodeI7N(T* buffer, const V* values, size_t n, size_t start)
+{
+    if constexpr (sizeof(T) == 1 && std::is_integral_v<V>)
+    {
+        return varint_encode_n(reinterpret_cast<uint8_t*>(buffer), values, n, start, 128, 0, [](uint8_t* buf, V value, size_t pos){
+            return EncodeI7(buf, value, pos);
+        });
+    }
+    else {
+        size_t pos = start;
+        for (size_t c = 0; c < n; c++) {
+            pos += EncodeI7(buffer, values[c], pos);
+        }
+        return pos - start;
+    }
+}
+
+template <typename T, typename V>
+size_t DecodeI7N(const T* buffer, V* values, size_t n, size_t start)
+{
+    if constexpr (sizeof(T) == 1 && std::is_integral_v<V>)
+    {
+        return varint_decode_n(reinterpret_cast<const uint8_t*>(buffer), values, n, start, 128, 0, [](const uint8_t* buf, V& value, size_t pos){
+            return DecodeI7(buf, value, pos);
+        });
+    }
+    else {
+        size_t pos = start;
+        for (size_t c = 0; c < n; c++) {
+            pos += DecodeI7(buffer, values[c], pos);
+        }
+        return pos - start;
+    }
+}
+
 template <typename T, typename V>
 struct I7Codec {
 
@@ -129,6 +170,16 @@ struct I7Codec {
         return EncodeI7(buffer, value, idx);
     }
 
+    size_t decode_n(const T* buffer, V* values, size_t n, size_t idx) const
+    {
+        return DecodeI7N(buffer, values, n, idx);
+    }
+
+    size_t encode_n(T* buffer, const V* values, size_t n, size_t idx) const
+    {
+        return EncodeI7N(buffer, values, n, idx);
+    }
+
     void move(T* buffer, size_t from, size_t to, size_t size) const
     {
         CopyBuffer(buffer + from, buffer + to, size);
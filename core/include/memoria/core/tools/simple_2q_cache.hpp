@@ -92,6 +92,11 @@ public:
         return a1_queue_.size();
     }
 
+    // Unlike get(), doesn't detach the entry from the eviction queues
+    bool contains(const ID& id) const noexcept {
+        return map_.find(id) != map_.end();
+    }
+
     Optional<EntryT*> get(const ID& id) noexcept {
         auto ii = map_.find(id);
         if (ii != map_.end())
@@ -18,6 +18,7 @@
 #include <memoria/core/types.hpp>
 
 #include <memoria/core/tools/result.hpp>
+#include <memoria/core/tools/varint_batch.hpp>
 
 namespace memoria {
 
@@ -77,7 +78,7 @@ static inline size_t encode_u64_56_vlen(uint8_t* array, uint64_t value)
 {
   size_t size = encode_u64_56_vlen_noex(array, value);
   if (MMA_LIKELY(size > 0)) {
-    return value;
+    return size;
   }
   else {
     MEMORIA_MAKE_GENERIC_ERROR("Provided ui64_56 value of {} is out of range", value).do_throw();
@@ -119,7 +120,7 @@ static inline constexpr size_t decode_u64_56_vlen(const uint8_t* array, uint64_t
     value |= token << (c * 8);
   }
 
-  return size;
+  return size + 1;
 }
 
 
@@ -130,4 +131,21 @@ static inline constexpr uint64_t decode_u64_56_vlen(const uint8_t* array) noexce
   return value;
 }
 
+// Batch versions for `n` consecutive values.
+// Return the number of bytes read/written.
+static inline size_t decode_u64_56_vlen_n(const uint8_t* array, uint64_t* values, size_t n) noexcept
+{
+  return varint_decode_n(array, values, n, 0, 249, 0, [](const uint8_t* buf, uint64_t& value, size_t pos){
+    value = 0;
+    return decode_u64_56_vlen(buf + pos, value);
+  });
+}
+
+static inline size_t encode_u64_56_vlen_n(uint8_t* array, const uint64_t* values, size_t n)
+{
+  return varint_encode_n(array, values, n, 0, 249, 0, [](uint8_t* buf, uint64_t value, size_t pos){
+    return encode_u64_56_vlen(buf + pos, value);
+  });
+}
+
 }
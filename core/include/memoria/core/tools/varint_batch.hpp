@@ -0,0 +1,384 @@
+// Copyright 2026 Victor Smirnov
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memoria/core/types.hpp>
+
+#include <atomic>
+#include <cstring>
+#include <type_traits>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define MMA_VARINT_BATCH_X86
+#endif
+
+namespace memoria {
+
+// Batch support for the byte-oriented variable length integer codecs
+// (I7, Exint, ValueCodec<(u)int64_t>, u64_56). All of them store small
+// values as a single byte below some bound, with an optional bias. The
+// kernels below encode and decode runs of such single-byte codes 16-32
+// at a time, in the spirit of masked VByte: a vector compare finds where
+// the run ends, and longer codes are left to the codec's scalar path.
+// The encoded bytes are exactly the same as with per-value calls.
+//
+// SIMD kernels are selected at runtime by the CPU's features. Other
+// architectures use the scalar loops only.
+
+enum class VarintBatchISA: int32_t {
+    SCALAR, SSE42, AVX2
+};
+
+namespace detail {
+
+inline VarintBatchISA detect_varint_batch_isa() noexcept
+{
+#ifdef MMA_VARINT_BATCH_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return VarintBatchISA::AVX2;
+    }
+    else if (__builtin_cpu_supports("sse4.2")) {
+        return VarintBatchISA::SSE42;
+    }
+#endif
+    return VarintBatchISA::SCALAR;
+}
+
+inline std::atomic<VarintBatchISA>& varint_batch_isa_holder() noexcept
+{
+    static std::atomic<VarintBatchISA> isa{detect_varint_batch_isa()};
+    return isa;
+}
+
+}
+
+inline VarintBatchISA varint_batch_isa() noexcept {
+    return detail::varint_batch_isa_holder().load(std::memory_order_relaxed);
+}
+
+// Overrides kernel selection, capped by what the CPU supports.
+// Returns the selected kernels. For tests and benchmarks.
+inline VarintBatchISA set_varint_batch_isa(VarintBatchISA isa) noexcept
+{
+    VarintBatchISA max = detail::detect_varint_batch_isa();
+    if (isa > max) {
+        isa = max;
+    }
+
+    detail::varint_batch_isa_holder().store(isa, std::memory_order_relaxed);
+    return isa;
+}
+
+namespace detail {
+
+// Decoding kernels. Leading bytes below `bound` are decoded as
+// (byte - bias), up to `n` values. Returns the length of the run.
+// Every code takes at least one byte, so `n` bytes at `src` are
+// readable and there is room for `n` values at `dst`. Whole chunks
+// are stored, values past the run are overwritten by the caller.
+
+inline size_t decode_short_run_scalar(const uint8_t* src, uint64_t* dst, size_t n, uint8_t bound, uint8_t bias) noexcept
+{
+    size_t c = 0;
+    while (c < n && src[c] < bound) {
+        dst[c] = static_cast<uint64_t>(src[c] - bias);
+        c++;
+    }
+    return c;
+}
+
+// Encoding kernels. Leading values below `bound` are encoded as
+// single bytes (value + bias), up to `n` values. Returns the length
+// of the run. Every value takes at least one byte, so there is room
+// for `n` bytes at `dst`. Whole chunks are stored, bytes past the run
+// are overwritten by the caller.
+
+inline size_t encode_short_run_scalar(const uint64_t* src, uint8_t* dst, size_t n, uint64_t bound, uint8_t bias) noexcept
+{
+    size_t c = 0;
+    while (c < n && src[c] < bound) {
+        dst[c] = static_cast<uint8_t>(src[c] + bias);
+        c++;
+    }
+    return c;
+}
+
+#ifdef MMA_VARINT_BATCH_X86
+
+__attribute__((target("sse4.2")))
+inline size_t decode_short_run_sse42(const uint8_t* src, uint64_t* dst, size_t n, uint8_t bound, uint8_t bias) noexcept
+{
+    const __m128i limit = _mm_set1_epi8(static_cast<char>(bound - 1));
+    const __m128i vbias = _mm_set1_epi64x(bias);
+
+    size_t c = 0;
+    for (; c + 16 <= n; c += 16)
+    {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + c));
+        __m128i short_codes = _mm_cmpeq_epi8(_mm_min_epu8(bytes, limit), bytes);
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(short_codes));
+
+        for (size_t d = 0; d < 16; d += 2)
+        {
+            uint16_t pair;
+            std::memcpy(&pair, src + c + d, sizeof(pair));
+
+            __m128i values = _mm_sub_epi64(_mm_cvtepu8_epi64(_mm_cvtsi32_si128(pair)), vbias);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + c + d), values);
+        }
+
+        if (mask != 0xFFFF) {
+            return c + __builtin_ctz(~mask);
+        }
+    }
+
+    return c + decode_short_run_scalar(src + c, dst + c, n - c, bound, bias);
+}
+
+__attribute__((target("avx2")))
+inline size_t decode_short_run_avx2(const uint8_t* src, uint64_t* dst, size_t n, uint8_t bound, uint8_t bias) noexcept
+{
+    const __m256i limit = _mm256_set1_epi8(static_cast<char>(bound - 1));
+    const __m256i vbias = _mm256_set1_epi64x(bias);
+
+    size_t c = 0;
+    for (; c + 32 <= n; c += 32)
+    {
+        __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + c));
+        __m256i short_codes = _mm256_cmpeq_epi8(_mm256_min_epu8(bytes, limit), bytes);
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(short_codes));
+
+        for (size_t d = 0; d < 32; d += 4)
+        {
+            int32_t quad;
+            std::memcpy(&quad, src + c + d, sizeof(quad));
+
+            __m256i values = _mm256_sub_epi64(_mm256_cvtepu8_epi64(_mm_cvtsi32_si128(quad)), vbias);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + c + d), values);
+        }
+
+        if (mask != 0xFFFFFFFF) {
+            return c + __builtin_ctz(~mask);
+        }
+    }
+
+    return c + decode_short_run_sse42(src + c, dst + c, n - c, bound, bias);
+}
+
+// Shuffle control moving the low bytes of both 64-bit
+// elements to positions `pos` and `pos + 1`.
+__attribute__((target("sse4.2")))
+inline __m128i low_bytes_shuffle(int32_t pos) noexcept
+{
+    alignas(16) int8_t ctrl[16];
+    std::memset(ctrl, 0x80, sizeof(ctrl));
+    ctrl[pos]     = 0;
+    ctrl[pos + 1] = 8;
+    return _mm_load_si128(reinterpret_cast<const __m128i*>(ctrl));
+}
+
+__attribute__((target("sse4.2")))
+inline size_t encode_short_run_sse42(const uint64_t* src, uint8_t* dst, size_t n, uint64_t bound, uint8_t bias) noexcept
+{
+    // Unsigned compare via signed one with flipped sign bits
+    const __m128i sign   = _mm_set1_epi64x(static_cast<int64_t>(1ull << 63));
+    const __m128i vbound = _mm_xor_si128(_mm_set1_epi64x(static_cast<int64_t>(bound)), sign);
+    const __m128i vbias  = _mm_set1_epi64x(bias);
+
+    __m128i shuffles[4];
+    for (int32_t d = 0; d < 4; d++) {
+        shuffles[d] = low_bytes_shuffle(d * 2);
+    }
+
+    size_t c = 0;
+    for (; c + 8 <= n; c += 8)
+    {
+        uint32_t mask{};
+        __m128i bytes = _mm_setzero_si128();
+
+        for (int32_t d = 0; d < 4; d++)
+        {
+            __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + c + d * 2));
+            __m128i lt = _mm_cmpgt_epi64(vbound, _mm_xor_si128(values, sign));
+
+            mask |= static_cast<uint32_t>(_mm_movemask_pd(_mm_castsi128_pd(lt))) << (d * 2);
+            bytes = _mm_or_si128(bytes, _mm_shuffle_epi8(_mm_add_epi64(values, vbias), shuffles[d]));
+        }
+
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + c), bytes);
+
+        if (mask != 0xFF) {
+            return c + __builtin_ctz(~mask);
+        }
+    }
+
+    return c + encode_short_run_scalar(src + c, dst + c, n - c, bound, bias);
+}
+
+__attribute__((target("avx2")))
+inline size_t encode_short_run_avx2(const uint64_t* src, uint8_t* dst, size_t n, uint64_t bound, uint8_t bias) noexcept
+{
+    const __m256i sign   = _mm256_set1_epi64x(static_cast<int64_t>(1ull << 63));
+    const __m256i vbound = _mm256_xor_si256(_mm256_set1_epi64x(static_cast<int64_t>(bound)), sign);
+    const __m256i vbias  = _mm256_set1_epi64x(bias);
+
+    __m256i shuffles[4];
+    for (int32_t d = 0; d < 4; d++) {
+        shuffles[d] = _mm256_broadcastsi128_si256(low_bytes_shuffle(d * 2));
+    }
+
+    size_t c = 0;
+    for (; c + 16 <= n; c += 16)
+    {
+        uint32_t mask{};
+        __m256i bytes = _mm256_setzero_si256();
+
+        for (int32_t d = 0; d < 4; d++)
+        {
+            __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + c + d * 4));
+            __m256i lt = _mm256_cmpgt_epi64(vbound, _mm256_xor_si256(values, sign));
+
+            mask |= static_cast<uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(lt))) << (d * 4);
+            bytes = _mm256_or_si256(bytes, _mm256_shuffle_epi8(_mm256_add_epi64(values, vbias), shuffles[d]));
+        }
+
+        // The low lane holds byte pairs of values 4d, 4d+1,
+        // the high lane of values 4d+2, 4d+3.
+        __m128i ordered = _mm_unpacklo_epi16(
+            _mm256_castsi256_si128(bytes), _mm256_extracti128_si256(bytes, 1)
+        );
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + c), ordered);
+
+        if (mask != 0xFFFF) {
+            return c + __builtin_ctz(~mask);
+        }
+    }
+
+    return c + encode_short_run_sse42(src + c, dst + c, n - c, bound, bias);
+}
+
+#endif
+
+template <typename V>
+constexpr bool VarintBatchKernelsApply = std::is_integral_v<V> && sizeof(V) == sizeof(uint64_t);
+
+}
+
+// Decodes a run of single-byte codes, see the kernels above.
+template <typename V>
+size_t varint_decode_short_run(const uint8_t* src, V* dst, size_t n, uint8_t bound, uint8_t bias = 0) noexcept
+{
+    if (MMA_UNLIKELY(n == 0 || src[0] >= bound)) {
+        return 0;
+    }
+
+    if constexpr (detail::VarintBatchKernelsApply<V>)
+    {
+        uint64_t* udst = reinterpret_cast<uint64_t*>(dst);
+
+        switch (varint_batch_isa())
+        {
+#ifdef MMA_VARINT_BATCH_X86
+            case VarintBatchISA::AVX2:  return detail::decode_short_run_avx2(src, udst, n, bound, bias);
+            case VarintBatchISA::SSE42: return detail::decode_short_run_sse42(src, udst, n, bound, bias);
+#endif
+            default: return detail::decode_short_run_scalar(src, udst, n, bound, bias);
+        }
+    }
+    else {
+        size_t c = 0;
+        while (c < n && src[c] < bound) {
+            dst[c] = src[c] - bias;
+            c++;
+        }
+        return c;
+    }
+}
+
+// Encodes a run of values below `bound` as single bytes, see the kernels above.
+template <typename V>
+size_t varint_encode_short_run(const V* src, uint8_t* dst, size_t n, uint64_t bound, uint8_t bias = 0) noexcept
+{
+    if constexpr (detail::VarintBatchKernelsApply<V>)
+    {
+        const uint64_t* usrc = reinterpret_cast<const uint64_t*>(src);
+
+        if (MMA_UNLIKELY(n == 0 || usrc[0] >= bound)) {
+            return 0;
+        }
+
+        switch (varint_batch_isa())
+        {
+#ifdef MMA_VARINT_BATCH_X86
+            case VarintBatchISA::AVX2:  return detail::encode_short_run_avx2(usrc, dst, n, bound, bias);
+            case VarintBatchISA::SSE42: return detail::encode_short_run_sse42(usrc, dst, n, bound, bias);
+#endif
+            default: return detail::encode_short_run_scalar(usrc, dst, n, bound, bias);
+        }
+    }
+    else {
+        // Only non-negative values can be short
+        size_t c = 0;
+        while (c < n && !(src[c] < V()) && static_cast<uint64_t>(src[c]) < bound) {
+            dst[c] = static_cast<uint8_t>(src[c] + bias);
+            c++;
+        }
+        return c;
+    }
+}
+
+// Generic batch loops over a codec's per-value functions: runs of short
+// codes go through the kernels, other values through `decode_one` and
+// `encode_one`. Both return the number of bytes processed.
+
+template <typename V, typename DecodeOneFn>
+size_t varint_decode_n(const uint8_t* buffer, V* values, size_t n, size_t start, uint8_t bound, uint8_t bias, DecodeOneFn&& decode_one)
+{
+    size_t pos = start;
+    for (size_t c = 0; c < n;)
+    {
+        size_t run = varint_decode_short_run(buffer + pos, values + c, n - c, bound, bias);
+        c   += run;
+        pos += run;
+
+        if (c < n) {
+            pos += decode_one(buffer, values[c++], pos);
+        }
+    }
+
+    return pos - start;
+}
+
+template <typename V, typename EncodeOneFn>
+size_t varint_encode_n(uint8_t* buffer, const V* values, size_t n, size_t start, uint64_t bound, uint8_t bias, EncodeOneFn&& encode_one)
+{
+    size_t pos = start;
+    for (size_t c = 0; c < n;)
+    {
+        size_t run = varint_encode_short_run(values + c, buffer + pos, n - c, bound, bias);
+        c   += run;
+        pos += run;
+
+        if (c < n) {
+            pos += encode_one(buffer, values[c++], pos);
+        }
+    }
+
+    return pos - start;
+}
+
+}
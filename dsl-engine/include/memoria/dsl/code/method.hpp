@@ -20,6 +20,8 @@
 
 #include <memoria/core/hermes/array/array_of.hpp>
 
+#include <memoria/dsl/vm/bytecode.hpp>
+
 
 namespace memoria::dsl {
 
@@ -70,6 +72,12 @@ public:
     hermes::ArrayOf<Argument> arguments() const {
         return hermes::ArrayOf<Argument>{this->object_.expect(ARGUMENTS).as_object_array()};
     }
+
+    // Bytecode is stored as Array<UInteger> of instruction words in CODE,
+    // and constant pool as Array<BigInt> of raw value bits in CONSTANTS.
+    // The program is verified on load.
+    vm::Program program() const;
+    void set_program(const vm::Program& program);
 };
 
 
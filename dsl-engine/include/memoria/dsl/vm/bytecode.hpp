@@ -0,0 +1,236 @@
+// Copyright 2026 Victor Smirnov
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memoria/core/types.hpp>
+#include <memoria/core/tools/span.hpp>
+#include <memoria/core/strings/string.hpp>
+
+#include <vector>
+#include <cstring>
+
+namespace memoria::dsl::vm {
+
+// Register-based bytecode. Each instruction is a 32-bit word:
+//
+//   | C:8 | B:8 | A:8 | OP:8 |
+//
+// A, B and C are register, span register or cursor slot numbers, or
+// small immediates. Bx is a 16-bit unsigned (B | C << 8), and sBx
+// is Bx with 32768 bias, used for jumps (relative to the next
+// instruction) and small integer constants.
+//
+// Registers hold untyped 64-bit values, opcodes define the type (I for
+// int64_t, F for double). Span registers hold views of cursor's column
+// data for the current chunk. Registers other than arguments start
+// from zero.
+//
+// Integer arithmetic wraps around on overflow, INT64_MIN / -1 is
+// INT64_MIN and INT64_MIN % -1 is 0. Division by zero, and F2I of NaN
+// or of a value out of int64_t range are VM errors.
+
+#define MEMORIA_DSL_VM_OPCODES(X) \
+    X(NOP)      /*                                          */ \
+    X(LOADK)    /* R[A] = K[Bx]                             */ \
+    X(LOADI)    /* R[A] = sBx                               */ \
+    X(MOV)      /* R[A] = R[B]                              */ \
+    X(ADDI)     /* R[A] = R[B] + R[C]                       */ \
+    X(SUBI)     /* R[A] = R[B] - R[C]                       */ \
+    X(MULI)     /* R[A] = R[B] * R[C]                       */ \
+    X(DIVI)     /* R[A] = R[B] / R[C]                       */ \
+    X(REMI)     /* R[A] = R[B] % R[C]                       */ \
+    X(ADDF)     /* R[A] = R[B] + R[C]                       */ \
+    X(SUBF)     /* R[A] = R[B] - R[C]                       */ \
+    X(MULF)     /* R[A] = R[B] * R[C]                       */ \
+    X(DIVF)     /* R[A] = R[B] / R[C]                       */ \
+    X(I2F)      /* R[A] = (double)R[B]                      */ \
+    X(F2I)      /* R[A] = (int64_t)R[B]                     */ \
+    X(LTI)      /* R[A] = R[B] < R[C]                       */ \
+    X(LEI)      /* R[A] = R[B] <= R[C]                      */ \
+    X(EQI)      /* R[A] = R[B] == R[C]                      */ \
+    X(NEI)      /* R[A] = R[B] != R[C]                      */ \
+    X(LTF)      /* R[A] = R[B] < R[C]                       */ \
+    X(LEF)      /* R[A] = R[B] <= R[C]                      */ \
+    X(JMP)      /* pc += sBx                                */ \
+    X(JT)       /* if (R[A]) pc += sBx                      */ \
+    X(JF)       /* if (!R[A]) pc += sBx                     */ \
+    X(CSEEK)    /* R[A] = cursor[C].seek(R[B])              */ \
+    X(CNEXT)    /* R[A] = cursor[C].next_chunk()            */ \
+    X(CCOLI)    /* S[A] = cursor[B].column_i64(C)           */ \
+    X(CCOLF)    /* S[A] = cursor[B].column_f64(C)           */ \
+    X(SLEN)     /* R[A] = S[B].size                         */ \
+    X(SGETI)    /* R[A] = S[B].i64[R[C]]                    */ \
+    X(SGETF)    /* R[A] = S[B].f64[R[C]]                    */ \
+    X(SSUMI)    /* R[A] += sum(S[B].i64)                    */ \
+    X(SSUMF)    /* R[A] += sum(S[B].f64)                    */ \
+    X(SCNTGEI)  /* R[A] += count(S[B].i64 >= R[C])          */ \
+    X(RET)      /* return R[A]                              */
+
+enum class OpCode: uint8_t {
+#define MEMORIA_DSL_VM_ENUM(Name) Name,
+    MEMORIA_DSL_VM_OPCODES(MEMORIA_DSL_VM_ENUM)
+#undef MEMORIA_DSL_VM_ENUM
+    OPCODES_NUM
+};
+
+const char* opcode_name(OpCode op);
+
+using Instruction = uint32_t;
+
+constexpr Instruction encode_abc(OpCode op, uint8_t a, uint8_t b = 0, uint8_t c = 0) {
+    return static_cast<uint32_t>(op) | (uint32_t{a} << 8) | (uint32_t{b} << 16) | (uint32_t{c} << 24);
+}
+
+constexpr Instruction encode_abx(OpCode op, uint8_t a, uint16_t bx) {
+    return static_cast<uint32_t>(op) | (uint32_t{a} << 8) | (uint32_t{bx} << 16);
+}
+
+constexpr int32_t SBX_BIAS = 32768;
+
+constexpr Instruction encode_asbx(OpCode op, uint8_t a, int32_t sbx) {
+    return encode_abx(op, a, static_cast<uint16_t>(sbx + SBX_BIAS));
+}
+
+constexpr OpCode  op_of(Instruction ii)  {return static_cast<OpCode>(ii & 0xFF);}
+constexpr uint8_t a_of(Instruction ii)   {return (ii >> 8) & 0xFF;}
+constexpr uint8_t b_of(Instruction ii)   {return (ii >> 16) & 0xFF;}
+constexpr uint8_t c_of(Instruction ii)   {return (ii >> 24) & 0xFF;}
+constexpr uint16_t bx_of(Instruction ii) {return ii >> 16;}
+constexpr int32_t sbx_of(Instruction ii) {return static_cast<int32_t>(ii >> 16) - SBX_BIAS;}
+
+
+union Value {
+    int64_t i;
+    double f;
+
+    static Value of_int(int64_t v) {
+        Value vv;
+        vv.i = v;
+        return vv;
+    }
+
+    static Value of_float(double v) {
+        Value vv;
+        vv.f = v;
+        return vv;
+    }
+};
+
+static_assert(sizeof(Value) == sizeof(int64_t));
+
+
+// Verified, ready to run program. The first code word is the header:
+//
+//   | VERSION:8 | SPANS:8 | ARGUMENTS:8 | REGISTERS:8 |
+//
+// Arguments are passed in registers 0..ARGUMENTS-1.
+class Program {
+public:
+    static constexpr uint32_t VERSION = 1;
+    static constexpr size_t MAX_REGISTERS = 256;
+    static constexpr size_t MAX_ARGUMENTS = 255;
+    static constexpr size_t MAX_SPANS = 32;
+
+private:
+    std::vector<Instruction> code_;
+    std::vector<Value> constants_;
+
+public:
+    // Program returning 0
+    Program(): code_{make_header(1, 0, 0), encode_abc(OpCode::RET, 0)} {}
+
+    // Throws if the code is malformed: an unknown opcode, a register,
+    // span or constant out of range, or a jump outside of the code.
+    Program(std::vector<Instruction> code, std::vector<Value> constants);
+
+    // Header fields are 8 bits wide, throws if a value doesn't fit.
+    static Instruction make_header(size_t registers, size_t arguments, size_t spans);
+
+    size_t registers() const {return code_[0] & 0xFF;}
+    size_t arguments() const {return (code_[0] >> 8) & 0xFF;}
+    size_t spans() const {return (code_[0] >> 16) & 0xFF;}
+
+    // Including the header
+    const std::vector<Instruction>& code() const {return code_;}
+    const std::vector<Value>& constants() const {return constants_;}
+
+    // Instructions, without the header
+    Span<const Instruction> instructions() const {
+        return Span<const Instruction>(code_.data() + 1, code_.size() - 1);
+    }
+
+    U8String disassemble() const;
+
+private:
+    void verify() const;
+};
+
+
+// Assembles a program with forward/backward labels.
+class ProgramBuilder {
+public:
+    struct Label {
+        size_t id;
+    };
+
+private:
+    std::vector<Instruction> code_;
+    std::vector<Value> constants_;
+
+    std::vector<int64_t> labels_;
+    std::vector<std::pair<size_t, size_t>> fixups_; // <instruction, label>
+
+    size_t registers_;
+    size_t arguments_;
+    size_t spans_{};
+
+public:
+    ProgramBuilder(size_t arguments = 0);
+
+    uint8_t reg();
+    uint8_t span();
+
+    // Argument's register
+    uint8_t arg(size_t num) const;
+
+    uint16_t constant(Value value);
+    uint16_t constant_i(int64_t value) {return constant(Value::of_int(value));}
+    uint16_t constant_f(double value) {return constant(Value::of_float(value));}
+
+    Label label();
+    void bind(Label label);
+
+    void emit(OpCode op, uint8_t a = 0, uint8_t b = 0, uint8_t c = 0) {
+        code_.push_back(encode_abc(op, a, b, c));
+    }
+
+    void load_k(uint8_t a, uint16_t k) {
+        code_.push_back(encode_abx(OpCode::LOADK, a, k));
+    }
+
+    // Small values are encoded inline, others go to the constant pool.
+    void load_i(uint8_t a, int64_t value);
+
+    void jmp(Label target) {jump(OpCode::JMP, 0, target);}
+    void jt(uint8_t a, Label target) {jump(OpCode::JT, a, target);}
+    void jf(uint8_t a, Label target) {jump(OpCode::JF, a, target);}
+
+    Program build();
+
+private:
+    void jump(OpCode op, uint8_t a, Label target);
+};
+
+}
@@ -0,0 +1,104 @@
+// Copyright 2026 Victor Smirnov
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memoria/dsl/vm/cursor.hpp>
+
+#include <memoria/core/tools/result.hpp>
+
+#include <functional>
+#include <type_traits>
+
+namespace memoria::dsl::vm {
+
+// Cursor over container chunk iterators, chunks are container's leaves.
+// Column 0 is chunk's keys(): Vector's elements, Multimap's keys and
+// so on. Positions are entry numbers, the seek function maps them to
+// chunks, like ICtrApi<Vector<T>>::seek_entry() does.
+//
+// Column spans point directly into the leaf, so the container must not
+// be updated while the cursor is in use.
+template <typename ChunkPtrT>
+class ChunkCursor: public VMCursor {
+public:
+    using SeekFn = std::function<ChunkPtrT (int64_t)>;
+
+private:
+    SeekFn seek_fn_;
+    int64_t size_;
+    ChunkPtrT chunk_;
+
+public:
+    ChunkCursor(int64_t size, SeekFn seek_fn):
+        seek_fn_(std::move(seek_fn)), size_(size)
+    {}
+
+    bool seek(int64_t pos) override
+    {
+        if (pos >= 0 && pos < size_) {
+            chunk_ = seek_fn_(pos);
+            return is_valid();
+        }
+
+        chunk_ = ChunkPtrT{};
+        return false;
+    }
+
+    bool next_chunk() override
+    {
+        if (is_valid()) {
+            chunk_ = chunk_->next_chunk();
+        }
+
+        return is_valid();
+    }
+
+    Span<const int64_t> column_i64(size_t column) override {
+        return column_of<int64_t>(column);
+    }
+
+    Span<const double> column_f64(size_t column) override {
+        return column_of<double>(column);
+    }
+
+private:
+    bool is_valid() const {
+        return chunk_ && !(chunk_->is_after_end() || chunk_->is_before_start());
+    }
+
+    template <typename T>
+    Span<const T> column_of(size_t column) const
+    {
+        if (column != 0) {
+            MEMORIA_MAKE_GENERIC_ERROR("DSL VM chunk cursor has no column {}", column).do_throw();
+        }
+
+        if (!is_valid()) {
+            return Span<const T>{};
+        }
+
+        auto span = chunk_->keys().raw_span();
+        using ElementT = std::remove_const_t<typename decltype(span)::value_type>;
+
+        if constexpr (std::is_same_v<ElementT, T>) {
+            return Span<const T>(span.data(), span.size());
+        }
+        else {
+            MEMORIA_MAKE_GENERIC_ERROR("DSL VM chunk cursor's column has a different data type").do_throw();
+        }
+    }
+};
+
+}
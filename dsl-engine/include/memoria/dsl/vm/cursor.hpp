@@ -0,0 +1,115 @@
+// Copyright 2026 Victor Smirnov
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memoria/core/types.hpp>
+#include <memoria/core/tools/span.hpp>
+#include <memoria/core/tools/result.hpp>
+
+#include <vector>
+
+namespace memoria::dsl::vm {
+
+// Chunked columnar cursor the VM's cursor opcodes operate on. Container
+// adapters map it to their chunk iterators: seek() positions the cursor
+// to the chunk containing the entry, next_chunk() moves to the next leaf,
+// column spans point directly into the current leaf's data.
+struct VMCursor {
+    virtual ~VMCursor() noexcept = default;
+
+    // Returns false if the position is past the end.
+    virtual bool seek(int64_t pos) = 0;
+
+    // Returns false if there are no more chunks.
+    virtual bool next_chunk() = 0;
+
+    // Spans are valid until the cursor is moved.
+    virtual Span<const int64_t> column_i64(size_t column) = 0;
+    virtual Span<const double>  column_f64(size_t column) = 0;
+};
+
+
+// Cursor over in-memory columns of equal size, split into fixed-size
+// chunks. Positions are row numbers.
+class ColumnarCursor: public VMCursor {
+    std::vector<Span<const int64_t>> columns_i64_;
+    std::vector<Span<const double>> columns_f64_;
+    size_t rows_;
+    size_t chunk_size_;
+    size_t chunk_start_{};
+
+public:
+    ColumnarCursor(size_t rows, size_t chunk_size):
+        rows_(rows), chunk_size_(chunk_size)
+    {
+        if (chunk_size == 0) {
+            MEMORIA_MAKE_GENERIC_ERROR("DSL VM cursor chunk size must be greater than zero").do_throw();
+        }
+    }
+
+    ColumnarCursor& add_column(Span<const int64_t> column) {
+        check_column_size(column.size());
+        columns_i64_.push_back(column);
+        return *this;
+    }
+
+    ColumnarCursor& add_column(Span<const double> column) {
+        check_column_size(column.size());
+        columns_f64_.push_back(column);
+        return *this;
+    }
+
+    bool seek(int64_t pos) override
+    {
+        if (pos >= 0 && static_cast<size_t>(pos) < rows_) {
+            chunk_start_ = pos - pos % chunk_size_;
+            return true;
+        }
+
+        chunk_start_ = rows_;
+        return false;
+    }
+
+    bool next_chunk() override
+    {
+        chunk_start_ = std::min(chunk_start_ + chunk_size_, rows_);
+        return chunk_start_ < rows_;
+    }
+
+    Span<const int64_t> column_i64(size_t column) override {
+        return chunk_of(columns_i64_.at(column));
+    }
+
+    Span<const double> column_f64(size_t column) override {
+        return chunk_of(columns_f64_.at(column));
+    }
+
+private:
+    void check_column_size(size_t size) const
+    {
+        if (size < rows_) {
+            MEMORIA_MAKE_GENERIC_ERROR("DSL VM cursor column has {} rows, {} expected", size, rows_).do_throw();
+        }
+    }
+
+    template <typename T>
+    Span<const T> chunk_of(Span<const T> column) const
+    {
+        size_t size = std::min(chunk_size_, rows_ - chunk_start_);
+        return column.subspan(chunk_start_, size);
+    }
+};
+
+}
@@ -0,0 +1,34 @@
+// Copyright 2026 Victor Smirnov
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memoria/dsl/vm/bytecode.hpp>
+#include <memoria/dsl/vm/cursor.hpp>
+
+namespace memoria::dsl::vm {
+
+// Executes verified programs. Dispatch uses computed goto where the
+// compiler supports it, and a switch otherwise. Interpreter has no
+// state between runs and may be shared by fibers of the same thread.
+class Interpreter {
+public:
+    Value run(const Program& program, Span<const Value> args) {
+        return run(program, args, Span<VMCursor* const>{});
+    }
+
+    Value run(const Program& program, Span<const Value> args, Span<VMCursor* const> cursors);
+};
+
+}
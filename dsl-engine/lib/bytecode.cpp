@@ -0,0 +1,313 @@
+// Copyright 2026 Victor Smirnov
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memoria/dsl/vm/bytecode.hpp>
+
+#include <memoria/core/tools/result.hpp>
+#include <memoria/core/strings/format.hpp>
+
+#include <sstream>
+
+namespace memoria::dsl::vm {
+
+namespace {
+
+// Operand kinds, for verification and disassembly
+enum class Opd: uint8_t {
+    NONE,
+    REG,    // register
+    SPAN,   // span register
+    IMM,    // cursor slot or column number, checked at runtime
+    CONST,  // Bx, constant pool index
+    SIMM,   // sBx, inline integer
+    JUMP    // sBx, relative jump
+};
+
+struct OpFormat {
+    Opd a, b, c;
+};
+
+OpFormat format_of(OpCode op)
+{
+    switch (op) {
+        case OpCode::NOP:     return {Opd::NONE, Opd::NONE,  Opd::NONE};
+        case OpCode::LOADK:   return {Opd::REG,  Opd::CONST, Opd::NONE};
+        case OpCode::LOADI:   return {Opd::REG,  Opd::SIMM,  Opd::NONE};
+        case OpCode::MOV:
+        case OpCode::I2F:
+        case OpCode::F2I:     return {Opd::REG,  Opd::REG,   Opd::NONE};
+        case OpCode::JMP:     return {Opd::NONE, Opd::JUMP,  Opd::NONE};
+        case OpCode::JT:
+        case OpCode::JF:      return {Opd::REG,  Opd::JUMP,  Opd::NONE};
+        case OpCode::CSEEK:   return {Opd::REG,  Opd::REG,   Opd::IMM};
+        case OpCode::CNEXT:   return {Opd::REG,  Opd::NONE,  Opd::IMM};
+        case OpCode::CCOLI:
+        case OpCode::CCOLF:   return {Opd::SPAN, Opd::IMM,   Opd::IMM};
+        case OpCode::SLEN:
+        case OpCode::SSUMI:
+        case OpCode::SSUMF:   return {Opd::REG,  Opd::SPAN,  Opd::NONE};
+        case OpCode::SGETI:
+        case OpCode::SGETF:
+        case OpCode::SCNTGEI: return {Opd::REG,  Opd::SPAN,  Opd::REG};
+        case OpCode::RET:     return {Opd::REG,  Opd::NONE,  Opd::NONE};
+        default:              return {Opd::REG,  Opd::REG,   Opd::REG};
+    }
+}
+
+}
+
+const char* opcode_name(OpCode op)
+{
+    switch (op) {
+#define MEMORIA_DSL_VM_NAME(Name) case OpCode::Name: return #Name;
+        MEMORIA_DSL_VM_OPCODES(MEMORIA_DSL_VM_NAME)
+#undef MEMORIA_DSL_VM_NAME
+        default: return "UNKNOWN";
+    }
+}
+
+
+Instruction Program::make_header(size_t registers, size_t arguments, size_t spans)
+{
+    if (registers > 0xFF || arguments > 0xFF || spans > 0xFF) {
+        MEMORIA_MAKE_GENERIC_ERROR(
+            "DSL VM program header is out of range: {} registers, {} arguments, {} spans",
+            registers, arguments, spans
+        ).do_throw();
+    }
+
+    return registers | (arguments << 8) | (spans << 16) | (VERSION << 24);
+}
+
+Program::Program(std::vector<Instruction> code, std::vector<Value> constants):
+    code_(std::move(code)),
+    constants_(std::move(constants))
+{
+    verify();
+}
+
+void Program::verify() const
+{
+    if (code_.size() < 2) {
+        MEMORIA_MAKE_GENERIC_ERROR("DSL VM program is empty").do_throw();
+    }
+
+    uint32_t version = code_[0] >> 24;
+    if (version != VERSION) {
+        MEMORIA_MAKE_GENERIC_ERROR("Unsupported DSL VM bytecode version: {}", version).do_throw();
+    }
+
+    if (arguments() > registers()) {
+        MEMORIA_MAKE_GENERIC_ERROR("DSL VM program has {} arguments but only {} registers", arguments(), registers()).do_throw();
+    }
+
+    if (spans() > MAX_SPANS) {
+        MEMORIA_MAKE_GENERIC_ERROR("DSL VM program has too many span registers: {}", spans()).do_throw();
+    }
+
+    auto code = instructions();
+
+    auto check = [&](size_t pc, Opd kind, uint32_t value) {
+        bool ok;
+        switch (kind) {
+            case Opd::REG:   ok = value < registers(); break;
+            case Opd::SPAN:  ok = value < spans(); break;
+            case Opd::CONST: ok = value < constants_.size(); break;
+            case Opd::JUMP: {
+                int64_t target = static_cast<int64_t>(pc) + 1 + static_cast<int32_t>(value) - SBX_BIAS;
+                ok = target >= 0 && target < static_cast<int64_t>(code.size());
+                break;
+            }
+            default: ok = true;
+        }
+
+        if (!ok) {
+            MEMORIA_MAKE_GENERIC_ERROR(
+                "DSL VM operand {} of {} at {} is out of range",
+                value, opcode_name(op_of(code[pc])), pc
+            ).do_throw();
+        }
+    };
+
+    for (size_t pc = 0; pc < code.size(); pc++)
+    {
+        Instruction ii = code[pc];
+        if (static_cast<size_t>(op_of(ii)) >= static_cast<size_t>(OpCode::OPCODES_NUM)) {
+            MEMORIA_MAKE_GENERIC_ERROR("Unknown DSL VM opcode {} at {}", ii & 0xFF, pc).do_throw();
+        }
+
+        OpFormat fmt = format_of(op_of(ii));
+        check(pc, fmt.a, a_of(ii));
+
+        if (fmt.b == Opd::CONST || fmt.b == Opd::SIMM || fmt.b == Opd::JUMP) {
+            check(pc, fmt.b, bx_of(ii));
+        }
+        else {
+            check(pc, fmt.b, b_of(ii));
+            check(pc, fmt.c, c_of(ii));
+        }
+    }
+
+    // Execution must never fall off the end of the code.
+    OpCode last = op_of(code[code.size() - 1]);
+    if (last != OpCode::RET && last != OpCode::JMP) {
+        MEMORIA_MAKE_GENERIC_ERROR("DSL VM program must end with RET or JMP").do_throw();
+    }
+}
+
+U8String Program::disassemble() const
+{
+    std::stringstream ss;
+    ss << format_u8("; registers: {}, arguments: {}, spans: {}\n", registers(), arguments(), spans());
+
+    for (size_t c = 0; c < constants_.size(); c++) {
+        ss << format_u8("; K{} = {}\n", c, constants_[c].i);
+    }
+
+    auto print = [&](Opd kind, uint32_t value) {
+        switch (kind) {
+            case Opd::REG:   ss << format_u8(" R{}", value); break;
+            case Opd::SPAN:  ss << format_u8(" S{}", value); break;
+            case Opd::IMM:   ss << format_u8(" #{}", value); break;
+            case Opd::CONST: ss << format_u8(" K{}", value); break;
+            case Opd::SIMM:
+            case Opd::JUMP:  ss << format_u8(" {}", static_cast<int32_t>(value) - SBX_BIAS); break;
+            default:;
+        }
+    };
+
+    auto code = instructions();
+    for (size_t pc = 0; pc < code.size(); pc++)
+    {
+        Instruction ii = code[pc];
+        OpFormat fmt = format_of(op_of(ii));
+
+        ss << format_u8("{:>5}: {:<8}", pc, opcode_name(op_of(ii)));
+        print(fmt.a, a_of(ii));
+
+        if (fmt.b == Opd::CONST || fmt.b == Opd::SIMM || fmt.b == Opd::JUMP) {
+            print(fmt.b, bx_of(ii));
+        }
+        else {
+            print(fmt.b, b_of(ii));
+            print(fmt.c, c_of(ii));
+        }
+
+        ss << "\n";
+    }
+
+    return U8String(ss.str());
+}
+
+
+ProgramBuilder::ProgramBuilder(size_t arguments):
+    registers_(arguments),
+    arguments_(arguments)
+{
+    if (arguments > Program::MAX_ARGUMENTS) {
+        MEMORIA_MAKE_GENERIC_ERROR("Too many DSL VM program arguments: {}", arguments).do_throw();
+    }
+
+    code_.push_back(0); // header
+}
+
+uint8_t ProgramBuilder::reg()
+{
+    if (registers_ >= Program::MAX_REGISTERS - 1) {
+        MEMORIA_MAKE_GENERIC_ERROR("DSL VM program is out of registers").do_throw();
+    }
+    return registers_++;
+}
+
+uint8_t ProgramBuilder::span()
+{
+    if (spans_ >= Program::MAX_SPANS) {
+        MEMORIA_MAKE_GENERIC_ERROR("DSL VM program is out of span registers").do_throw();
+    }
+    return spans_++;
+}
+
+uint8_t ProgramBuilder::arg(size_t num) const
+{
+    if (num >= arguments_) {
+        MEMORIA_MAKE_GENERIC_ERROR("DSL VM program argument {} is out of range {}", num, arguments_).do_throw();
+    }
+    return num;
+}
+
+uint16_t ProgramBuilder::constant(Value value)
+{
+    for (size_t c = 0; c < constants_.size(); c++) {
+        if (constants_[c].i == value.i) {
+            return c;
+        }
+    }
+
+    if (constants_.size() > UINT16_MAX) {
+        MEMORIA_MAKE_GENERIC_ERROR("DSL VM program is out of constants").do_throw();
+    }
+
+    constants_.push_back(value);
+    return constants_.size() - 1;
+}
+
+void ProgramBuilder::load_i(uint8_t a, int64_t value)
+{
+    if (value >= -SBX_BIAS && value < SBX_BIAS) {
+        code_.push_back(encode_asbx(OpCode::LOADI, a, value));
+    }
+    else {
+        load_k(a, constant_i(value));
+    }
+}
+
+ProgramBuilder::Label ProgramBuilder::label()
+{
+    labels_.push_back(-1);
+    return Label{labels_.size() - 1};
+}
+
+void ProgramBuilder::bind(Label label) {
+    labels_.at(label.id) = code_.size();
+}
+
+void ProgramBuilder::jump(OpCode op, uint8_t a, Label target)
+{
+    fixups_.emplace_back(code_.size(), target.id);
+    code_.push_back(encode_asbx(op, a, 0));
+}
+
+Program ProgramBuilder::build()
+{
+    for (auto& fixup: fixups_)
+    {
+        int64_t target = labels_.at(fixup.second);
+        if (target < 0) {
+            MEMORIA_MAKE_GENERIC_ERROR("DSL VM label {} is not bound", fixup.second).do_throw();
+        }
+
+        int64_t offset = target - static_cast<int64_t>(fixup.first) - 1;
+        if (offset < -SBX_BIAS || offset >= SBX_BIAS) {
+            MEMORIA_MAKE_GENERIC_ERROR("DSL VM jump offset {} is out of range", offset).do_throw();
+        }
+
+        Instruction ii = code_[fixup.first];
+        code_[fixup.first] = encode_asbx(op_of(ii), a_of(ii), offset);
+    }
+
+    code_[0] = Program::make_header(registers_, arguments_, spans_);
+    return Program(code_, constants_);
+}
+
+}
@@ -0,0 +1,274 @@
+// Copyright 2026 Victor Smirnov
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memoria/dsl/vm/interpreter.hpp>
+
+#include <memoria/core/tools/result.hpp>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define MEMORIA_DSL_VM_COMPUTED_GOTO
+#endif
+
+namespace memoria::dsl::vm {
+
+namespace {
+
+struct SpanReg {
+    const void* data;
+    size_t size;
+
+    template <typename T>
+    const T* as() const {
+        return static_cast<const T*>(data);
+    }
+};
+
+[[noreturn]] void span_range_error(int64_t idx, size_t size) {
+    MEMORIA_MAKE_GENERIC_ERROR("DSL VM span index {} is out of range {}", idx, size).do_throw();
+}
+
+[[noreturn]] void cursor_range_error(size_t slot, size_t size) {
+    MEMORIA_MAKE_GENERIC_ERROR("DSL VM cursor slot {} is out of range {}", slot, size).do_throw();
+}
+
+[[noreturn]] void division_by_zero() {
+    MEMORIA_MAKE_GENERIC_ERROR("DSL VM integer division by zero").do_throw();
+}
+
+[[noreturn]] void float_range_error(double value) {
+    MEMORIA_MAKE_GENERIC_ERROR("DSL VM float value {} is out of int64 range", value).do_throw();
+}
+
+// Signed overflow is UB in C++, the VM's integers wrap around
+int64_t wrap_add(int64_t a, int64_t b) {
+    return static_cast<int64_t>(static_cast<uint64_t>(a) + static_cast<uint64_t>(b));
+}
+
+int64_t wrap_sub(int64_t a, int64_t b) {
+    return static_cast<int64_t>(static_cast<uint64_t>(a) - static_cast<uint64_t>(b));
+}
+
+int64_t wrap_mul(int64_t a, int64_t b) {
+    return static_cast<int64_t>(static_cast<uint64_t>(a) * static_cast<uint64_t>(b));
+}
+
+// -2^63 and 2^63 are exact doubles, INT64_MAX is not.
+constexpr double F2I_MIN = -9223372036854775808.0;
+constexpr double F2I_MAX = 9223372036854775808.0;
+
+}
+
+Value Interpreter::run(const Program& program, Span<const Value> args, Span<VMCursor* const> cursors)
+{
+    if (args.size() != program.arguments()) {
+        MEMORIA_MAKE_GENERIC_ERROR(
+            "DSL VM program expects {} arguments, {} provided",
+            program.arguments(), args.size()
+        ).do_throw();
+    }
+
+    // Operands are verified by Program, so register
+    // and constant accesses are not checked here.
+    Value regs[Program::MAX_REGISTERS];
+    SpanReg spans[Program::MAX_SPANS]{};
+
+    for (size_t c = 0; c < args.size(); c++) {
+        regs[c] = args[c];
+    }
+
+    for (size_t c = args.size(); c < program.registers(); c++) {
+        regs[c].i = 0;
+    }
+
+    const Value* consts = program.constants().data();
+    const Instruction* code = program.instructions().data();
+    const Instruction* pc = code;
+    Instruction ii;
+
+    auto cursor = [&](size_t slot) -> VMCursor* {
+        if (MMA_UNLIKELY(slot >= cursors.size())) {
+            cursor_range_error(slot, cursors.size());
+        }
+        return cursors[slot];
+    };
+
+#define RA regs[a_of(ii)]
+#define RB regs[b_of(ii)]
+#define RC regs[c_of(ii)]
+#define SB spans[b_of(ii)]
+
+#ifdef MEMORIA_DSL_VM_COMPUTED_GOTO
+    static const void* dispatch_table[] = {
+#define MEMORIA_DSL_VM_LABEL(Name) &&op_##Name,
+        MEMORIA_DSL_VM_OPCODES(MEMORIA_DSL_VM_LABEL)
+#undef MEMORIA_DSL_VM_LABEL
+    };
+
+#define VM_CASE(Name) op_##Name:
+#define VM_NEXT() do { ii = *pc++; goto *dispatch_table[ii & 0xFF]; } while (0)
+
+    VM_NEXT();
+#else
+#define VM_CASE(Name) case OpCode::Name:
+#define VM_NEXT() continue
+
+    while (true) {
+    ii = *pc++;
+    switch (op_of(ii)) {
+#endif
+
+    VM_CASE(NOP)  VM_NEXT();
+
+    VM_CASE(LOADK) RA = consts[bx_of(ii)]; VM_NEXT();
+    VM_CASE(LOADI) RA.i = sbx_of(ii); VM_NEXT();
+    VM_CASE(MOV)   RA = RB; VM_NEXT();
+
+    VM_CASE(ADDI) RA.i = wrap_add(RB.i, RC.i); VM_NEXT();
+    VM_CASE(SUBI) RA.i = wrap_sub(RB.i, RC.i); VM_NEXT();
+    VM_CASE(MULI) RA.i = wrap_mul(RB.i, RC.i); VM_NEXT();
+    VM_CASE(DIVI)
+        if (MMA_UNLIKELY(RC.i == 0)) {
+            division_by_zero();
+        }
+        else if (MMA_UNLIKELY(RC.i == -1)) {
+            // INT64_MIN / -1 traps on x86
+            RA.i = wrap_sub(0, RB.i);
+        }
+        else {
+            RA.i = RB.i / RC.i;
+        }
+        VM_NEXT();
+    VM_CASE(REMI)
+        if (MMA_UNLIKELY(RC.i == 0)) {
+            division_by_zero();
+        }
+        else if (MMA_UNLIKELY(RC.i == -1)) {
+            RA.i = 0;
+        }
+        else {
+            RA.i = RB.i % RC.i;
+        }
+        VM_NEXT();
+
+    VM_CASE(ADDF) RA.f = RB.f + RC.f; VM_NEXT();
+    VM_CASE(SUBF) RA.f = RB.f - RC.f; VM_NEXT();
+    VM_CASE(MULF) RA.f = RB.f * RC.f; VM_NEXT();
+    VM_CASE(DIVF) RA.f = RB.f / RC.f; VM_NEXT();
+
+    VM_CASE(I2F) RA.f = static_cast<double>(RB.i); VM_NEXT();
+    VM_CASE(F2I) {
+        double value = RB.f;
+        if (MMA_UNLIKELY(!(value >= F2I_MIN && value < F2I_MAX))) {
+            float_range_error(value);
+        }
+        RA.i = static_cast<int64_t>(value);
+        VM_NEXT();
+    }
+
+    VM_CASE(LTI) RA.i = RB.i <  RC.i; VM_NEXT();
+    VM_CASE(LEI) RA.i = RB.i <= RC.i; VM_NEXT();
+    VM_CASE(EQI) RA.i = RB.i == RC.i; VM_NEXT();
+    VM_CASE(NEI) RA.i = RB.i != RC.i; VM_NEXT();
+    VM_CASE(LTF) RA.i = RB.f <  RC.f; VM_NEXT();
+    VM_CASE(LEF) RA.i = RB.f <= RC.f; VM_NEXT();
+
+    VM_CASE(JMP) pc += sbx_of(ii); VM_NEXT();
+    VM_CASE(JT)
+        if (RA.i) {
+            pc += sbx_of(ii);
+        }
+        VM_NEXT();
+    VM_CASE(JF)
+        if (!RA.i) {
+            pc += sbx_of(ii);
+        }
+        VM_NEXT();
+
+    VM_CASE(CSEEK) RA.i = cursor(c_of(ii))->seek(RB.i); VM_NEXT();
+    VM_CASE(CNEXT) RA.i = cursor(c_of(ii))->next_chunk(); VM_NEXT();
+    VM_CASE(CCOLI) {
+        auto span = cursor(b_of(ii))->column_i64(c_of(ii));
+        spans[a_of(ii)] = SpanReg{span.data(), span.size()};
+        VM_NEXT();
+    }
+    VM_CASE(CCOLF) {
+        auto span = cursor(b_of(ii))->column_f64(c_of(ii));
+        spans[a_of(ii)] = SpanReg{span.data(), span.size()};
+        VM_NEXT();
+    }
+
+    VM_CASE(SLEN) RA.i = SB.size; VM_NEXT();
+    VM_CASE(SGETI) {
+        int64_t idx = RC.i;
+        if (MMA_UNLIKELY(static_cast<uint64_t>(idx) >= SB.size)) {
+            span_range_error(idx, SB.size);
+        }
+        RA.i = SB.as<int64_t>()[idx];
+        VM_NEXT();
+    }
+    VM_CASE(SGETF) {
+        int64_t idx = RC.i;
+        if (MMA_UNLIKELY(static_cast<uint64_t>(idx) >= SB.size)) {
+            span_range_error(idx, SB.size);
+        }
+        RA.f = SB.as<double>()[idx];
+        VM_NEXT();
+    }
+    VM_CASE(SSUMI) {
+        const int64_t* data = SB.as<int64_t>();
+        uint64_t sum{};
+        for (size_t c = 0; c < SB.size; c++) {
+            sum += static_cast<uint64_t>(data[c]);
+        }
+        RA.i = wrap_add(RA.i, static_cast<int64_t>(sum));
+        VM_NEXT();
+    }
+    VM_CASE(SSUMF) {
+        const double* data = SB.as<double>();
+        double sum{};
+        for (size_t c = 0; c < SB.size; c++) {
+            sum += data[c];
+        }
+        RA.f += sum;
+        VM_NEXT();
+    }
+    VM_CASE(SCNTGEI) {
+        const int64_t* data = SB.as<int64_t>();
+        int64_t threshold = RC.i;
+        int64_t cnt{};
+        for (size_t c = 0; c < SB.size; c++) {
+            cnt += data[c] >= threshold;
+        }
+        RA.i = wrap_add(RA.i, cnt);
+        VM_NEXT();
+    }
+
+    VM_CASE(RET) return RA;
+
+#ifndef MEMORIA_DSL_VM_COMPUTED_GOTO
+        default:
+            MEMORIA_MAKE_GENERIC_ERROR("Unknown DSL VM opcode {}", ii & 0xFF).do_throw();
+    }
+    }
+#endif
+
+#undef VM_CASE
+#undef VM_NEXT
+#undef RA
+#undef RB
+#undef RC
+#undef SB
+}
+
+}
@@ -0,0 +1,62 @@
+// Copyright 2026 Victor Smirnov
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memoria/dsl/code/method.hpp>
+
+#include <memoria/core/hermes/hermes.hpp>
+
+namespace memoria::dsl {
+
+vm::Program Method::program() const
+{
+    auto code = object_.expect(CODE).cast_to<hermes::Array<UInteger>>();
+
+    std::vector<vm::Instruction> words;
+    words.reserve(code.size());
+    for (uint64_t c = 0; c < code.size(); c++) {
+        words.push_back(code.get(c));
+    }
+
+    std::vector<vm::Value> constants;
+    auto consts = object_.get(CONSTANTS);
+    if (consts)
+    {
+        auto array = consts.value().cast_to<hermes::Array<BigInt>>();
+        constants.reserve(array.size());
+        for (uint64_t c = 0; c < array.size(); c++) {
+            constants.push_back(vm::Value::of_int(array.get(c)));
+        }
+    }
+
+    return vm::Program(std::move(words), std::move(constants));
+}
+
+void Method::set_program(const vm::Program& program)
+{
+    auto ctr = object_.ctr();
+
+    auto code = ctr.make_array<UInteger>();
+    for (vm::Instruction ii: program.code()) {
+        code.push_back(ii);
+    }
+    object_.put(CODE, code.as_object());
+
+    auto consts = ctr.make_array<BigInt>();
+    for (vm::Value vv: program.constants()) {
+        consts.push_back(vv.i);
+    }
+    object_.put(CONSTANTS, consts.as_object());
+}
+
+}
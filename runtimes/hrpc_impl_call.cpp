@@ -86,9 +86,10 @@ void HRPCCallImpl::set_response(Response rs)
     }
 }
 
-void HRPCCallImpl::new_message(Message&& msg, ChannelCode code)
+void HRPCCallImpl::new_message(Message&& msg, ChannelCode code, uint64_t size)
 {
     if (code < input_channels_.size() && !input_channels_[code].is_null()) {
+        input_channels_[code]->message_received(size);
         input_channels_[code]->new_message(std::move(msg));
     }
 }
@@ -107,10 +108,10 @@ void HRPCCallImpl::close_channel(bool input, ChannelCode code)
     }
 }
 
-void HRPCCallImpl::reset_output_channel_buffer(ChannelCode code)
+void HRPCCallImpl::grant_output_channel_credit(ChannelCode code, uint64_t limit)
 {
     if (code < output_channels_.size() && !output_channels_[code].is_null()) {
-        output_channels_[code]->reset_buffer_size();
+        output_channels_[code]->grant_credit(limit);
     }
 }
 
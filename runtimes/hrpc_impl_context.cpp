@@ -80,17 +80,18 @@ void HRPCContextImpl::cancel_call()
     }
 }
 
-void HRPCContextImpl::new_message(Message&& msg, ChannelCode code)
+void HRPCContextImpl::new_message(Message&& msg, ChannelCode code, uint64_t size)
 {
     if (code < input_channels_.size() && !input_channels_[code].is_null()) {
+        input_channels_[code]->message_received(size);
         input_channels_[code]->new_message(std::move(msg));
     }
 }
 
-void HRPCContextImpl::reset_output_channel_buffer(ChannelCode code)
+void HRPCContextImpl::grant_output_channel_credit(ChannelCode code, uint64_t limit)
 {
     if (code < output_channels_.size() && !output_channels_[code].is_null()) {
-        output_channels_[code]->reset_buffer_size();
+        output_channels_[code]->grant_credit(limit);
     }
 }
 
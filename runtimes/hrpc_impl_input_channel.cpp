@@ -16,6 +16,8 @@
 #include <memoria/hrpc/hrpc_impl_input_channel.hpp>
 #include <memoria/hrpc/hrpc_impl_session.hpp>
 
+#include <algorithm>
+
 namespace memoria::hrpc::st {
 
 HRPCInputChannelImpl::HRPCInputChannelImpl(
@@ -28,11 +30,100 @@ HRPCInputChannelImpl::HRPCInputChannelImpl(
     session_(session), call_id_(call_id),
     channel_code_(channel_code), closed_(),
     call_side_(call_side),
-    batch_size_limit_(batch_size_limit)
+    batch_size_limit_(batch_size_limit),
+    max_window_(std::max(batch_size_limit, session->max_channel_buffer_size())),
+    window_(batch_size_limit),
+    credit_limit_(batch_size_limit),
+    last_grant_time_(Clock::now())
 {}
 
 PoolSharedPtr<Session> HRPCInputChannelImpl::session() {
     return session_;
 }
 
+void HRPCInputChannelImpl::message_received(uint64_t size)
+{
+    received_ += size;
+    message_sizes_.push_back(size);
+
+    stats_.messages++;
+    stats_.bytes += size;
+
+    if (rtt_probe_ && received_ > rtt_probe_limit_)
+    {
+        int64_t sample = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            Clock::now() - rtt_probe_time_
+        ).count();
+
+        srtt_ns_ = srtt_ns_ ? (srtt_ns_ * 7 + sample) / 8 : sample;
+        rtt_probe_ = false;
+    }
+}
+
+void HRPCInputChannelImpl::message_consumed()
+{
+    if (message_sizes_.empty()) {
+        return;
+    }
+
+    consumed_ += message_sizes_.front();
+    message_sizes_.pop_front();
+
+    if (consumed_ + window_ / 2 >= credit_limit_) {
+        grant_credit();
+    }
+}
+
+void HRPCInputChannelImpl::grant_credit()
+{
+    auto now = Clock::now();
+    tune_window(now);
+
+    // If the sender has used up its credit, it's waiting for this
+    // grant, and the first byte past the current limit will arrive
+    // one round trip later.
+    if (received_ >= credit_limit_ && !rtt_probe_)
+    {
+        rtt_probe_ = true;
+        rtt_probe_limit_ = credit_limit_;
+        rtt_probe_time_ = now;
+    }
+
+    credit_limit_ = consumed_ + window_;
+    last_grant_time_ = now;
+    consumed_at_last_grant_ = consumed_;
+
+    stats_.credit_grants++;
+    session_->grant_channel_credit(call_id_, channel_code_, call_side_, credit_limit_);
+}
+
+void HRPCInputChannelImpl::tune_window(Clock::time_point now)
+{
+    int64_t interval = std::chrono::duration_cast<std::chrono::nanoseconds>(now - last_grant_time_).count();
+    if (interval > 0)
+    {
+        double rate = (consumed_ - consumed_at_last_grant_) / static_cast<double>(interval);
+        drain_rate_ = drain_rate_ > 0 ? (drain_rate_ * 7 + rate) / 8 : rate;
+    }
+
+    if (srtt_ns_ > 0 && window_ < max_window_)
+    {
+        // The window should cover two round trips of draining. Grants
+        // following each other faster than that mean the window, not
+        // the consumer, is what limits the stream.
+        uint64_t target = static_cast<uint64_t>(drain_rate_ * srtt_ns_ * 2);
+        if (target > window_ || interval < 2 * srtt_ns_) {
+            window_ = std::min(max_window_, std::max(target, window_ * 2));
+        }
+    }
+}
+
+InputChannelStats HRPCInputChannelImpl::stats()
+{
+    InputChannelStats stats = stats_;
+    stats.window = window_;
+    stats.rtt_ns = srtt_ns_;
+    return stats;
+}
+
 }
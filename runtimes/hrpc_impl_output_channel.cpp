@@ -16,6 +16,8 @@
 #include <memoria/hrpc/hrpc_impl_session.hpp>
 #include <memoria/hrpc/hrpc_impl_output_channel.hpp>
 
+#include <chrono>
+
 
 namespace memoria::hrpc::st {
 
@@ -31,7 +33,8 @@ HRPCOutputChannelImpl::HRPCOutputChannelImpl(
     code_(code),
     closed_(),
     call_side_(call_side),
-    batch_size_limit_(batch_size_limit)
+    batch_size_limit_(batch_size_limit),
+    credit_limit_(batch_size_limit)
 {}
 
 
@@ -43,13 +46,23 @@ void HRPCOutputChannelImpl::push(const Message& msg)
 {
     if (!closed_)
     {
-        if (batch_size_ >= batch_size_limit_)
+        if (!has_credit())
         {
+            auto t0 = std::chrono::steady_clock::now();
             wait_for_lease();
+
+            stats_.stalls++;
+            stats_.stall_time_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - t0
+            ).count();
+
+            if (closed_) {
+                return;
+            }
         }
 
         MessageType msg_type = call_side_ ? MessageType::CALL_CHANNEL_MESSAGE : MessageType::CONTEXT_CHANNEL_MESSAGE;
-        batch_size_ += session_->send_message(
+        size_t size = session_->send_message(
             msg.object().ctr(),
             [&](MessageHeader& header){
                 header.set_message_type(msg_type);
@@ -57,6 +70,10 @@ void HRPCOutputChannelImpl::push(const Message& msg)
                 header.set_channel_code(code_);
             }
         );
+
+        sent_ += size;
+        stats_.messages++;
+        stats_.bytes += size;
     }
     else {
         MEMORIA_MAKE_GENERIC_ERROR("Channel {} for {} has been closed", code_, call_id_);
@@ -80,12 +97,23 @@ void HRPCOutputChannelImpl::close()
 
 void HRPCOutputChannelImpl::do_close_channel() {
     closed_ = true;
-    reset_buffer_size();
+    notify_lease_ready();
 }
 
-void HRPCOutputChannelImpl::reset_buffer_size() {
-    batch_size_ = 0;
-    notify_lease_ready();
+void HRPCOutputChannelImpl::grant_credit(uint64_t limit)
+{
+    if (limit > credit_limit_)
+    {
+        credit_limit_ = limit;
+        notify_lease_ready();
+    }
+}
+
+OutputChannelStats HRPCOutputChannelImpl::stats()
+{
+    OutputChannelStats stats = stats_;
+    stats.credit_limit = credit_limit_;
+    return stats;
 }
 
 
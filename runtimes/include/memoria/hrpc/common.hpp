@@ -66,7 +66,7 @@ public:
     }
 };
 
-constexpr ProtocolVersion PROTOCOL_VERSION = ProtocolVersion(1);
+constexpr ProtocolVersion PROTOCOL_VERSION = ProtocolVersion(2);
 
 enum class SessionSide: uint8_t {
     CLIENT, SERVER
@@ -84,8 +84,8 @@ enum class MessageType: uint8_t {
     CONTEXT_CLOSE_INPUT_CHANNEL,
     CALL_CLOSE_OUTPUT_CHANNEL,
     CONTEXT_CLOSE_OUTPUT_CHANNEL,
-    CALL_CHANNEL_BUFFER_RESET,
-    CONTEXT_CHANNEL_BUFFER_RESET,
+    CALL_CHANNEL_CREDIT,
+    CONTEXT_CHANNEL_CREDIT,
     CANCEL_CALL
 };
 
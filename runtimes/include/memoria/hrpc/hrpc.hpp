@@ -36,6 +36,12 @@ public:
     virtual void remove_handler(const EndpointID& endpoint_id) = 0;
     virtual Optional<RequestHandlerFn> get_handler(const EndpointID& endpoint_id) = 0;
 
+    // Expected maximal stack depth of the endpoint's handler, in bytes.
+    // Runtimes with stackful handlers may use it to pick a smaller stack.
+    // Zero means runtime's default.
+    virtual void set_stack_size(const EndpointID& endpoint_id, size_t size) = 0;
+    virtual size_t stack_size(const EndpointID& endpoint_id) = 0;
+
     static PoolSharedPtr<EndpointRepository> make();
 };
 
@@ -48,6 +54,29 @@ public:
 };
 
 
+struct OutputChannelStats {
+    uint64_t messages{};
+    uint64_t bytes{};
+    uint64_t credit_limit{};
+
+    // Pushes blocked waiting for flow control credit
+    // and the total time spent in them.
+    uint64_t stalls{};
+    int64_t stall_time_ns{};
+};
+
+struct InputChannelStats {
+    uint64_t messages{};
+    uint64_t bytes{};
+    uint64_t credit_grants{};
+
+    // Current receive window and the smoothed round trip
+    // time it's tuned for, zero if not measured yet.
+    uint64_t window{};
+    int64_t rtt_ns{};
+};
+
+
 class OutputChannel {
 public:
     virtual ~OutputChannel() noexcept = default;
@@ -59,6 +88,8 @@ public:
     virtual void push(const Message& msg) = 0;
     virtual void close() = 0;
     virtual bool is_closed() = 0;
+
+    virtual OutputChannelStats stats() = 0;
 };
 
 
@@ -74,6 +105,8 @@ public:
     virtual void close() = 0;
 
     virtual bool pop(Message& msg) = 0;
+
+    virtual InputChannelStats stats() = 0;
 };
 
 
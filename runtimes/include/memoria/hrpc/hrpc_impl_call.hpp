@@ -106,14 +106,14 @@ public:
         }
     }
 
-    void new_message(Message&& msg, ChannelCode code);
+    void new_message(Message&& msg, ChannelCode code, uint64_t size);
     void close_channel(bool input, ChannelCode code);
 
     void close_channels() {
         MEMORIA_MAKE_GENERIC_ERROR("Call::close_channels() is not implemented").do_throw();
     }
 
-    void reset_output_channel_buffer(ChannelCode code);
+    void grant_output_channel_credit(ChannelCode code, uint64_t limit);
 
 protected:
     virtual InputChannelImplPtr make_input_channel(ChannelCode code) = 0;
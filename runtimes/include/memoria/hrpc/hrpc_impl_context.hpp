@@ -95,13 +95,13 @@ public:
         return endpoint_id_;
     }
 
-    void new_message(Message&& msg, ChannelCode code);
+    void new_message(Message&& msg, ChannelCode code, uint64_t size);
 
     void close_channel(bool input, ChannelCode code);
 
     void cancel_call();
 
-    void reset_output_channel_buffer(ChannelCode code);
+    void grant_output_channel_credit(ChannelCode code, uint64_t limit);
 
 
     bool is_cancelled() override {
@@ -27,6 +27,7 @@ class HRPCEndpointRepositoryImpl final:
         public pool::enable_shared_from_this<HRPCEndpointRepositoryImpl>
 {
     ska::flat_hash_map<EndpointID, RequestHandlerFn> handlers_;
+    ska::flat_hash_map<EndpointID, size_t> stack_sizes_;
 
 public:
     HRPCEndpointRepositoryImpl() {}
@@ -37,6 +38,21 @@ public:
 
     void remove_handler(const EndpointID& endpoint_id) override {
         handlers_.erase(endpoint_id);
+        stack_sizes_.erase(endpoint_id);
+    }
+
+    void set_stack_size(const EndpointID& endpoint_id, size_t size) override {
+        stack_sizes_[endpoint_id] = size;
+    }
+
+    size_t stack_size(const EndpointID& endpoint_id) override
+    {
+        auto ii = stack_sizes_.find(endpoint_id);
+        if (ii != stack_sizes_.end()) {
+            return ii->second;
+        }
+
+        return 0;
     }
 
     Optional<RequestHandlerFn> get_handler(const EndpointID& endpoint_id) override
@@ -18,6 +18,8 @@
 
 #include <memoria/hrpc/hrpc_impl_common.hpp>
 
+#include <chrono>
+#include <deque>
 #include <list>
 
 namespace memoria::hrpc::st {
@@ -33,8 +35,35 @@ protected:
     bool closed_;
     bool call_side_;
 
-    uint64_t batch_size_{};
+    using Clock = std::chrono::steady_clock;
+
+    // Credit-based flow control. The receiver grants the sender an
+    // absolute limit of bytes it may send, renewing it when half of the
+    // window has been consumed, so the sender isn't stalled while the
+    // consumer keeps up. The window starts at the negotiated channel
+    // buffer size and grows up to the session's maximum when the
+    // measured drain rate times RTT exceeds it.
     uint64_t batch_size_limit_;
+    uint64_t max_window_;
+    uint64_t window_;
+
+    uint64_t received_{};
+    uint64_t consumed_{};
+    uint64_t credit_limit_;
+
+    // Sizes of received but not yet consumed messages, in order
+    std::deque<uint64_t> message_sizes_;
+
+    Clock::time_point last_grant_time_;
+    uint64_t consumed_at_last_grant_{};
+    double drain_rate_{}; // bytes per ns
+
+    bool rtt_probe_{};
+    uint64_t rtt_probe_limit_{};
+    Clock::time_point rtt_probe_time_;
+    int64_t srtt_ns_{};
+
+    InputChannelStats stats_{};
 
 public:
     HRPCInputChannelImpl(
@@ -53,7 +82,21 @@ public:
 
     virtual void new_message(Message&& msg) = 0;
     virtual void do_close_channel() = 0;
+
+    // Accounts a message of the given wire size, called
+    // before it's handed over to new_message().
+    void message_received(uint64_t size);
+
+    InputChannelStats stats() override;
+
+protected:
+    // Accounts the oldest received message as consumed,
+    // runtimes call it on each successful pop().
+    void message_consumed();
+
 private:
+    void grant_credit();
+    void tune_window(Clock::time_point now);
 };
 
 }
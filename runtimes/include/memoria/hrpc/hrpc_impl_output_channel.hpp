@@ -31,7 +31,13 @@ protected:
     bool call_side_;
 
     uint64_t batch_size_limit_{};
-    uint64_t batch_size_{};
+
+    // Total size of messages sent and the credit limit
+    // granted by the receiver for this channel.
+    uint64_t sent_{};
+    uint64_t credit_limit_{};
+
+    OutputChannelStats stats_{};
 
 public:
     HRPCOutputChannelImpl(
@@ -60,7 +66,15 @@ public:
 
     void do_close_channel();
 
-    void reset_buffer_size();
+    // Credit limits are absolute, so grants reordered
+    // or repeated can't extend the window by mistake.
+    void grant_credit(uint64_t limit);
+
+    bool has_credit() const {
+        return sent_ < credit_limit_ || closed_;
+    }
+
+    OutputChannelStats stats() override;
 };
 
 }
@@ -26,6 +26,8 @@
 
 #include <boost/exception/exception.hpp>
 
+#include <algorithm>
+
 namespace memoria::hrpc::st {
 
 class HRPCSessionBase: public Session {
@@ -83,6 +85,13 @@ public:
     virtual void wait_for_negotiation() = 0;
     virtual void notify_negotiated() = 0;
     virtual void run_async(std::function<void()> fn) = 0;
+
+    // Runs endpoint's handler. Runtimes with stackful handlers
+    // may use the stack size hint, see EndpointRepository::stack_size().
+    virtual void run_handler_async(std::function<void()> fn, size_t stack_size) {
+        run_async(fn);
+    }
+
     virtual void write_message(const MessageHeader& header, const uint8_t* data) = 0;
     virtual bool is_transport_closed() = 0;
 
@@ -108,6 +117,10 @@ public:
         return channel_buffer_size_;
     }
 
+    uint64_t max_channel_buffer_size() const {
+        return std::max(config_.max_channel_buffer_size(), channel_buffer_size_);
+    }
+
     PoolSharedPtr<EndpointRepository> endpoints() override {
         return endpoints_;
     }
@@ -221,12 +234,12 @@ public:
             handle_return(*header, std::move(msg));
             break;
         }
-        case MessageType::CALL_CHANNEL_BUFFER_RESET: {
-            handle_call_stream_buffer_reset(*header);
+        case MessageType::CALL_CHANNEL_CREDIT: {
+            handle_call_stream_credit(*header, std::move(msg));
             break;
         }
-        case MessageType::CONTEXT_CHANNEL_BUFFER_RESET: {
-            handle_context_stream_buffer_reset(*header);
+        case MessageType::CONTEXT_CHANNEL_CREDIT: {
+            handle_context_stream_credit(*header, std::move(msg));
             break;
         }
         }
@@ -310,17 +323,20 @@ public:
     }
 
 
-    void unblock_output_channel(CallID call_id, ChannelCode code, bool call_side)
+    void grant_channel_credit(CallID call_id, ChannelCode code, bool call_side, uint64_t limit)
     {
         MessageType type;
         if (call_side) {
-            type = MessageType::CALL_CHANNEL_BUFFER_RESET;
+            type = MessageType::CALL_CHANNEL_CREDIT;
         }
         else {
-            type = MessageType::CONTEXT_CHANNEL_BUFFER_RESET;
+            type = MessageType::CONTEXT_CHANNEL_CREDIT;
         }
 
-        send_message([&](MessageHeader& header){
+        ChannelCredit credit(hermes::HermesCtr::make_pooled());
+        credit.set_limit(limit);
+
+        send_message(credit.object().ctr(), [&](MessageHeader& header){
             header.set_message_type(type);
             header.set_call_id(call_id);
             header.set_channel_code(code);
@@ -358,7 +374,7 @@ protected:
             auto ptr = ii->second.lock();
             if (!ptr.is_null()) {
                 Message rq(msg.root().value().as_tiny_object_map());
-                ptr->new_message(std::move(rq), header.channel_code());
+                ptr->new_message(std::move(rq), header.channel_code(), header.message_size());
             }
             else {
                 calls_.erase(header.call_id());
@@ -371,7 +387,7 @@ protected:
         auto ctx = context(header.call_id());
         if (!ctx.is_null()) {
             Message rq(msg.root().value().as_tiny_object_map());
-            ctx->new_message(std::move(rq), header.channel_code());
+            ctx->new_message(std::move(rq), header.channel_code(), header.message_size());
         }
     }
 
@@ -394,22 +410,24 @@ protected:
         }
     }
 
-    void handle_context_stream_buffer_reset(const MessageHeader& header)
+    void handle_context_stream_credit(const MessageHeader& header, hermes::HermesCtr&& msg)
     {
         auto ii = calls_.find(header.call_id());
         if (ii != calls_.end()) {
             auto ptr = ii->second.lock();
             if (!ptr.is_null()) {
-                ptr->reset_output_channel_buffer(header.channel_code());
+                ChannelCredit credit(msg.root().value().as_tiny_object_map());
+                ptr->grant_output_channel_credit(header.channel_code(), credit.limit());
             }
         }
     }
 
-    void handle_call_stream_buffer_reset(const MessageHeader& header)
+    void handle_call_stream_credit(const MessageHeader& header, hermes::HermesCtr&& msg)
     {
         auto ii = contexts_.find(header.call_id());
         if (ii != contexts_.end()) {
-            ii->second->reset_output_channel_buffer(header.channel_code());
+            ChannelCredit credit(msg.root().value().as_tiny_object_map());
+            ii->second->grant_output_channel_credit(header.channel_code(), credit.limit());
         }
     }
 
@@ -520,7 +538,7 @@ protected:
             {
                 ctx = make_context(header.call_id(), endpoint_id, rq);
                 contexts_[header.call_id()] = ctx;
-                run_handler(handler.value(), ctx, header.call_id());
+                run_handler(handler.value(), ctx, header.call_id(), endpoints_->stack_size(endpoint_id));
             }
             else {
                 Response rs = Response::error0();
@@ -545,9 +563,9 @@ protected:
     };
     friend struct CtxCleaner;
 
-    void run_handler(RequestHandlerFn handler, const ContextImplPtr& ctx, CallID call_id)
+    void run_handler(RequestHandlerFn handler, const ContextImplPtr& ctx, CallID call_id, size_t stack_size)
     {
-        run_async([=, this](){
+        run_handler_async([=, this](){
             CtxCleaner cleaner{self(), call_id};
             try {
                 Response rs = handler(ctx);
@@ -600,7 +618,7 @@ protected:
                 error.set_description(boost::current_exception_diagnostic_information());
                 send_response(rs, call_id);
             }
-        });
+        }, stack_size);
     }
 
     void send_response(Response rs, CallID call_id)
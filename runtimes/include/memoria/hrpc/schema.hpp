@@ -450,6 +450,32 @@ public:
 };
 
 
+// Flow control credit for a streaming channel: the sender may send
+// messages while the total size of the messages sent is below the limit.
+class ChannelCredit: public hermes::TinyObjectBase {
+public:
+    static constexpr NamedCode LIMIT = NamedCode(1, "limit");
+
+    ChannelCredit() {}
+
+    ChannelCredit(hermes::TinyObjectMap&& object):
+        hermes::TinyObjectBase(std::move(object))
+    {}
+
+    ChannelCredit(hermes::HermesCtr&& ctr):
+        hermes::TinyObjectBase(std::move(ctr))
+    {}
+
+    uint64_t limit() const {
+        return object_.expect(LIMIT).cast_to<UBigInt>();
+    }
+
+    void set_limit(uint64_t limit) {
+        object_.put(LIMIT, limit);
+    }
+};
+
+
 class ConnectionMetadata: public hermes::TinyObjectBase {
 
 public:
@@ -483,6 +509,10 @@ public:
     static constexpr NamedCode CHANNEL_BUFFER_SIZE = NamedCode(1, "channel_buffer_size");
     static constexpr uint64_t  CHANNEL_BUFFER_SIZE_DEFAULT = 1024*1024; // 1MB
 
+    // Upper bound for auto-tuned receive windows of channels
+    static constexpr NamedCode MAX_CHANNEL_BUFFER_SIZE = NamedCode(4, "max_channel_buffer_size");
+    static constexpr uint64_t  MAX_CHANNEL_BUFFER_SIZE_DEFAULT = 16*1024*1024; // 16MB
+
     ProtocolConfig() {}
     ProtocolConfig(hermes::TinyObjectMap map):
         hermes::TinyObjectBase(std::move(map))
@@ -505,6 +535,20 @@ public:
     void set_channel_buffer_size(uint64_t size) {
         object_.put(CHANNEL_BUFFER_SIZE, size);
     }
+
+    uint64_t max_channel_buffer_size() const
+    {
+        auto val = object_.get(MAX_CHANNEL_BUFFER_SIZE);
+        if (val) {
+            return val->cast_to<UBigInt>();
+        }
+
+        return MAX_CHANNEL_BUFFER_SIZE_DEFAULT;
+    }
+
+    void set_max_channel_buffer_size(uint64_t size) {
+        object_.put(MAX_CHANNEL_BUFFER_SIZE, size);
+    }
 };
 
 class TCPProtocolConfig: public ProtocolConfig {
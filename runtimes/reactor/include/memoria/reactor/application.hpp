@@ -96,11 +96,14 @@ class Application final: protected ApplicationInit {
     static Application* application_;
     
     bool debug_{};
+    bool fiber_stack_probe_{};
+    bool work_stealing_{};
 
     std::vector<U8String> args_;
 	Environment env_;
 
     uint64_t iopoll_timeout_{10}; // 10 ms
+    uint64_t task_quota_us_{500};
 
     uint32_t threads_{1};
 
@@ -132,6 +135,12 @@ public:
         iopoll_timeout_ = value_ms;
     }
 
+    // Time a scheduling group may run before other groups are considered
+    uint64_t task_quota_us() const {return task_quota_us_;}
+    void set_task_quota_us(uint64_t value_us) {
+        task_quota_us_ = value_us;
+    }
+
     void start_engines();
 
 
@@ -153,6 +162,14 @@ public:
     bool is_debug() const {
         return debug_;
     }
+
+    bool is_fiber_stack_probe() const {
+        return fiber_stack_probe_;
+    }
+
+    bool is_work_stealing() const {
+        return work_stealing_;
+    }
     
     template<typename Fn, typename... Args> 
     auto run(Fn&& fn, Args&&... args) 
@@ -199,6 +216,9 @@ public:
             ("help,h", "Prints command line switches")
             ("threads,t", boost::program_options::value<uint32_t>()->default_value(1), "Specifies number of threads to use")
             ("debug,d", boost::program_options::value<bool>()->default_value(false), "Enable debug output")
+            ("fiber-stack-probe", boost::program_options::value<bool>()->default_value(false), "Track and report fiber stack usage watermarks")
+            ("work-stealing", boost::program_options::value<bool>()->default_value(false), "Let idle reactors run migratable fibers and messages of busy ones")
+            ("task-quota", boost::program_options::value<uint64_t>()->default_value(500), "Scheduling group task quota, in microseconds")
             ("io-timeout", boost::program_options::value<uint64_t>()->default_value(20), "Event poller timeout value, in milliseconds.");
     }
     
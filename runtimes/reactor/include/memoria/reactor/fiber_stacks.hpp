@@ -0,0 +1,133 @@
+
+// Copyright 2026 Victor Smirnov
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memoria/reactor/protected_stack_pool.hpp>
+
+#include <array>
+
+namespace memoria {
+namespace reactor {
+
+// Stack size classes for fibers spawned by the reactor. DEFAULT is the
+// legacy 16MB stack, smaller classes are for handlers with known shallow
+// call depth (e.g. HRPC endpoints), so that tens of thousands of them can
+// be alive at the same time.
+enum class FiberStackClass: uint8_t {
+    SMALL = 0, MEDIUM, LARGE, DEFAULT
+};
+
+class FiberStackPools {
+public:
+    static constexpr size_t CLASSES = 4;
+
+private:
+    using Pool = memoria::fibers::protected_stack_pool;
+
+    std::array<Pool, CLASSES> pools_;
+
+public:
+    FiberStackPools():
+        pools_{
+            Pool{64,  1024, stack_size(FiberStackClass::SMALL)},
+            Pool{32,  256,  stack_size(FiberStackClass::MEDIUM)},
+            Pool{16,  64,   stack_size(FiberStackClass::LARGE)},
+            Pool{8,   16,   stack_size(FiberStackClass::DEFAULT)}
+        }
+    {}
+
+    static constexpr size_t stack_size(FiberStackClass cls)
+    {
+        switch (cls) {
+            case FiberStackClass::SMALL:  return 64 * 1024;
+            case FiberStackClass::MEDIUM: return 256 * 1024;
+            case FiberStackClass::LARGE:  return 1024 * 1024;
+            default: return 16 * 1024 * 1024;
+        }
+    }
+
+    // The smallest class that fits the requested stack size,
+    // DEFAULT for zero (no preference).
+    static constexpr FiberStackClass for_size(size_t size)
+    {
+        if (size == 0) {
+            return FiberStackClass::DEFAULT;
+        }
+
+        for (size_t c = 0; c < CLASSES - 1; c++)
+        {
+            auto cls = static_cast<FiberStackClass>(c);
+            if (size <= stack_size(cls)) {
+                return cls;
+            }
+        }
+
+        return FiberStackClass::DEFAULT;
+    }
+
+    static const char* name(FiberStackClass cls)
+    {
+        switch (cls) {
+            case FiberStackClass::SMALL:  return "SMALL";
+            case FiberStackClass::MEDIUM: return "MEDIUM";
+            case FiberStackClass::LARGE:  return "LARGE";
+            default: return "DEFAULT";
+        }
+    }
+
+    Pool& pool(FiberStackClass cls) {
+        return pools_[static_cast<size_t>(cls)];
+    }
+
+    const Pool& pool(FiberStackClass cls) const {
+        return pools_[static_cast<size_t>(cls)];
+    }
+
+    memoria::fibers::stack_pool_stats stats(FiberStackClass cls) const {
+        return pool(cls).stats();
+    }
+
+    void set_probe(bool probe)
+    {
+        for (auto& pool: pools_) {
+            pool.set_probe(probe);
+        }
+    }
+
+    bool probe() const {
+        return pools_[0].probe();
+    }
+
+    size_t trim()
+    {
+        size_t released{};
+        for (auto& pool: pools_) {
+            released += pool.trim();
+        }
+        return released;
+    }
+
+    template <typename Fn>
+    void for_each(Fn&& fn) const
+    {
+        for (size_t c = 0; c < CLASSES; c++) {
+            auto cls = static_cast<FiberStackClass>(c);
+            fn(cls, stats(cls));
+        }
+    }
+};
+
+}}
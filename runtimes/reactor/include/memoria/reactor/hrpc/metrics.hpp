@@ -0,0 +1,32 @@
+// Copyright 2026 Victor Smirnov
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memoria/hrpc/hrpc.hpp>
+#include <memoria/core/tools/uid_256.hpp>
+
+namespace memoria::reactor::hrpc {
+
+using namespace memoria::hrpc;
+
+// Returns an array of per-reactor metrics: counters, stack pool usage
+// and count/mean/p50/p90/p99/p999/max of the latency histograms, in ns.
+constexpr UID256 REACTOR_METRICS_ENDPOINT = UID256{3883021225793989539ull, 3696186814801552778ull, 803115059717783275ull, 108422686021578818ull};
+
+Response reactor_metrics_handler(PoolSharedPtr<st::Context> context);
+
+void add_reactor_metrics_endpoint(const PoolSharedPtr<st::EndpointRepository>& endpoints);
+
+}
@@ -44,7 +44,7 @@ public:
     void wait_for_lease() {
         std::unique_lock<boost::fibers::mutex> lock(mutex_);
         flow_control_.wait(lock, [&](){
-            return batch_size_ >= batch_size_limit_;
+            return has_credit();
         });
     }
 
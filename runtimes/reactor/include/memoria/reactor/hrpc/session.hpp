@@ -19,6 +19,7 @@
 
 #include <memoria/reactor/hrpc/call.hpp>
 #include <memoria/reactor/hrpc/context.hpp>
+#include <memoria/reactor/reactor.hpp>
 
 
 #include <boost/fiber/condition_variable.hpp>
@@ -62,6 +63,16 @@ public:
         boost::fibers::fiber(fn).detach();
     }
 
+    void run_handler_async(std::function<void()> fn, size_t stack_size) override
+    {
+        if (stack_size) {
+            reactor::in_fiber(FiberStackPools::for_size(stack_size), fn).detach();
+        }
+        else {
+            run_async(fn);
+        }
+    }
+
     st::SessionImplPtr self() override {
         return this->shared_from_this();
     }
@@ -18,6 +18,9 @@
 #include <memoria/core/memory/shared_ptr.hpp>
 #include <memoria/core/tools/type_name.hpp>
 
+#include <memoria/reactor/fiber_stacks.hpp>
+#include <memoria/reactor/scheduling_group.hpp>
+
 #include <boost/fiber/context.hpp>
 
 #include <boost/pool/object_pool.hpp>
@@ -39,6 +42,15 @@ protected:
     bool return_: 1;
     //bool ow_chainable_: 1;
     bool run_in_fiber_: 1;
+    // May be processed by a reactor other than the one
+    // it has been sent to, when work stealing is enabled.
+    bool migratable_: 1;
+
+    FiberStackClass stack_class_{FiberStackClass::DEFAULT};
+    SchedulingGroup scheduling_group_{};
+
+    // Time the message has been sent at, for queue delay metrics
+    uint64_t sent_ns_{};
 
     void* data_{};
 
@@ -48,7 +60,8 @@ public:
     Message(int cpu, bool one_way):
         one_way_(one_way),
         return_(false),
-        run_in_fiber_(false)
+        run_in_fiber_(false),
+        migratable_(false)
     {
         this->owner_cpu_ = cpu;
     }
@@ -63,6 +76,19 @@ public:
     //bool is_ow_chainable() const {return ow_chainable_;}
     bool is_run_in_fiber() const {return run_in_fiber_;}
 
+    bool is_migratable() const {return migratable_;}
+    void set_migratable(bool value) {migratable_ = value;}
+
+    FiberStackClass stack_class() const {return stack_class_;}
+    void set_stack_class(FiberStackClass cls) {stack_class_ = cls;}
+
+    // Group of the fiber processing the message
+    SchedulingGroup scheduling_group() const {return scheduling_group_;}
+    void set_scheduling_group(SchedulingGroup group) {scheduling_group_ = group;}
+
+    uint64_t sent_ns() const {return sent_ns_;}
+    void set_sent_ns(uint64_t ns) {sent_ns_ = ns;}
+
     void* data() const {return data_;}
     
     void set_data(void* custom_data) {data_ = custom_data;}
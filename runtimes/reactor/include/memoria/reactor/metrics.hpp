@@ -0,0 +1,270 @@
+// Copyright 2026 Victor Smirnov
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memoria/reactor/fiber_stacks.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace memoria {
+namespace reactor {
+
+inline uint64_t metrics_now_ns() noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()
+    ).count();
+}
+
+// Counter updated by its reactor only and read by anyone.
+class MetricCounter {
+    std::atomic<uint64_t> value_{};
+public:
+    void inc(uint64_t delta = 1) noexcept {
+        value_.store(value_.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+    }
+
+    void set(uint64_t value) noexcept {
+        value_.store(value, std::memory_order_relaxed);
+    }
+
+    uint64_t value() const noexcept {
+        return value_.load(std::memory_order_relaxed);
+    }
+};
+
+// Point-in-time copy of a LatencyHistogram. Snapshots of
+// several reactors can be merged.
+struct HistogramSnapshot {
+    std::vector<uint64_t> buckets;
+    uint64_t count{};
+    uint64_t sum{};
+    uint64_t max{};
+
+    double mean() const {
+        return count ? static_cast<double>(sum) / count : 0.0;
+    }
+
+    // Upper bound of the bucket the value at the
+    // percentile (0..1) falls into.
+    uint64_t percentile(double p) const;
+
+    void merge(const HistogramSnapshot& other);
+};
+
+// Log-linear histogram of values in nanoseconds, in the spirit of
+// HdrHistogram. Each power of two is split into SUB_BUCKETS linear
+// sub-buckets, so the relative error is below 1/SUB_BUCKETS. It has
+// one writer, the owning reactor, and lock-free readers: buckets are
+// updated with relaxed stores, so a snapshot taken while recording
+// may be off by a few values, but never torn.
+class LatencyHistogram {
+public:
+    static constexpr size_t SUB_BITS    = 4;
+    static constexpr size_t SUB_BUCKETS = size_t(1) << SUB_BITS;
+    static constexpr size_t BUCKETS     = (64 - SUB_BITS + 1) * SUB_BUCKETS;
+
+private:
+    std::array<std::atomic<uint64_t>, BUCKETS> buckets_{};
+    std::atomic<uint64_t> count_{};
+    std::atomic<uint64_t> sum_{};
+    std::atomic<uint64_t> max_{};
+
+public:
+    static size_t bucket_of(uint64_t value) noexcept
+    {
+        if (value < SUB_BUCKETS) {
+            return value;
+        }
+
+        size_t msb = 63 - __builtin_clzll(value);
+        size_t shift = msb - SUB_BITS;
+        return (shift + 1) * SUB_BUCKETS + ((value >> shift) & (SUB_BUCKETS - 1));
+    }
+
+    // The largest value that falls into the bucket
+    static uint64_t bucket_upper_bound(size_t bucket) noexcept
+    {
+        if (bucket < SUB_BUCKETS) {
+            return bucket;
+        }
+
+        size_t shift = bucket / SUB_BUCKETS - 1;
+        uint64_t sub = bucket % SUB_BUCKETS;
+        uint64_t lower = (SUB_BUCKETS + sub) << shift;
+        return lower + ((uint64_t(1) << shift) - 1);
+    }
+
+    void record(uint64_t value) noexcept
+    {
+        auto& bucket = buckets_[bucket_of(value)];
+        bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+        count_.store(count_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        sum_.store(sum_.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+
+        if (value > max_.load(std::memory_order_relaxed)) {
+            max_.store(value, std::memory_order_relaxed);
+        }
+    }
+
+    HistogramSnapshot snapshot() const
+    {
+        HistogramSnapshot snp;
+        snp.buckets.resize(BUCKETS);
+
+        for (size_t c = 0; c < BUCKETS; c++) {
+            snp.buckets[c] = buckets_[c].load(std::memory_order_relaxed);
+            snp.count += snp.buckets[c];
+        }
+
+        snp.sum = sum_.load(std::memory_order_relaxed);
+        snp.max = max_.load(std::memory_order_relaxed);
+        return snp;
+    }
+};
+
+inline uint64_t HistogramSnapshot::percentile(double p) const
+{
+    if (!count) {
+        return 0;
+    }
+
+    uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(p * count + 0.5));
+
+    uint64_t seen{};
+    for (size_t c = 0; c < buckets.size(); c++)
+    {
+        seen += buckets[c];
+        if (seen >= rank) {
+            return std::min(LatencyHistogram::bucket_upper_bound(c), max);
+        }
+    }
+
+    return max;
+}
+
+inline void HistogramSnapshot::merge(const HistogramSnapshot& other)
+{
+    if (buckets.size() < other.buckets.size()) {
+        buckets.resize(other.buckets.size());
+    }
+
+    for (size_t c = 0; c < other.buckets.size(); c++) {
+        buckets[c] += other.buckets[c];
+    }
+
+    count += other.count;
+    sum += other.sum;
+    max = std::max(max, other.max);
+}
+
+
+struct StackPoolMetricsSnapshot {
+    uint64_t allocations;
+    uint64_t live;
+    uint64_t peak_live;
+    uint64_t pooled;
+};
+
+struct ReactorMetricsSnapshot {
+    int cpu;
+
+    HistogramSnapshot queue_delay;
+    HistogramSnapshot fiber_run_time;
+    HistogramSnapshot io_latency;
+    HistogramSnapshot poll_iteration;
+
+    uint64_t messages;
+    uint64_t returns;
+    uint64_t io_events;
+    uint64_t fibers_started;
+
+    std::array<StackPoolMetricsSnapshot, FiberStackPools::CLASSES> stack_pools;
+};
+
+// Always-on metrics of a reactor. Written by the reactor's thread
+// only, readable from any thread without stopping the reactor.
+struct ReactorMetrics {
+    // From sending a message to the start of its processing
+    LatencyHistogram queue_delay;
+    // Time a fiber runs before it yields or suspends
+    LatencyHistogram fiber_run_time;
+    // From submitting a file I/O operation to resuming the waiting fiber
+    LatencyHistogram io_latency;
+    // One iteration of the event loop, including running ready fibers
+    LatencyHistogram poll_iteration;
+
+    MetricCounter messages;
+    MetricCounter returns;
+    MetricCounter io_events;
+    MetricCounter fibers_started;
+
+    struct StackPool {
+        MetricCounter allocations;
+        MetricCounter live;
+        MetricCounter peak_live;
+        MetricCounter pooled;
+    };
+
+    // Published by the reactor periodically, the pools
+    // themselves are not thread-safe.
+    std::array<StackPool, FiberStackPools::CLASSES> stack_pools;
+
+    void publish(const FiberStackPools& pools)
+    {
+        pools.for_each([&](FiberStackClass cls, const memoria::fibers::stack_pool_stats& stats){
+            auto& pool = stack_pools[static_cast<size_t>(cls)];
+            pool.allocations.set(stats.allocations);
+            pool.live.set(stats.live);
+            pool.peak_live.set(stats.peak_live);
+            pool.pooled.set(stats.pooled);
+        });
+    }
+
+    ReactorMetricsSnapshot snapshot(int cpu) const
+    {
+        ReactorMetricsSnapshot snp;
+        snp.cpu = cpu;
+
+        snp.queue_delay    = queue_delay.snapshot();
+        snp.fiber_run_time = fiber_run_time.snapshot();
+        snp.io_latency     = io_latency.snapshot();
+        snp.poll_iteration = poll_iteration.snapshot();
+
+        snp.messages       = messages.value();
+        snp.returns        = returns.value();
+        snp.io_events      = io_events.value();
+        snp.fibers_started = fibers_started.value();
+
+        for (size_t c = 0; c < FiberStackPools::CLASSES; c++)
+        {
+            snp.stack_pools[c] = StackPoolMetricsSnapshot{
+                stack_pools[c].allocations.value(),
+                stack_pools[c].live.value(),
+                stack_pools[c].peak_live.value(),
+                stack_pools[c].pooled.value()
+            };
+        }
+
+        return snp;
+    }
+};
+
+}}
@@ -1,5 +1,3 @@
-
-
 //          Copyright Oliver Kowalke 2014.
 //          Copyright Victor Smirnov 2017.
 // Distributed under the Boost Software License, Version 1.0.
@@ -8,42 +6,71 @@
 
 #pragma once
 
+#include <memoria/core/config.hpp>
 #include <memoria/core/memory/ptr_cast.hpp>
 
 #include <boost/fiber/protected_fixedsize_stack.hpp>
 
 
 #include <boost/intrusive/list.hpp>
+#include <boost/intrusive_ptr.hpp>
 
 #include <stdint.h>
 #include <cstring>
+#include <vector>
+#include <algorithm>
+
+#ifdef MMA_POSIX
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 
 namespace memoria {
 namespace fibers {
 
+struct stack_pool_stats {
+    size_t stack_size{};
+    size_t live{};
+    size_t peak_live{};
+    size_t pooled{};
+    size_t trimmed{};
+    uint64_t allocations{};
+
+    // Maximal observed stack usage, in bytes. Zero if probing is disabled.
+    size_t watermark{};
+};
+
 class protected_stack_pool {
     
     class storage {
         struct ListNode: boost::intrusive::list_base_hook<> {
             boost::context::stack_context stack_ctx_;
+            bool trimmed_;
         };
         
         size_t min_pool_size_;
+        size_t max_pool_size_;
         boost::fibers::protected_fixedsize_stack  allocator_;
         
         boost::intrusive::list<ListNode> stack_list_;
         
         size_t use_count_{0};
+
+        bool probe_{false};
+        stack_pool_stats stats_{};
         
     public:
-        storage(size_t min_pool_size, size_t stack_size): 
+        storage(size_t min_pool_size, size_t max_pool_size, size_t stack_size):
             min_pool_size_(min_pool_size),
+            max_pool_size_(std::max(min_pool_size, max_pool_size)),
             allocator_(stack_size) 
         {
+            stats_.stack_size = stack_size;
+
             for (size_t c = 0; c < min_pool_size; c++)
             {
                 auto ctx = create_new_node();
-                deallocate(ctx);
+                stack_list_.push_back(*ptr_cast<ListNode>(ctx.sp));
             }
         }
         
@@ -59,10 +86,19 @@ class protected_stack_pool {
         
         boost::context::stack_context allocate()
         {
+            stats_.allocations++;
+            stats_.live++;
+            stats_.peak_live = std::max(stats_.peak_live, stats_.live);
+
             if (stack_list_.size() > 0) 
             {
                 ListNode* node = &stack_list_.back();
                 stack_list_.pop_back();
+
+                if (node->trimmed_) {
+                    node->trimmed_ = false;
+                    stats_.trimmed--;
+                }
                 
                 boost::context::stack_context ctx(node->stack_ctx_);
                 ctx.sp = ptr_cast<uint8_t>(ctx.sp) - sizeof(ListNode);
@@ -80,8 +116,14 @@ class protected_stack_pool {
         void deallocate( boost::context::stack_context & sctx) noexcept 
         {
             ListNode* node = ptr_cast<ListNode>(sctx.sp);
+
+            stats_.live--;
+
+            if (probe_) {
+                stats_.watermark = std::max(stats_.watermark, resident_depth(node->stack_ctx_));
+            }
             
-            if (stack_list_.size() < min_pool_size_)
+            if (stack_list_.size() < max_pool_size_)
             {
                 stack_list_.push_back(*node);
             }
@@ -89,6 +131,52 @@ class protected_stack_pool {
                 allocator_.deallocate(node->stack_ctx_);
             }
         }
+
+        // Releases physical memory of idle stacks except `min_pool_size`
+        // most recently used ones. Address space stays reserved, so the
+        // stacks can be reused without a new mapping.
+        size_t trim() noexcept
+        {
+            size_t released{};
+            size_t idle = stack_list_.size();
+
+            if (idle <= min_pool_size_) {
+                return released;
+            }
+
+            size_t cold = idle - min_pool_size_;
+            for (auto ii = stack_list_.begin(); cold > 0; ++ii, --cold)
+            {
+                if (!ii->trimmed_)
+                {
+                    if (probe_) {
+                        stats_.watermark = std::max(stats_.watermark, resident_depth(ii->stack_ctx_));
+                    }
+
+                    release_pages(&*ii);
+                    ii->trimmed_ = true;
+                    stats_.trimmed++;
+                    released++;
+                }
+            }
+
+            return released;
+        }
+
+        void set_probe(bool probe) noexcept {
+            probe_ = probe;
+        }
+
+        bool probe() const noexcept {
+            return probe_;
+        }
+
+        stack_pool_stats stats() const noexcept
+        {
+            stack_pool_stats stats = stats_;
+            stats.pooled = stack_list_.size();
+            return stats;
+        }
         
         friend void intrusive_ptr_add_ref( storage * s) noexcept {
             ++s->use_count_;
@@ -118,14 +206,76 @@ class protected_stack_pool {
             ctx.size -= node_size;
             
             return ctx;
-        }  
+        }
+
+        static size_t page_size() noexcept
+        {
+#ifdef MMA_POSIX
+            static const size_t size = ::sysconf(_SC_PAGESIZE);
+            return size;
+#else
+            return 4096;
+#endif
+        }
+
+        // Pages of the stack below the page holding the list node.
+        void release_pages(ListNode* node) noexcept
+        {
+#ifdef MMA_POSIX
+            size_t psize  = page_size();
+            uint8_t* top  = ptr_cast<uint8_t>(node->stack_ctx_.sp);
+            uint8_t* low  = top - node->stack_ctx_.size;
+            uint8_t* high = reinterpret_cast<uint8_t*>(reinterpret_cast<uintptr_t>(node) & ~(psize - 1));
+
+            if (high > low) {
+                ::madvise(low, high - low, MADV_DONTNEED);
+            }
+#endif
+        }
+
+        // Stack grows down, so the lowest resident page of the stack
+        // marks the deepest point it has been used to.
+        static size_t resident_depth(const boost::context::stack_context& ctx) noexcept
+        {
+#ifdef MMA_POSIX
+            size_t psize = page_size();
+            uint8_t* top = ptr_cast<uint8_t>(ctx.sp);
+            uint8_t* low = top - ctx.size;
+
+            uintptr_t aligned_low = reinterpret_cast<uintptr_t>(low) & ~(psize - 1);
+            size_t length = reinterpret_cast<uintptr_t>(top) - aligned_low;
+            size_t pages = (length + psize - 1) / psize;
+
+#if defined(MMA_LINUX)
+            using VecT = unsigned char;
+#else
+            using VecT = char;
+#endif
+            std::vector<VecT> vec(pages);
+            if (::mincore(reinterpret_cast<void*>(aligned_low), length, vec.data()) == 0)
+            {
+                for (size_t c = 0; c < pages; c++) {
+                    if (vec[c] & 1) {
+                        return length - c * psize;
+                    }
+                }
+            }
+#endif
+            return 0;
+        }
     };
     
     ::boost::intrusive_ptr< storage > storage_;
     
 public:
     protected_stack_pool(size_t min_pool_size, size_t stack_size = boost::context::stack_traits::default_size()): 
-        storage_(new storage(min_pool_size, stack_size))
+        storage_(new storage(min_pool_size, min_pool_size, stack_size))
+    {}
+
+    // Keeps up to max_pool_size idle stacks, min_pool_size of them are
+    // never trimmed.
+    protected_stack_pool(size_t min_pool_size, size_t max_pool_size, size_t stack_size):
+        storage_(new storage(min_pool_size, max_pool_size, stack_size))
     {}
     
     boost::context::stack_context allocate() {
@@ -135,6 +285,22 @@ public:
     void deallocate( boost::context::stack_context & sctx) noexcept {
         return storage_->deallocate(sctx);
     }
+
+    size_t trim() noexcept {
+        return storage_->trim();
+    }
+
+    void set_probe(bool probe) noexcept {
+        storage_->set_probe(probe);
+    }
+
+    bool probe() const noexcept {
+        return storage_->probe();
+    }
+
+    stack_pool_stats stats() const noexcept {
+        return storage_->stats();
+    }
 };
 
 }}
@@ -26,7 +26,7 @@
 #include <memoria/reactor/timer.hpp>
 #include <memoria/reactor/message_queue.hpp>
 
-#include <memoria/reactor/protected_stack_pool.hpp>
+#include <memoria/reactor/fiber_stacks.hpp>
 #include <boost/fiber/pooled_fixedsize_stack.hpp>
 
 #ifdef MMA_WINDOWS
@@ -50,6 +50,7 @@
 #include <memory>
 #include <atomic>
 #include <chrono>
+#include <functional>
 #include <list>
 
 namespace memoria {
@@ -63,6 +64,12 @@ class Reactor: public std::enable_shared_from_this<Reactor> {
 
     using TaskQueueT = MessageQueue;
 
+    static constexpr uint64_t FIBER_STACKS_TRIM_IDLE_TICKS = 1024;
+
+    // Number of ready migratable fibers the reactor keeps for itself
+    // before leaving pending migratable messages to other reactors.
+    static constexpr size_t WORK_STEALING_LOCAL_BATCH = 4;
+
     std::shared_ptr<Smp> smp_ {};
     int cpu_;
     bool own_thread_;
@@ -78,8 +85,7 @@ class Reactor: public std::enable_shared_from_this<Reactor> {
     RingBuffer<Message*> ring_buffer_{1024};
     
     IOPoller io_poller_;
-    memoria::fibers::protected_stack_pool fiber_stack_pool_{8, 16 * 1024 * 1024};
-    //fibers::protected_fixedsize_stack fiber_stack_pool_{};
+    FiberStackPools fiber_stacks_;
 
     uint64_t io_poll_cnt_{};
     uint64_t yield_cnt_{};
@@ -100,6 +106,9 @@ class Reactor: public std::enable_shared_from_this<Reactor> {
 
     uint64_t service_fibers_{2};
 
+    // Next peer to steal from
+    int steal_victim_{};
+
     std::list<TaskQueueT> tasks_queues_;
 
 public:
@@ -202,6 +211,7 @@ public:
             BOOST_ASSERT_MSG(ctx != nullptr, "Fiber context is null");
         
             auto msg = make_fiber_lambda_message(cpu_, this, ctx, std::forward<Fn>(task), std::forward<Args>(args)...);
+            msg->set_scheduling_group(scheduler_->current_group());
             smp_->submit_to(target_cpu, msg.get());
             scheduler_->suspend(ctx);
         
@@ -212,6 +222,29 @@ public:
         }
     }
 
+    // Runs the task on the target CPU in a fiber with the
+    // specified stack size class.
+    template <typename Fn, typename... Args>
+    auto run_at(int target_cpu, FiberStackClass stack_class, Fn&& task, Args&&... args)
+    {
+        if (target_cpu != cpu_)
+        {
+            auto ctx = boost::fibers::context::active();
+            BOOST_ASSERT_MSG(ctx != nullptr, "Fiber context is null");
+
+            auto msg = make_fiber_lambda_message(cpu_, this, ctx, std::forward<Fn>(task), std::forward<Args>(args)...);
+            msg->set_scheduling_group(scheduler_->current_group());
+            msg->set_stack_class(stack_class);
+            smp_->submit_to(target_cpu, msg.get());
+            scheduler_->suspend(ctx);
+
+            return std::move(msg->result());
+        }
+        else {
+            return task(std::forward<Args>(args)...);
+        }
+    }
+
     template <typename Fn, typename... Args>
     auto run(MessageQueue& queue, Fn&& task, Args&&... args)
     {
@@ -219,6 +252,7 @@ public:
         BOOST_ASSERT_MSG(ctx != nullptr, "Fiber context is null");
 
         auto msg = make_fiber_lambda_message(cpu_, this, ctx, std::forward<Fn>(task), std::forward<Args>(args)...);
+        msg->set_scheduling_group(scheduler_->current_group());
 
         queue.get()->send(msg.get());
         scheduler_->suspend(ctx);
@@ -235,6 +269,7 @@ public:
             BOOST_ASSERT_MSG(ctx != nullptr, "Fiber context is null");
 
             auto msg = make_fiber_lambda_message(cpu_, this, ctx, std::forward<Fn>(task), std::forward<Args>(args)...);
+            msg->set_scheduling_group(scheduler_->current_group());
             smp_->submit_to(target_cpu, msg.get());
             scheduler_->suspend(ctx);
         }
@@ -260,6 +295,47 @@ public:
         }
     }
 
+    // Runs the task on the target CPU in a migratable fiber. With
+    // work stealing enabled, the task may be taken by an idle reactor
+    // before it starts and, once started, may be resumed by another
+    // reactor after each suspension. The task must not use reactor-bound
+    // objects like files, sockets and timers, they stay pinned to their
+    // reactor. Without work stealing it's the same as run_at(), but the
+    // message is always sent, even to the current CPU.
+    template <typename Fn, typename... Args>
+    auto run_migratable_at(int target_cpu, Fn&& task, Args&&... args)
+    {
+        return run_migratable_at(target_cpu, FiberStackClass::DEFAULT, std::forward<Fn>(task), std::forward<Args>(args)...);
+    }
+
+    template <typename Fn, typename... Args>
+    auto run_migratable_at(int target_cpu, FiberStackClass stack_class, Fn&& task, Args&&... args)
+    {
+        auto ctx = boost::fibers::context::active();
+        BOOST_ASSERT_MSG(ctx != nullptr, "Fiber context is null");
+
+        auto msg = make_fiber_lambda_message(cpu_, this, ctx, std::forward<Fn>(task), std::forward<Args>(args)...);
+        msg->set_scheduling_group(scheduler_->current_group());
+        msg->set_stack_class(stack_class);
+        msg->set_migratable(true);
+        smp_->submit_to(target_cpu, msg.get());
+        scheduler_->suspend(ctx);
+
+        return msg->result();
+    }
+
+    // One-way counterpart of run_migratable_at(). The task is run
+    // in the event loop of the reactor that takes the message.
+    template <typename Fn, typename... Args>
+    void run_migratable_at_async(int target_cpu, Fn&& task, Args&&... args)
+    {
+        BOOST_ASSERT_MSG(boost::fibers::context::active() != nullptr, "Fiber context is null");
+
+        auto msg = make_one_way_lambda_message(cpu_, std::forward<Fn>(task), std::forward<Args>(args)...);
+        msg->set_migratable(true);
+        smp_->submit_to(target_cpu, msg);
+    }
+
     template <typename Fn, typename... Args>
     void run_async(MessageQueue& queue, Fn&& task, Args&&... args)
     {
@@ -413,14 +489,82 @@ public:
 
     bool shutdown_requested() const {return !running_;}
 
+    bool is_work_stealing() const {return scheduler_->is_work_stealing();}
+
+    FiberStackPools& fiber_stacks() {return fiber_stacks_;}
+    const FiberStackPools& fiber_stacks() const {return fiber_stacks_;}
+
+    // Metrics of this reactor, written by this reactor only
+    ReactorMetrics& metrics() {return smp_->metrics(cpu_);}
+
+    // Current metrics of all reactors. Reactors are not stopped,
+    // so the snapshots are not taken at exactly the same time.
+    std::vector<ReactorMetricsSnapshot> metrics_snapshot() const {
+        return smp_->metrics_snapshot();
+    }
+
+    SchedulingGroup current_scheduling_group() const {
+        return scheduler_->current_group();
+    }
+
+    // Counters of the group on this reactor
+    SchedulingGroupStats scheduling_group_stats(SchedulingGroup group) const {
+        return scheduler_->group_stats(group);
+    }
+
+    // Runs the function in the current fiber, accounting it to the
+    // group. Fibers and fiber messages started by the function
+    // inherit the group.
+    template <typename Fn, typename... Args>
+    auto with_scheduling_group(SchedulingGroup group, Fn&& fn, Args&&... args)
+    {
+        struct GroupScope {
+            boost::fibers::context* ctx;
+            SchedulingGroup prev;
+
+            ~GroupScope() noexcept {
+                // The fiber may have been migrated meanwhile
+                engine().scheduler()->enter_group(ctx, prev);
+            }
+        } scope{boost::fibers::context::active(), scheduler_->current_group()};
+
+        scheduler_->enter_group(scope.ctx, group);
+        return fn(std::forward<Args>(args)...);
+    }
 
+    // Fibers are started in the group of the current fiber,
+    // unless a group is specified.
     template <typename Fn, typename... Args>
     boost::fibers::fiber in_fiber(Fn&& fn, Args&&... args)
     {
+        return in_fiber(current_scheduling_group(), FiberStackClass::DEFAULT, std::forward<Fn>(fn), std::forward<Args>(args)...);
+    }
+
+    template <typename Fn, typename... Args>
+    boost::fibers::fiber in_fiber(FiberStackClass stack_class, Fn&& fn, Args&&... args)
+    {
+        return in_fiber(current_scheduling_group(), stack_class, std::forward<Fn>(fn), std::forward<Args>(args)...);
+    }
+
+    template <typename Fn, typename... Args>
+    boost::fibers::fiber in_fiber(SchedulingGroup group, Fn&& fn, Args&&... args)
+    {
+        return in_fiber(group, FiberStackClass::DEFAULT, std::forward<Fn>(fn), std::forward<Args>(args)...);
+    }
+
+    template <typename Fn, typename... Args>
+    boost::fibers::fiber in_fiber(SchedulingGroup group, FiberStackClass stack_class, Fn&& fn, Args&&... args)
+    {
+        // The fiber is started right away, before it has passed through
+        // the scheduler, so it enters the group itself.
         boost::fibers::fiber ff(
             boost::fibers::launch::dispatch,
             std::allocator_arg_t(),
-            this->fiber_stack_pool_,
+            fiber_stacks_.pool(stack_class),
+            [this, group](auto&& fn, auto&&... args) {
+                scheduler_->enter_group(boost::fibers::context::active(), group);
+                std::invoke(std::forward<decltype(fn)>(fn), std::forward<decltype(args)>(args)...);
+            },
             std::forward<Fn>(fn),
             std::forward<Args>(args)...
         );
@@ -428,6 +572,59 @@ public:
         return ff;
     }
 
+    // Starts a migratable fiber, see run_migratable_at(). Migratable
+    // fibers may finish on another reactor, so with work stealing
+    // enabled their stacks are not taken from the reactor's pools.
+    template <typename Fn, typename... Args>
+    boost::fibers::fiber in_migratable_fiber(Fn&& fn, Args&&... args)
+    {
+        return in_migratable_fiber(current_scheduling_group(), FiberStackClass::DEFAULT, std::forward<Fn>(fn), std::forward<Args>(args)...);
+    }
+
+    template <typename Fn, typename... Args>
+    boost::fibers::fiber in_migratable_fiber(FiberStackClass stack_class, Fn&& fn, Args&&... args)
+    {
+        return in_migratable_fiber(current_scheduling_group(), stack_class, std::forward<Fn>(fn), std::forward<Args>(args)...);
+    }
+
+    template <typename Fn, typename... Args>
+    boost::fibers::fiber in_migratable_fiber(SchedulingGroup group, FiberStackClass stack_class, Fn&& fn, Args&&... args)
+    {
+        struct SpawnScope {
+            Scheduler<Reactor>* scheduler;
+
+            SpawnScope(Scheduler<Reactor>* sch, SchedulingGroup group): scheduler(sch) {
+                scheduler->set_spawn_migratable(true);
+                scheduler->set_spawn_group(group);
+            }
+
+            ~SpawnScope() noexcept {
+                scheduler->set_spawn_migratable(false);
+                scheduler->reset_spawn_group();
+            }
+        } scope(scheduler_.get(), group);
+
+        if (is_work_stealing())
+        {
+            return boost::fibers::fiber(
+                boost::fibers::launch::post,
+                std::allocator_arg_t(),
+                boost::fibers::protected_fixedsize_stack(FiberStackPools::stack_size(stack_class)),
+                std::forward<Fn>(fn),
+                std::forward<Args>(args)...
+            );
+        }
+        else {
+            return boost::fibers::fiber(
+                boost::fibers::launch::post,
+                std::allocator_arg_t(),
+                fiber_stacks_.pool(stack_class),
+                std::forward<Fn>(fn),
+                std::forward<Args>(args)...
+            );
+        }
+    }
+
 private:
 
     void register_queue(const MessageQueue& queue) {
@@ -450,6 +647,9 @@ private:
     void event_loop(uint64_t iopoll_timeout);
 
     void handle_memory_objects(MemoryObject* obj);
+    bool steal_work(WorkStealingQueue& own_queue);
+    void dump_fiber_stacks_stats(std::ostream& out) const;
+    void dump_scheduling_group_stats(std::ostream& out) const;
 };
 
 bool has_engine();
@@ -465,6 +665,64 @@ boost::fibers::fiber in_fiber(Fn&& fn, Args&&... args)
     );
 }
 
+template <typename Fn, typename... Args>
+boost::fibers::fiber in_fiber(FiberStackClass stack_class, Fn&& fn, Args&&... args)
+{
+    return engine().in_fiber(
+        stack_class,
+        std::forward<Fn>(fn),
+        std::forward<Args>(args)...
+    );
+}
+
+
+template <typename Fn, typename... Args>
+boost::fibers::fiber in_fiber(SchedulingGroup group, Fn&& fn, Args&&... args)
+{
+    return engine().in_fiber(
+        group,
+        std::forward<Fn>(fn),
+        std::forward<Args>(args)...
+    );
+}
+
+template <typename Fn, typename... Args>
+boost::fibers::fiber in_migratable_fiber(Fn&& fn, Args&&... args)
+{
+    return engine().in_migratable_fiber(
+        std::forward<Fn>(fn),
+        std::forward<Args>(args)...
+    );
+}
+
+template <typename Fn, typename... Args>
+auto with_scheduling_group(SchedulingGroup group, Fn&& fn, Args&&... args)
+{
+    return engine().with_scheduling_group(
+        group,
+        std::forward<Fn>(fn),
+        std::forward<Args>(args)...
+    );
+}
+
+inline std::vector<ReactorMetricsSnapshot> collect_reactor_metrics() {
+    return engine().metrics_snapshot();
+}
+
+// True if the current fiber has run longer than the task quota
+// while other fibers are waiting.
+inline bool need_preempt() {
+    return engine().scheduler()->need_preempt();
+}
+
+// Preemption point for long-running fibers: yields only
+// if the task quota has been used up.
+inline void maybe_yield()
+{
+    if (need_preempt()) {
+        boost::this_fiber::yield();
+    }
+}
 
 template <typename Fn, typename... Args> 
 auto engine_or_local(Fn&& fn, Args&&... args)
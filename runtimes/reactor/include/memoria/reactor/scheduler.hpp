@@ -15,8 +15,15 @@
 
 #pragma once
 
+#include <memoria/reactor/work_stealing.hpp>
+#include <memoria/reactor/scheduling_group.hpp>
+#include <memoria/reactor/metrics.hpp>
+
 #include <boost/fiber/all.hpp>
 
+#include <algorithm>
+#include <array>
+#include <chrono>
 #include <thread>
 #include <memory>
 #include <iostream>
@@ -26,45 +33,253 @@ namespace reactor {
     
     
 class FiberProperties : public boost::fibers::fiber_properties {
+    // Migratable fibers may be resumed by other reactors
+    // when work stealing is enabled.
+    bool migratable_{false};
+    uint64_t ticket_{};
+
+    SchedulingGroup group_{};
+    uint64_t ready_since_ns_{};
 public:
     FiberProperties( boost::fibers::context * ctx):
         boost::fibers::fiber_properties( ctx)
     {}
+
+    bool is_migratable() const {return migratable_;}
+    void set_migratable(bool value) {migratable_ = value;}
+
+    uint64_t ticket() const {return ticket_;}
+    void set_ticket(uint64_t ticket) {ticket_ = ticket;}
+
+    SchedulingGroup group() const {return group_;}
+    void set_group(SchedulingGroup group) {group_ = group;}
+
+    uint64_t ready_since_ns() const {return ready_since_ns_;}
+    void set_ready_since_ns(uint64_t value) {ready_since_ns_ = value;}
 };     
 
+// Fair-share scheduler. Ready fibers are queued per scheduling group.
+// A group runs its fibers for up to the task quota, then the next group
+// is selected: a group whose oldest ready fiber has been waiting longer
+// than the group's max latency goal, if any, otherwise the group with
+// the least runtime normalized by its shares. Within a group fibers
+// are run in FIFO order.
 template <typename Reactor>
 class Scheduler: public boost::fibers::algo::algorithm_with_properties<FiberProperties> {
     std::shared_ptr<Reactor> reactor_;
     
     using ReadyQueue = boost::fibers::scheduler::ready_queue_type;
-    ReadyQueue ready_queue_ {};
+    using Clock = std::chrono::steady_clock;
+
+    struct GroupState {
+        ReadyQueue queue{};
+        // Runtime normalized by shares
+        uint64_t vruntime{};
+
+        uint64_t runtime_ns{};
+        uint64_t queue_delay_ns{};
+        uint64_t max_queue_delay_ns{};
+        uint64_t activations{};
+        uint64_t latency_goal_misses{};
+        uint64_t ready{};
+    };
+
+    SchedulingGroupRegistry& registry_;
+
+    std::array<GroupState, MAX_SCHEDULING_GROUPS> groups_{};
+    // Groups with ready fibers
+    uint32_t ready_groups_{};
     
     uint64_t activations_{};
+
+    uint32_t current_group_{};
+    // Start of the current fiber's run and of the current group's quota
+    uint64_t slice_start_ns_;
+    uint64_t quota_start_ns_;
+    uint64_t min_vruntime_{};
+
+    uint64_t task_quota_ns_{500000};
+
+    // Start of the current context's run, for fiber run time metrics
+    uint64_t run_start_ns_;
+    ReactorMetrics* metrics_{};
+
+    // Ready migratable fibers are kept here instead of the group queues
+    // so that idle reactors can steal them. Null if work stealing is
+    // disabled.
+    WorkStealingQueue* steal_queue_;
+
+    // Orders fibers across the group queues and the steal queue
+    uint64_t next_ticket_{};
+
+    bool spawn_migratable_{false};
+    int32_t spawn_group_{-1};
 public:
-    Scheduler(std::shared_ptr<Reactor> reactor): reactor_(reactor) {}
+    Scheduler(std::shared_ptr<Reactor> reactor, WorkStealingQueue* steal_queue = nullptr):
+        reactor_(reactor),
+        registry_(SchedulingGroupRegistry::instance()),
+        slice_start_ns_(now_ns()),
+        quota_start_ns_(slice_start_ns_),
+        run_start_ns_(slice_start_ns_),
+        steal_queue_(steal_queue)
+    {}
 
     uint64_t activations() const {return activations_;}
-    
+
+    void set_metrics(ReactorMetrics* metrics) {metrics_ = metrics;}
+
+    bool is_work_stealing() const {return steal_queue_ != nullptr;}
+
+    // Fibers created while set are marked migratable
+    void set_spawn_migratable(bool value) {spawn_migratable_ = value;}
+
+    // Fibers created while set are put into this group instead of
+    // the group of the current fiber.
+    void set_spawn_group(SchedulingGroup group) {spawn_group_ = static_cast<int32_t>(group.id());}
+    void reset_spawn_group() {spawn_group_ = -1;}
+
+    std::chrono::microseconds task_quota() const {
+        return std::chrono::microseconds(task_quota_ns_ / 1000);
+    }
+
+    void set_task_quota(std::chrono::microseconds quota) {
+        task_quota_ns_ = quota.count() * 1000;
+    }
+
+    SchedulingGroup current_group() const {return SchedulingGroup(current_group_);}
+
+    // Moves the running fiber to the group. Runtime up to this point
+    // is accounted to the previous group.
+    void enter_group(boost::fibers::context* ctx, SchedulingGroup group)
+    {
+        uint64_t now = now_ns();
+        charge(now);
+
+        ensure_properties(ctx).set_group(group);
+
+        if (group.id() != current_group_)
+        {
+            current_group_ = group.id();
+            quota_start_ns_ = now;
+        }
+    }
+
+    // True if the running fiber has used up the task quota
+    // and other fibers are ready to run.
+    bool need_preempt() const noexcept {
+        return now_ns() - slice_start_ns_ >= task_quota_ns_ && has_ready_fibers();
+    }
+
+    SchedulingGroupStats group_stats(SchedulingGroup group) const
+    {
+        const GroupState& gs = groups_[group.id()];
+        return SchedulingGroupStats{
+            gs.runtime_ns,
+            gs.queue_delay_ns,
+            gs.max_queue_delay_ns,
+            gs.activations,
+            gs.latency_goal_misses,
+            gs.ready
+        };
+    }
+
+    virtual boost::fibers::fiber_properties* new_properties(boost::fibers::context* ctx)
+    {
+        auto props = new FiberProperties(ctx);
+        props->set_migratable(spawn_migratable_);
+        if (!ctx->is_context(boost::fibers::type::pinned_context))
+        {
+            props->set_group(SchedulingGroup(spawn_group_ >= 0 ? spawn_group_ : current_group_));
+
+            if (metrics_) {
+                metrics_->fibers_started.inc();
+            }
+        }
+        return props;
+    }
+
     virtual void awakened( boost::fibers::context* ctx, FiberProperties& properties) noexcept
     {
         BOOST_ASSERT( nullptr != ctx);
 
-        BOOST_ASSERT( ! ctx->ready_is_linked() );
-        ctx->ready_link( ready_queue_);
+        properties.set_ticket(next_ticket_++);
+        properties.set_ready_since_ns(now_ns());
+
+        if (steal_queue_ && properties.is_migratable() && !ctx->is_context(boost::fibers::type::pinned_context))
+        {
+            ctx->detach();
+            steal_queue_->push_fiber(ctx, properties.ticket());
+        }
+        else {
+            uint32_t group = properties.group().id();
+            GroupState& gs = groups_[group];
+
+            // Don't let a group that has been idle catch up
+            // with the runtime of the busy ones.
+            if (!gs.ready && group != current_group_) {
+                gs.vruntime = std::max(gs.vruntime, min_vruntime_);
+            }
+
+            BOOST_ASSERT( ! ctx->ready_is_linked() );
+            ctx->ready_link( gs.queue);
+
+            gs.ready++;
+            ready_groups_ |= 1u << group;
+        }
+    }
+
+    // Re-queues a fiber stolen from another reactor. The fiber
+    // stays detached until it is picked to run.
+    void push_stolen(boost::fibers::context* ctx) noexcept
+    {
+        steal_queue_->push_fiber(ctx, next_ticket_++);
     }
 
     virtual boost::fibers::context * pick_next() noexcept
     {
         boost::fibers::context* victim{ nullptr };
-        
-        if ( ! ready_queue_.empty() )
+
+        uint64_t now = now_ns();
+        charge(now);
+
+        // Event loop and dispatcher runs are not fiber runs
+        if (metrics_ && !boost::fibers::context::active()->is_context(boost::fibers::type::pinned_context)) {
+            metrics_->fiber_run_time.record(now - run_start_ns_);
+        }
+        run_start_ns_ = now;
+
+        int32_t group = select_group(now);
+
+        uint64_t steal_ticket;
+        if (steal_queue_ && steal_queue_->front_ticket(steal_ticket))
+        {
+            if (group < 0 || properties(&groups_[group].queue.front()).ticket() > steal_ticket)
+            {
+                // May have been stolen meanwhile
+                victim = steal_queue_->pop_fiber();
+                if (victim)
+                {
+                    boost::fibers::context::active()->attach(victim);
+                    start_run(properties(victim), now);
+                    return victim;
+                }
+            }
+        }
+
+        if (group >= 0)
         {
-            victim = & ready_queue_.front();
-            ready_queue_.pop_front();
+            GroupState& gs = groups_[group];
+
+            victim = & gs.queue.front();
+            gs.queue.pop_front();
             BOOST_ASSERT( nullptr != victim);
             BOOST_ASSERT( ! victim->ready_is_linked() );
 
-            ++activations_;
+            if (!--gs.ready) {
+                ready_groups_ &= ~(1u << group);
+            }
+
+            start_run(properties(victim), now);
         }
         
         return victim;
@@ -72,7 +287,7 @@ public:
 
     virtual bool has_ready_fibers() const noexcept 
     {
-        return ! ready_queue_.empty();
+        return ready_groups_ || (steal_queue_ && steal_queue_->fibers());
     }
 
     virtual void suspend_until( std::chrono::steady_clock::time_point const&) noexcept 
@@ -92,6 +307,104 @@ public:
     {        
         ctx->get_scheduler()->schedule(ctx);
     }
+
+private:
+    static uint64_t now_ns() noexcept {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+    }
+
+    FiberProperties& ensure_properties(boost::fibers::context* ctx)
+    {
+        if (!ctx->get_properties()) {
+            ctx->set_properties(new_properties(ctx));
+        }
+        return properties(ctx);
+    }
+
+    // Accounts time since the last switch to the current group
+    void charge(uint64_t now) noexcept
+    {
+        uint64_t delta = now - slice_start_ns_;
+        slice_start_ns_ = now;
+
+        GroupState& gs = groups_[current_group_];
+        gs.runtime_ns += delta;
+        gs.vruntime   += delta * DEFAULT_SCHEDULING_GROUP_SHARES / registry_.shares_at(current_group_);
+    }
+
+    int32_t select_group(uint64_t now) noexcept
+    {
+        if (!ready_groups_) {
+            return -1;
+        }
+
+        // The current group keeps running until its quota is used up
+        if ((ready_groups_ & (1u << current_group_)) && now - quota_start_ns_ < task_quota_ns_) {
+            return current_group_;
+        }
+
+        int32_t overdue{-1};
+        uint64_t max_overdue{};
+
+        int32_t fair{-1};
+        uint64_t min_vruntime{};
+
+        for (uint32_t mask = ready_groups_; mask; mask &= mask - 1)
+        {
+            uint32_t group = __builtin_ctz(mask);
+            GroupState& gs = groups_[group];
+
+            // Groups that would miss their latency goal if
+            // another group's quota were run first
+            uint64_t max_latency = registry_.max_latency_ns_at(group);
+            if (max_latency)
+            {
+                uint64_t waiting = now - properties(&gs.queue.front()).ready_since_ns() + task_quota_ns_;
+                if (waiting > max_latency && waiting - max_latency > max_overdue)
+                {
+                    overdue = group;
+                    max_overdue = waiting - max_latency;
+                }
+            }
+
+            if (fair < 0 || gs.vruntime < min_vruntime)
+            {
+                fair = group;
+                min_vruntime = gs.vruntime;
+            }
+        }
+
+        if (overdue < 0) {
+            min_vruntime_ = std::max(min_vruntime_, min_vruntime);
+        }
+
+        quota_start_ns_ = now;
+        return overdue >= 0 ? overdue : fair;
+    }
+
+    void start_run(FiberProperties& props, uint64_t now) noexcept
+    {
+        uint32_t group = props.group().id();
+        GroupState& gs = groups_[group];
+
+        if (group != current_group_)
+        {
+            current_group_ = group;
+            quota_start_ns_ = now;
+        }
+
+        uint64_t delay = now - props.ready_since_ns();
+        gs.queue_delay_ns += delay;
+        gs.max_queue_delay_ns = std::max(gs.max_queue_delay_ns, delay);
+
+        uint64_t max_latency = registry_.max_latency_ns_at(group);
+        if (max_latency && delay > max_latency) {
+            gs.latency_goal_misses++;
+        }
+
+        gs.activations++;
+        ++activations_;
+    }
 };
     
 }}
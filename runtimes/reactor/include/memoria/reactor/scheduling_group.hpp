@@ -0,0 +1,237 @@
+// Copyright 2026 Victor Smirnov
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memoria/core/exceptions/core.hpp>
+#include <memoria/core/strings/format.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+namespace memoria {
+namespace reactor {
+
+static constexpr size_t MAX_SCHEDULING_GROUPS = 16;
+static constexpr uint32_t DEFAULT_SCHEDULING_GROUP_SHARES = 1000;
+
+// Handle of a scheduling group. Fibers and fiber messages carry
+// a group, reactors share CPU time between groups with ready fibers
+// in proportion to their shares. A group may also have a max latency
+// goal: its fibers are run first once they have been waiting longer
+// than that. Group zero, "main", is the default one.
+class SchedulingGroup {
+    uint32_t id_;
+public:
+    constexpr SchedulingGroup(): id_(0) {}
+    constexpr explicit SchedulingGroup(uint32_t id): id_(id) {}
+
+    uint32_t id() const {return id_;}
+
+    std::string name() const;
+
+    uint32_t shares() const;
+    void set_shares(uint32_t shares);
+
+    std::chrono::microseconds max_latency() const;
+    void set_max_latency(std::chrono::microseconds latency);
+
+    bool operator==(const SchedulingGroup& other) const {return id_ == other.id_;}
+    bool operator!=(const SchedulingGroup& other) const {return id_ != other.id_;}
+};
+
+// Process-wide group configuration, read by all reactors.
+class SchedulingGroupRegistry {
+    struct Entry {
+        std::string name;
+        std::atomic<uint32_t> shares{DEFAULT_SCHEDULING_GROUP_SHARES};
+        std::atomic<uint64_t> max_latency_ns{};
+    };
+
+    mutable std::mutex mutex_;
+    Entry entries_[MAX_SCHEDULING_GROUPS];
+    std::atomic<size_t> size_{1};
+
+public:
+    SchedulingGroupRegistry() {
+        entries_[0].name = "main";
+    }
+
+    SchedulingGroupRegistry(const SchedulingGroupRegistry&) = delete;
+    SchedulingGroupRegistry& operator=(const SchedulingGroupRegistry&) = delete;
+
+    static SchedulingGroupRegistry& instance()
+    {
+        static SchedulingGroupRegistry registry;
+        return registry;
+    }
+
+    size_t size() const {
+        return size_.load(std::memory_order_acquire);
+    }
+
+    SchedulingGroup create(const std::string& name, uint32_t shares, std::chrono::microseconds max_latency)
+    {
+        check_shares(shares);
+
+        std::lock_guard<std::mutex> lk(mutex_);
+
+        size_t size = size_.load(std::memory_order_relaxed);
+        for (size_t c = 0; c < size; c++)
+        {
+            if (entries_[c].name == name) {
+                MMA_THROW(RuntimeException()) << format_ex("Scheduling group {} already exists", name);
+            }
+        }
+
+        if (size == MAX_SCHEDULING_GROUPS) {
+            MMA_THROW(RuntimeException()) << format_ex("Too many scheduling groups, max is {}", MAX_SCHEDULING_GROUPS);
+        }
+
+        Entry& entry = entries_[size];
+        entry.name = name;
+        entry.shares.store(shares, std::memory_order_relaxed);
+        entry.max_latency_ns.store(max_latency.count() * 1000, std::memory_order_relaxed);
+
+        size_.store(size + 1, std::memory_order_release);
+
+        return SchedulingGroup(static_cast<uint32_t>(size));
+    }
+
+    SchedulingGroup find(const std::string& name) const
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+
+        size_t size = size_.load(std::memory_order_relaxed);
+        for (size_t c = 0; c < size; c++)
+        {
+            if (entries_[c].name == name) {
+                return SchedulingGroup(static_cast<uint32_t>(c));
+            }
+        }
+
+        MMA_THROW(RuntimeException()) << format_ex("Scheduling group {} is not found", name);
+    }
+
+    std::string name(SchedulingGroup group) const
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        return entry(group).name;
+    }
+
+    uint32_t shares(SchedulingGroup group) const {
+        return entry(group).shares.load(std::memory_order_relaxed);
+    }
+
+    void set_shares(SchedulingGroup group, uint32_t shares)
+    {
+        check_shares(shares);
+        entry(group).shares.store(shares, std::memory_order_relaxed);
+    }
+
+    // Zero if the group has no latency goal
+    uint64_t max_latency_ns(SchedulingGroup group) const {
+        return entry(group).max_latency_ns.load(std::memory_order_relaxed);
+    }
+
+    void set_max_latency(SchedulingGroup group, std::chrono::microseconds latency) {
+        entry(group).max_latency_ns.store(latency.count() * 1000, std::memory_order_relaxed);
+    }
+
+    // Unchecked accessors for schedulers
+    uint32_t shares_at(size_t idx) const noexcept {
+        return entries_[idx].shares.load(std::memory_order_relaxed);
+    }
+
+    uint64_t max_latency_ns_at(size_t idx) const noexcept {
+        return entries_[idx].max_latency_ns.load(std::memory_order_relaxed);
+    }
+
+private:
+    const Entry& entry(SchedulingGroup group) const
+    {
+        if (MMA_UNLIKELY(group.id() >= size())) {
+            MMA_THROW(RuntimeException()) << format_ex("Invalid scheduling group: {}", group.id());
+        }
+        return entries_[group.id()];
+    }
+
+    Entry& entry(SchedulingGroup group) {
+        return const_cast<Entry&>(const_cast<const SchedulingGroupRegistry*>(this)->entry(group));
+    }
+
+    static void check_shares(uint32_t shares)
+    {
+        if (shares == 0) {
+            MMA_THROW(RuntimeException()) << WhatCInfo("Scheduling group shares must be greater than zero");
+        }
+    }
+};
+
+inline std::string SchedulingGroup::name() const {
+    return SchedulingGroupRegistry::instance().name(*this);
+}
+
+inline uint32_t SchedulingGroup::shares() const {
+    return SchedulingGroupRegistry::instance().shares(*this);
+}
+
+inline void SchedulingGroup::set_shares(uint32_t shares) {
+    SchedulingGroupRegistry::instance().set_shares(*this, shares);
+}
+
+inline std::chrono::microseconds SchedulingGroup::max_latency() const {
+    return std::chrono::microseconds(SchedulingGroupRegistry::instance().max_latency_ns(*this) / 1000);
+}
+
+inline void SchedulingGroup::set_max_latency(std::chrono::microseconds latency) {
+    SchedulingGroupRegistry::instance().set_max_latency(*this, latency);
+}
+
+// Creates a new group, visible to all reactors. Groups are never destroyed.
+inline SchedulingGroup create_scheduling_group(
+        const std::string& name,
+        uint32_t shares = DEFAULT_SCHEDULING_GROUP_SHARES,
+        std::chrono::microseconds max_latency = std::chrono::microseconds(0)
+) {
+    return SchedulingGroupRegistry::instance().create(name, shares, max_latency);
+}
+
+inline SchedulingGroup find_scheduling_group(const std::string& name) {
+    return SchedulingGroupRegistry::instance().find(name);
+}
+
+inline constexpr SchedulingGroup default_scheduling_group() {
+    return SchedulingGroup();
+}
+
+// Per-reactor counters of a scheduling group
+struct SchedulingGroupStats {
+    // Time the group's fibers have been running
+    uint64_t runtime_ns;
+    // Total and max time ready fibers have waited to be run
+    uint64_t queue_delay_ns;
+    uint64_t max_queue_delay_ns;
+    // Number of times a fiber of the group has been run
+    uint64_t activations;
+    // Number of times a fiber has waited longer than the latency goal
+    uint64_t latency_goal_misses;
+    // Fibers ready to run now
+    uint64_t ready;
+};
+
+}}
@@ -22,6 +22,8 @@
 #include <memoria/reactor/message.hpp>
 
 #include <memoria/reactor/message_queue.hpp>
+#include <memoria/reactor/metrics.hpp>
+#include <memoria/reactor/work_stealing.hpp>
 
 #include <vector>
 #include <memory>
@@ -44,6 +46,8 @@ class SmpBase: public std::enable_shared_from_this<MyType> {
     int cpu_num_;
     
     std::vector<WorkerMessageQueuePtr> inboxes_;
+    std::vector<std::unique_ptr<WorkStealingQueue>> steal_queues_;
+    std::vector<std::unique_ptr<ReactorMetrics>> metrics_;
     
 public:
     SmpBase(int cpu_num): 
@@ -54,6 +58,8 @@ public:
             for (int c = 0; c < cpu_num; c++)
             {
                 inboxes_.push_back(std::make_unique<WorkerMessageQueue>());
+                steal_queues_.push_back(std::make_unique<WorkStealingQueue>());
+                metrics_.push_back(std::make_unique<ReactorMetrics>());
             }
         }
         else {
@@ -68,6 +74,7 @@ public:
         }
 
         BOOST_ASSERT_MSG(cpu >= 0 && cpu < cpu_num_, "Invalid cpu number");
+        msg->set_sent_ns(metrics_now_ns());
         return inboxes_[cpu]->send(msg);
     }
     
@@ -85,6 +92,27 @@ public:
         return inboxes_[cpu]->get_all(std::forward<Fn>(consumer));
     }
     
+    WorkStealingQueue& steal_queue(int cpu)
+    {
+        BOOST_ASSERT_MSG(cpu >= 0 && cpu < cpu_num_, "Invalid cpu number");
+        return *steal_queues_[cpu];
+    }
+
+    ReactorMetrics& metrics(int cpu)
+    {
+        BOOST_ASSERT_MSG(cpu >= 0 && cpu < cpu_num_, "Invalid cpu number");
+        return *metrics_[cpu];
+    }
+
+    std::vector<ReactorMetricsSnapshot> metrics_snapshot() const
+    {
+        std::vector<ReactorMetricsSnapshot> snps;
+        for (int c = 0; c < cpu_num_; c++) {
+            snps.push_back(metrics_[c]->snapshot(c));
+        }
+        return snps;
+    }
+
     int cpu_num() const {return cpu_num_;}
 
     friend class Application;
@@ -0,0 +1,183 @@
+// Copyright 2026 Victor Smirnov
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memoria/reactor/message/message.hpp>
+
+#include <boost/fiber/context.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+
+namespace memoria {
+namespace reactor {
+
+// Per-reactor queue of work other reactors may take over: ready
+// migratable fibers, detached from their scheduler while queued,
+// and migratable run_in_fiber messages not yet started. The owner
+// pops from the front, thieves steal from the back.
+class WorkStealingQueue {
+public:
+    struct ReadyFiber {
+        boost::fibers::context* ctx;
+        uint64_t ticket;
+    };
+
+    struct Stats {
+        uint64_t stolen_fibers;
+        uint64_t stolen_messages;
+    };
+
+private:
+    mutable std::mutex mutex_;
+
+    std::deque<ReadyFiber> fibers_;
+    std::deque<Message*> messages_;
+
+    // Read without locking by the owner's scheduler and by thieves
+    std::atomic<size_t> fibers_size_{};
+    std::atomic<size_t> messages_size_{};
+
+    std::atomic<uint64_t> stolen_fibers_{};
+    std::atomic<uint64_t> stolen_messages_{};
+
+public:
+    WorkStealingQueue() = default;
+
+    WorkStealingQueue(const WorkStealingQueue&) = delete;
+    WorkStealingQueue& operator=(const WorkStealingQueue&) = delete;
+
+    size_t fibers() const noexcept {
+        return fibers_size_.load(std::memory_order_acquire);
+    }
+
+    size_t messages() const noexcept {
+        return messages_size_.load(std::memory_order_acquire);
+    }
+
+    void push_fiber(boost::fibers::context* ctx, uint64_t ticket)
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        fibers_.push_back(ReadyFiber{ctx, ticket});
+        fibers_size_.store(fibers_.size(), std::memory_order_release);
+    }
+
+    // Ticket of the oldest queued fiber, if any
+    bool front_ticket(uint64_t& ticket) const
+    {
+        if (!fibers()) {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lk(mutex_);
+        if (fibers_.empty()) {
+            return false;
+        }
+
+        ticket = fibers_.front().ticket;
+        return true;
+    }
+
+    boost::fibers::context* pop_fiber()
+    {
+        if (!fibers()) {
+            return nullptr;
+        }
+
+        std::lock_guard<std::mutex> lk(mutex_);
+        if (fibers_.empty()) {
+            return nullptr;
+        }
+
+        auto ctx = fibers_.front().ctx;
+        fibers_.pop_front();
+        fibers_size_.store(fibers_.size(), std::memory_order_release);
+        return ctx;
+    }
+
+    boost::fibers::context* steal_fiber()
+    {
+        if (!fibers()) {
+            return nullptr;
+        }
+
+        std::lock_guard<std::mutex> lk(mutex_);
+        if (fibers_.empty()) {
+            return nullptr;
+        }
+
+        auto ctx = fibers_.back().ctx;
+        fibers_.pop_back();
+        fibers_size_.store(fibers_.size(), std::memory_order_release);
+
+        stolen_fibers_.fetch_add(1, std::memory_order_relaxed);
+        return ctx;
+    }
+
+    void push_message(Message* msg)
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        messages_.push_back(msg);
+        messages_size_.store(messages_.size(), std::memory_order_release);
+    }
+
+    Message* pop_message()
+    {
+        if (!messages()) {
+            return nullptr;
+        }
+
+        std::lock_guard<std::mutex> lk(mutex_);
+        if (messages_.empty()) {
+            return nullptr;
+        }
+
+        auto msg = messages_.front();
+        messages_.pop_front();
+        messages_size_.store(messages_.size(), std::memory_order_release);
+        return msg;
+    }
+
+    Message* steal_message()
+    {
+        if (!messages()) {
+            return nullptr;
+        }
+
+        std::lock_guard<std::mutex> lk(mutex_);
+        if (messages_.empty()) {
+            return nullptr;
+        }
+
+        auto msg = messages_.back();
+        messages_.pop_back();
+        messages_size_.store(messages_.size(), std::memory_order_release);
+
+        stolen_messages_.fetch_add(1, std::memory_order_relaxed);
+        return msg;
+    }
+
+    // Number of fibers and messages taken from this queue by other reactors
+    Stats stats() const noexcept {
+        return Stats{
+            stolen_fibers_.load(std::memory_order_relaxed),
+            stolen_messages_.load(std::memory_order_relaxed)
+        };
+    }
+};
+
+}}
@@ -76,9 +76,12 @@ Application::Application(const options_description& descr, int argc, char** argv
     boost::program_options::notify(options_);
 
     debug_ = options_["debug"].as<bool>();
+    fiber_stack_probe_ = options_["fiber-stack-probe"].as<bool>();
+    work_stealing_ = options_["work-stealing"].as<bool>();
     
     application_ = this;
     iopoll_timeout_ = options_["io-timeout"].as<uint64_t>();
+    task_quota_us_ = options_["task-quota"].as<uint64_t>();
 
     threads_ = options_["threads"].as<uint32_t>();
 }
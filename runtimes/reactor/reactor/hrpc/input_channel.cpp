@@ -30,13 +30,8 @@ bool ReactorHRPCInputChannel::is_closed() {
 bool ReactorHRPCInputChannel::pop(Message& msg)
 {
     bool success = channel_.pop(msg);
-    if (success)
-    {
-        size_t msg_size = msg.object().ctr().memory_size();
-        batch_size_ += msg_size;
-        if (batch_size_ >= batch_size_limit_ / 2) {
-            session_->unblock_output_channel(call_id_, channel_code_, call_side_);
-        }
+    if (success) {
+        message_consumed();
     }
     return success;
 }
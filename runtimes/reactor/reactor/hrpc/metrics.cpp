@@ -0,0 +1,86 @@
+// Copyright 2026 Victor Smirnov
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memoria/reactor/hrpc/metrics.hpp>
+#include <memoria/reactor/reactor.hpp>
+
+namespace memoria::reactor::hrpc {
+
+namespace {
+
+hermes::Object histogram_object(hermes::HermesCtr& ctr, const HistogramSnapshot& snp)
+{
+    auto map = ctr.make_object_map();
+
+    map.put_t<BigInt>("count", snp.count);
+    map.put_t<BigInt>("mean", static_cast<int64_t>(snp.mean()));
+    map.put_t<BigInt>("p50",  snp.percentile(0.5));
+    map.put_t<BigInt>("p90",  snp.percentile(0.9));
+    map.put_t<BigInt>("p99",  snp.percentile(0.99));
+    map.put_t<BigInt>("p999", snp.percentile(0.999));
+    map.put_t<BigInt>("max",  snp.max);
+
+    return map.as_object();
+}
+
+}
+
+Response reactor_metrics_handler(PoolSharedPtr<st::Context>)
+{
+    auto rs = Response::ok();
+    auto ctr = rs.object().ctr();
+
+    auto reactors = ctr.make_object_array();
+    for (const auto& snp: collect_reactor_metrics())
+    {
+        auto map = ctr.make_object_map();
+
+        map.put_t<BigInt>("cpu", snp.cpu);
+        map.put_t<BigInt>("messages", snp.messages);
+        map.put_t<BigInt>("returns", snp.returns);
+        map.put_t<BigInt>("io_events", snp.io_events);
+        map.put_t<BigInt>("fibers_started", snp.fibers_started);
+
+        map.put("queue_delay",    histogram_object(ctr, snp.queue_delay));
+        map.put("fiber_run_time", histogram_object(ctr, snp.fiber_run_time));
+        map.put("io_latency",     histogram_object(ctr, snp.io_latency));
+        map.put("poll_iteration", histogram_object(ctr, snp.poll_iteration));
+
+        auto pools = ctr.make_object_map();
+        for (size_t c = 0; c < FiberStackPools::CLASSES; c++)
+        {
+            const auto& pool_snp = snp.stack_pools[c];
+
+            auto pool = ctr.make_object_map();
+            pool.put_t<BigInt>("allocations", pool_snp.allocations);
+            pool.put_t<BigInt>("live", pool_snp.live);
+            pool.put_t<BigInt>("peak_live", pool_snp.peak_live);
+            pool.put_t<BigInt>("pooled", pool_snp.pooled);
+
+            pools.put(FiberStackPools::name(static_cast<FiberStackClass>(c)), pool.as_object());
+        }
+        map.put("fiber_stacks", pools.as_object());
+
+        reactors.push_back(map.as_object());
+    }
+
+    rs.set_result(reactors.as_object());
+    return rs;
+}
+
+void add_reactor_metrics_endpoint(const PoolSharedPtr<st::EndpointRepository>& endpoints) {
+    endpoints->add_handler(REACTOR_METRICS_ENDPOINT, reactor_metrics_handler);
+}
+
+}
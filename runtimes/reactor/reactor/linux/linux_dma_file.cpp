@@ -95,8 +95,11 @@ public:
         return "FileSingleIOMessage";
     }
    
-    void wait_for() {
+    void wait_for()
+    {
+        uint64_t t0 = metrics_now_ns();
         engine().scheduler()->suspend(fiber_context_);
+        engine().metrics().io_latency.record(metrics_now_ns() - t0);
     }
     
     int64_t size() const {return size_;}
@@ -231,8 +234,11 @@ public:
         return "FileMultiIOMessage";
     }
    
-    void wait_for() {
+    void wait_for()
+    {
+        uint64_t t0 = metrics_now_ns();
         engine().scheduler()->suspend(fiber_context_);
+        engine().metrics().io_latency.record(metrics_now_ns() - t0);
     }
     
     void add_submited(size_t num) 
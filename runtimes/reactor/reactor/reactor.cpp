@@ -57,27 +57,55 @@ void Reactor::start()
 
 void Reactor::event_loop (uint64_t iopoll_timeout)
 {
-    scheduler_ = new Scheduler<Reactor>(shared_from_this());
+    WorkStealingQueue* steal_queue = app().is_work_stealing() ? &smp_->steal_queue(cpu_) : nullptr;
+
+    scheduler_ = new Scheduler<Reactor>(shared_from_this(), steal_queue);
+    scheduler_->set_task_quota(std::chrono::microseconds(app().task_quota_us()));
+
+    ReactorMetrics& metrics = smp_->metrics(cpu_);
+    scheduler_->set_metrics(&metrics);
     running_ = true;
 
     boost::fibers::context::active()
         ->get_scheduler()
         ->set_algo(scheduler_);
+
+    fiber_stacks_.set_probe(app().is_fiber_stack_probe());
     
     CallDuration fiber_stat;
     CallDuration yield_stat;
     CallDuration finish_stat;
         
-    auto process_fn = [&](Message* msg) {
-        if (msg->is_return())
-        {
-            withTime(finish_stat, [&]{
-                msg->finish();
+    auto run_fn = [&](Message* msg) {
+        if (msg->is_migratable() && msg->is_run_in_fiber()) {
+            withTime(fiber_stat, [&]{
+                // The fiber may complete on another reactor
+                auto ff = in_migratable_fiber(msg->scheduling_group(), msg->stack_class(), [msg](){
+                    msg->process();
+
+                    Reactor& reactor = engine();
+                    if (!msg->is_one_way())
+                    {
+                        reactor.smp_->submit_to(msg->cpu(), msg);
+                    }
+                    else {
+                        try {
+                            reactor.handle_memory_objects(msg);
+                        }
+                        catch (...) {
+                            std::terminate();
+                        }
+                    }
+                });
+
+                ff.detach();
             });
         }
         else if (msg->is_run_in_fiber()) {
             withTime(fiber_stat, [&]{
-                boost::fibers::fiber ff(boost::fibers::launch::dispatch, std::allocator_arg_t(), this->fiber_stack_pool_, [&, msg](){
+                auto& stack_pool = this->fiber_stacks_.pool(msg->stack_class());
+                boost::fibers::fiber ff(boost::fibers::launch::dispatch, std::allocator_arg_t(), stack_pool, [&, msg](){
+                    scheduler_->enter_group(boost::fibers::context::active(), msg->scheduling_group());
                     msg->process();
                     if (!msg->is_one_way())
                     {
@@ -113,15 +141,48 @@ void Reactor::event_loop (uint64_t iopoll_timeout)
         }
     };
 
+    auto process_fn = [&](Message* msg) {
+        // Messages not sent through the inboxes aren't stamped
+        if (msg->sent_ns())
+        {
+            metrics.queue_delay.record(metrics_now_ns() - msg->sent_ns());
+            msg->set_sent_ns(0);
+        }
+
+        if (msg->is_return())
+        {
+            metrics.returns.inc();
+            withTime(finish_stat, [&]{
+                msg->finish();
+            });
+        }
+        else if (steal_queue && msg->is_migratable()) {
+            metrics.messages.inc();
+            // Started later, unless stolen by an idle reactor first
+            steal_queue->push_message(msg);
+        }
+        else {
+            metrics.messages.inc();
+            run_fn(msg);
+        }
+    };
+
     bool restart_iocontext{};
 
     uint64_t io_poll_batch = 32;
+    uint64_t iteration_start_ns = metrics_now_ns();
     while(running_ /*|| boost::fibers::context::contexts() > fibers::DEFAULT_CONTEXTS*/)
     {
+        uint64_t now_ns = metrics_now_ns();
+        metrics.poll_iteration.record(now_ns - iteration_start_ns);
+        iteration_start_ns = now_ns;
+
         if (++io_poll_cnt_ >= io_poll_batch)
         {
             io_poll_cnt_ = 0;
 
+            metrics.publish(fiber_stacks_);
+
             bool use_long_timeout{};
 
 //            if (this->idle_ticks() >= io_poll_batch)
@@ -140,6 +201,7 @@ void Reactor::event_loop (uint64_t iopoll_timeout)
                 this->reset_idle_ticks();
                 auto msg = ring_buffer_.pop_back();
                 if (msg) {
+                    metrics.io_events.inc();
                     process_fn(msg);
                 }
             }
@@ -159,6 +221,18 @@ void Reactor::event_loop (uint64_t iopoll_timeout)
         for (auto& task_queue: tasks_queues_) {
             task_queue.receive(process_fn);
         }
+
+        if (steal_queue)
+        {
+            for (size_t c = steal_queue->fibers(); c < WORK_STEALING_LOCAL_BATCH; c++)
+            {
+                Message* msg = steal_queue->pop_message();
+                if (!msg) {
+                    break;
+                }
+                run_fn(msg);
+            }
+        }
         
         auto acct0 = scheduler_->activations();
 
@@ -168,8 +242,21 @@ void Reactor::event_loop (uint64_t iopoll_timeout)
 
         auto acct1 = scheduler_->activations();
 
-        if (acct1 - acct0 <= service_fibers_) {
+        if (acct1 - acct0 <= service_fibers_)
+        {
+            if (steal_queue && steal_work(*steal_queue))
+            {
+                this->reset_idle_ticks();
+                continue;
+            }
+
             this->inc_idle_ticks();
+
+            // Give physical memory of cold idle stacks back
+            // once the reactor has been idle for a while.
+            if (this->idle_ticks() == FIBER_STACKS_TRIM_IDLE_TICKS) {
+                fiber_stacks_.trim();
+            }
         }
         else {
             this->reset_idle_ticks();
@@ -186,10 +273,111 @@ void Reactor::event_loop (uint64_t iopoll_timeout)
     
         std::cout << buf.str();
     }
+
+    if (app().is_debug() && steal_queue)
+    {
+        auto stats = steal_queue->stats();
+
+        SBuf buf;
+        buf << "Work stealing for " << cpu_ << ": fibers stolen: " << stats.stolen_fibers << ", messages stolen: " << stats.stolen_messages << "\n";
+
+        std::cout << buf.str();
+    }
+
+    if (app().is_debug())
+    {
+        SBuf buf;
+        dump_scheduling_group_stats(buf.buffer());
+        std::cout << buf.str();
+    }
+
+    if (app().is_debug() || fiber_stacks_.probe())
+    {
+        SBuf buf;
+        dump_fiber_stacks_stats(buf.buffer());
+        std::cout << buf.str();
+    }
     
     thread_pool_.stop_workers();
 }
 
+void Reactor::dump_fiber_stacks_stats(std::ostream& out) const
+{
+    fiber_stacks_.for_each([&](FiberStackClass cls, const memoria::fibers::stack_pool_stats& stats){
+        if (stats.allocations)
+        {
+            out << "Fiber stacks " << FiberStackPools::name(cls) << " for " << cpu_
+                << ": size: " << stats.stack_size
+                << ", allocations: " << stats.allocations
+                << ", peak live: " << stats.peak_live
+                << ", pooled: " << stats.pooled
+                << ", trimmed: " << stats.trimmed;
+
+            if (fiber_stacks_.probe()) {
+                out << ", watermark: " << stats.watermark;
+            }
+
+            out << "\n";
+        }
+    });
+}
+
+void Reactor::dump_scheduling_group_stats(std::ostream& out) const
+{
+    auto& registry = SchedulingGroupRegistry::instance();
+    for (size_t c = 0; c < registry.size(); c++)
+    {
+        SchedulingGroup group(static_cast<uint32_t>(c));
+        auto stats = scheduler_->group_stats(group);
+        if (stats.activations)
+        {
+            out << "Scheduling group " << group.name() << " for " << cpu_
+                << ": runtime, us: " << stats.runtime_ns / 1000
+                << ", activations: " << stats.activations
+                << ", queue delay avg, us: " << stats.queue_delay_ns / stats.activations / 1000
+                << ", max, us: " << stats.max_queue_delay_ns / 1000
+                << ", latency goal misses: " << stats.latency_goal_misses
+                << "\n";
+        }
+    }
+}
+
+// Takes one pending migratable message or one ready migratable
+// fiber from a peer, trying peers round-robin. Messages are preferred
+// as they have not been started yet. Stolen work is added to the own
+// queue and is picked up on the next iteration of the event loop.
+bool Reactor::steal_work(WorkStealingQueue& own_queue)
+{
+    if (own_queue.fibers() || own_queue.messages()) {
+        return false;
+    }
+
+    int cpus = smp_->cpu_num();
+    for (int c = 0; c < cpus; c++)
+    {
+        int victim = steal_victim_;
+        steal_victim_ = (steal_victim_ + 1) % cpus;
+
+        if (victim == cpu_) {
+            continue;
+        }
+
+        WorkStealingQueue& queue = smp_->steal_queue(victim);
+
+        if (Message* msg = queue.steal_message()) {
+            own_queue.push_message(msg);
+            return true;
+        }
+
+        if (boost::fibers::context* ctx = queue.steal_fiber()) {
+            scheduler_->push_stolen(ctx);
+            return true;
+        }
+    }
+
+    return false;
+}
+
 void Reactor::handle_memory_objects(MemoryObject* obj)
 {
     MemoryObjectList& list = MemoryObjectList::list(cpu_);
@@ -17,6 +17,8 @@
 #include <memoria/seastar/hrpc/session.hpp>
 #include <memoria/seastar/hrpc/hrpc.hpp>
 
+#include <seastar/core/coroutine.hh>
+
 
 namespace memoria::seastar::hrpc {
 
@@ -91,31 +93,129 @@ SeastarTCPClientMessageProvider(ss::connected_socket socket):
 }
 
 
-RawMessagePtr TCPMessageProviderBase::read_message()
-{
-    constexpr size_t basic_header_size = MessageHeader::basic_size();
+namespace {
+
+using TmpBuffer = ss::temporary_buffer<char>;
+using ConsumptionResult = ss::consumption_result<char>;
 
-    auto header_buf = input_stream_.read_exactly(basic_header_size).get();
+// Received buffers backing RawMessagePtrs, keyed by their data. Seastar
+// buffers are shard-local, so are the messages sharing them.
+thread_local ska::flat_hash_map<const void*, TmpBuffer> shared_buffers;
 
-    if (header_buf.size() < basic_header_size) {
-        return RawMessagePtr{nullptr, ::free};
+void release_shared_buffer(void* ptr) {
+    shared_buffers.erase(ptr);
+}
+
+RawMessagePtr share_buffer(TmpBuffer&& buffer)
+{
+    uint8_t* ptr = ptr_cast<uint8_t>(buffer.get_write());
+
+    // Message's arena expects its buffer to be aligned as the header is
+    if (reinterpret_cast<uintptr_t>(ptr) % alignof(MessageHeader))
+    {
+        auto copy = allocate_system<uint8_t>(buffer.size());
+        std::memcpy(copy.get(), buffer.get(), buffer.size());
+        return copy;
     }
 
-    MessageHeader* header = ptr_cast<MessageHeader>(header_buf.get());
-    auto buffer = allocate_system<uint8_t>(header->message_size());
+    shared_buffers[ptr] = std::move(buffer);
+    return RawMessagePtr{ptr, release_shared_buffer};
+}
+
+
+// Input stream consumer assembling one message. A message contained
+// in a single received buffer is shared, otherwise it's gathered into
+// a buffer of the message's size.
+class MessageAssembler {
+    static constexpr size_t basic_header_size = MessageHeader::basic_size();
 
-    std::memcpy(buffer.get(), header_buf.get(), basic_header_size);
+    alignas(MessageHeader) uint8_t header_[basic_header_size];
+    size_t header_pos_{};
 
-    size_t msg_size = header->message_size() - basic_header_size;
-    auto data_buf = input_stream_.read_exactly(msg_size).get();
+    TmpBuffer message_;
+    size_t message_pos_{};
+
+public:
+    ss::future<ConsumptionResult> operator()(TmpBuffer buffer)
+    {
+        return ss::futurize_invoke([&] {
+            return consume(buffer);
+        });
+    }
 
-    std::memcpy(buffer.get() + basic_header_size, data_buf.get(), msg_size);
+    RawMessagePtr release()
+    {
+        if (!message_ || message_pos_ < message_.size()) {
+            return RawMessagePtr{nullptr, ::free};
+        }
 
-    if (data_buf.size() < msg_size) {
-        return RawMessagePtr{nullptr, ::free};
+        return share_buffer(std::move(message_));
     }
 
-    return buffer;
+private:
+    ConsumptionResult consume(TmpBuffer& buffer)
+    {
+        if (buffer.empty()) {
+            // End of the stream
+            return ss::stop_consuming<char>(TmpBuffer{});
+        }
+
+        if (!message_)
+        {
+            size_t size = std::min(basic_header_size - header_pos_, buffer.size());
+            std::memcpy(header_ + header_pos_, buffer.get(), size);
+
+            if (header_pos_ + size < basic_header_size) {
+                header_pos_ += size;
+                return ss::continue_consuming{};
+            }
+
+            size_t message_size = ptr_cast<MessageHeader>(header_)->message_size();
+            if (message_size < basic_header_size) {
+                MEMORIA_MAKE_GENERIC_ERROR("Invalid HRPC message size: {}", message_size).do_throw();
+            }
+
+            if (header_pos_ == 0 && buffer.size() >= message_size)
+            {
+                message_ = buffer.share(0, message_size);
+                message_pos_ = message_size;
+                buffer.trim_front(message_size);
+                return ss::stop_consuming<char>(std::move(buffer));
+            }
+
+            message_ = TmpBuffer(message_size);
+            std::memcpy(message_.get_write(), header_, basic_header_size);
+            message_pos_ = basic_header_size;
+
+            buffer.trim_front(size);
+        }
+
+        size_t size = std::min(message_.size() - message_pos_, buffer.size());
+        std::memcpy(message_.get_write() + message_pos_, buffer.get(), size);
+        message_pos_ += size;
+        buffer.trim_front(size);
+
+        if (message_pos_ < message_.size()) {
+            return ss::continue_consuming{};
+        }
+
+        return ss::stop_consuming<char>(std::move(buffer));
+    }
+};
+
+}
+
+
+RawMessagePtr TCPMessageProviderBase::read_message() {
+    return read_message_async().get();
+}
+
+
+ss::future<RawMessagePtr> TCPMessageProviderBase::read_message_async()
+{
+    MessageAssembler assembler;
+    co_await input_stream_.consume(std::ref(assembler));
+    co_return assembler.release();
 }
 
 
@@ -123,8 +223,73 @@ void TCPMessageProviderBase::write_message(
         const MessageHeader& header,
         const uint8_t* data
 ) {
-    output_stream_.write(ptr_cast<char>(data), header.message_size()).get();
-    output_stream_.flush().get();
+    while (send_queue_bytes_ >= SEND_QUEUE_LIMIT && !send_error_) {
+        send_cv_.wait().get();
+    }
+
+    if (send_error_) {
+        std::rethrow_exception(send_error_);
+    }
+
+    TmpBuffer buffer(ptr_cast<const char>(data), header.message_size());
+    send_queue_bytes_ += buffer.size();
+    send_queue_.push_back(std::move(buffer));
+
+    if (!sending_) {
+        sending_ = true;
+        (void)send_loop();
+    }
+}
+
+
+ss::future<> TCPMessageProviderBase::send_loop()
+{
+    std::vector<TmpBuffer> batch;
+    try {
+        while (!send_queue_.empty())
+        {
+            std::swap(batch, send_queue_);
+
+            size_t batch_bytes{};
+            for (auto& buffer: batch) {
+                batch_bytes += buffer.size();
+                co_await output_stream_.write(std::move(buffer));
+            }
+            batch.clear();
+
+            // One flush per batch of messages queued
+            // while the previous one was being sent.
+            co_await output_stream_.flush();
+
+            send_queue_bytes_ -= batch_bytes;
+            send_cv_.broadcast();
+        }
+    }
+    catch (...) {
+        send_error_ = std::current_exception();
+        send_queue_.clear();
+        send_queue_bytes_ = 0;
+    }
+
+    sending_ = false;
+    send_cv_.broadcast();
+}
+
+
+void TCPMessageProviderBase::drain_send_queue() noexcept
+{
+    if (!ss::thread::running_in_thread()) {
+        return;
+    }
+
+    try {
+        while (sending_) {
+            send_cv_.wait().get();
+        }
+    }
+    catch (...) {
+        println("Exception draining HRPC send queue");
+    }
 }
 
 
@@ -39,7 +39,7 @@ public:
 
     void wait_for_lease() {
         flow_control_.wait([&](){
-            return batch_size_ >= batch_size_limit_;
+            return has_credit();
         }).get();
     }
 
@@ -24,6 +24,9 @@
 #include <seastar/core/reactor.hh>
 #include <seastar/core/thread.hh>
 #include <seastar/core/shared_mutex.hh>
+#include <seastar/core/condition-variable.hh>
+#include <seastar/core/temporary_buffer.hh>
+#include <seastar/core/iostream.hh>
 #include <seastar/net/api.hh>
 
 #include <boost/asio.hpp>
@@ -89,9 +92,22 @@ public:
 
 class TCPMessageProviderBase: public st::MessageProvider  {
 protected:
+    // Bytes of queued but not yet flushed messages
+    // above which writers are blocked.
+    static constexpr size_t SEND_QUEUE_LIMIT = 1024 * 1024;
+
     ss::input_stream<char> input_stream_;
     ss::output_stream<char> output_stream_;
     bool closed_{};
+
+    // Messages written while the send loop is busy are
+    // queued and flushed together with the next batch.
+    std::vector<ss::temporary_buffer<char>> send_queue_;
+    size_t send_queue_bytes_{};
+    bool sending_{};
+    std::exception_ptr send_error_;
+    ss::condition_variable send_cv_;
+
 public:
     TCPMessageProviderBase(
         ss::input_stream<char> input_stream,
@@ -114,6 +130,17 @@ public:
 
     RawMessagePtr read_message() override;
     void write_message(const MessageHeader& header, const uint8_t* data) override;
+
+    // Resolves to an empty pointer at the end of the stream. The
+    // message shares the received buffer when it's not split between
+    // reads, and must be released on the shard that has read it.
+    ss::future<RawMessagePtr> read_message_async();
+
+protected:
+    ss::future<> send_loop();
+
+    // Waits for queued messages to be flushed. No-op outside of a seastar thread.
+    void drain_send_queue() noexcept;
 };
 
 
@@ -124,6 +151,7 @@ public:
     SeastarTCPClientMessageProvider(::seastar::connected_socket socket);
 
     void close() noexcept override {
+        drain_send_queue();
         try {
             socket_.shutdown_input();
             socket_.shutdown_output();
@@ -150,6 +178,7 @@ public:
     );
 
     void close() noexcept override {
+        drain_send_queue();
         try {
             connection_.connection.shutdown_input();
             connection_.connection.shutdown_output();
@@ -0,0 +1,125 @@
+// Copyright 2026 Victor Smirnov
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <memoria/core/types.hpp>
+#include <memoria/profiles/common/block.hpp>
+
+#include <array>
+#include <unordered_map>
+
+namespace memoria::io {
+
+enum class BlockCodec: uint8_t {
+    NONE = 0, LZ4, ZSTD
+};
+
+// Which blocks a store compresses on write. Codec is selected by
+// container type hash, if there is an entry for it, or by the
+// block's caching group otherwise. Compressed blocks are detected
+// on read, so the policy may be changed at any time.
+class BlockCompressionPolicy {
+    static constexpr size_t GROUPS = static_cast<size_t>(BlockCachingGroup::OTHER) + 1;
+
+    std::array<BlockCodec, GROUPS> groups_{};
+    std::unordered_map<uint64_t, BlockCodec> ctr_types_;
+
+    int32_t level_{};
+
+    // Compressed image is stored only if it's not larger than
+    // this percentage of the raw block.
+    uint32_t max_ratio_{90};
+
+public:
+    BlockCompressionPolicy() = default;
+
+    // Leaves are compressed, branches are kept raw.
+    static BlockCompressionPolicy leaves(BlockCodec codec)
+    {
+        BlockCompressionPolicy policy;
+        policy.set_for_group(BlockCachingGroup::LEAF, codec);
+        return policy;
+    }
+
+    BlockCompressionPolicy& set_for_group(BlockCachingGroup group, BlockCodec codec)
+    {
+        groups_[static_cast<size_t>(group)] = codec;
+        return *this;
+    }
+
+    BlockCompressionPolicy& set_for_ctr_type(uint64_t ctr_type_hash, BlockCodec codec)
+    {
+        ctr_types_[ctr_type_hash] = codec;
+        return *this;
+    }
+
+    BlockCompressionPolicy& set_level(int32_t level)
+    {
+        level_ = level;
+        return *this;
+    }
+
+    BlockCompressionPolicy& set_max_ratio(uint32_t percents)
+    {
+        max_ratio_ = percents;
+        return *this;
+    }
+
+    int32_t level() const {
+        return level_;
+    }
+
+    uint32_t max_ratio() const {
+        return max_ratio_;
+    }
+
+    BlockCodec codec_for(uint64_t ctr_type_hash, BlockCachingGroup group) const
+    {
+        if (ctr_types_.size())
+        {
+            auto ii = ctr_types_.find(ctr_type_hash);
+            if (ii != ctr_types_.end()) {
+                return ii->second;
+            }
+        }
+
+        size_t idx = static_cast<size_t>(group);
+        return idx < GROUPS ? groups_[idx] : BlockCodec::NONE;
+    }
+
+    bool uses(BlockCodec codec) const
+    {
+        for (auto cc: groups_) {
+            if (cc == codec) {
+                return true;
+            }
+        }
+
+        for (auto& entry: ctr_types_) {
+            if (entry.second == codec) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool is_enabled() const {
+        return uses(BlockCodec::LZ4) || uses(BlockCodec::ZSTD);
+    }
+};
+
+}
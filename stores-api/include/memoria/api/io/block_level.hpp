@@ -32,6 +32,12 @@ struct BlockIOProvider {
 
     virtual void execute(const IOCmdPtr& graph) = 0;
 
+    // Starts the reads in the graph without waiting for them to complete.
+    // Read commands may have no block attached, in which case the data is
+    // only brought into the provider's cache. This is a hint, providers
+    // without asynchronous I/O may ignore it.
+    virtual void prefetch(const IOCmdPtr& graph) {}
+
     // in bytes
     virtual DevSizeT extent_size() = 0;
 
@@ -77,6 +77,10 @@ public:
     virtual bool is_dump_snapshot_lifecycle() const = 0;
     virtual void set_dump_snapshot_lifecycle(bool do_dump) = 0;
 
+    // Blocks created after the call are carved out of huge page arenas
+    virtual bool is_huge_page_blocks() const = 0;
+    virtual void set_huge_page_blocks(bool enabled) = 0;
+
     virtual SnapshotID root_shaphot_id() const = 0;
     virtual std::vector<SnapshotID> children_of(const SnapshotID& snapshot_id) const = 0;
     virtual std::vector<std::string> children_of_str(const SnapshotID& snapshot_id) const = 0;
@@ -22,6 +22,7 @@
 #include <memoria/core/tools/checks.hpp>
 #include <memoria/profiles/common/common.hpp>
 #include <memoria/api/common/ctr_api.hpp>
+#include <memoria/api/store/store_io_stat.hpp>
 
 
 namespace memoria {
@@ -53,6 +54,21 @@ public:
 
     virtual Optional<U8String> ctr_type_name_for(const CtrID& name) = 0;
 
+    // Block I/O done through this snapshot
+    virtual StoreIOStat io_stat() const {
+        return StoreIOStat{};
+    }
+
+    // Starts recording a timeline of block reads, clones and
+    // allocations of this snapshot, until the trace is stopped.
+    virtual void start_block_access_trace() {
+        MEMORIA_MAKE_GENERIC_ERROR("Block access tracing is not supported by this store").do_throw();
+    }
+
+    virtual std::vector<BlockAccessTraceEntry<Profile>> stop_block_access_trace() {
+        MEMORIA_MAKE_GENERIC_ERROR("Block access tracing is not supported by this store").do_throw();
+    }
+
 //    virtual void walk_containers(
 //            ContainerWalker<Profile>* walker,
 //            const char* allocator_descr = nullptr
@@ -0,0 +1,137 @@
+// Copyright 2026 Victor Smirnov
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memoria/core/types.hpp>
+#include <memoria/core/tools/any_id.hpp>
+#include <memoria/core/tools/optional.hpp>
+#include <memoria/profiles/common/common.hpp>
+
+#include <ostream>
+#include <vector>
+
+namespace memoria {
+
+// Block I/O and cache counters of a store or of a snapshot.
+// Counters only grow, take a difference of two values to get
+// the counts for a time interval.
+struct StoreIOStat {
+    // Blocks requested by containers
+    uint64_t block_reads{};
+
+    // Reads served by the snapshot's block cache and reads resolved
+    // through the block map or the file. Stores without a block cache
+    // count neither.
+    uint64_t cache_hits{};
+    uint64_t cache_misses{};
+
+    // Blocks passed to the store's read-ahead
+    uint64_t block_prefetches{};
+
+    // Copy-on-write clones of existing blocks
+    uint64_t block_clones{};
+
+    // New blocks, not including clones
+    uint64_t block_allocations{};
+
+    // Bytes of new and cloned blocks
+    uint64_t bytes_allocated{};
+
+    uint64_t flushes{};
+    uint64_t bytes_flushed{};
+    uint64_t flush_time_ns{};
+
+    StoreIOStat& operator+=(const StoreIOStat& other) noexcept
+    {
+        block_reads       += other.block_reads;
+        cache_hits        += other.cache_hits;
+        cache_misses      += other.cache_misses;
+        block_prefetches  += other.block_prefetches;
+        block_clones      += other.block_clones;
+        block_allocations += other.block_allocations;
+        bytes_allocated   += other.bytes_allocated;
+        flushes           += other.flushes;
+        bytes_flushed     += other.bytes_flushed;
+        flush_time_ns     += other.flush_time_ns;
+        return *this;
+    }
+
+    StoreIOStat operator-(const StoreIOStat& other) const noexcept
+    {
+        StoreIOStat stat;
+        stat.block_reads       = block_reads - other.block_reads;
+        stat.cache_hits        = cache_hits - other.cache_hits;
+        stat.cache_misses      = cache_misses - other.cache_misses;
+        stat.block_prefetches  = block_prefetches - other.block_prefetches;
+        stat.block_clones      = block_clones - other.block_clones;
+        stat.block_allocations = block_allocations - other.block_allocations;
+        stat.bytes_allocated   = bytes_allocated - other.bytes_allocated;
+        stat.flushes           = flushes - other.flushes;
+        stat.bytes_flushed     = bytes_flushed - other.bytes_flushed;
+        stat.flush_time_ns     = flush_time_ns - other.flush_time_ns;
+        return stat;
+    }
+
+    uint64_t mean_flush_time_ns() const noexcept {
+        return flushes ? flush_time_ns / flushes : 0;
+    }
+};
+
+inline void print(std::ostream& out, const StoreIOStat& stat)
+{
+    out << "Block reads: "       << stat.block_reads
+        << ", cache hits: "      << stat.cache_hits
+        << ", cache misses: "    << stat.cache_misses
+        << ", prefetches: "      << stat.block_prefetches
+        << ", clones: "          << stat.block_clones
+        << ", allocations: "     << stat.block_allocations
+        << ", bytes allocated: " << stat.bytes_allocated
+        << ", flushes: "         << stat.flushes
+        << ", bytes flushed: "   << stat.bytes_flushed
+        << ", mean flush time, us: " << stat.mean_flush_time_ns() / 1000
+        << "\n";
+}
+
+enum class BlockAccessType: uint8_t {
+    READ, CLONE, CREATE
+};
+
+enum class BlockCacheAccess: uint8_t {
+    NONE, HIT, MISS
+};
+
+// Entry of a snapshot's block access timeline
+template <typename Profile>
+struct BlockAccessTraceEntry {
+    using CtrID = ApiProfileCtrID<Profile>;
+
+    // Time since the tracing has been started
+    uint64_t time_ns;
+
+    BlockAccessType type;
+    BlockCacheAccess cache;
+
+    // For clones, the ID of the new block
+    AnyID block_id;
+
+    // Type of the container the block belongs to
+    uint64_t ctr_type_hash;
+    uint64_t block_size;
+
+    // Known for clones and new blocks only
+    Optional<CtrID> ctr_id;
+};
+
+}
@@ -20,6 +20,8 @@
 #include <memoria/core/strings/string.hpp>
 #include <memoria/core/tools/checks.hpp>
 #include <memoria/core/tools/any_id.hpp>
+#include <memoria/core/tools/span.hpp>
+#include <memoria/api/io/block_compression.hpp>
 
 
 #include <functional>
@@ -42,9 +44,24 @@ struct ISWMRStoreSnapshotBase: virtual IROStoreSnapshotCtrOps<Profile> {
 template <typename Profile>
 struct ISWMRStoreWritableSnapshot: virtual ISWMRStoreSnapshotBase<Profile>, virtual IROStoreWritableSnapshotCtrOps<Profile> {
     using SnapshotID = ApiProfileSnapshotID<Profile>;
+    using CtrID = ApiProfileCtrID<Profile>;
 
     virtual void set_transient(bool transient) = 0;
 
+    // Relocates container's blocks, not yet owned by this snapshot, into
+    // contiguous runs using regular CoW path.
+    virtual void compact(const CtrID& ctr_id) = 0;
+    virtual void compact() = 0;
+
+    // Opens a session updating the container (existing or to be created
+    // through the session) on another thread, concurrently with sessions
+    // of other containers, including clones sharing blocks with it.
+    // Snapshot's own containers are not accessible while it has open
+    // sessions. Session's commit() merges it into the snapshot, sessions
+    // left open are merged by snapshot's prepare(). Session pointers must
+    // be released before the snapshot is committed.
+    virtual SharedPtr<ISWMRStoreWritableSnapshot> open_write_session(const CtrID& ctr_id) = 0;
+
     virtual void prepare(ConsistencyPoint cp = ConsistencyPoint::AUTO) = 0;
     virtual void rollback() = 0;
 
@@ -122,6 +139,10 @@ struct IBasicSWMRStore {
     virtual Optional<SequenceID> check(const CheckResultConsumerFn& consumer) = 0;
 
     virtual U8String describe() const = 0;
+
+    // Block I/O, cache and flush counters of all snapshots
+    // and threads since the store has been opened.
+    virtual StoreIOStat io_stat() const = 0;
 };
 
 
@@ -129,6 +150,22 @@ enum class FlushType {
     DEFAULT, FULL = DEFAULT
 };
 
+// Receives replication records: byte images of committed snapshots,
+// to be applied to a follower store in the same order.
+using SWMRReplicationSinkFn = std::function<void (Span<const uint8_t>)>;
+
+struct SWMRReplicationStatus {
+    uint64_t records{};
+    uint64_t bytes{};
+
+    // Sequence ID of the last shipped or applied snapshot.
+    uint64_t sequence_id{};
+
+    // Time between the leader's commit and the follower's
+    // apply of the last record, in milliseconds.
+    int64_t lag_ms{};
+};
+
 template <typename Profile>
 struct ISWMRStore: IBasicSWMRStore<Profile> {
     using Base = IBasicSWMRStore<Profile>;
@@ -177,8 +214,29 @@ struct ISWMRStore: IBasicSWMRStore<Profile> {
 
     virtual Optional<SequenceID> check(const CheckResultConsumerFn& consumer) = 0;
 
+    // The same checks as check(), spread over a pool of threads. Blocks
+    // shared by snapshots are checked and traversed once.
+    virtual Optional<SequenceID> check_parallel(
+            const CheckResultConsumerFn& consumer,
+            const StoreCheckOptions& options = StoreCheckOptions{}
+    ) = 0;
+
     virtual HistoryPtr history_view() = 0;
 
+    // Leader side. Every commit made after the call passes a replication
+    // record with the commit's new blocks and header updates to the sink
+    // before the commit returns. An empty sink disables replication.
+    virtual void set_replication_sink(SWMRReplicationSinkFn sink) = 0;
+
+    // Follower side, for stores opened with SWMRParams::open_follower()
+    // over a copy of the leader's file. Writes the record into the file and
+    // makes its snapshot visible to open(). Returns false, leaving the store
+    // unchanged, if the record evicts a snapshot that is still open here.
+    // Such record should be applied again later.
+    virtual bool apply_replication_record(Span<const uint8_t> record) = 0;
+
+    virtual SWMRReplicationStatus replication_status() = 0;
+
     virtual void close() = 0;
 
     virtual uint64_t count_refs(const AnyID& block_id) = 0;
@@ -188,7 +246,10 @@ struct ISWMRStore: IBasicSWMRStore<Profile> {
 
 class SWMRParams {
     Optional<uint64_t> file_size_; // in MB
+    Optional<uint64_t> max_file_size_; // in MB
     bool read_only_{false};
+    bool follower_{false};
+    bool huge_pages_{false};
 public:
     SWMRParams(uint64_t file_size) noexcept :
         file_size_(file_size)
@@ -203,13 +264,46 @@ public:
         return *this;
     }
 
+    // Read-only for clients, but accepts replication records
+    SWMRParams& open_follower(bool follower = true) noexcept {
+        follower_ = follower;
+        return *this;
+    }
+
+    // Upper bound of the file's size in this process. Mapped stores
+    // reserve this much of the address space up front, so the file can be
+    // grown while the store is online without moving the mapping.
+    SWMRParams& set_max_file_size(uint64_t size_mb) noexcept {
+        max_file_size_ = size_mb;
+        return *this;
+    }
+
+    // Backs the store's memory with huge pages: transparent ones for
+    // regular files and raw buffers, explicit ones for files on hugetlbfs.
+    SWMRParams& use_huge_pages(bool huge_pages = true) noexcept {
+        huge_pages_ = huge_pages;
+        return *this;
+    }
+
     const Optional<uint64_t>& file_size() const noexcept {
         return file_size_;
     }
 
+    const Optional<uint64_t>& max_file_size() const noexcept {
+        return max_file_size_;
+    }
+
     bool is_read_only() const noexcept {
         return read_only_;
     }
+
+    bool is_follower() const noexcept {
+        return follower_;
+    }
+
+    bool is_huge_pages() const noexcept {
+        return huge_pages_;
+    }
 };
 
 std::unique_ptr<SWMRStoreGraphVisitor<CoreApiProfile>> create_graphviz_dot_visitor(U8StringView path);
@@ -224,8 +318,8 @@ SharedPtr<ISWMRStore<CoreApiProfile>> open_lite_swmr_store(U8StringView path, co
 SharedPtr<ISWMRStore<CoreApiProfile>> create_lite_swmr_store(U8StringView path, const SWMRParams& params);
 bool is_lite_swmr_store(U8StringView path);
 
-SharedPtr<ISWMRStore<CoreApiProfile>> open_lite_raw_swmr_store(Span<uint8_t> buffer);
-SharedPtr<ISWMRStore<CoreApiProfile>> create_lite_raw_swmr_store(Span<uint8_t> buffer);
+SharedPtr<ISWMRStore<CoreApiProfile>> open_lite_raw_swmr_store(Span<uint8_t> buffer, const SWMRParams& params = SWMRParams());
+SharedPtr<ISWMRStore<CoreApiProfile>> create_lite_raw_swmr_store(Span<uint8_t> buffer, const SWMRParams& params = SWMRParams());
 bool is_lite_raw_swmr_store(Span<uint8_t> buffer);
 
 
@@ -241,6 +335,17 @@ struct ILMDBStore: IBasicSWMRStore<Profile> {
     virtual void set_async(bool is_async) = 0;
     virtual void copy_to(U8String path, bool with_compaction = true) = 0;
     virtual void flush(bool force = true) = 0;
+
+    // Applies to snapshots started after the call. Blocks written
+    // with compression are readable regardless of the current policy.
+    virtual void set_block_compression(const io::BlockCompressionPolicy& policy) = 0;
+    virtual io::BlockCompressionPolicy block_compression() const = 0;
+
+    // Max number of blocks a writable snapshot keeps in memory. Updated
+    // blocks evicted from the cache are written to the transaction's
+    // pages. Applies to snapshots started after the call.
+    virtual void set_block_cache_size(size_t blocks) = 0;
+    virtual size_t block_cache_size() const = 0;
 };
 
 SharedPtr<ILMDBStore<CoreApiProfile>> open_lmdb_store(U8StringView path);
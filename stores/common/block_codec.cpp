@@ -0,0 +1,204 @@
+// Copyright 2026 Victor Smirnov
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memoria/store/common/block_codec.hpp>
+#include <memoria/core/tools/result.hpp>
+#include <memoria/core/memory/ptr_cast.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef MEMORIA_HAS_LZ4
+#include <lz4.h>
+#endif
+
+#ifdef MEMORIA_HAS_ZSTD
+#include <zstd.h>
+#endif
+
+namespace memoria::io {
+
+namespace {
+
+size_t payload_bound(BlockCodec codec, size_t raw_size)
+{
+    switch (codec) {
+#ifdef MEMORIA_HAS_LZ4
+        case BlockCodec::LZ4: return LZ4_compressBound(static_cast<int>(raw_size));
+#endif
+#ifdef MEMORIA_HAS_ZSTD
+        case BlockCodec::ZSTD: return ZSTD_compressBound(raw_size);
+#endif
+        default: return 0;
+    }
+}
+
+// Returns payload size, or zero if the payload doesn't fit.
+size_t compress_payload(BlockCodec codec, int32_t level, Span<const uint8_t> raw, uint8_t* payload, size_t capacity)
+{
+    switch (codec) {
+#ifdef MEMORIA_HAS_LZ4
+        case BlockCodec::LZ4: {
+            int size = LZ4_compress_fast(
+                ptr_cast<const char>(raw.data()),
+                ptr_cast<char>(payload),
+                static_cast<int>(raw.size()),
+                static_cast<int>(capacity),
+                level > 0 ? level : 1
+            );
+            return size > 0 ? size : 0;
+        }
+#endif
+#ifdef MEMORIA_HAS_ZSTD
+        case BlockCodec::ZSTD: {
+            size_t size = ZSTD_compress(payload, capacity, raw.data(), raw.size(), level);
+            return ZSTD_isError(size) ? 0 : size;
+        }
+#endif
+        default: return 0;
+    }
+}
+
+}
+
+const char* block_codec_name(BlockCodec codec)
+{
+    switch (codec) {
+        case BlockCodec::NONE: return "NONE";
+        case BlockCodec::LZ4:  return "LZ4";
+        case BlockCodec::ZSTD: return "ZSTD";
+        default: return "UNKNOWN";
+    }
+}
+
+bool is_block_codec_available(BlockCodec codec)
+{
+    switch (codec) {
+#ifdef MEMORIA_HAS_LZ4
+        case BlockCodec::LZ4: return true;
+#endif
+#ifdef MEMORIA_HAS_ZSTD
+        case BlockCodec::ZSTD: return true;
+#endif
+        default: return false;
+    }
+}
+
+bool compress_block(
+        BlockCodec codec,
+        int32_t level,
+        Span<const uint8_t> raw,
+        size_t max_size,
+        std::vector<uint8_t>& image
+)
+{
+    size_t bound = payload_bound(codec, raw.size());
+    if (bound == 0 || max_size <= sizeof(CompressedBlockHeader)) {
+        return false;
+    }
+
+    size_t capacity = std::min(bound, max_size - sizeof(CompressedBlockHeader));
+    image.resize(sizeof(CompressedBlockHeader) + capacity);
+
+    size_t payload_size = compress_payload(
+        codec, level, raw, image.data() + sizeof(CompressedBlockHeader), capacity
+    );
+
+    if (payload_size == 0) {
+        return false;
+    }
+
+    CompressedBlockHeader header{};
+    header.magic = CompressedBlockHeader::MAGIC;
+    header.codec = static_cast<uint8_t>(codec);
+    header.raw_size = static_cast<uint32_t>(raw.size());
+    header.payload_size = static_cast<uint32_t>(payload_size);
+
+    std::memcpy(image.data(), &header, sizeof(header));
+    image.resize(sizeof(CompressedBlockHeader) + payload_size);
+
+    return true;
+}
+
+bool is_compressed_block(Span<const uint8_t> image)
+{
+    if (image.size() >= sizeof(CompressedBlockHeader))
+    {
+        uint32_t magic;
+        std::memcpy(&magic, image.data(), sizeof(magic));
+        return magic == CompressedBlockHeader::MAGIC;
+    }
+
+    return false;
+}
+
+size_t compressed_block_raw_size(Span<const uint8_t> image)
+{
+    CompressedBlockHeader header;
+    std::memcpy(&header, image.data(), sizeof(header));
+    return header.raw_size;
+}
+
+void decompress_block(Span<const uint8_t> image, Span<uint8_t> raw)
+{
+    CompressedBlockHeader header;
+    std::memcpy(&header, image.data(), sizeof(header));
+
+    if (header.payload_size + sizeof(header) > image.size() || header.raw_size != raw.size()) {
+        MEMORIA_MAKE_GENERIC_ERROR(
+            "Malformed compressed block image: image size {}, payload size {}, raw size {}",
+            image.size(), header.payload_size, header.raw_size
+        ).do_throw();
+    }
+
+    const uint8_t* payload = image.data() + sizeof(header);
+    BlockCodec codec = static_cast<BlockCodec>(header.codec);
+
+    switch (codec) {
+#ifdef MEMORIA_HAS_LZ4
+        case BlockCodec::LZ4: {
+            int size = LZ4_decompress_safe(
+                ptr_cast<const char>(payload),
+                ptr_cast<char>(raw.data()),
+                static_cast<int>(header.payload_size),
+                static_cast<int>(raw.size())
+            );
+
+            if (size < 0 || static_cast<size_t>(size) != raw.size()) {
+                MEMORIA_MAKE_GENERIC_ERROR("LZ4 block decompression failed, error = {}", size).do_throw();
+            }
+            return;
+        }
+#endif
+#ifdef MEMORIA_HAS_ZSTD
+        case BlockCodec::ZSTD: {
+            size_t size = ZSTD_decompress(raw.data(), raw.size(), payload, header.payload_size);
+            if (ZSTD_isError(size)) {
+                MEMORIA_MAKE_GENERIC_ERROR("Zstd block decompression failed, error = {}", ZSTD_getErrorName(size)).do_throw();
+            }
+            else if (size != raw.size()) {
+                MEMORIA_MAKE_GENERIC_ERROR("Zstd block decompression failed, expected {} bytes, actual {}", raw.size(), size).do_throw();
+            }
+            return;
+        }
+#endif
+        default:
+            MEMORIA_MAKE_GENERIC_ERROR(
+                "Block codec {} is not available in this build",
+                block_codec_name(codec)
+            ).do_throw();
+    }
+}
+
+}
@@ -0,0 +1,59 @@
+// Copyright 2026 Victor Smirnov
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <memoria/api/io/block_compression.hpp>
+#include <memoria/core/tools/span.hpp>
+
+#include <vector>
+
+namespace memoria::io {
+
+// Header of a compressed block image, followed by codec's payload.
+// Raw blocks start with BasicBlockHeader, its first field is block
+// size that is never equal to MAGIC.
+struct CompressedBlockHeader {
+    static constexpr uint32_t MAGIC = 0x4B4C4243; // "CBLK"
+
+    uint32_t magic;
+    uint8_t  codec;
+    uint8_t  reserved[3];
+    uint32_t raw_size;
+    uint32_t payload_size;
+};
+
+const char* block_codec_name(BlockCodec codec);
+
+// LZ4 and Zstd are optional build dependencies.
+bool is_block_codec_available(BlockCodec codec);
+
+// Writes compressed image of the raw block into `image`. Returns false
+// if the codec is not available or the image is larger than max_size.
+bool compress_block(
+        BlockCodec codec,
+        int32_t level,
+        Span<const uint8_t> raw,
+        size_t max_size,
+        std::vector<uint8_t>& image
+);
+
+bool is_compressed_block(Span<const uint8_t> image);
+
+size_t compressed_block_raw_size(Span<const uint8_t> image);
+
+void decompress_block(Span<const uint8_t> image, Span<uint8_t> raw);
+
+}
@@ -0,0 +1,262 @@
+// Copyright 2026 Victor Smirnov
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memoria/api/store/store_io_stat.hpp>
+#include <memoria/profiles/common/common.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace memoria {
+
+// Store-wide I/O counters. Each thread updates its own slot without
+// synchronization, slots are summed up when the statistics are read.
+class StoreStatCounters {
+public:
+    enum Counter: size_t {
+        BLOCK_READS, CACHE_HITS, CACHE_MISSES, BLOCK_PREFETCHES, BLOCK_CLONES,
+        BLOCK_ALLOCATIONS, BYTES_ALLOCATED, FLUSHES, BYTES_FLUSHED,
+        FLUSH_TIME_NS, COUNTERS
+    };
+
+private:
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> values[COUNTERS]{};
+    };
+
+    // Never reused, so a thread's cached slot of a destroyed
+    // store can't be taken for a slot of a new one.
+    uint64_t id_;
+
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<Slot>> slots_;
+
+public:
+    StoreStatCounters(): id_(next_id()) {}
+
+    StoreStatCounters(const StoreStatCounters&) = delete;
+    StoreStatCounters& operator=(const StoreStatCounters&) = delete;
+
+    void add(Counter counter, uint64_t value = 1) {
+        bump(local_slot(), counter, value);
+    }
+
+    void add_flush(uint64_t bytes, uint64_t time_ns)
+    {
+        Slot& slot = local_slot();
+        bump(slot, FLUSHES, 1);
+        bump(slot, BYTES_FLUSHED, bytes);
+        bump(slot, FLUSH_TIME_NS, time_ns);
+    }
+
+    StoreIOStat stat() const
+    {
+        uint64_t values[COUNTERS]{};
+
+        {
+            std::lock_guard<std::mutex> lk(mutex_);
+            for (const auto& slot: slots_)
+            {
+                for (size_t c = 0; c < COUNTERS; c++) {
+                    values[c] += slot->values[c].load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        StoreIOStat stat;
+        stat.block_reads       = values[BLOCK_READS];
+        stat.cache_hits        = values[CACHE_HITS];
+        stat.cache_misses      = values[CACHE_MISSES];
+        stat.block_prefetches  = values[BLOCK_PREFETCHES];
+        stat.block_clones      = values[BLOCK_CLONES];
+        stat.block_allocations = values[BLOCK_ALLOCATIONS];
+        stat.bytes_allocated   = values[BYTES_ALLOCATED];
+        stat.flushes           = values[FLUSHES];
+        stat.bytes_flushed     = values[BYTES_FLUSHED];
+        stat.flush_time_ns     = values[FLUSH_TIME_NS];
+        return stat;
+    }
+
+    static uint64_t now_ns() noexcept {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()
+        ).count();
+    }
+
+private:
+    static void bump(Slot& slot, Counter counter, uint64_t value) noexcept
+    {
+        auto& cnt = slot.values[counter];
+        cnt.store(cnt.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    static uint64_t next_id()
+    {
+        static std::atomic<uint64_t> ids{1};
+        return ids.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    Slot& local_slot()
+    {
+        struct LastSlot {
+            uint64_t id;
+            Slot* slot;
+        };
+
+        thread_local LastSlot last{0, nullptr};
+        if (MMA_LIKELY(last.id == id_)) {
+            return *last.slot;
+        }
+
+        thread_local std::unordered_map<uint64_t, Slot*> thread_slots;
+
+        Slot*& slot = thread_slots[id_];
+        if (!slot)
+        {
+            std::lock_guard<std::mutex> lk(mutex_);
+            slots_.push_back(std::make_unique<Slot>());
+            slot = slots_.back().get();
+        }
+
+        last = LastSlot{id_, slot};
+        return *slot;
+    }
+};
+
+
+// I/O counters of a snapshot, forwarded to the store's counters,
+// and the optional block access trace. Snapshots are not used by
+// several threads at once, so the snapshot's own counters are plain.
+template <typename Profile>
+class SnapshotIOStatCollector {
+    using BlockID = ProfileBlockID<Profile>;
+    using CtrID   = ProfileCtrID<Profile>;
+    using TraceEntryT = BlockAccessTraceEntry<ApiProfile<Profile>>;
+
+    StoreStatCounters* store_counters_;
+    StoreIOStat stat_;
+
+    std::unique_ptr<std::vector<TraceEntryT>> trace_;
+    uint64_t trace_start_ns_{};
+
+public:
+    SnapshotIOStatCollector(StoreStatCounters* store_counters):
+        store_counters_(store_counters)
+    {}
+
+    const StoreIOStat& stat() const {return stat_;}
+
+    // Block header is read only if tracing is enabled
+    template <typename BlockT>
+    void on_read(const BlockID& block_id, const BlockT* block, BlockCacheAccess cache)
+    {
+        stat_.block_reads++;
+        store_counters_->add(StoreStatCounters::BLOCK_READS);
+
+        if (cache == BlockCacheAccess::HIT) {
+            stat_.cache_hits++;
+            store_counters_->add(StoreStatCounters::CACHE_HITS);
+        }
+        else if (cache == BlockCacheAccess::MISS) {
+            stat_.cache_misses++;
+            store_counters_->add(StoreStatCounters::CACHE_MISSES);
+        }
+
+        if (MMA_UNLIKELY((bool)trace_)) {
+            trace(BlockAccessType::READ, cache, block_id, block, Optional<CtrID>{});
+        }
+    }
+
+    void on_prefetch()
+    {
+        stat_.block_prefetches++;
+        store_counters_->add(StoreStatCounters::BLOCK_PREFETCHES);
+    }
+
+    template <typename BlockT>
+    void on_clone(const BlockT* new_block, const CtrID& ctr_id)
+    {
+        uint64_t block_size = new_block->memory_block_size();
+
+        stat_.block_clones++;
+        stat_.bytes_allocated += block_size;
+        store_counters_->add(StoreStatCounters::BLOCK_CLONES);
+        store_counters_->add(StoreStatCounters::BYTES_ALLOCATED, block_size);
+
+        if (MMA_UNLIKELY((bool)trace_)) {
+            trace(BlockAccessType::CLONE, BlockCacheAccess::NONE, new_block->id(), new_block, ctr_id);
+        }
+    }
+
+    template <typename BlockT>
+    void on_create(const BlockT* block, const CtrID& ctr_id)
+    {
+        uint64_t block_size = block->memory_block_size();
+
+        stat_.block_allocations++;
+        stat_.bytes_allocated += block_size;
+        store_counters_->add(StoreStatCounters::BLOCK_ALLOCATIONS);
+        store_counters_->add(StoreStatCounters::BYTES_ALLOCATED, block_size);
+
+        if (MMA_UNLIKELY((bool)trace_)) {
+            trace(BlockAccessType::CREATE, BlockCacheAccess::NONE, block->id(), block, ctr_id);
+        }
+    }
+
+    bool is_tracing() const {return (bool)trace_;}
+
+    void start_trace()
+    {
+        trace_ = std::make_unique<std::vector<TraceEntryT>>();
+        trace_start_ns_ = StoreStatCounters::now_ns();
+    }
+
+    std::vector<TraceEntryT> stop_trace()
+    {
+        std::vector<TraceEntryT> entries;
+        if (trace_) {
+            entries = std::move(*trace_);
+            trace_.reset();
+        }
+        return entries;
+    }
+
+private:
+    template <typename BlockT>
+    void trace(
+            BlockAccessType type,
+            BlockCacheAccess cache,
+            const BlockID& block_id,
+            const BlockT* block,
+            Optional<CtrID> ctr_id
+    ) {
+        trace_->push_back(TraceEntryT{
+            StoreStatCounters::now_ns() - trace_start_ns_,
+            type,
+            cache,
+            AnyID::wrap(block_id),
+            block->ctr_type_hash(),
+            static_cast<uint64_t>(block->memory_block_size()),
+            ctr_id
+        });
+    }
+};
+
+}
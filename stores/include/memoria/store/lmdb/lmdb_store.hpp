@@ -76,7 +76,12 @@ class LMDBStore:
     MDB_dbi system_db_{};
     MDB_dbi data_db_{};
 
+    io::BlockCompressionPolicy block_compression_;
+    size_t block_cache_size_{1024 * 1024};
+
     mutable std::recursive_mutex store_mutex_;
+
+    StoreStatCounters io_stat_counters_;
 public:
     // create store
     LMDBStore(MaybeError& maybe_error, U8String file_name, uint64_t file_size_mb):
@@ -247,6 +252,43 @@ public:
         }
     }
 
+    virtual void set_block_compression(const io::BlockCompressionPolicy& policy)
+    {
+        for (auto codec: {io::BlockCodec::LZ4, io::BlockCodec::ZSTD})
+        {
+            if (policy.uses(codec) && !io::is_block_codec_available(codec)) {
+                MEMORIA_MAKE_GENERIC_ERROR(
+                    "Block codec {} is not available in this build", io::block_codec_name(codec)
+                ).do_throw();
+            }
+        }
+
+        LockGuard lock(store_mutex_);
+        block_compression_ = policy;
+    }
+
+    virtual io::BlockCompressionPolicy block_compression() const
+    {
+        LockGuard lock(store_mutex_);
+        return block_compression_;
+    }
+
+    virtual void set_block_cache_size(size_t blocks)
+    {
+        if (blocks == 0) {
+            MEMORIA_MAKE_GENERIC_ERROR("Block cache size must be greater than zero").do_throw();
+        }
+
+        LockGuard lock(store_mutex_);
+        block_cache_size_ = blocks;
+    }
+
+    virtual size_t block_cache_size() const
+    {
+        LockGuard lock(store_mutex_);
+        return block_cache_size_;
+    }
+
     virtual ReadOnlySnapshotPtr open()
     {
 
@@ -332,6 +374,14 @@ public:
         return format_u8("LMDBStore<{}>", TypeNameFactory<Profile>::name());
     }
 
+    virtual StoreIOStat io_stat() const {
+        return io_stat_counters_.stat();
+    }
+
+    StoreStatCounters& io_stat_counters() {
+        return io_stat_counters_;
+    }
+
 private:
     void init_store()
     {
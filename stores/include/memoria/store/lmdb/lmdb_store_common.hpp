@@ -18,6 +18,8 @@
 
 #include <memoria/api/store/swmr_store_api.hpp>
 #include <memoria/store/lmdb/lmdb_store_superblock.hpp>
+#include <memoria/store/common/block_codec.hpp>
+#include <memoria/store/common/store_stat_counters.hpp>
 #include <memoria/core/memory/memory.hpp>
 #include <memoria/core/container/ctr_impl.hpp>
 #include <memoria/core/container/ctr_instance_pool.hpp>
@@ -90,6 +92,8 @@ protected:
 
     hermes::HermesCtr metadata_;
 
+    SnapshotIOStatCollector<Profile> io_stat_;
+
     template <typename> friend class SWMRMappedStoreHistoryView;
 
 public:
@@ -100,7 +104,8 @@ public:
     ):
         store_(store),
         mdb_env_(mdb_env),
-        transaction_(), system_db_(), data_db_()
+        transaction_(), system_db_(), data_db_(),
+        io_stat_(&store->io_stat_counters())
     {
         instance_pool_ = std::make_shared<CtrInstancePool<Profile>>();
     }
@@ -400,6 +405,18 @@ public:
         return Optional<U8String>{};
     }
 
+    virtual StoreIOStat io_stat() const {
+        return io_stat_.stat();
+    }
+
+    virtual void start_block_access_trace() {
+        io_stat_.start_trace();
+    }
+
+    virtual std::vector<BlockAccessTraceEntry<ApiProfileT>> stop_block_access_trace() {
+        return io_stat_.stop_trace();
+    }
+
     virtual SnpSharedPtr<IStoreApiBase<ApiProfileT>> snapshot_ref_opening_allowed() {
         return SnpSharedPtr<IStoreApiBase<ApiProfileT>>{};
     }
@@ -478,6 +495,22 @@ protected:
         }
     }
 
+    static bool is_compressed_data(const MDB_val& data) {
+        return io::is_compressed_block(Span<const uint8_t>(ptr_cast<const uint8_t>(data.mv_data), data.mv_size));
+    }
+
+    // Returns malloc'ed block, the caller takes the ownership.
+    BlockType* decompress_data(const MDB_val& data)
+    {
+        Span<const uint8_t> image(ptr_cast<const uint8_t>(data.mv_data), data.mv_size);
+        size_t raw_size = io::compressed_block_raw_size(image);
+
+        auto block_addr = allocate_system<uint8_t>(raw_size);
+        io::decompress_block(image, Span<uint8_t>(block_addr.get(), raw_size));
+
+        return ptr_cast<BlockType>(block_addr.release());
+    }
+
     /*
     std::enable_if_t<!std::is_same_v<CtrID, BlockID>, MDB_val> get_data_addr(const CtrID& ctr_id, MDB_dbi dbi)
     {
@@ -58,8 +58,27 @@ protected:
     using Base::system_db_;
     using Base::data_db_;
     using Base::get_data_addr;
+    using Base::is_compressed_data;
+    using Base::decompress_data;
 
-    using BlockGuardCache = SimpleTwoQueueCache<BlockID, Shared>;
+    // Compressed blocks are decompressed into buffers owned by
+    // the cache entry, others are views into LMDB's map.
+    struct CacheEntryBase: Shared {
+        bool owned_{false};
+
+        CacheEntryBase(const BlockID& id, BlockType* block, bool owned):
+            Shared(id, block), owned_(owned)
+        {}
+
+        ~CacheEntryBase() noexcept
+        {
+            if (owned_) {
+                ::free(this->get());
+            }
+        }
+    };
+
+    using BlockGuardCache = SimpleTwoQueueCache<BlockID, CacheEntryBase>;
     using BlockCacheEntry = typename BlockGuardCache::EntryT;
 
     template <typename>
@@ -166,6 +185,9 @@ protected:
         });
     }
 
+    // Blocks are views into LMDB's read-only map, valid for the
+    // lifetime of the read transaction. Only compressed blocks
+    // are copied.
     virtual SharedBlockConstPtr getBlock(const BlockID& id)
     {
         if (MMA_UNLIKELY(id.is_null())) {
@@ -174,18 +196,21 @@ protected:
 
         auto block = block_shared_cache_.get(id);
         if (block) {
+            this->io_stat_.on_read(id, block.value()->get(), BlockCacheAccess::HIT);
             return block.value();
         }
         else {
             auto block_ptr = get_data_addr(id, data_db_);
             if (block_ptr.mv_data) {
-                BlockType* block = ptr_cast<BlockType>(block_ptr.mv_data);
+                bool compressed = is_compressed_data(block_ptr);
+                BlockType* block = compressed ? decompress_data(block_ptr) : ptr_cast<BlockType>(block_ptr.mv_data);
 
-                BlockCacheEntry* entry = block_shared_cache_pool_.construct(id, block);
+                BlockCacheEntry* entry = block_shared_cache_pool_.construct(id, block, compressed);
                 entry->set_store(this);
 
                 block_shared_cache_.insert(entry);
 
+                this->io_stat_.on_read(id, block, BlockCacheAccess::MISS);
                 return entry;
             }
             else {
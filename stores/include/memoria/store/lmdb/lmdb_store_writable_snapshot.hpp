@@ -22,6 +22,7 @@
 #include <memoria/core/tools/2q_cache.hpp>
 
 #include <type_traits>
+#include <unordered_set>
 
 template <typename Profile>
 class LMDBStoreReadOnlySnapshot;
@@ -65,6 +66,7 @@ class LMDBStoreWritableSnapshot:
     struct CacheEntryBase: Shared {
         UpdatedEntriesMemberHook upd_hook_;
         bool deleted_{false};
+        bool view_{false};
 
         CacheEntryBase(const BlockID& id, BlockType* block)  :
             Shared(id, block),
@@ -82,6 +84,16 @@ class LMDBStoreWritableSnapshot:
         bool is_deleted() const {
           return deleted_;
         }
+
+        // Block data points into LMDB's memory map and is not owned
+        // by the entry.
+        bool is_view() const {
+          return view_;
+        }
+
+        void set_view(bool view) {
+          view_ = view;
+        }
     };
 
     using BlockCache = TwoQueueCache<BlockID, CacheEntryBase>;
@@ -112,12 +124,25 @@ class LMDBStoreWritableSnapshot:
     using Base::data_db_;
     using Base::store_;
     using Base::get_data_addr;
+    using Base::is_compressed_data;
+    using Base::decompress_data;
     using Base::mutable_;
 
     boost::object_pool<BlockCacheEntry> block_cache_entry_pool_;
     BlockCache block_cache_;
     UpdatedEntriesList updated_entries_;
 
+    // Blocks written to the data_db by this transaction. They live in dirty
+    // pages that LMDB may move on subsequent updates, so they can't be
+    // served as views.
+    std::unordered_set<BlockID> written_blocks_;
+
+    io::BlockCompressionPolicy block_compression_;
+    std::vector<uint8_t> compression_buffer_;
+
+    // Bytes put into the database by this transaction
+    uint64_t put_bytes_{};
+
     bool committed_{false};
     bool allocator_initialization_mode_{false};
 
@@ -136,13 +161,14 @@ public:
             MDB_dbi data_db
     )  :
         Base(maybe_error, store, mdb_env),
-        block_cache_(1024*1024, [this](bool keep_entry, BlockCacheEntry* entry){
+        block_cache_(store->block_cache_size(), [this](bool keep_entry, BlockCacheEntry* entry){
             return this->evictionFn(keep_entry, entry);
         })
     {
         mutable_ = true;
 
         superblock_ = superblock;
+        block_compression_ = store->block_compression();
         system_db_ = system_db;
         data_db_ = data_db;
 
@@ -179,11 +205,12 @@ public:
             InitLMDBStoreTag
     ) :
         Base(maybe_error, store, mdb_env),
-        block_cache_(1024*1024, [this](bool keep_entry, BlockCacheEntry* entry){
+        block_cache_(store->block_cache_size(), [this](bool keep_entry, BlockCacheEntry* entry){
             return this->evictionFn(keep_entry, entry);
         })
     {
         superblock_ = superblock;
+        block_compression_ = store->block_compression();
         system_db_ = system_db;
         data_db_ = data_db;
 
@@ -202,7 +229,7 @@ public:
         }
 
         block_cache_.for_each_entry([&](BlockCacheEntry* entry){
-           ::free(entry->get());
+           free_block_data(entry);
         });
     }
 
@@ -242,10 +269,13 @@ public:
                 write_data(DirectoryCtrID, superblock_, superblock_->superblock_size(), system_db_);
             }
 
+            uint64_t t0 = StoreStatCounters::now_ns();
             if (const int rc = mdb_txn_commit(transaction_)) {
                 make_generic_error("Can't commit read-write transaction, error = {}", mdb_strerror(rc)).do_throw();
             }
 
+            store_->io_stat_counters().add_flush(put_bytes_, StoreStatCounters::now_ns() - t0);
+
             committed_ = true;
         }
         else {
@@ -395,7 +425,7 @@ public:
         }
     }
 
-    virtual SharedBlockPtr createBlock(int32_t initial_size, const CtrID&)
+    virtual SharedBlockPtr createBlock(int32_t initial_size, const CtrID& ctr_id)
     {
         check_updates_allowed();
 
@@ -423,10 +453,12 @@ public:
 
         block_addr.release();
 
+        this->io_stat_.on_create(block, ctr_id);
+
         return entry;
     }
 
-    virtual SharedBlockPtr cloneBlock(const SharedBlockConstPtr& block, const CtrID&)
+    virtual SharedBlockPtr cloneBlock(const SharedBlockConstPtr& block, const CtrID& ctr_id)
     {
         check_updates_allowed();
         size_t block_size = block->memory_block_size();
@@ -451,6 +483,8 @@ public:
 
         block_addr.release();
 
+        this->io_stat_.on_clone(new_block, ctr_id);
+
         return SharedBlockPtr{entry};
     }
 
@@ -514,6 +548,10 @@ private:
 
         BlockCacheEntry* entry = ptr_cast<BlockCacheEntry>(block);
 
+        if (entry->is_view()) {
+            materialize(entry);
+        }
+
         if (!entry->is_updated()) {
             updated_entries_.push_back(*entry);
         }
@@ -544,6 +582,7 @@ private:
         block->set_block(new_block);
 
         BlockCacheEntry* entry = ptr_cast<BlockCacheEntry>(block);
+        entry->set_view(false);
 
         if (!entry->is_updated()) {
             updated_entries_.push_back(*entry);
@@ -578,16 +617,15 @@ private:
         if (block) {
             BlockCacheEntry* entry = block.value();
             if (entry->get()) {
+                this->io_stat_.on_read(id, entry->get(), BlockCacheAccess::HIT);
                 return block.value();
             }
             else {
                 auto block_ptr = get_data_addr(id, data_db_);
                 if (block_ptr.mv_data)
                 {
-                    BlockType* block_data = ptr_cast<BlockType>(::malloc(block_ptr.mv_size));
-                    std::memcpy(block_data, block_ptr.mv_data, block_ptr.mv_size);
-                    entry->set_block(block_data);
-                    entry->set_mutable(true);
+                    attach_block_data(entry, block_ptr);
+                    this->io_stat_.on_read(id, entry->get(), BlockCacheAccess::MISS);
                     return SharedBlockConstPtr(entry);
                 }
                 else {
@@ -598,15 +636,13 @@ private:
         else {
             auto block_ptr = get_data_addr(id, data_db_);
             if (block_ptr.mv_data) {
-                BlockType* block = ptr_cast<BlockType>(::malloc(block_ptr.mv_size));
-                std::memcpy(block, block_ptr.mv_data, block_ptr.mv_size);
-
-                BlockCacheEntry* entry = block_cache_entry_pool_.construct(id, block);
+                BlockCacheEntry* entry = block_cache_entry_pool_.construct(id, nullptr);
                 entry->set_store(this);
-                entry->set_mutable(true);
+                attach_block_data(entry, block_ptr);
 
                 block_cache_.insert(entry);
 
+                this->io_stat_.on_read(id, entry->get(), BlockCacheAccess::MISS);
                 return SharedBlockConstPtr(entry);
             }
             else {
@@ -636,7 +672,7 @@ private:
         }
 
         if (keep_entry) {
-            ::free(entry->get());
+            free_block_data(entry);
             entry->set_block(static_cast<BlockType*>(nullptr));
 
             if (entry->is_updated()) {
@@ -648,9 +684,56 @@ private:
         }
     }
 
+    // Clean pages of the LMDB map stay valid till the end of the
+    // transaction, so blocks that are not written by it are served
+    // as views. Others are copied, compressed ones are decompressed.
+    void attach_block_data(BlockCacheEntry* entry, const MDB_val& block_ptr)
+    {
+        if (is_compressed_data(block_ptr))
+        {
+            entry->set_block(decompress_data(block_ptr));
+            entry->set_view(false);
+        }
+        else if (written_blocks_.find(entry->id()) == written_blocks_.end())
+        {
+            entry->set_block(ptr_cast<BlockType>(block_ptr.mv_data));
+            entry->set_view(true);
+        }
+        else {
+            BlockType* block_data = ptr_cast<BlockType>(::malloc(block_ptr.mv_size));
+            std::memcpy(block_data, block_ptr.mv_data, block_ptr.mv_size);
+            entry->set_block(block_data);
+            entry->set_view(false);
+        }
+
+        entry->set_mutable(true);
+    }
+
+    // Views are read-only, the block is copied on the first update.
+    void materialize(BlockCacheEntry* entry)
+    {
+        const BlockType* view = entry->get();
+        size_t block_size = view->memory_block_size();
+
+        auto block_addr = allocate_system<uint8_t>(block_size);
+        std::memcpy(block_addr.get(), view, block_size);
+
+        entry->set_block(ptr_cast<BlockType>(block_addr.release()));
+        entry->set_view(false);
+    }
+
+    void free_block_data(BlockCacheEntry* entry) noexcept
+    {
+        if (!entry->is_view()) {
+            ::free(entry->get());
+        }
+
+        entry->set_view(false);
+    }
+
     void forget_entry(BlockCacheEntry* entry)
     {
-        ::free(entry->get());
+        free_block_data(entry);
 
         if (entry->is_updated()) {
             updated_entries_.erase(updated_entries_.iterator_to(*entry));
@@ -672,13 +755,47 @@ private:
     }
 
     void write_data(const BlockID& block_id, void* bytes, size_t size, MDB_dbi dbi)
+    {
+        if (dbi == data_db_ && block_compression_.is_enabled())
+        {
+            const BlockType* block = ptr_cast<const BlockType>(bytes);
+            auto codec = block_compression_.codec_for(
+                block->ctr_type_hash(), block->basic_header().cache_traits().group()
+            );
+
+            if (codec != io::BlockCodec::NONE && io::compress_block(
+                    codec,
+                    block_compression_.level(),
+                    Span<const uint8_t>(ptr_cast<const uint8_t>(bytes), size),
+                    size * block_compression_.max_ratio() / 100,
+                    compression_buffer_
+                )
+            )
+            {
+                return put_data(block_id, compression_buffer_.data(), compression_buffer_.size(), dbi);
+            }
+        }
+
+        return put_data(block_id, bytes, size, dbi);
+    }
+
+    // Blocks are already serialized, in memory or in the compression
+    // buffer, so LMDB's own copy into its pages is the only one.
+    // MDB_RESERVE would not save anything here.
+    void put_data(const BlockID& block_id, const void* bytes, size_t size, MDB_dbi dbi)
     {
         MDB_val key = {sizeof(block_id), ptr_cast<void>(&block_id)};
-        MDB_val data = {size, bytes};
+        MDB_val data = {size, const_cast<void*>(bytes)};
 
         if (int rc = mdb_put(transaction_, dbi, &key, &data, 0)) {
             make_generic_error("Can't write block {} of {} bytes to the database, error = {}", block_id, size, mdb_strerror(rc)).do_throw();
         }
+
+        put_bytes_ += size;
+
+        if (dbi == data_db_) {
+            written_blocks_.insert(block_id);
+        }
     }
 
     /*void write_data(const CtrID& ctr_id, void* bytes, size_t size, MDB_dbi dbi)
@@ -732,6 +849,18 @@ private:
     bool remove_branch(U8StringView branch_name) {
         MEMORIA_MAKE_GENERIC_ERROR("Method remove_branch() is not summported").do_throw();
     }
+
+    void compact(const CtrID&) {
+        MEMORIA_MAKE_GENERIC_ERROR("Method compact() is not supported, use ILMDBStore::copy_to() instead").do_throw();
+    }
+
+    void compact() {
+        MEMORIA_MAKE_GENERIC_ERROR("Method compact() is not supported, use ILMDBStore::copy_to() instead").do_throw();
+    }
+
+    SharedPtr<ISWMRStoreWritableSnapshot<ApiProfileT>> open_write_session(const CtrID&) {
+        MEMORIA_MAKE_GENERIC_ERROR("Write sessions are not supported for LMDB stores").do_throw();
+    }
 };
 
 }
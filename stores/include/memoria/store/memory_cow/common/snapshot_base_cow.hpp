@@ -16,7 +16,8 @@
 
 #pragma once
 
-#include <memoria/core/memory/malloc.hpp>
+#include <memoria/core/memory/malloc.hpp>
+#include <memoria/core/memory/huge_pages.hpp>
 
 #include <memoria/api/store/memory_store_api.hpp>
 
@@ -733,7 +734,7 @@ public:
 
         auto id = newId();
 
-        auto buf = allocate_system<uint8_t>(initial_size);
+        auto buf = history_tree_raw_->template allocate_block_memory<uint8_t>(initial_size);
         memset(buf.get(), 0, initial_size);
 
         BlockType* p = new (buf.get()) BlockType(id);
@@ -1032,7 +1033,7 @@ protected:
 
     UniquePtr<BlockType> clone_block(const BlockType* block)
     {
-        auto new_block = allocate_block_of_size<BlockType>(block->memory_block_size());
+        auto new_block = history_tree_raw_->template allocate_block_memory<BlockType>(block->memory_block_size());
 
         CopyByteBuffer(block, new_block.get(), block->memory_block_size());
 
@@ -1115,7 +1116,7 @@ protected:
           this->unref_block(child_id);
         });
 
-        ::free(blk);
+        free_huge_page_block(blk);
       }
 
       shared_pool_.destroy(block);
@@ -23,6 +23,7 @@
 #include <memoria/core/memory/ptr_cast.hpp>
 #include <memoria/core/memory/memory.hpp>
 #include <memoria/core/memory/malloc.hpp>
+#include <memoria/core/memory/huge_pages.hpp>
 
 #include <memoria/core/tools/pair.hpp>
 
@@ -432,6 +433,7 @@ protected:
     ReverseBranchMap snapshot_labels_metadata_;
 
     std::atomic<bool> dump_snapshot_lifecycle_{false};
+    std::atomic<bool> huge_page_blocks_{false};
 
     uint64_t id_counter_{1};
 
@@ -455,6 +457,21 @@ public:
     bool is_dump_snapshot_lifecycle() const  {return dump_snapshot_lifecycle_.load();}
     void set_dump_snapshot_lifecycle(bool do_dump)  {dump_snapshot_lifecycle_.store(do_dump);}
 
+    bool is_huge_page_blocks() const  {return huge_page_blocks_.load();}
+    void set_huge_page_blocks(bool enabled)  {huge_page_blocks_.store(enabled);}
+
+    // Block memory is released with free_huge_page_block(),
+    // that accepts both arena and malloc memory.
+    template <typename T>
+    UniquePtr<T> allocate_block_memory(size_t size)
+    {
+        void* ptr = huge_page_blocks_.load(std::memory_order_relaxed) ?
+                    HugePageArenaAllocator::instance().allocate(size) :
+                    ::malloc(size);
+
+        return UniquePtr<T>(ptr_cast<T>(ptr), free_huge_page_block);
+    }
+
     auto get_root_snapshot_uuid() const  {
         return history_tree_->snapshot_id();
     }
@@ -926,7 +943,7 @@ protected:
         in >> block_hash;
 
         auto block_data = allocate_system<uint8_t>(block_data_size);
-        auto block = allocate_block_of_size<BlockType>(block_size);
+        auto block = allocate_block_memory<BlockType>(block_size);
 
         in.read(block_data.get(), 0, block_data_size);
 
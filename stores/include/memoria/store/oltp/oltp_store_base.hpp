@@ -22,6 +22,8 @@
 #include <memoria/store/oltp/oltp_snapshot_history.hpp>
 #include <memoria/store/oltp/oltp_superblock.hpp>
 
+#include <memoria/store/common/store_stat_counters.hpp>
+
 #include <memoria/core/tools/span.hpp>
 #include <memoria/core/memory/ptr_cast.hpp>
 
@@ -87,14 +89,28 @@ protected:
 
     bool active_writer_{false};
 
+    StoreStatCounters io_stat_counters_;
 
-
+    // Bytes of blocks allocated since the last data flush
+    std::atomic<uint64_t> unflushed_bytes_{};
 
 public:
     using Base::flush;
 
     OLTPStoreBase() {}
 
+    StoreIOStat io_stat() const override {
+        return io_stat_counters_.stat();
+    }
+
+    StoreStatCounters& io_stat_counters() {
+        return io_stat_counters_;
+    }
+
+    void add_unflushed_bytes(uint64_t bytes) {
+        unflushed_bytes_.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
 
     uint64_t cp_allocation_threshold() const {
         LockGuard lock(writer_mutex_);
@@ -138,6 +154,17 @@ public:
     virtual void flush_data(bool async = false) = 0;
     virtual void flush_header(bool async = false) = 0;
 
+    // Data flush accounted in the I/O statistics
+    void flush_data_with_stat()
+    {
+        uint64_t t0 = StoreStatCounters::now_ns();
+        flush_data();
+        io_stat_counters_.add_flush(
+            unflushed_bytes_.exchange(0, std::memory_order_relaxed),
+            StoreStatCounters::now_ns() - t0
+        );
+    }
+
     virtual void check_if_open() = 0;
 
     virtual OLTPReadOnlySnapshotPtr do_open_readonly(CDescrPtr snapshot_descr) = 0;
@@ -243,7 +270,7 @@ public:
 
             sb->build_superblock_description();
 
-            flush_data();
+            flush_data_with_stat();
 
             auto sb_slot = sb->consistency_point_sequence_id() % 2;
             store_superblock(sb.get(), sb_slot);
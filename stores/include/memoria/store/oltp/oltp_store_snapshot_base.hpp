@@ -33,6 +33,8 @@
 #include <memoria/store/swmr/common/lite_allocation_map.hpp>
 #include <memoria/store/swmr/common/allocation_pool.hpp>
 
+#include <memoria/store/common/store_stat_counters.hpp>
+
 #include <memoria/core/tools/uid_256.hpp>
 
 #include <memoria/store/oltp/oltp_store_snapshot_base.hpp>
@@ -113,6 +115,8 @@ protected:
 
     std::shared_ptr<io::BlockIOProvider> block_provider_;
 
+    SnapshotIOStatCollector<Profile> io_stat_;
+
 public:
     using Base::getBlock;
 
@@ -121,7 +125,8 @@ public:
             CDescrPtr& snapshot_descriptor
     ) :
         store_(store),
-        snapshot_descriptor_(snapshot_descriptor)
+        snapshot_descriptor_(snapshot_descriptor),
+        io_stat_(&store->io_stat_counters())
     {
         instance_pool_ = std::make_shared<CtrInstancePool<Profile>>();
 
@@ -543,6 +548,18 @@ public:
         return Optional<U8String>{};
     }
 
+    virtual StoreIOStat io_stat() const {
+        return io_stat_.stat();
+    }
+
+    virtual void start_block_access_trace() {
+        io_stat_.start_trace();
+    }
+
+    virtual std::vector<BlockAccessTraceEntry<ApiProfileT>> stop_block_access_trace() {
+        return io_stat_.stop_trace();
+    }
+
     virtual SnpSharedPtr<IStoreApiBase<ApiProfileT>> snapshot_ref_opening_allowed() {
         return SnpSharedPtr<IStoreApiBase<ApiProfileT>>{};
     }
@@ -713,13 +730,59 @@ public:
     struct ResolvedBlock {
         io::DevSizeT file_pos;
         SharedBlockConstPtr block;
+        BlockCacheAccess cache{BlockCacheAccess::NONE};
     };
 
     virtual ResolvedBlock resolve_block(const BlockID& block_id) = 0;
     virtual AllocationMetadataT resolve_block_allocation(const BlockID& block_id) = 0;
 
-    SharedBlockConstPtr getBlock(const BlockID& block_id) {
-        return resolve_block(block_id).block;
+    SharedBlockConstPtr getBlock(const BlockID& block_id)
+    {
+        auto resolved = resolve_block(block_id);
+        if (resolved.block) {
+            io_stat_.on_read(block_id, resolved.block.block(), resolved.cache);
+        }
+        return std::move(resolved.block);
+    }
+
+    virtual void prefetch_blocks(Span<const BlockID> block_ids)
+    {
+        if (!block_provider_ || block_ids.size() == 0) {
+            return;
+        }
+
+        std::vector<io::IOCmdPtr> reads;
+        reads.reserve(block_ids.size());
+
+        // Read-ahead is a hint: blocks that can't be resolved
+        // are skipped, the following reads will report the error.
+        // Only Memoria's own errors are ignored, OOM and the like
+        // are propagated.
+        for (const BlockID& block_id: block_ids)
+        {
+            try {
+                auto alc = resolve_block_allocation(block_id);
+                reads.push_back(std::make_shared<io::IOReadCommand>(
+                    alc.position() * BASIC_BLOCK_SIZE,
+                    alc.size1() * BASIC_BLOCK_SIZE
+                ));
+                io_stat_.on_prefetch();
+            }
+            catch (const ResultException&) {
+            }
+            catch (const MemoriaThrowable&) {
+            }
+        }
+
+        if (reads.size()) {
+            try {
+                block_provider_->prefetch(std::make_shared<io::IOParExecutionGroup>(std::move(reads)));
+            }
+            catch (const ResultException&) {
+            }
+            catch (const MemoriaThrowable&) {
+            }
+        }
     }
 };
 
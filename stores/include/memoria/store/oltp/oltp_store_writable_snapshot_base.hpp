@@ -178,6 +178,18 @@ public:
         return false;
     }
 
+    virtual void compact(const CtrID&) {
+        MEMORIA_MAKE_GENERIC_ERROR("Method compact() is not supported for OLTP stores").do_throw();
+    }
+
+    virtual void compact() {
+        MEMORIA_MAKE_GENERIC_ERROR("Method compact() is not supported for OLTP stores").do_throw();
+    }
+
+    virtual SharedPtr<ISWMRStoreWritableSnapshot<ApiProfileT>> open_write_session(const CtrID&) {
+        MEMORIA_MAKE_GENERIC_ERROR("Write sessions are not supported for OLTP stores").do_throw();
+    }
+
     // FIXME: We probably don't need both.
     virtual SnpSharedPtr<StoreT> my_self_ptr()  = 0;
     virtual SnpSharedPtr<StoreT> self_ptr() {
@@ -670,6 +682,9 @@ public:
         // It's not a good idea to drain free_db_mem_ on a threshold into
         // freedb_ctr_ here because of the btree's self-referentiality.
 
+        this->io_stat_.on_clone(new_block.block(), ctr_id);
+        store_->add_unflushed_bytes(new_block->memory_block_size());
+
         return new_block;
     }
 
@@ -692,6 +707,9 @@ public:
         block->snapshot_id() = snapshot_id();
         my_blocks_[block->id()] = new_block;
 
+        this->io_stat_.on_create(block, ctr_id);
+        store_->add_unflushed_bytes(block->memory_block_size());
+
         return new_block;
     }
 
@@ -174,6 +174,19 @@ class AllocationPool {
         }
     };
 
+    // A run of level-0 blocks carved out of a higher-level allocation
+    // and dedicated to a single locality key (usually, a container's leaves).
+    // Consecutive allocations with the same key are served sequentially
+    // from the extent, so leaves of a container end up in contiguous runs.
+    struct LocalityExtent {
+        uint64_t key;
+        SizeT position;
+        SizeT remainder;
+        uint64_t last_used;
+    };
+
+    static constexpr size_t LOCALITY_EXTENTS = 16;
+
     LevelQueue levels_[Levels];
 
     uint64_t level0_total_{};
@@ -182,6 +195,11 @@ class AllocationPool {
     size_t size_{};
     size_t capacity_{};
 
+    LocalityExtent extents_[LOCALITY_EXTENTS]{};
+    size_t active_extents_{};
+    uint64_t extents_clock_{};
+    SizeT extent_level_{Levels > 6 ? 5 : Levels - 1};
+
 public:
     AllocationPool(size_t capacity):
         capacity_(capacity)
@@ -204,7 +222,29 @@ public:
 
 
     size_t available_slots(size_t level) const {
-        return capacity_ - reserved(level);
+        size_t used = reserved(level) + active_extents_;
+        return capacity_ > used ? capacity_ - used : 0;
+    }
+
+    SizeT extent_level() const {
+        return extent_level_;
+    }
+
+    void set_extent_level(SizeT level)
+    {
+        if (MMA_UNLIKELY(level >= Levels)) {
+            MEMORIA_MAKE_GENERIC_ERROR(
+                "Locality extent level exceeds maximum of {}: {}",
+                Levels - 1, level
+            ).do_throw();
+        }
+
+        release_extents();
+        extent_level_ = level;
+    }
+
+    size_t active_extents() const {
+        return active_extents_;
     }
 
     uint64_t level0_total() const  {
@@ -215,6 +255,12 @@ public:
         return level0_reserved_;
     }
 
+    // Pools that are not stored in a superblock, like sub-pools of
+    // write sessions, don't need blocks reserved for superblocks.
+    void set_level0_reserved(uint64_t value) {
+        level0_reserved_ = value;
+    }
+
     template <size_t Size>
     void load(const AllocationPoolData<Size>& data)
     {
@@ -233,6 +279,14 @@ public:
                 data.push_back(meta.raw_data());
             }
         }
+
+        // Unused tails of locality extents are stored as
+        // regular level-0 allocations.
+        for (const LocalityExtent& ext: extents_) {
+            if (ext.remainder) {
+                data.push_back(AlcMetadata::from_ln(ext.position, ext.remainder, 0).raw_data());
+            }
+        }
     }
 
     bool add(const AlcMetadata& meta)
@@ -246,7 +300,7 @@ public:
                 level0_total_ += meta.size1();
                 return true;
             }
-            else if (size_ < capacity_) {
+            else if (size_ + active_extents_ < capacity_) {
                 size_++;
                 levels_[meta.level()].push(meta);
                 level0_total_ += meta.size1();
@@ -256,7 +310,7 @@ public:
                 return false;
             }
         }
-        else if (size_ < capacity_) {
+        else if (size_ + active_extents_ < capacity_) {
             size_++;
             levels_[meta.level()].push(meta);
             level0_total_ += meta.size1();
@@ -280,6 +334,11 @@ public:
 
         level0_total_ = 0;
         size_ = 0;
+
+        for (LocalityExtent& ext: extents_) {
+            ext = LocalityExtent{};
+        }
+        active_extents_ = 0;
     }
 
     void reset()  {
@@ -292,6 +351,12 @@ public:
            out << alc << std::endl;
         });
 
+        for (const LocalityExtent& ext: extents_) {
+            if (ext.remainder) {
+                out << "Extent " << ext.key << ": " << AlcMetadata::from_ln(ext.position, ext.remainder, 0) << std::endl;
+            }
+        }
+
         out << std::endl;
     }
 
@@ -307,6 +372,63 @@ public:
         return {};
     }
 
+    // Allocates one block at the level, preferring the locality extent
+    // associated with the key. Zero key means 'no locality'. Only
+    // level-0 allocations are served from extents.
+    Optional<AlcMetadata> allocate_one(SizeT level, uint64_t locality_key)
+    {
+        if (locality_key == 0 || level != 0) {
+            return allocate_one(level);
+        }
+
+        LocalityExtent* ext = find_extent(locality_key);
+        if (ext && ext->remainder)
+        {
+            if (level0_total_ > level0_reserved_) {
+                return take_from_extent(*ext);
+            }
+
+            return {};
+        }
+
+        SizeT l0_size = static_cast<SizeT>(1) << extent_level_;
+        if (
+            extent_level_ > 0 &&
+            level0_total_ >= level0_reserved_ + l0_size &&
+            size_ + active_extents_ < capacity_
+        )
+        {
+            if (!ext) {
+                ext = acquire_extent_slot();
+            }
+
+            auto alc = do_allocate_one(extent_level_);
+            if (alc)
+            {
+                // Blocks of the extent are still counted as
+                // available in the pool until they are taken.
+                level0_total_ += alc.value().size1();
+
+                ext->key       = locality_key;
+                ext->position  = alc.value().position();
+                ext->remainder = alc.value().size1();
+                active_extents_++;
+
+                return take_from_extent(*ext);
+            }
+        }
+
+        return allocate_one(level);
+    }
+
+    // Returns unused tails of all locality extents to the pool.
+    void release_extents()
+    {
+        for (LocalityExtent& ext: extents_) {
+            release_extent(ext);
+        }
+    }
+
     Optional<AlcMetadata> allocate_reserved(SizeT remainder)
     {
         if (level0_total_ > remainder) {
@@ -349,6 +471,75 @@ public:
     }
 
 private:
+    LocalityExtent* find_extent(uint64_t key)
+    {
+        for (LocalityExtent& ext: extents_) {
+            if (ext.key == key) {
+                return &ext;
+            }
+        }
+        return nullptr;
+    }
+
+    // Finds a free extent slot, evicting the least recently used
+    // extent if all slots are occupied.
+    LocalityExtent* acquire_extent_slot()
+    {
+        LocalityExtent* lru{};
+        for (LocalityExtent& ext: extents_)
+        {
+            if (!ext.remainder) {
+                ext = LocalityExtent{};
+                return &ext;
+            }
+            else if (!lru || ext.last_used < lru->last_used) {
+                lru = &ext;
+            }
+        }
+
+        release_extent(*lru);
+        return lru;
+    }
+
+    AlcMetadata take_from_extent(LocalityExtent& ext)
+    {
+        AlcMetadata alc = AlcMetadata::from_ln(ext.position, 1, 0);
+
+        ext.position++;
+        ext.remainder--;
+        ext.last_used = ++extents_clock_;
+
+        if (ext.remainder == 0) {
+            active_extents_--;
+        }
+
+        level0_total_--;
+        return alc;
+    }
+
+    // Moves the extent's tail back to the level-0 queue. The slot
+    // the extent occupied in the pool's capacity is reused, so
+    // this operation never fails.
+    void release_extent(LocalityExtent& ext)
+    {
+        if (ext.remainder)
+        {
+            AlcMetadata meta = AlcMetadata::from_ln(ext.position, ext.remainder, 0);
+            AlcMetadata* tgt = levels_[0].find_exising(meta);
+            if (tgt && tgt->fits(meta.size_at_level())) {
+                levels_[0].push_at(tgt, meta);
+            }
+            else {
+                size_++;
+                levels_[0].push(meta);
+            }
+
+            active_extents_--;
+        }
+
+        ext = LocalityExtent{};
+    }
+
     SizeT compute_level_total(SizeT level) const
     {
         SizeT total = 0;
@@ -70,6 +70,10 @@ public:
     virtual uint64_t buffer_size() override {
         return buffer_.size();
     }
+
+    virtual Span<uint8_t> file_buffer() override {
+        return buffer_;
+    }
 };
 
 }
@@ -25,6 +25,10 @@
 #include <memoria/store/swmr/common/swmr_store_history_tree.hpp>
 
 #include <memoria/store/swmr/common/lite_allocation_map.hpp>
+#include <memoria/store/swmr/common/swmr_store_parallel_check.hpp>
+#include <memoria/store/swmr/common/swmr_store_replication.hpp>
+
+#include <memoria/store/common/store_stat_counters.hpp>
 
 #include <memoria/core/tools/span.hpp>
 #include <memoria/core/memory/ptr_cast.hpp>
@@ -119,6 +123,16 @@ protected:
 
     std::unique_ptr<LiteAllocationMap<ApiProfileT>> allocations_;
 
+    bool follower_{false};
+    SWMRReplicationSinkFn replication_sink_;
+    SWMRReplicationRecordBuilder replication_record_;
+    SWMRReplicationStatus replication_status_;
+
+    StoreStatCounters io_stat_counters_;
+
+    // Bytes of blocks allocated since the last data flush
+    std::atomic<uint64_t> unflushed_bytes_{};
+
 public:
     using Base::flush;
 
@@ -142,6 +156,18 @@ public:
         return history_mutex_;
     }
 
+    StoreIOStat io_stat() const override {
+        return io_stat_counters_.stat();
+    }
+
+    StoreStatCounters& io_stat_counters() {
+        return io_stat_counters_;
+    }
+
+    void add_unflushed_bytes(uint64_t bytes) {
+        unflushed_bytes_.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
     uint64_t cp_allocation_threshold() const override {
         LockGuard lock(history_mutex_);
         return cp_allocation_threshold_;
@@ -204,9 +230,28 @@ public:
     virtual SharedSBPtr<SuperblockT> get_superblock(uint64_t file_pos) = 0;
     virtual SharedSBPtr<CounterBlockT> get_counter_block(uint64_t file_pos) = 0;
     virtual uint64_t buffer_size() = 0;
+    virtual Span<uint8_t> file_buffer() = 0;
+
+    // Extends the store's file to at least min_size bytes, rounded up
+    // to ALLOCATION_MAP_SIZE_STEP. Returns the resulting size, that is
+    // not changed if the store can't grow.
+    virtual uint64_t grow_buffer(uint64_t min_size) {
+        return buffer_size();
+    }
 
     virtual void do_flush() = 0;
 
+    // Data flush accounted in the I/O statistics
+    void flush_data_with_stat()
+    {
+        uint64_t t0 = StoreStatCounters::now_ns();
+        flush_data();
+        io_stat_counters_.add_flush(
+            unflushed_bytes_.exchange(0, std::memory_order_relaxed),
+            StoreStatCounters::now_ns() - t0
+        );
+    }
+
     virtual ReadOnlySnapshotPtr flush(FlushType ft) override
     {
         LockGuard lock(writer_mutex_);
@@ -591,7 +636,7 @@ public:
 
             sb->build_superblock_description();
 
-            flush_data();
+            flush_data_with_stat();
 
             auto sb_slot = sb->consistency_point_sequence_id() % 2;
             store_superblock(sb.get(), sb_slot);
@@ -601,6 +646,8 @@ public:
             sb0->set_metadata_doc(store_params_);
             store_superblock(sb0.get(), sb_slot);
 
+            replicate_region(sb_slot * BASIC_BLOCK_SIZE, BASIC_BLOCK_SIZE);
+
             flush_header();
         }
         else {
@@ -621,6 +668,15 @@ public:
         {
             LockGuard lock(history_mutex_);
 
+            if (MMA_UNLIKELY(is_replicating()))
+            {
+                // Blocks of these snapshots have been freed by this commit,
+                // followers must not have them open.
+                for (auto& descr: history_tree_.eviction_queue()) {
+                    replication_record_.add_evicted(descr.superblock_ptr());
+                }
+            }
+
             // We need to cleanup eviction queue before attaching the new snapshot
             // to the history tree. Because attaching may add a new entry to
             // the queue.
@@ -641,14 +697,126 @@ public:
             }
         }
 
+        if (MMA_UNLIKELY(is_replicating()))
+        {
+            try {
+                auto sb = get_superblock(snapshot_descriptor->superblock_ptr());
+                replicate_region(sb->superblock_file_pos(), sb->superblock_size());
+
+                ship_replication_record(
+                    sb->superblock_file_pos(),
+                    snapshot_descriptor->sequence_id(),
+                    do_consistency_point
+                );
+            }
+            catch (...) {
+                unlock_writer();
+                throw;
+            }
+        }
+
         unlock_writer();
     }
 
     virtual void do_rollback(CDescrPtr snapshot_descriptor)
     {
+        replication_record_.clear();
         unlock_writer();
     }
 
+    bool is_replicating() const {
+        return (bool)replication_sink_;
+    }
+
+    void replicate_region(uint64_t file_pos, uint64_t size)
+    {
+        if (MMA_UNLIKELY(is_replicating())) {
+            replication_record_.add_region(file_pos, size);
+        }
+    }
+
+    void replicate_allocation(const AllocationMetadataT& alc)
+    {
+        if (MMA_UNLIKELY(is_replicating())) {
+            replication_record_.add_region(alc.position() * BASIC_BLOCK_SIZE, alc.size1() * BASIC_BLOCK_SIZE);
+        }
+    }
+
+    void replicate_deallocation(const AllocationMetadataT& alc)
+    {
+        if (MMA_UNLIKELY(is_replicating())) {
+            replication_record_.add_freed(alc.position() * BASIC_BLOCK_SIZE, alc.size1() * BASIC_BLOCK_SIZE);
+        }
+    }
+
+    virtual void set_replication_sink(SWMRReplicationSinkFn sink) override
+    {
+        LockGuard lock(writer_mutex_);
+        check_if_open();
+        throw_if_read_only();
+
+        replication_sink_ = sink;
+        replication_record_.clear();
+    }
+
+    virtual bool apply_replication_record(Span<const uint8_t> record) override
+    {
+        LockGuard lock(writer_mutex_);
+        check_if_open();
+
+        if (!follower_) {
+            MEMORIA_MAKE_GENERIC_ERROR("The store is not opened as a replication follower").do_throw();
+        }
+
+        SWMRReplicationRecordView view(record);
+        if (view.header().file_size > buffer_size()) {
+            // The leader's file has grown since the last record
+            grow_buffer(view.header().file_size);
+        }
+
+        if (view.header().file_size != buffer_size()) {
+            MEMORIA_MAKE_GENERIC_ERROR(
+                "Replication record is for a file of {} bytes, this store's file is {} bytes",
+                view.header().file_size, buffer_size()
+            ).do_throw();
+        }
+
+        {
+            LockGuard rlock(history_mutex_);
+            for (uint64_t sb_ptr: view.evicted())
+            {
+                auto descr = history_tree_.find_by_superblock(sb_ptr);
+                if (descr && history_tree_.is_open(descr.get())) {
+                    return false;
+                }
+            }
+        }
+
+        // New blocks are not reachable from any snapshot visible here,
+        // so they are written without blocking readers.
+        auto buffer = file_buffer();
+        view.for_each_region([&](const SWMRFileRegion& region, Span<const uint8_t> data){
+            std::memcpy(buffer.data() + region.file_pos, data.data(), data.size());
+        });
+
+        if (view.header().superblock_file_pos) {
+            replicate_snapshot(view.header().superblock_file_pos, view.is_consistency_point());
+        }
+
+        replication_status_.records++;
+        replication_status_.bytes += record.size();
+        replication_status_.sequence_id = view.header().sequence_id;
+        replication_status_.lag_ms = getTimeInMillis() - view.header().commit_time;
+
+        return true;
+    }
+
+    virtual SWMRReplicationStatus replication_status() override
+    {
+        LockGuard lock(writer_mutex_);
+        return replication_status_;
+    }
+
 
     SharedPtr<ISWMRStoreHistoryView<ApiProfileT>> history_view() override
     {
@@ -684,6 +852,14 @@ public:
         return do_check(consumer);
     }
 
+    virtual Optional<SequenceID> check_parallel(
+            const CheckResultConsumerFn& consumer,
+            const StoreCheckOptions& options
+    ) override {
+        check_if_open();
+        return do_check_parallel(consumer, options);
+    }
+
     void for_all_evicting_snapshots(std::function<void (SnapshotDescriptorT*)> fn)
     {
         LockGuard lock(history_mutex_);
@@ -754,6 +930,60 @@ protected:
         }
     }
 
+    Optional<SequenceID> do_check_parallel(const CheckResultConsumerFn& consumer, const StoreCheckOptions& options)
+    {
+        LockGuard lock(writer_mutex_);
+
+        allocations_ = make_lite_allocation_map();
+
+        std::vector<CDescrPtr> snapshots;
+        history_tree_.traverse_tree_preorder([&](CDescrPtr descr){
+            snapshots.push_back(descr);
+        });
+
+        std::sort(snapshots.begin(), snapshots.end(), [&](const auto& one, const auto& two) -> bool {
+            return one->sequence_id() < two->sequence_id();
+        });
+
+        if (snapshots.size() > 0)
+        {
+            SequenceID sequence_id = snapshots[snapshots.size() - 1]->sequence_id();
+
+            SWMRParallelChecker<Profile> checker(
+                std::move(snapshots),
+                [&](const CDescrPtr& descr) {
+                    return do_open_readonly(descr);
+                },
+                *allocations_.get(),
+                consumer,
+                options
+            );
+
+            try {
+                checker.run();
+            }
+            catch (...) {
+                allocations_.reset();
+                throw;
+            }
+
+            SnapshotCheckState<Profile> check_state;
+            checker.build_counters(check_state.counters);
+
+            check_refcounters(check_state.counters, consumer);
+            do_check_allocations(consumer);
+
+            allocations_->close();
+            allocations_.reset();
+            return sequence_id;
+        }
+        else {
+            allocations_->close();
+            allocations_.reset();
+            return Optional<SequenceID>{};
+        }
+    }
+
     std::unique_ptr<LiteAllocationMap<ApiProfileT>> make_lite_allocation_map()
     {
         auto ptr = do_open_readonly(history_tree_.head());
@@ -930,6 +1160,8 @@ protected:
             auto blk = get_counter_block(counters_block_pos);
             blk->init(counter_block_size);
 
+            replicate_region(counters_block_pos, counter_block_size);
+
             while (blk->available() && cntr_ii != block_counters_.end())
             {
                 blk->add_counter(CounterStorageT{
@@ -955,7 +1187,7 @@ protected:
 
     virtual void prepare_to_close()
     {
-        if (!this->active_writer_)
+        if (!this->active_writer_ && !read_only_)
         {
             // Creating a system snapshot in a case,
             // if last commit didn't create a consistency
@@ -973,13 +1205,18 @@ protected:
 
                     store_counters(sb0.get());
 
-                    flush_data();
+                    flush_data_with_stat();
 
                     sb0->set_clean_status();
                     sb0->build_superblock_description();
                     store_superblock(sb0.get(), sb_slot);
 
                     flush_header();
+
+                    if (is_replicating()) {
+                        replicate_region(sb_slot * BASIC_BLOCK_SIZE, BASIC_BLOCK_SIZE);
+                        ship_replication_record(0, head_ptr->sequence_id(), false);
+                    }
                 }
 
                 block_counters_.clear();
@@ -1154,6 +1391,44 @@ protected:
     }
 
 private:
+    void ship_replication_record(uint64_t superblock_file_pos, uint64_t sequence_id, bool consistency_point)
+    {
+        SWMRReplicationRecordHeader header{};
+        header.flags = consistency_point ? SWMRReplicationRecordHeader::CONSISTENCY_POINT : 0;
+        header.sequence_id = sequence_id;
+        header.superblock_file_pos = superblock_file_pos;
+        header.commit_time = getTimeInMillis();
+
+        auto record = replication_record_.build(header, file_buffer());
+
+        replication_status_.records++;
+        replication_status_.bytes += record.size();
+        replication_status_.sequence_id = sequence_id;
+
+        replication_sink_(to_span(record));
+    }
+
+    void replicate_snapshot(uint64_t superblock_file_pos, bool consistency_point)
+    {
+        using MetaT = std::pair<SnapshotID, SWMRSnapshotMetadata<ApiProfile<Profile>>>;
+        std::vector<MetaT> metas;
+
+        auto sb = get_superblock(superblock_file_pos);
+        auto snapshot_id = sb->snapshot_id();
+
+        {
+            CDescrPtr descr = history_tree_.new_snapshot_descriptor(superblock_file_pos, sb.get(), "");
+            auto ptr = do_open_readonly(descr.get());
+
+            ptr->for_each_history_entry([&](const auto& snapshot_id, const auto& snapshot_meta) {
+                metas.push_back(MetaT(snapshot_id, snapshot_meta));
+            });
+        }
+
+        LockGuard lock(history_mutex_);
+        history_tree_.replicate(metas, snapshot_id, consistency_point);
+    }
+
     CDescrPtr get_branch_head_read_sync(U8StringView name) const  {
         LockGuard lock(history_mutex_);
         return history_tree_.get_branch_head(name);
@@ -168,7 +168,7 @@ public:
                 superblock_file_pos_ == other.superblock_file_pos_ &&
                 flags_ == other.flags_ &&
                 timestamp_ == other.timestamp_ &&
-                ttl_ = other.ttl_;
+                ttl_ == other.ttl_;
     }
 
     bool operator!=(const SWMRSnapshotMetadata& other) const  {
@@ -355,27 +355,7 @@ public:
             const SnapshotMetadataT& meta = std::get<1>(pair);
             const SnapshotID& snapshot_id   = std::get<0>(pair);
 
-            auto superblock = superblock_fn_(meta.superblock_file_pos());
-
-            auto doc = superblock->metadata_doc();
-            auto map = doc.root().value().as_object_map();
-
-            U8String branch_name;
-            auto bname_opt = map.get("branch_name");
-            if (bname_opt) {
-                branch_name = bname_opt->as_varchar();
-            }
-            else {
-                branch_name = "";
-            }
-
-            CDescrPtr descr = new_snapshot_descriptor(branch_name);
-
-            descr->set_superblock(meta.superblock_file_pos() * BASIC_BLOCK_SIZE, superblock.get());
-            descr->set_transient(meta.is_transient());
-            descr->set_system_snapshot(meta.is_system_snapshot());
-
-            snapshots_[snapshot_id] = descr;
+            snapshots_[snapshot_id] = make_descriptor(meta);
         }
 
         for (const auto& pair: metas)
@@ -433,7 +413,156 @@ public:
 
 
 
+    // Follower side of replication. Brings the tree in sync with the
+    // history of the replicated snapshot: adds new snapshots, drops
+    // evicted ones and re-links the rest, as the history may have
+    // been reparented by the leader.
+    void replicate(
+            Span<const std::pair<SnapshotID, SnapshotMetadataT>> metas,
+            const SnapshotID& head_id,
+            bool consistency_point
+    )
+    {
+        std::unordered_set<SnapshotID> live;
+        for (const auto& pair: metas)
+        {
+            live.insert(pair.first);
+            if (snapshots_.find(pair.first) == snapshots_.end()) {
+                snapshots_[pair.first] = make_descriptor(pair.second);
+            }
+        }
+
+        auto head = get(head_id);
+        if (!head) {
+            MEMORIA_MAKE_GENERIC_ERROR("Replicated snapshot {} is not in its own history", head_id).do_throw();
+        }
+
+        for (auto& entry: snapshots_) {
+            entry.second->set_parent(nullptr);
+            entry.second->children().clear();
+        }
+
+        root_ = CDescrPtr{};
+        branch_heads_.clear();
+
+        for (auto ii = snapshots_.begin(); ii != snapshots_.end();)
+        {
+            if (live.find(ii->first) == live.end())
+            {
+                if (ii->second->is_linked()) {
+                    ii->second->unlink_from_eviction_queue();
+                }
+
+                ii->second->set_new();
+
+                if (consistency_point1_ == ii->second) {
+                    consistency_point1_ = CDescrPtr{};
+                }
+
+                if (consistency_point2_ == ii->second) {
+                    consistency_point2_ = CDescrPtr{};
+                }
+
+                ii = snapshots_.erase(ii);
+            }
+            else {
+                ++ii;
+            }
+        }
+
+        for (const auto& pair: metas)
+        {
+            CDescrPtr current = snapshots_[pair.first];
+            current->set_transient(pair.second.is_transient());
+
+            if (pair.second.parent_snapshot_id())
+            {
+                CDescrPtr parent = get(pair.second.parent_snapshot_id());
+                if (parent) {
+                    current->set_parent(parent.get());
+                    parent->children().insert(current);
+                }
+                else {
+                    MEMORIA_MAKE_GENERIC_ERROR("Cannot find parent snapshot: {}", pair.second.parent_snapshot_id()).do_throw();
+                }
+            }
+            else {
+                root_ = current;
+            }
+        }
+
+        if (consistency_point) {
+            consistency_point2_ = consistency_point1_;
+            consistency_point1_ = head;
+        }
+
+        head_ = head;
+
+        traverse_tree_preorder([&](CDescrPtr descr){
+            if (descr->children().empty()) {
+                branch_heads_[get_branch_name(descr)] = descr;
+            }
+        });
+    }
+
+    CDescrPtr find_by_superblock(uint64_t superblock_ptr) const
+    {
+        for (const auto& entry: snapshots_) {
+            if (entry.second->superblock_ptr() == superblock_ptr) {
+                return entry.second;
+            }
+        }
+        return CDescrPtr{};
+    }
+
+    // True if something besides the tree itself, like an open
+    // snapshot, holds the descriptor.
+    bool is_open(const SnapshotDescriptorT* descr) const
+    {
+        int32_t refs = 1; // snapshots_
+
+        if (descr->parent()) {
+            refs++;
+        }
+
+        refs += head_.get() == descr;
+        refs += root_.get() == descr;
+        refs += consistency_point1_.get() == descr;
+        refs += consistency_point2_.get() == descr;
+
+        for (const auto& entry: branch_heads_) {
+            refs += entry.second.get() == descr;
+        }
+
+        return descr->references_ > refs;
+    }
+
 private:
+    CDescrPtr make_descriptor(const SnapshotMetadataT& meta)
+    {
+        auto superblock = superblock_fn_(meta.superblock_file_pos());
+
+        auto doc = superblock->metadata_doc();
+        auto map = doc.root().value().as_object_map();
+
+        U8String branch_name;
+        auto bname_opt = map.get("branch_name");
+        if (bname_opt) {
+            branch_name = bname_opt->as_varchar();
+        }
+        else {
+            branch_name = "";
+        }
+
+        CDescrPtr descr = new_snapshot_descriptor(branch_name);
+
+        descr->set_superblock(meta.superblock_file_pos() * BASIC_BLOCK_SIZE, superblock.get());
+        descr->set_transient(meta.is_transient());
+        descr->set_system_snapshot(meta.is_system_snapshot());
+
+        return descr;
+    }
+
     class TraverseState {
         CDescrPtr descr_;
         typename SnapshotDescriptorT::ChildIterator ii_;
@@ -0,0 +1,593 @@
+// Copyright 2026 Victor Smirnov
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <memoria/store/swmr/common/swmr_store_counters.hpp>
+#include <memoria/store/swmr/common/swmr_store_readonly_snapshot_base.hpp>
+#include <memoria/store/swmr/common/lite_allocation_map.hpp>
+
+#include <memoria/core/flat_map/flat_hash_map.hpp>
+#include <memoria/core/tools/checks.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace memoria {
+
+namespace detail {
+
+template <typename BlockID>
+size_t swmr_check_shard(const BlockID& block_id, size_t shards_log2)
+{
+    uint64_t hash = std::hash<BlockID>{}(block_id);
+    return (hash * 0x9E3779B97F4A7C15ull) >> (64 - shards_log2);
+}
+
+// Token bucket without bursts, shared by all workers.
+class SWMRCheckRateLimiter {
+    using Clock = std::chrono::steady_clock;
+
+    uint64_t rate_;
+    std::mutex mutex_;
+    Clock::time_point next_;
+
+public:
+    SWMRCheckRateLimiter(uint64_t rate):
+        rate_(rate), next_(Clock::now())
+    {}
+
+    void acquire(uint64_t bytes)
+    {
+        if (!rate_) {
+            return;
+        }
+
+        Clock::time_point wake_at;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto now = Clock::now();
+            if (next_ < now) {
+                next_ = now;
+            }
+
+            wake_at = next_;
+            next_ += std::chrono::nanoseconds(bytes * 1000000000ull / rate_);
+        }
+
+        std::this_thread::sleep_until(wake_at);
+    }
+};
+
+}
+
+// Set of block IDs shared by the checker's workers.
+// Sharded by block ID hash to keep lock contention low.
+template <typename Profile>
+class SWMRConcurrentBlockSet {
+    using BlockID = ProfileBlockID<Profile>;
+
+    static constexpr size_t SHARDS_LOG2 = 6;
+
+    struct alignas(64) Shard {
+        std::mutex mutex;
+        ska::flat_hash_set<BlockID> blocks;
+    };
+
+    std::unique_ptr<Shard[]> shards_;
+
+public:
+    SWMRConcurrentBlockSet():
+        shards_(std::make_unique<Shard[]>(1ull << SHARDS_LOG2))
+    {}
+
+    // Returns true if the block was not in the set.
+    bool insert(const BlockID& block_id)
+    {
+        auto& shard = shards_[detail::swmr_check_shard(block_id, SHARDS_LOG2)];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        return shard.blocks.insert(block_id).second;
+    }
+};
+
+template <typename Profile>
+class SWMRConcurrentBlockCounters {
+    using BlockID = ProfileBlockID<Profile>;
+
+    static constexpr size_t SHARDS_LOG2 = 6;
+
+    struct alignas(64) Shard {
+        std::mutex mutex;
+        SWMRBlockCounters<Profile> counters;
+    };
+
+    std::unique_ptr<Shard[]> shards_;
+
+public:
+    SWMRConcurrentBlockCounters():
+        shards_(std::make_unique<Shard[]>(1ull << SHARDS_LOG2))
+    {}
+
+    // Returns true if it's the first reference to the block.
+    bool inc(const BlockID& block_id)
+    {
+        auto& shard = shards_[detail::swmr_check_shard(block_id, SHARDS_LOG2)];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        return shard.counters.inc(block_id);
+    }
+
+    void merge_to(SWMRBlockCounters<Profile>& counters) const
+    {
+        for (size_t c = 0; c < (1ull << SHARDS_LOG2); c++) {
+            shards_[c].counters.for_each([&](const BlockID& block_id, int64_t value){
+                counters.set(block_id, value);
+            });
+        }
+    }
+};
+
+
+// Parallel version of SWMRStoreBase::do_check() traversal. Runs in two
+// phases over a pool of threads:
+//
+// 1. Container checks. One task per snapshot for system containers and
+//    one per distinct data container root. Blocks shared between
+//    snapshots are checked once (IStoreBase::check_subtree()).
+//
+// 2. Reference counters. Block graph traversal from snapshots' roots,
+//    a task per block. Workers run subtrees depth-first and share the
+//    bottom of their stacks when other workers are idle.
+//
+// Each worker opens its own read-only snapshot objects. Allocations
+// are collected in per-worker batches and merged into the allocation
+// map by the calling thread, which also reports progress.
+template <typename Profile>
+class SWMRParallelChecker {
+    using ApiProfileT         = ApiProfile<Profile>;
+    using BlockID             = ProfileBlockID<Profile>;
+    using CtrID               = ProfileCtrID<Profile>;
+    using AllocationMetadataT = AllocationMetadata<ApiProfileT>;
+
+    using SnapshotDescriptorT = SnapshotDescriptor<Profile>;
+    using CDescrPtr           = typename SnapshotDescriptorT::SharedPtrT;
+    using SnapshotPtr         = SnpSharedPtr<SWMRStoreReadOnlySnapshotBase<Profile>>;
+
+    using OpenSnapshotFn      = std::function<SnapshotPtr (const CDescrPtr&)>;
+
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr size_t MAX_OPEN_SNAPSHOTS = 16;
+    static constexpr size_t ALLOCATIONS_BATCH  = 4096;
+    static constexpr size_t THROTTLE_BATCH     = 1024 * 1024;
+
+    struct CheckTask {
+        size_t snapshot;
+        bool system;
+        CtrID ctr_name;
+        BlockID root_id;
+    };
+
+    struct BlockTask {
+        size_t snapshot;
+        BlockID block_id;
+    };
+
+    class Worker: public SWMRCheckContext<Profile> {
+        SWMRParallelChecker& checker_;
+
+        ska::flat_hash_map<size_t, SnapshotPtr> snapshots_;
+        std::vector<AllocationMetadataT> allocations_;
+        uint64_t unthrottled_{};
+
+    public:
+        std::vector<BlockTask> stack_;
+
+        Worker(SWMRParallelChecker& checker):
+            checker_(checker)
+        {}
+
+        SnapshotPtr snapshot(size_t idx)
+        {
+            auto ii = snapshots_.find(idx);
+            if (ii != snapshots_.end()) {
+                return ii->second;
+            }
+
+            if (snapshots_.size() >= MAX_OPEN_SNAPSHOTS) {
+                snapshots_.clear();
+            }
+
+            auto snp = checker_.open_snapshot_fn_(checker_.snapshots_[idx]);
+            snp->set_check_context(this);
+            snapshots_[idx] = snp;
+
+            return snp;
+        }
+
+        virtual bool check_subtree(const BlockID& block_id) {
+            return checker_.checked_blocks_.insert(block_id);
+        }
+
+        virtual void register_allocation(const AllocationMetadataT& alc)
+        {
+            allocations_.push_back(alc);
+            if (allocations_.size() >= ALLOCATIONS_BATCH) {
+                flush_allocations();
+            }
+        }
+
+        virtual void on_block_read(size_t size)
+        {
+            checker_.blocks_.fetch_add(1, std::memory_order_relaxed);
+            checker_.bytes_.fetch_add(size, std::memory_order_relaxed);
+
+            unthrottled_ += size;
+            if (unthrottled_ >= THROTTLE_BATCH) {
+                checker_.rate_limiter_.acquire(unthrottled_);
+                unthrottled_ = 0;
+            }
+        }
+
+        void flush_allocations()
+        {
+            if (allocations_.size())
+            {
+                std::lock_guard<std::mutex> lock(checker_.allocations_mutex_);
+                checker_.pending_allocations_.push_back(std::move(allocations_));
+                allocations_ = std::vector<AllocationMetadataT>{};
+            }
+        }
+
+        void finish()
+        {
+            flush_allocations();
+            snapshots_.clear();
+        }
+    };
+
+    std::vector<CDescrPtr> snapshots_;
+    OpenSnapshotFn open_snapshot_fn_;
+
+    LiteAllocationMap<ApiProfileT>& allocations_;
+    std::vector<std::vector<AllocationMetadataT>> pending_allocations_;
+    std::mutex allocations_mutex_;
+
+    CheckResultConsumerFn consumer_;
+    std::mutex consumer_mutex_;
+
+    StoreCheckOptions options_;
+    size_t threads_;
+
+    SWMRConcurrentBlockSet<Profile> checked_blocks_;
+    SWMRConcurrentBlockCounters<Profile> counters_;
+    detail::SWMRCheckRateLimiter rate_limiter_;
+
+    std::vector<CheckTask> check_tasks_;
+    std::atomic<size_t> next_check_task_{};
+
+    std::vector<BlockTask> root_tasks_;
+    std::deque<BlockTask> shared_tasks_;
+    std::mutex shared_tasks_mutex_;
+    std::condition_variable shared_tasks_cv_;
+    std::atomic<uint64_t> outstanding_tasks_{};
+    std::atomic<size_t> idle_workers_{};
+
+    std::atomic<uint64_t> tasks_total_{};
+    std::atomic<uint64_t> tasks_done_{};
+    std::atomic<uint64_t> blocks_{};
+    std::atomic<uint64_t> bytes_{};
+
+    std::atomic<bool> failed_{false};
+    std::exception_ptr error_;
+    std::mutex error_mutex_;
+
+    Clock::time_point start_time_;
+
+public:
+    SWMRParallelChecker(
+            std::vector<CDescrPtr> snapshots,
+            OpenSnapshotFn open_snapshot_fn,
+            LiteAllocationMap<ApiProfileT>& allocations,
+            const CheckResultConsumerFn& consumer,
+            const StoreCheckOptions& options
+    ):
+        snapshots_(std::move(snapshots)),
+        open_snapshot_fn_(std::move(open_snapshot_fn)),
+        allocations_(allocations),
+        consumer_(consumer),
+        options_(options),
+        threads_(options.threads ? options.threads : std::max(1u, std::thread::hardware_concurrency())),
+        rate_limiter_(options.max_read_rate)
+    {}
+
+    void run()
+    {
+        start_time_ = Clock::now();
+
+        prepare_tasks();
+
+        tasks_total_ = check_tasks_.size();
+        run_phase([&](Worker& worker){
+            run_check_tasks(worker);
+        });
+
+        tasks_total_ = 0;
+        tasks_done_  = 0;
+
+        for (const auto& task: root_tasks_)
+        {
+            if (counters_.inc(task.block_id)) {
+                shared_tasks_.push_back(task);
+            }
+        }
+
+        tasks_total_ = outstanding_tasks_ = shared_tasks_.size();
+        run_phase([&](Worker& worker){
+            run_block_tasks(worker);
+        });
+    }
+
+    void build_counters(SWMRBlockCounters<Profile>& counters) const {
+        counters_.merge_to(counters);
+    }
+
+private:
+    // Superblocks are registered and the task lists are built
+    // on the calling thread, one snapshot open at a time.
+    void prepare_tasks()
+    {
+        ska::flat_hash_set<BlockID> ctr_roots;
+
+        for (size_t idx = 0; idx < snapshots_.size(); idx++)
+        {
+            auto snp = open_snapshot_fn_(snapshots_[idx]);
+            snp->add_superblock(allocations_);
+
+            check_tasks_.push_back(CheckTask{idx, true, CtrID{}, BlockID{}});
+
+            // The same root means the same tree
+            snp->for_each_ctr_root([&](const CtrID& ctr_name, const BlockID& root_id){
+                if (ctr_roots.insert(root_id).second) {
+                    check_tasks_.push_back(CheckTask{idx, false, ctr_name, root_id});
+                }
+            });
+
+            snp->for_each_root_block([&](const BlockID& root_id){
+                if (!root_id.is_null()) {
+                    root_tasks_.push_back(BlockTask{idx, root_id});
+                }
+            });
+        }
+    }
+
+    template <typename Fn>
+    void run_phase(Fn&& fn)
+    {
+        std::mutex done_mutex;
+        std::condition_variable done_cv;
+        size_t running = threads_;
+
+        std::vector<std::thread> threads;
+        for (size_t c = 0; c < threads_; c++)
+        {
+            threads.emplace_back([&]{
+                Worker worker(*this);
+
+                try {
+                    fn(worker);
+                    worker.finish();
+                }
+                catch (...) {
+                    fail(std::current_exception());
+                }
+
+                std::lock_guard<std::mutex> lock(done_mutex);
+                running--;
+                done_cv.notify_all();
+            });
+        }
+
+        auto interval = std::chrono::milliseconds(options_.progress_interval_ms);
+        auto next_report = Clock::now() + interval;
+
+        while (true)
+        {
+            bool done;
+            {
+                std::unique_lock<std::mutex> lock(done_mutex);
+                done = done_cv.wait_for(lock, std::chrono::milliseconds(10), [&]{
+                    return running == 0;
+                });
+            }
+
+            merge_allocations();
+
+            if (done) {
+                break;
+            }
+
+            if (Clock::now() >= next_report) {
+                report_progress();
+                next_report = Clock::now() + interval;
+            }
+        }
+
+        for (auto& thread: threads) {
+            thread.join();
+        }
+
+        if (error_) {
+            std::rethrow_exception(error_);
+        }
+
+        report_progress();
+    }
+
+    void run_check_tasks(Worker& worker)
+    {
+        CheckResultConsumerFn consumer = [&](CheckSeverity svr, const hermes::HermesCtr& doc) {
+            std::lock_guard<std::mutex> lock(consumer_mutex_);
+            consumer_(svr, doc);
+        };
+
+        while (!failed_.load(std::memory_order_relaxed))
+        {
+            size_t idx = next_check_task_.fetch_add(1);
+            if (idx >= check_tasks_.size()) {
+                break;
+            }
+
+            const auto& task = check_tasks_[idx];
+            auto snp = worker.snapshot(task.snapshot);
+
+            if (task.system) {
+                snp->check_system_ctrs(consumer);
+            }
+            else {
+                snp->check_ctr(task.ctr_name, task.root_id, consumer);
+            }
+
+            tasks_done_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void run_block_tasks(Worker& worker)
+    {
+        auto& stack = worker.stack_;
+
+        while (!failed_.load(std::memory_order_relaxed))
+        {
+            BlockTask task;
+            if (stack.size()) {
+                task = stack.back();
+                stack.pop_back();
+            }
+            else if (!take_shared_task(task)) {
+                break;
+            }
+
+            auto snp = worker.snapshot(task.snapshot);
+            size_t size = snp->for_each_block_child(task.block_id, [&](const BlockID& child_id){
+                if (!child_id.is_null() && counters_.inc(child_id))
+                {
+                    outstanding_tasks_.fetch_add(1);
+                    tasks_total_.fetch_add(1, std::memory_order_relaxed);
+                    stack.push_back(BlockTask{task.snapshot, child_id});
+                }
+            });
+
+            worker.on_block_read(size);
+            tasks_done_.fetch_add(1, std::memory_order_relaxed);
+
+            if (outstanding_tasks_.fetch_sub(1) == 1)
+            {
+                std::lock_guard<std::mutex> lock(shared_tasks_mutex_);
+                shared_tasks_cv_.notify_all();
+            }
+
+            if (stack.size() > 1 && idle_workers_.load(std::memory_order_relaxed) > 0) {
+                share_tasks(stack);
+            }
+        }
+    }
+
+    // Gives the bottom half of the stack, nodes closest
+    // to the roots, to idle workers.
+    void share_tasks(std::vector<BlockTask>& stack)
+    {
+        size_t half = stack.size() / 2;
+
+        std::lock_guard<std::mutex> lock(shared_tasks_mutex_);
+        shared_tasks_.insert(shared_tasks_.end(), stack.begin(), stack.begin() + half);
+        stack.erase(stack.begin(), stack.begin() + half);
+
+        shared_tasks_cv_.notify_all();
+    }
+
+    bool take_shared_task(BlockTask& task)
+    {
+        std::unique_lock<std::mutex> lock(shared_tasks_mutex_);
+
+        idle_workers_++;
+        shared_tasks_cv_.wait(lock, [&]{
+            return shared_tasks_.size() || outstanding_tasks_.load() == 0 || failed_.load();
+        });
+        idle_workers_--;
+
+        if (shared_tasks_.empty() || failed_.load()) {
+            return false;
+        }
+
+        task = shared_tasks_.front();
+        shared_tasks_.pop_front();
+        return true;
+    }
+
+    void merge_allocations()
+    {
+        std::vector<std::vector<AllocationMetadataT>> batches;
+        {
+            std::lock_guard<std::mutex> lock(allocations_mutex_);
+            batches.swap(pending_allocations_);
+        }
+
+        for (const auto& batch: batches) {
+            for (const auto& alc: batch) {
+                allocations_.append(alc);
+            }
+        }
+    }
+
+    void fail(std::exception_ptr ex)
+    {
+        {
+            std::lock_guard<std::mutex> lock(error_mutex_);
+            if (!error_) {
+                error_ = ex;
+            }
+        }
+
+        failed_ = true;
+
+        std::lock_guard<std::mutex> lock(shared_tasks_mutex_);
+        shared_tasks_cv_.notify_all();
+    }
+
+    void report_progress()
+    {
+        if (options_.progress_fn)
+        {
+            StoreCheckProgress progress;
+            progress.tasks_total = tasks_total_.load();
+            progress.tasks_done  = tasks_done_.load();
+            progress.blocks      = blocks_.load();
+            progress.bytes       = bytes_.load();
+            progress.elapsed_ms  = std::chrono::duration_cast<std::chrono::milliseconds>(
+                Clock::now() - start_time_
+            ).count();
+
+            options_.progress_fn(progress);
+        }
+    }
+};
+
+}
@@ -63,8 +63,14 @@ public:
     void start_no_reentry(const CtrID& ctr_id) {}
     void finish_no_reentry(const CtrID& ctr_id) noexcept {}
 
-    void register_allocation(const AllocationMetadataT& alc) {
-        this->store_->register_allocation(alc);
+    void register_allocation(const AllocationMetadataT& alc)
+    {
+        if (this->check_context_) {
+            this->check_context_->register_allocation(alc);
+        }
+        else {
+            this->store_->register_allocation(alc);
+        }
     }
 };
 
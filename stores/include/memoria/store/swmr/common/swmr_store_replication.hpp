@@ -0,0 +1,313 @@
+// Copyright 2026 Victor Smirnov
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <memoria/core/tools/span.hpp>
+#include <memoria/core/tools/result.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include <unistd.h>
+#include <errno.h>
+
+namespace memoria {
+
+struct SWMRFileRegion {
+    uint64_t file_pos;
+    uint64_t size;
+};
+
+// Replication record layout: header, written regions, freed regions,
+// superblock positions of evicted snapshots, then the bytes of the
+// written regions in the same order. All fields are in the host's
+// byte order, leader and follower are expected to share the platform.
+struct SWMRReplicationRecordHeader {
+    static constexpr uint64_t MAGICK  = 0x315045524d4d5753ull; // "SWMMREP1"
+    static constexpr uint32_t VERSION = 1;
+
+    static constexpr uint32_t CONSISTENCY_POINT = 1;
+
+    uint64_t magick;
+    uint32_t version;
+    uint32_t flags;
+    uint64_t file_size;
+    uint64_t sequence_id;
+
+    // Zero for records that only update the store's header,
+    // like the one made by closing the store.
+    uint64_t superblock_file_pos;
+    int64_t  commit_time;
+
+    uint64_t regions;
+    uint64_t freed;
+    uint64_t evicted;
+    uint64_t data_size;
+};
+
+class SWMRReplicationRecordBuilder {
+    std::vector<SWMRFileRegion> regions_;
+    std::vector<SWMRFileRegion> freed_;
+    std::vector<uint64_t> evicted_;
+
+public:
+    void add_region(uint64_t file_pos, uint64_t size) {
+        regions_.push_back(SWMRFileRegion{file_pos, size});
+    }
+
+    void add_freed(uint64_t file_pos, uint64_t size) {
+        freed_.push_back(SWMRFileRegion{file_pos, size});
+    }
+
+    void add_evicted(uint64_t superblock_file_pos) {
+        evicted_.push_back(superblock_file_pos);
+    }
+
+    void clear()
+    {
+        regions_.clear();
+        freed_.clear();
+        evicted_.clear();
+    }
+
+    // Adjacent and overlapping regions are merged, so a run of blocks
+    // allocated from the same extent is shipped as one region.
+    std::vector<uint8_t> build(SWMRReplicationRecordHeader header, Span<const uint8_t> buffer)
+    {
+        coalesce(regions_);
+        coalesce(freed_);
+
+        uint64_t data_size{};
+        for (const auto& region: regions_)
+        {
+            if (region.file_pos + region.size > buffer.size()) {
+                MEMORIA_MAKE_GENERIC_ERROR(
+                    "Replicated region {}:{} is out of the file bounds {}",
+                    region.file_pos, region.size, buffer.size()
+                ).do_throw();
+            }
+            data_size += region.size;
+        }
+
+        header.magick    = SWMRReplicationRecordHeader::MAGICK;
+        header.version   = SWMRReplicationRecordHeader::VERSION;
+        header.file_size = buffer.size();
+        header.regions   = regions_.size();
+        header.freed     = freed_.size();
+        header.evicted   = evicted_.size();
+        header.data_size = data_size;
+
+        std::vector<uint8_t> record(
+            sizeof(header) +
+            (regions_.size() + freed_.size()) * sizeof(SWMRFileRegion) +
+            evicted_.size() * sizeof(uint64_t) +
+            data_size
+        );
+
+        uint8_t* ptr = record.data();
+        ptr = put(ptr, &header, sizeof(header));
+        ptr = put(ptr, regions_.data(), regions_.size() * sizeof(SWMRFileRegion));
+        ptr = put(ptr, freed_.data(), freed_.size() * sizeof(SWMRFileRegion));
+        ptr = put(ptr, evicted_.data(), evicted_.size() * sizeof(uint64_t));
+
+        for (const auto& region: regions_) {
+            ptr = put(ptr, buffer.data() + region.file_pos, region.size);
+        }
+
+        clear();
+
+        return record;
+    }
+
+private:
+    static uint8_t* put(uint8_t* ptr, const void* data, size_t size)
+    {
+        if (size) {
+            std::memcpy(ptr, data, size);
+        }
+        return ptr + size;
+    }
+
+    static void coalesce(std::vector<SWMRFileRegion>& regions)
+    {
+        if (regions.empty()) {
+            return;
+        }
+
+        std::sort(regions.begin(), regions.end(), [](const auto& one, const auto& two){
+            return one.file_pos < two.file_pos;
+        });
+
+        size_t last = 0;
+        for (size_t c = 1; c < regions.size(); c++)
+        {
+            auto& prev = regions[last];
+            if (regions[c].file_pos <= prev.file_pos + prev.size)
+            {
+                uint64_t end = std::max(prev.file_pos + prev.size, regions[c].file_pos + regions[c].size);
+                prev.size = end - prev.file_pos;
+            }
+            else {
+                regions[++last] = regions[c];
+            }
+        }
+
+        regions.resize(last + 1);
+    }
+};
+
+
+class SWMRReplicationRecordView {
+    SWMRReplicationRecordHeader header_;
+    Span<const SWMRFileRegion> regions_;
+    Span<const SWMRFileRegion> freed_;
+    Span<const uint64_t> evicted_;
+    const uint8_t* data_;
+
+public:
+    SWMRReplicationRecordView(Span<const uint8_t> record)
+    {
+        if (record.size() < sizeof(header_)) {
+            MEMORIA_MAKE_GENERIC_ERROR("Replication record is too short: {}", record.size()).do_throw();
+        }
+
+        std::memcpy(&header_, record.data(), sizeof(header_));
+
+        if (header_.magick != SWMRReplicationRecordHeader::MAGICK) {
+            MEMORIA_MAKE_GENERIC_ERROR("Replication record magick number mismatch: {}", header_.magick).do_throw();
+        }
+
+        if (header_.version != SWMRReplicationRecordHeader::VERSION) {
+            MEMORIA_MAKE_GENERIC_ERROR("Unsupported replication record version: {}", header_.version).do_throw();
+        }
+
+        uint64_t size = sizeof(header_) +
+            (header_.regions + header_.freed) * sizeof(SWMRFileRegion) +
+            header_.evicted * sizeof(uint64_t) +
+            header_.data_size;
+
+        if (size != record.size()) {
+            MEMORIA_MAKE_GENERIC_ERROR(
+                "Replication record size mismatch: {}, expected {}", record.size(), size
+            ).do_throw();
+        }
+
+        // The header's size is a multiple of 8, so the arrays
+        // following it are aligned as long as the record is.
+        const uint8_t* ptr = record.data() + sizeof(header_);
+
+        regions_ = Span<const SWMRFileRegion>(reinterpret_cast<const SWMRFileRegion*>(ptr), header_.regions);
+        ptr += header_.regions * sizeof(SWMRFileRegion);
+
+        freed_ = Span<const SWMRFileRegion>(reinterpret_cast<const SWMRFileRegion*>(ptr), header_.freed);
+        ptr += header_.freed * sizeof(SWMRFileRegion);
+
+        evicted_ = Span<const uint64_t>(reinterpret_cast<const uint64_t*>(ptr), header_.evicted);
+        ptr += header_.evicted * sizeof(uint64_t);
+
+        data_ = ptr;
+
+        uint64_t data_size{};
+        for (const auto& region: regions_) {
+            data_size += region.size;
+        }
+
+        if (data_size != header_.data_size) {
+            MEMORIA_MAKE_GENERIC_ERROR(
+                "Replication record data size mismatch: {}, expected {}", data_size, header_.data_size
+            ).do_throw();
+        }
+    }
+
+    const SWMRReplicationRecordHeader& header() const {
+        return header_;
+    }
+
+    bool is_consistency_point() const {
+        return header_.flags & SWMRReplicationRecordHeader::CONSISTENCY_POINT;
+    }
+
+    Span<const SWMRFileRegion> regions() const {return regions_;}
+    Span<const SWMRFileRegion> freed() const {return freed_;}
+    Span<const uint64_t> evicted() const {return evicted_;}
+
+    template <typename Fn>
+    void for_each_region(Fn&& fn) const
+    {
+        const uint8_t* ptr = data_;
+        for (const auto& region: regions_) {
+            fn(region, Span<const uint8_t>(ptr, region.size));
+            ptr += region.size;
+        }
+    }
+};
+
+
+// Length-prefixed framing of replication records for byte stream
+// transports like pipes and sockets.
+namespace detail {
+
+inline void replication_io(int fd, uint8_t* data, size_t size, bool write, bool* eof = nullptr)
+{
+    size_t done{};
+    while (done < size)
+    {
+        ssize_t rr = write ? ::write(fd, data + done, size - done) : ::read(fd, data + done, size - done);
+        if (rr > 0) {
+            done += rr;
+        }
+        else if (rr == 0 && !write && done == 0 && eof) {
+            *eof = true;
+            return;
+        }
+        else if (rr < 0 && errno == EINTR) {
+            continue;
+        }
+        else {
+            MEMORIA_MAKE_GENERIC_ERROR(
+                "Replication stream {} error on fd {}: {}", write ? "write" : "read", fd,
+                rr < 0 ? std::strerror(errno) : "unexpected end of stream"
+            ).do_throw();
+        }
+    }
+}
+
+}
+
+inline void write_replication_record(int fd, Span<const uint8_t> record)
+{
+    uint64_t size = record.size();
+    detail::replication_io(fd, reinterpret_cast<uint8_t*>(&size), sizeof(size), true);
+    detail::replication_io(fd, const_cast<uint8_t*>(record.data()), record.size(), true);
+}
+
+// Returns false at the end of the stream.
+inline bool read_replication_record(int fd, std::vector<uint8_t>& record)
+{
+    uint64_t size{};
+    bool eof{};
+    detail::replication_io(fd, reinterpret_cast<uint8_t*>(&size), sizeof(size), false, &eof);
+    if (eof) {
+        return false;
+    }
+
+    record.resize(size);
+    detail::replication_io(fd, record.data(), size, false);
+    return true;
+}
+
+}
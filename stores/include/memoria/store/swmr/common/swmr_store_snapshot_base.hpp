@@ -34,6 +34,8 @@
 #include <memoria/store/swmr/common/lite_allocation_map.hpp>
 #include <memoria/store/swmr/common/allocation_pool.hpp>
 
+#include <memoria/store/common/store_stat_counters.hpp>
+
 #include <memoria/core/tools/uid_256.hpp>
 
 
@@ -57,6 +59,20 @@ struct SnapshotCheckState {
     SWMRBlockCounters<Profile> counters;
 };
 
+// Per-worker state of the parallel store checker,
+// attached to the snapshots the worker opens.
+template <typename Profile>
+struct SWMRCheckContext {
+    using BlockID = ProfileBlockID<Profile>;
+    using AllocationMetadataT = AllocationMetadata<ApiProfile<Profile>>;
+
+    virtual ~SWMRCheckContext() noexcept = default;
+
+    virtual bool check_subtree(const BlockID& block_id) = 0;
+    virtual void register_allocation(const AllocationMetadataT& alc) = 0;
+    virtual void on_block_read(size_t size) = 0;
+};
+
 
 template <typename Profile>
 struct ReferenceCounterDelegate {
@@ -143,10 +159,14 @@ protected:
 
     ReferenceCounterDelegate<Profile>* refcounter_delegate_;
 
+    SWMRCheckContext<Profile>* check_context_{};
+
     hermes::HermesCtr metadata_;
 
     bool writable_{false};
 
+    SnapshotIOStatCollector<Profile> io_stat_;
+
 public:
     using Base::getBlock;
 
@@ -157,7 +177,8 @@ public:
     ) :
         store_(store),
         snapshot_descriptor_(snapshot_descriptor),
-        refcounter_delegate_(refcounter_delegate)
+        refcounter_delegate_(refcounter_delegate),
+        io_stat_(&store->io_stat_counters())
     {
         instance_pool_ = std::make_shared<CtrInstancePool<Profile>>();
 
@@ -251,6 +272,14 @@ public:
         return allocation_map_ctr_->check_allocated(alc);
     }
 
+    virtual bool check_subtree(const BlockID& block_id) {
+        return check_context_ ? check_context_->check_subtree(block_id) : true;
+    }
+
+    void set_check_context(SWMRCheckContext<Profile>* context) {
+        check_context_ = context;
+    }
+
     virtual SharedSBPtr<Superblock> get_superblock(uint64_t pos) = 0;
 
     virtual CtrSharedPtr<CtrReferenceable<ApiProfileT>> internal_create_by_name(
@@ -450,6 +479,15 @@ public:
     }
 
     virtual void check(const CheckResultConsumerFn& consumer)
+    {
+        check_system_ctrs(consumer);
+
+        directory_ctr_->for_each([&](auto ctr_name, auto block_id){
+          check_ctr(ctr_name, block_id, consumer);
+        });
+    }
+
+    void check_system_ctrs(const CheckResultConsumerFn& consumer)
     {
         directory_ctr_->check(consumer);
 
@@ -460,14 +498,22 @@ public:
 
         allocation_map_ctr_->check(consumer);
         check_allocation_pool(consumer);
+    }
 
-        directory_ctr_->for_each([&](auto ctr_name, auto block_id){
-          auto block = this->getBlock(block_id);
+    void check_ctr(const CtrID& ctr_name, const BlockID& root_id, const CheckResultConsumerFn& consumer)
+    {
+        auto block = this->getBlock(root_id);
 
-          auto ctr_intf = ProfileMetadata<Profile>::local()
-                  ->get_container_operations(block->ctr_type_hash());
+        auto ctr_intf = ProfileMetadata<Profile>::local()
+                ->get_container_operations(block->ctr_type_hash());
 
-          ctr_intf->check(ctr_name, this->self_ptr(), consumer);
+        ctr_intf->check(ctr_name, this->self_ptr(), consumer);
+    }
+
+    void for_each_ctr_root(const std::function<void (const CtrID&, const BlockID&)>& fn)
+    {
+        directory_ctr_->for_each([&](auto ctr_name, auto block_id){
+            fn(ctr_name, block_id);
         });
     }
 
@@ -475,6 +521,10 @@ public:
 
     void check_storage(SharedBlockConstPtr block, const CheckResultConsumerFn& consumer)
     {
+        if (check_context_) {
+            check_context_->on_block_read(block->memory_block_size());
+        }
+
         init_allocator_ctr();
         check_storage_specific(block, consumer);
 
@@ -622,6 +672,18 @@ public:
         return Optional<U8String>{};
     }
 
+    virtual StoreIOStat io_stat() const {
+        return io_stat_.stat();
+    }
+
+    virtual void start_block_access_trace() {
+        io_stat_.start_trace();
+    }
+
+    virtual std::vector<BlockAccessTraceEntry<ApiProfileT>> stop_block_access_trace() {
+        return io_stat_.stop_trace();
+    }
+
     virtual SnpSharedPtr<IStoreApiBase<ApiProfileT>> snapshot_ref_opening_allowed() {
         return SnpSharedPtr<IStoreApiBase<ApiProfileT>>{};
     }
@@ -696,18 +758,39 @@ public:
     {
         RebuildRefcountersHandler handler(counters);
 
+        for_each_root_block([&](const BlockID& root_id){
+            traverse_ctr(root_id, handler);
+        });
+    }
+
+    void for_each_root_block(const std::function<void (const BlockID&)>& fn)
+    {
         auto sb = get_superblock();
 
-        traverse_ctr(sb->directory_root_id(), handler);
+        fn(sb->directory_root_id());
 
-        traverse_ctr(sb->history_root_id(), handler);
-        traverse_ctr(sb->allocator_root_id(), handler);
+        fn(sb->history_root_id());
+        fn(sb->allocator_root_id());
 
-        if (get_superblock()->blockmap_root_id().is_set()) {
-            traverse_ctr(sb->blockmap_root_id(), handler);
+        if (sb->blockmap_root_id().is_set()) {
+            fn(sb->blockmap_root_id());
         }
     }
 
+    // One step of traverse_ctr(): lists block's children
+    // without descending into them. Returns block's size.
+    size_t for_each_block_child(const BlockID& block_id, const std::function<void (const BlockID&)>& fn)
+    {
+        auto block = getBlock(block_id);
+
+        auto blk_intf = ProfileMetadata<Profile>::local()
+                ->get_block_operations(block->ctr_type_hash(), block->block_type_hash());
+
+        blk_intf->for_each_child(block.block(), fn);
+
+        return block->memory_block_size();
+    }
+
 
 
 
@@ -891,15 +974,52 @@ public:
     struct ResolvedBlock {
         uint64_t file_pos;
         SharedBlockConstPtr block;
+        BlockCacheAccess cache{BlockCacheAccess::NONE};
     };
 
     virtual ResolvedBlock resolve_block(const BlockID& block_id) = 0;
     virtual AllocationMetadataT resolve_block_allocation(const BlockID& block_id) = 0;
 
-    SharedBlockConstPtr getBlock(const BlockID& block_id) {
-        return resolve_block(block_id).block;
+    SharedBlockConstPtr getBlock(const BlockID& block_id)
+    {
+        auto resolved = resolve_block(block_id);
+        if (resolved.block) {
+            io_stat_.on_read(block_id, resolved.block.block(), resolved.cache);
+        }
+        return std::move(resolved.block);
+    }
+
+    // Read-ahead is a hint: blocks that can't be resolved
+    // are skipped, the following reads will report the error.
+    // Only Memoria's own errors are ignored, OOM and the like
+    // are propagated.
+    virtual void prefetch_blocks(Span<const BlockID> block_ids)
+    {
+        for (const BlockID& block_id: block_ids)
+        {
+            try {
+                prefetch_block(block_id);
+                io_stat_.on_prefetch();
+            }
+            catch (const ResultException&) {
+            }
+            catch (const MemoriaThrowable&) {
+            }
+        }
     }
 
+    // Block IDs of lite profiles are positions, so resolving
+    // them is cheap. Stores with a BlockMap override this.
+    virtual void prefetch_block(const BlockID& block_id)
+    {
+        auto alc = resolve_block_allocation(block_id);
+        prefetch_file_region(alc.position() * BASIC_BLOCK_SIZE, alc.size1() * BASIC_BLOCK_SIZE);
+    }
+
+    // Byte range of the store's file. Only mapped stores can do
+    // something useful here.
+    virtual void prefetch_file_region(uint64_t file_pos, uint64_t size) {}
+
     void for_each_history_entry_batch(const std::function<void (Span<const SnapshotID>, Span<const SnapshotMetadataT>)>& fn)
     {
         init_history_ctr();
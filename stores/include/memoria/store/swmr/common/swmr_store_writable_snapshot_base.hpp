@@ -22,6 +22,10 @@
 
 #include <memoria/core/flat_map/flat_hash_map.hpp>
 
+#include <memory>
+#include <mutex>
+#include <vector>
+
 
 namespace memoria {
 
@@ -86,7 +90,6 @@ protected:
     using Base::allocation_map_ctr_;
     using Base::history_ctr_;
     using Base::createCtrName;
-    using Base::getRootID;
     using Base::getBlock;
     using Base::instance_pool;
 
@@ -98,6 +101,7 @@ protected:
     using Base::is_system_snapshot;
 
     using Base::ALLOCATION_MAP_LEVELS;
+    using Base::ALLOCATION_MAP_SIZE_STEP;
     using Base::BASIC_BLOCK_SIZE;
     using Base::SUPERBLOCK_ALLOCATION_LEVEL;
     using Base::SUPERBLOCK_SIZE;
@@ -125,10 +129,15 @@ protected:
     Optional<AllocationMetadataT> preallocated_;
 
     bool populating_allocation_pool_{};
+    bool growing_store_{};
     int32_t allocate_reserved_{};
     int32_t forbid_allocations_{};
     bool init_store_mode_{};
 
+    // The store grows by 1/STORE_GROWTH_RATIO of its current size,
+    // but not less than ALLOCATION_MAP_SIZE_STEP.
+    static constexpr uint64_t STORE_GROWTH_RATIO = 8;
+
     bool allocator_map_cloned_{};
 
     class FlagScope {
@@ -186,6 +195,22 @@ protected:
     // removed, we can proceed proceed removing node's ancestors.
     ska::flat_hash_map<SnapshotID, RWCounter> branch_removal_counters_;
 
+    // Write sessions. A session is a snapshot object of its own, sharing
+    // the descriptor (and the superblock) with the parent snapshot. It has
+    // its own allocation sub-pool and counters, everything else it needs
+    // from the parent is accessed under the parent's mutex.
+    static constexpr size_t SESSION_POOL_CAPACITY = 4096;
+
+    MyType* session_parent_{};
+    CtrID session_ctr_id_{};
+    std::unique_ptr<AllocationPoolT> session_pool_;
+    ArenaBuffer<AllocationMetadataT> session_allocations_;
+    uint64_t session_allocated_{};
+
+    std::mutex write_sessions_mutex_;
+    std::vector<SnpSharedPtr<MyType>> write_sessions_;
+    ska::flat_hash_set<CtrID> write_session_ctrs_;
+
 public:
     using Base::check;
     using Base::resolve_block;
@@ -217,10 +242,17 @@ public:
     virtual Shared* allocate_block(uint64_t at, size_t size, bool for_idmap) = 0;
     virtual Shared* allocate_block_from(const BlockType* source, uint64_t at, bool for_idmap) = 0;
 
+    // Creates an uninitialized snapshot object of the same
+    // type for the same descriptor, to be used as a write session.
+    virtual SnpSharedPtr<MyType> make_write_session() = 0;
+
     virtual void init_idmap() {}
     virtual void open_idmap() {}
     virtual void drop_idmap() {}
 
+    // Called after the store's file has been grown by this snapshot
+    virtual void memory_grown() {}
+
     virtual void init_snapshot(MaybeError& maybe_error)  {}
     virtual void init_store_snapshot(MaybeError& maybe_error)  {}
 
@@ -240,7 +272,28 @@ public:
         }
     }
 
-    AllocationMetadataT allocate_one_or_throw(int32_t level = 0)
+    // Leaves of data containers are allocated from per-container
+    // extents of the allocation pool. Branch nodes and system containers
+    // are allocated without locality.
+    uint64_t locality_key_for(const CtrID& ctr_id, BlockAllocationHint hint) const
+    {
+        if (hint != BlockAllocationHint::LEAF || init_store_mode_) {
+            return 0;
+        }
+
+        if (
+            ctr_id == AllocationMapCtrID ||
+            ctr_id == HistoryCtrID ||
+            ctr_id == DirectoryCtrID ||
+            ctr_id == BlockMapCtrID
+        ) {
+            return 0;
+        }
+
+        return std::hash<CtrID>{}(ctr_id) | 1ull;
+    }
+
+    AllocationMetadataT allocate_one_or_throw(int32_t level = 0, uint64_t locality_key = 0)
     {
         if (MMA_UNLIKELY(forbid_allocations_))
         {
@@ -254,7 +307,7 @@ public:
         }
         else if (MMA_LIKELY(!allocate_reserved_))
         {
-            auto alc = allocation_pool_->allocate_one(level);
+            auto alc = allocation_pool_->allocate_one(level, locality_key);
             if (alc)
             {
                 if (MMA_UNLIKELY(init_store_mode_)) {
@@ -267,6 +320,9 @@ public:
                 // Level must be 0 here
                 return do_allocate_reserved(1);
             }
+            else if (MMA_UNLIKELY(session_parent_ != nullptr)) {
+                return allocate_from_parent(level, locality_key);
+            }
             else {
                 // FIXME: More clever logic is needed here
                 // Current pool population algirithm is not optimal.
@@ -301,6 +357,178 @@ public:
         }
     }
 
+    // Sessions refill their sub-pools with whole locality extents taken
+    // from the parent's pool, so the parent's mutex is taken once per
+    // extent, not per block, and locality of leaves is preserved.
+    AllocationMetadataT allocate_from_parent(int32_t level, uint64_t locality_key)
+    {
+        int32_t refill_level = std::max<int32_t>(level, allocation_pool_->extent_level());
+
+        auto refill = with_parent([&](MyType& parent){
+            return parent.allocate_one_or_throw(refill_level);
+        });
+
+        if (!allocation_pool_->add(refill)) {
+            MEMORIA_MAKE_GENERIC_ERROR("Write session's allocation pool is full").do_throw();
+        }
+
+        auto alc = allocation_pool_->allocate_one(level, locality_key);
+        if (alc) {
+            return alc.value();
+        }
+
+        MEMORIA_MAKE_GENERIC_ERROR("Can't allocate a block at level {} in write session", level).do_throw();
+    }
+
+    template <typename Fn>
+    auto with_parent(Fn&& fn)
+    {
+        std::lock_guard<std::mutex> lock(session_parent_->write_sessions_mutex_);
+        return fn(*session_parent_);
+    }
+
+    // Runs the function under parent's mutex in write sessions.
+    template <typename Fn>
+    auto with_parent_lock(Fn&& fn)
+    {
+        if (MMA_UNLIKELY(session_parent_ != nullptr)) {
+            std::lock_guard<std::mutex> lock(session_parent_->write_sessions_mutex_);
+            return fn();
+        }
+
+        return fn();
+    }
+
+    // Sessions update counters of blocks they may share with the
+    // parent's containers, so the parent's containers are not
+    // accessible until sessions are merged.
+    void check_no_write_sessions()
+    {
+        std::lock_guard<std::mutex> lock(write_sessions_mutex_);
+        if (MMA_UNLIKELY(!write_sessions_.empty())) {
+            MEMORIA_MAKE_GENERIC_ERROR(
+                "Snapshot {} has open write sessions, its containers are not accessible until it's prepared", snapshot_id()
+            ).do_throw();
+        }
+    }
+
+    void check_session_ctr(const CtrID& ctr_id)
+    {
+        if (MMA_UNLIKELY(session_parent_ != nullptr))
+        {
+            if (ctr_id != session_ctr_id_) {
+                MEMORIA_MAKE_GENERIC_ERROR(
+                    "Container {} is not a part of the write session for {}", ctr_id, session_ctr_id_
+                ).do_throw();
+            }
+        }
+        else {
+            check_no_write_sessions();
+        }
+    }
+
+    virtual SharedPtr<ISWMRStoreWritableSnapshot<ApiProfileT>> open_write_session(const CtrID& ctr_id)
+    {
+        if (session_parent_) {
+            MEMORIA_MAKE_GENERIC_ERROR("Write sessions can't be nested").do_throw();
+        }
+
+        if (!is_active()) {
+            MEMORIA_MAKE_GENERIC_ERROR("Snapshot {} has been already closed", snapshot_id()).do_throw();
+        }
+
+        if (
+            ctr_id == AllocationMapCtrID ||
+            ctr_id == HistoryCtrID ||
+            ctr_id == DirectoryCtrID ||
+            ctr_id == BlockMapCtrID
+        ) {
+            MEMORIA_MAKE_GENERIC_ERROR("System container {} can't be updated in a write session", ctr_id).do_throw();
+        }
+
+        std::lock_guard<std::mutex> lock(write_sessions_mutex_);
+
+        if (write_session_ctrs_.count(ctr_id)) {
+            MEMORIA_MAKE_GENERIC_ERROR("Container {} is already a part of a write session", ctr_id).do_throw();
+        }
+
+        // Container's instance in this snapshot would be stale
+        // after the session is merged.
+        instance_pool().remove(ctr_id);
+
+        auto session = make_write_session();
+        session->init_write_session(this, ctr_id);
+
+        write_sessions_.push_back(session);
+        write_session_ctrs_.insert(ctr_id);
+
+        return session;
+    }
+
+    void init_write_session(MyType* parent, const CtrID& ctr_id)
+    {
+        session_parent_ = parent;
+        session_ctr_id_ = ctr_id;
+        parent_snapshot_id_ = parent->parent_snapshot_id_;
+
+        session_pool_ = std::make_unique<AllocationPoolT>(SESSION_POOL_CAPACITY);
+        session_pool_->set_level0_reserved(0);
+        allocation_pool_ = session_pool_.get();
+    }
+
+    // Moves session's counters, unused blocks and accounting
+    // into the parent. Containers of the session are not
+    // usable after that.
+    void merge_write_session()
+    {
+        if (!is_active()) {
+            return;
+        }
+
+        flush_open_containers();
+
+        allocation_pool_->release_extents();
+
+        with_parent([&](MyType& parent){
+            allocation_pool_->for_each([&](const AllocationMetadataT& alc){
+                if (!parent.allocation_pool_->add(alc)) {
+                    parent.add_postponed_deallocation(alc);
+                }
+            });
+
+            // Session's counters are deltas, other sessions
+            // may have changed the same blocks.
+            for (const auto& entry: counters_) {
+                parent.counters_[entry.first].value += entry.second.value;
+            }
+            counters_.clear();
+
+            for (const auto& alc: session_allocations_.span()) {
+                store_->replicate_allocation(alc);
+            }
+
+            if (parent.consistency_point_snapshot_descriptor_) {
+                parent.consistency_point_snapshot_descriptor_->add_allocated(session_allocated_);
+            }
+        });
+
+        allocation_pool_->clear();
+        session_allocations_.clear();
+        session_allocated_ = 0;
+
+        state_ = State::COMMITTED;
+    }
+
+    void merge_write_sessions()
+    {
+        for (auto& session: write_sessions_) {
+            session->merge_write_session();
+        }
+
+        write_sessions_.clear();
+        write_session_ctrs_.clear();
+    }
+
     void remove_all_blocks(CountersT* counters)
     {
         try {
@@ -590,16 +818,109 @@ public:
             MEMORIA_MAKE_GENERIC_ERROR("Internal Error: populate_allocation_pool() re-entry.").do_throw();
         }
 
-        FlagScope scope(populating_allocation_pool_);
+        {
+            FlagScope scope(populating_allocation_pool_);
+            if (allocation_map_ctr_->populate_allocation_pool(*allocation_pool_, level)) {
+                return;
+            }
+        }
 
-        if (!allocation_map_ctr_->populate_allocation_pool(*allocation_pool_, level))
+        if (grow_store())
         {
+            FlagScope scope(populating_allocation_pool_);
+            if (allocation_map_ctr_->populate_allocation_pool(*allocation_pool_, level)) {
+                return;
+            }
+        }
+
+        MEMORIA_MAKE_GENERIC_ERROR(
+                    "No enough free space among {}K blocks. Requested = {} blocks.",
+                    (BASIC_BLOCK_SIZE / 1024) << level,
+                    1
+        ).do_throw();
+    }
+
+    // Extends the store's file when the allocation map is out of free
+    // blocks, and appends the new range to the allocation map. It's done
+    // as a part of this snapshot, so the new blocks become visible to the
+    // store with its commit. Readers are not affected, the file is
+    // extended in place.
+    bool grow_store()
+    {
+        if (init_store_mode_ || growing_store_) {
+            return false;
+        }
+
+        uint64_t size = get_memory_size();
+        uint64_t increment = std::max<uint64_t>(size / STORE_GROWTH_RATIO, ALLOCATION_MAP_SIZE_STEP);
+
+        uint64_t new_size = store_->grow_buffer(size + increment);
+        if (new_size <= size) {
+            return false;
+        }
+
+        FlagScope scope(growing_store_);
+        memory_grown();
+
+        uint64_t old_blocks = size / BASIC_BLOCK_SIZE;
+        uint64_t new_blocks = new_size / BASIC_BLOCK_SIZE;
+
+        auto sb = get_superblock();
+
+        // Global block counters are stored in a contiguous region sized
+        // for the file at creation time. If it's too small for the new
+        // size, the new region is placed at the start of the added range.
+        constexpr uint64_t ctr_blk_scale = (1 << (ALLOCATION_MAP_LEVELS - 1));
+        uint64_t counters_block_capacity = CounterBlockT::capacity_for(BASIC_BLOCK_SIZE * ctr_blk_scale);
+        uint64_t counters_blocks = div_up(new_blocks, counters_block_capacity) * ctr_blk_scale;
+
+        uint64_t relocated_counters_blocks{};
+        if (counters_blocks > sb->global_block_counters_blocks()) {
+            relocated_counters_blocks = counters_blocks;
+        }
+
+        // Blocks for the allocation map's own growth are taken from
+        // the beginning of the added range.
+        uint64_t seed_pos    = old_blocks + relocated_counters_blocks;
+        uint64_t seed_blocks = ALLOCATION_MAP_SIZE_STEP / BASIC_BLOCK_SIZE;
+
+        if (seed_pos + seed_blocks > new_blocks) {
             MEMORIA_MAKE_GENERIC_ERROR(
-                        "No enough free space among {}K blocks. Requested = {} blocks.",
-                        (BASIC_BLOCK_SIZE / 1024) << level,
-                        1
+                "Store's file growth from {} to {} bytes is too small", size, new_size
             ).do_throw();
         }
+
+        auto seed = AllocationMetadataT::from_l0(seed_pos, seed_blocks, ALLOCATION_MAP_LEVELS - 1);
+        if (!allocation_pool_->add(seed)) {
+            MEMORIA_MAKE_GENERIC_ERROR("Allocation pool is full while growing the store").do_throw();
+        }
+
+        allocation_map_ctr_->expand(new_blocks - old_blocks);
+
+        // Seed blocks are either in the pool or are used by the
+        // allocation map, so they must be marked as allocated.
+        ArenaBuffer<AllocationMetadataT> allocated;
+        allocated.push_back(AllocationMetadataT::from_l0(
+            old_blocks, relocated_counters_blocks + seed_blocks, ALLOCATION_MAP_LEVELS - 1
+        ));
+        allocation_map_ctr_->setup_bits(allocated.span(), true);
+
+        if (relocated_counters_blocks)
+        {
+            uint64_t old_counters_pos = sb->global_block_counters_file_pos() / BASIC_BLOCK_SIZE;
+            uint64_t old_counters_blocks = sb->global_block_counters_blocks();
+
+            sb->set_global_block_counters_file_pos(old_blocks * BASIC_BLOCK_SIZE);
+            sb->set_global_block_counters_blocks(relocated_counters_blocks);
+
+            release_block(AllocationMetadataT::from_l0(
+                old_counters_pos, old_counters_blocks, ALLOCATION_MAP_LEVELS - 1
+            ));
+        }
+
+        sb->set_file_size(new_size);
+
+        return true;
     }
 
     std::pair<uint64_t, SharedSBPtr<Superblock>> allocate_superblock(
@@ -708,8 +1029,14 @@ public:
 
     void prepare(ConsistencyPoint cp)
     {
+        if (MMA_UNLIKELY(session_parent_ != nullptr)) {
+            MEMORIA_MAKE_GENERIC_ERROR("Write sessions can't be prepared, use commit() to merge them").do_throw();
+        }
+
         if (is_active())
         {
+            merge_write_sessions();
+
             if (consistency_point_snapshot_descriptor_) {
                 consistency_point_snapshot_descriptor_->inc_snapshots();
             }
@@ -774,6 +1101,10 @@ public:
             if (evicting_blocks.size() > 0) {
                 evicting_blocks.sort();
                 allocation_map_ctr_->touch_bits(evicting_blocks.span());
+
+                for (const auto& alc: evicting_blocks.span()) {
+                    store_->replicate_deallocation(alc);
+                }
             }
 
             // Note: All deallocation before this line MUST do 'touch bits' to
@@ -827,6 +1158,10 @@ public:
 
     void commit(ConsistencyPoint cp)
     {
+        if (MMA_UNLIKELY(session_parent_ != nullptr)) {
+            return merge_write_session();
+        }
+
         if (is_active()) {
             prepare(cp);
         }
@@ -837,6 +1172,13 @@ public:
 
     void rollback()
     {
+        if (MMA_UNLIKELY(session_parent_ != nullptr)) {
+            MEMORIA_MAKE_GENERIC_ERROR("Write sessions can't be rolled back separately from their snapshot").do_throw();
+        }
+
+        write_sessions_.clear();
+        write_session_ctrs_.clear();
+
         store_->do_rollback(Base::snapshot_descriptor_);
         state_ = State::ROLLED_BACK;
     }
@@ -848,13 +1190,18 @@ public:
     virtual CtrSharedPtr<CtrReferenceable<ApiProfileT>> create(const hermes::Datatype& decl, const CtrID& ctr_id)
     {
         checkIfConainersCreationAllowed();
+        check_session_ctr(ctr_id);
         return this->create_ctr_instance(decl, ctr_id);
     }
 
     virtual CtrSharedPtr<CtrReferenceable<ApiProfileT>> create(const hermes::Datatype& decl)
     {
         checkIfConainersCreationAllowed();
-        auto ctr_id = createCtrName();
+        if (!session_parent_) {
+            check_no_write_sessions();
+        }
+
+        auto ctr_id = session_parent_ ? session_ctr_id_ : createCtrName();
         return this->create_ctr_instance(decl, ctr_id);
     }
 
@@ -888,6 +1235,8 @@ public:
 
     CtrID clone_ctr(const CtrID& ctr_name, const CtrID& new_ctr_name)
     {
+        check_session_ctr(ctr_name);
+
         auto root_id = getRootID(ctr_name);
         auto block = getBlock(root_id);
 
@@ -911,13 +1260,60 @@ public:
         snapshot_descriptor_->set_transient(transient);
     }
 
+    virtual void compact(const CtrID& ctr_id)
+    {
+        check_updates_allowed();
+
+        auto ctr = this->find(ctr_id);
+        if (ctr) {
+            ctr->compact();
+        }
+        else {
+            MEMORIA_MAKE_GENERIC_ERROR("Container with name {} does not exist in snapshot {} ", ctr_id, snapshot_id()).do_throw();
+        }
+    }
+
+    virtual void compact()
+    {
+        for (const CtrID& ctr_id: container_names()) {
+            compact(ctr_id);
+        }
+    }
+
 
 
 
     virtual CtrSharedPtr<CtrReferenceable<ApiProfileT>> find(const CtrID& ctr_id) {
+        check_session_ctr(ctr_id);
         return Base::find(ctr_id);
     }
 
+    virtual BlockID getRootID(const CtrID& ctr_id)
+    {
+        if (MMA_UNLIKELY(session_parent_ != nullptr))
+        {
+            check_session_ctr(ctr_id);
+            return with_parent([&](MyType& parent){
+                return parent.getRootID(ctr_id);
+            });
+        }
+
+        return Base::getRootID(ctr_id);
+    }
+
+    virtual bool hasRoot(const CtrID& ctr_id)
+    {
+        if (MMA_UNLIKELY(session_parent_ != nullptr))
+        {
+            check_session_ctr(ctr_id);
+            return with_parent([&](MyType& parent){
+                return parent.hasRoot(ctr_id);
+            });
+        }
+
+        return Base::hasRoot(ctr_id);
+    }
+
     virtual bool is_committed() const  {
         return state_ == State::COMMITTED;
     }
@@ -961,6 +1357,10 @@ public:
 
     virtual void setRoot(const CtrID& ctr_id, const BlockID& root)
     {
+        if (MMA_UNLIKELY(session_parent_ != nullptr)) {
+            return set_session_root(ctr_id, root);
+        }
+
         auto sb = get_superblock();
         if (MMA_UNLIKELY(ctr_id == DirectoryCtrID))
         {
@@ -1053,6 +1453,33 @@ public:
         }
     }
 
+    // Only the directory entry is updated in the parent. References
+    // to the container's blocks are counted in the session.
+    void set_session_root(const CtrID& ctr_id, const BlockID& root)
+    {
+        check_session_ctr(ctr_id);
+
+        if (root.is_set()) {
+            ref_block(root);
+        }
+
+        auto prev_id = with_parent([&](MyType& parent) -> Optional<BlockID> {
+            auto prev = root.is_set() ?
+                parent.directory_ctr_->replace_and_return(ctr_id, root) :
+                parent.directory_ctr_->remove_and_return(ctr_id);
+
+            if (prev) {
+                return BlockID(prev.value());
+            }
+
+            return Optional<BlockID>{};
+        });
+
+        if (prev_id) {
+            unref_ctr_root(prev_id.value());
+        }
+    }
+
     void checkIfConainersCreationAllowed() {
     }
 
@@ -1085,8 +1512,38 @@ public:
 
 
 
+    // Sessions keep their counters as deltas to parent's ones. All
+    // sessions change them under the parent's mutex, so the current
+    // value of a block's counter is the parent's value plus deltas
+    // of all open sessions.
+    static int64_t session_counter_value(MyType& parent, const BlockID& block_id)
+    {
+        int64_t value{};
+
+        auto ii = parent.counters_.find(block_id);
+        if (ii != parent.counters_.end()) {
+            value = ii->second.value;
+        }
+
+        for (const auto& session: parent.write_sessions_)
+        {
+            auto jj = session->counters_.find(block_id);
+            if (jj != session->counters_.end()) {
+                value += jj->second.value;
+            }
+        }
+
+        return value;
+    }
+
     virtual void ref_block(const BlockID& block_id)
     {
+        if (MMA_UNLIKELY(session_parent_ != nullptr)) {
+            return with_parent([&](MyType&){
+                counters_[block_id].inc();
+            });
+        }
+
         auto ii = counters_ptr_->find(block_id);
         if (ii != counters_ptr_->end()) {
             ii->second.inc();
@@ -1122,14 +1579,24 @@ public:
 
         bool zero = false;
 
-        auto ii = counters_ptr_->find(block_id);
-        if (ii != counters_ptr_->end()) {
-            zero = ii->second.dec(cnt);
+        if (MMA_UNLIKELY(session_parent_ != nullptr))
+        {
+            zero = with_parent([&](MyType& parent){
+                RWCounter cntr{session_counter_value(parent, block_id)};
+                counters_[block_id].value--;
+                return cntr.dec(cnt);
+            });
         }
         else {
-            RWCounter cntr{0};
-            zero = cntr.dec(cnt);
-            counters_ptr_->insert(std::make_pair(block_id, cntr));
+            auto ii = counters_ptr_->find(block_id);
+            if (ii != counters_ptr_->end()) {
+                zero = ii->second.dec(cnt);
+            }
+            else {
+                RWCounter cntr{0};
+                zero = cntr.dec(cnt);
+                counters_ptr_->insert(std::make_pair(block_id, cntr));
+            }
         }
 
         if (zero) {
@@ -1169,64 +1636,92 @@ public:
         if (MMA_UNLIKELY((bool)removing_blocks_consumer_fn_)) {
             removing_blocks_consumer_fn_(id, block_alc);
         }
-        else
-        {
-            int32_t level = block_alc.level();
-            int64_t ll_allocator_block_pos = block_alc.position() >> block_alc.level();
+        else if (MMA_UNLIKELY(session_parent_ != nullptr)) {
+            with_parent([&](MyType& parent){
+                parent.release_block(block_alc);
+            });
+        }
+        else {
+            release_block(block_alc);
+        }
+    }
+
+    void release_block(const AllocationMetadataT& block_alc)
+    {
+        store_->replicate_deallocation(block_alc);
+
+        int32_t level = block_alc.level();
+        int64_t ll_allocator_block_pos = block_alc.position() >> block_alc.level();
 
-            if (head_allocation_map_ctr_)
+        if (head_allocation_map_ctr_)
+        {
+            // Checking first in the head snapshot
+            auto head_blk_status = head_allocation_map_ctr_->get_allocation_status(level, ll_allocator_block_pos);
+            if ((!head_blk_status) || head_blk_status.value() == AllocationMapEntryStatus::FREE)
             {
-                // Checking first in the head snapshot
-                auto head_blk_status = head_allocation_map_ctr_->get_allocation_status(level, ll_allocator_block_pos);
-                if ((!head_blk_status) || head_blk_status.value() == AllocationMapEntryStatus::FREE)
-                {
-                    // If the block is FREE in the HEAD snapshot, it is also FREE
-                    // in the CONSISTENCY POINT snapshot. So we are just marking it FREE
-                    // in this snapshot. It's immediately reusable.
-
-                    // Returning the block to the pool of available blocks
-                    if (!allocation_pool_->add(block_alc)) {
-                        // FIXME: Add it into an 'extra' local pool instead of postponing
-                        add_postponed_deallocation(block_alc);
-                    }
+                // If the block is FREE in the HEAD snapshot, it is also FREE
+                // in the CONSISTENCY POINT snapshot. So we are just marking it FREE
+                // in this snapshot. It's immediately reusable.
+
+                // Returning the block to the pool of available blocks
+                if (!allocation_pool_->add(block_alc)) {
+                    // FIXME: Add it into an 'extra' local pool instead of postponing
+                    add_postponed_deallocation(block_alc);
                 }
-                else if (consistency_point_allocation_map_ctr_)
+            }
+            else if (consistency_point_allocation_map_ctr_)
+            {
+                auto cp_blk_status = consistency_point_allocation_map_ctr_->get_allocation_status(level, ll_allocator_block_pos);
+                if ((!cp_blk_status) || cp_blk_status.value() == AllocationMapEntryStatus::FREE)
                 {
-                    auto cp_blk_status = consistency_point_allocation_map_ctr_->get_allocation_status(level, ll_allocator_block_pos);
-                    if ((!cp_blk_status) || cp_blk_status.value() == AllocationMapEntryStatus::FREE)
-                    {
-                        // The block is allocated in the HEAD snapshot, but free in the
-                        // CONSISTENCY POINT snapshot.
-                        add_postponed_deallocation(block_alc);
-                    }
-                    else {
-                        // The block is allocated in the HEAD snapshot, AND it's allocated in the
-                        // CONSISTENCY POINT snapshot.
-                        // This block will be freed at the consistency point snapshot.
-                        add_cp_postponed_deallocation(block_alc);
-                    }
+                    // The block is allocated in the HEAD snapshot, but free in the
+                    // CONSISTENCY POINT snapshot.
+                    add_postponed_deallocation(block_alc);
                 }
                 else {
-                    // The block is allocated in the head snapshot AND there is no
-                    // consistency point yet. Can't free the block now.
-                    // Postoponing it until the snapshot. The block will be reuable
-                    // in the next snapshot
-                    add_postponed_deallocation(block_alc);
+                    // The block is allocated in the HEAD snapshot, AND it's allocated in the
+                    // CONSISTENCY POINT snapshot.
+                    // This block will be freed at the consistency point snapshot.
+                    add_cp_postponed_deallocation(block_alc);
                 }
             }
             else {
-                // Returning the block to the pool of available blocks
-                if (!allocation_pool_->add(block_alc)) {
-                    // FIXME: Add it into an 'extra' local pool instead of postponing
-                    add_postponed_deallocation(block_alc);
-                }
+                // The block is allocated in the head snapshot AND there is no
+                // consistency point yet. Can't free the block now.
+                // Postoponing it until the snapshot. The block will be reuable
+                // in the next snapshot
+                add_postponed_deallocation(block_alc);
+            }
+        }
+        else {
+            // Returning the block to the pool of available blocks
+            if (!allocation_pool_->add(block_alc)) {
+                // FIXME: Add it into an 'extra' local pool instead of postponing
+                add_postponed_deallocation(block_alc);
             }
         }
     }
 
 
 
-    virtual SharedBlockPtr cloneBlock(const SharedBlockConstPtr& block, const CtrID& ctr_id)
+    // Sessions hand their allocations to the store when merged.
+    void replicate_allocation(const AllocationMetadataT& alc)
+    {
+        if (MMA_UNLIKELY(session_parent_ != nullptr)) {
+            if (store_->is_replicating()) {
+                session_allocations_.push_back(alc);
+            }
+        }
+        else {
+            store_->replicate_allocation(alc);
+        }
+    }
+
+    virtual SharedBlockPtr cloneBlock(const SharedBlockConstPtr& block, const CtrID& ctr_id) {
+        return cloneBlock(block, ctr_id, BlockAllocationHint::NONE);
+    }
+
+    virtual SharedBlockPtr cloneBlock(const SharedBlockConstPtr& block, const CtrID& ctr_id, BlockAllocationHint hint)
     {
         check_updates_allowed();
 
@@ -1234,19 +1729,28 @@ public:
         int32_t scale_factor = block_size / BASIC_BLOCK_SIZE;
         int32_t level = CustomLog2(scale_factor);
 
-        AllocationMetadataT allocation = allocate_one_or_throw(level);
+        AllocationMetadataT allocation = allocate_one_or_throw(level, locality_key_for(ctr_id, hint));
         uint64_t position = allocation.position();
 
+        replicate_allocation(allocation);
+
         auto shared = allocate_block_from(block.block(), position, ctr_id == BlockMapCtrID);        
         BlockType* new_block = shared->get();
 
         new_block->snapshot_id() = snapshot_id();
         new_block->set_references(0);
 
+        this->io_stat_.on_clone(new_block, ctr_id);
+        store_->add_unflushed_bytes(block_size);
+
         return SharedBlockPtr{shared};
     }
 
-    virtual SharedBlockPtr createBlock(int32_t initial_size, const CtrID& ctr_id)
+    virtual SharedBlockPtr createBlock(int32_t initial_size, const CtrID& ctr_id) {
+        return createBlock(initial_size, ctr_id, BlockAllocationHint::NONE);
+    }
+
+    virtual SharedBlockPtr createBlock(int32_t initial_size, const CtrID& ctr_id, BlockAllocationHint hint)
     {
         check_updates_allowed();
 
@@ -1258,18 +1762,26 @@ public:
         int32_t scale_factor = initial_size / BASIC_BLOCK_SIZE;
         int32_t level = CustomLog2(scale_factor);
 
-        AllocationMetadataT allocation = allocate_one_or_throw(level);
+        AllocationMetadataT allocation = allocate_one_or_throw(level, locality_key_for(ctr_id, hint));
         uint64_t position = allocation.position();
 
+        replicate_allocation(allocation);
+
         auto shared = allocate_block(position, initial_size, ctr_id == BlockMapCtrID);
 
-        if (consistency_point_snapshot_descriptor_) {
+        if (MMA_UNLIKELY(session_parent_ != nullptr)) {
+            session_allocated_ += scale_factor;
+        }
+        else if (consistency_point_snapshot_descriptor_) {
             consistency_point_snapshot_descriptor_->add_allocated(scale_factor);
         }
 
         BlockType* block = shared->get();
         block->snapshot_id() = snapshot_id();
 
+        this->io_stat_.on_create(block, ctr_id);
+        store_->add_unflushed_bytes(initial_size);
+
         return shared;
     }
 
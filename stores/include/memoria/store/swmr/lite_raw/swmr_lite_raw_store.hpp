@@ -23,6 +23,7 @@
 
 #include <memoria/core/tools/span.hpp>
 #include <memoria/core/memory/ptr_cast.hpp>
+#include <memoria/core/memory/huge_pages.hpp>
 
 #include <boost/filesystem/path.hpp>
 
@@ -81,8 +82,14 @@ public:
     using Base::init_store;
     using Base::do_open_store;
 
-    SWMRLiteRawStore(Span<uint8_t> buffer)  {
+    // The buffer is owned by the caller. Huge pages are only advised,
+    // allocate it with HugePageBuffer to get it aligned.
+    SWMRLiteRawStore(Span<uint8_t> buffer, const SWMRParams& params = SWMRParams())  {
         buffer_ = buffer;
+
+        if (params.is_huge_pages()) {
+            advise_huge_pages(buffer_.data(), buffer_.size());
+        }
     }
 
     ~SWMRLiteRawStore() noexcept {
@@ -17,6 +17,7 @@
 #pragma once
 
 #include <memoria/store/swmr/common/mapped_swmr_store_base.hpp>
+#include <memoria/store/swmr/mapped/swmr_mapped_store_common.hpp>
 
 #include <memoria/store/swmr/mapped/swmr_mapped_store_readonly_snapshot_cow.hpp>
 #include <memoria/store/swmr/mapped/swmr_mapped_store_readonly_snapshot_cowlite.hpp>
@@ -29,8 +30,6 @@
 #include <boost/filesystem/path.hpp>
 #include <boost/filesystem/operations.hpp>
 
-#include <boost/interprocess/file_mapping.hpp>
-#include <boost/interprocess/mapped_region.hpp>
 #include <boost/interprocess/sync/file_lock.hpp>
 
 #include <mutex>
@@ -70,8 +69,10 @@ protected:
     using Base::prepare_to_close;
     using Base::buffer_;
     using Base::writer_mutex_;
+    using Base::history_mutex_;
     using Base::history_tree_;
     using Base::read_only_;
+    using Base::follower_;
 
     using Base::HEADER_SIZE;
     using Base::BASIC_BLOCK_SIZE;
@@ -83,10 +84,12 @@ protected:
     using LockGuard     = std::lock_guard<std::recursive_mutex>;
     using Superblock    = SWMRSuperblock<Profile>;
 
+    // Address space reserved for the file's growth by default
+    static constexpr uint64_t DEFAULT_MAX_FILE_SIZE = 1ull << 40;
+
     U8String file_name_;
     uint64_t file_size_;
-    std::unique_ptr<boost::interprocess::file_mapping> file_;
-    boost::interprocess::mapped_region region_;
+    MappedStoreFile file_;
 
     std::unique_ptr<detail::FileLockHandler> lock_;
 
@@ -105,9 +108,8 @@ public:
 
             make_file(file_name, file_size_);
 
-            file_   = std::make_unique<boost::interprocess::file_mapping>(file_name_.data(), boost::interprocess::read_write);
-            region_ = boost::interprocess::mapped_region(*file_.get(), boost::interprocess::read_write, 0, file_size_);
-            buffer_ = Span<uint8_t>(ptr_cast<uint8_t>(region_.get_address()), file_size_);
+            file_.open(file_name_.data(), file_size_, true, max_file_size(params), params.is_huge_pages());
+            buffer_ = file_.buffer();
 
             return VoidResult::of();
         });
@@ -119,16 +121,18 @@ public:
         wrap_construction(maybe_error, [&]() -> VoidResult {
             acquire_lock(file_name.data(), false);
 
-            auto mapping_params = params.is_read_only() ? boost::interprocess::read_only : boost::interprocess::read_write;
+            // Followers are read-only for clients, but
+            // replication writes into the file.
+            bool read_only_mapping = params.is_read_only() && !params.is_follower();
 
-            read_only_ = params.is_read_only();
+            read_only_ = params.is_read_only() || params.is_follower();
+            follower_  = params.is_follower();
 
-            file_       = std::make_unique<boost::interprocess::file_mapping>(file_name_.data(), mapping_params);
             file_size_  = boost::filesystem::file_size(file_name_.to_std_string());
             check_file_size();
 
-            region_ = boost::interprocess::mapped_region(*file_.get(), boost::interprocess::read_write);
-            buffer_ = Span<uint8_t>(ptr_cast<uint8_t>(region_.get_address()), file_size_);
+            file_.open(file_name_.data(), file_size_, !read_only_mapping, max_file_size(params), params.is_huge_pages());
+            buffer_ = file_.buffer();
 
             return VoidResult::of();
         });
@@ -149,13 +153,31 @@ public:
     {
         LockGuard lock(writer_mutex_);
 
-        if (file_) {
+        if (file_.is_open()) {
             prepare_to_close();
 
             lock_->unlock();
-            region_.flush();
-            file_.reset();
+            file_.flush(0, buffer_.size(), false);
+            file_.close();
+        }
+    }
+
+    // The file is extended in place, snapshots opened before
+    // the call keep working with their part of the mapping.
+    virtual uint64_t grow_buffer(uint64_t min_size) override
+    {
+        LockGuard lock(writer_mutex_);
+        check_if_open();
+
+        uint64_t new_size = div_up(min_size, (uint64_t)ALLOCATION_MAP_SIZE_STEP) * ALLOCATION_MAP_SIZE_STEP;
+        if (new_size > file_size_ && file_.grow(new_size))
+        {
+            LockGuard rlock(history_mutex_);
+            file_size_ = new_size;
+            buffer_ = file_.buffer();
         }
+
+        return file_size_;
     }
 
     static void init_profile_metadata()  {
@@ -165,7 +187,7 @@ public:
     void flush_data(bool async = false) override
     {
         check_if_open();
-        if (!region_.flush(HEADER_SIZE, buffer_.size() - HEADER_SIZE, async)) {
+        if (!file_.flush(HEADER_SIZE, buffer_.size() - HEADER_SIZE, async)) {
             make_generic_error("DataFlush operation failed").do_throw();
         }
     }
@@ -173,7 +195,7 @@ public:
     void flush_header(bool async = false) override
     {
         check_if_open();
-        if (!region_.flush(0, HEADER_SIZE, async)) {
+        if (!file_.flush(0, HEADER_SIZE, async)) {
             make_generic_error("HeaderFlush operation failed").do_throw();
         }
     }
@@ -226,7 +248,7 @@ private:
     }
 
     void check_if_open() override {
-        if (!file_) {
+        if (!file_.is_open()) {
             make_generic_error("File {} has been already closed", file_name_).do_throw();
         }
     }
@@ -241,8 +263,29 @@ private:
         return (file_size_mb / allocation_size_mb) * allocation_size_mb * MB;
     }
 
+    static uint64_t max_file_size(const SWMRParams& params)
+    {
+        if (params.max_file_size()) {
+            return params.max_file_size().value() * MB;
+        }
+
+        return DEFAULT_MAX_FILE_SIZE;
+    }
+
     static void make_file(const U8String& name, uint64_t file_size)
     {
+#ifdef MMA_POSIX
+        // Files on hugetlbfs can't be written to, only resized
+        int fd = ::open(name.data(), O_RDWR);
+        if (fd < 0 || ::ftruncate(fd, file_size)) {
+            int err = errno;
+            if (fd >= 0) {
+                ::close(fd);
+            }
+            MEMORIA_MAKE_GENERIC_ERROR("Can't set size of file {}: {}", name, std::strerror(err)).do_throw();
+        }
+        ::close(fd);
+#else
         std::filebuf fbuf;
 
         fbuf.open(name.to_std_string(), std::ios_base::in | std::ios_base::out | std::ios_base::binary);
@@ -251,6 +294,7 @@ private:
         fbuf.pubseekoff(file_size - 1, std::ios_base::beg);
         fbuf.sputc(0);
         fbuf.close();
+#endif
     }
 
     void acquire_lock(const char* file_name, bool create_file) {
@@ -17,8 +17,239 @@
 #pragma once
 
 #include <memoria/store/swmr/common/swmr_store_snapshot_base.hpp>
+#include <memoria/core/tools/span.hpp>
+#include <memoria/core/memory/huge_pages.hpp>
+
+#ifdef MMA_POSIX
+#include <sys/mman.h>
+#include <unistd.h>
+#include <fcntl.h>
+#else
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <memory>
 
 namespace memoria {
 
+// Asks the kernel to start paging in the given range of the mapped file.
+// The range is widened to page boundaries. This is a hint only, errors
+// are ignored.
+inline void mapped_store_advise_willneed(Span<uint8_t> buffer, uint64_t file_pos, uint64_t size) noexcept
+{
+#ifdef MMA_POSIX
+    if (MMA_UNLIKELY(file_pos >= buffer.size())) {
+        return;
+    }
+
+    static const uint64_t page_size = static_cast<uint64_t>(::sysconf(_SC_PAGESIZE));
+
+    uint64_t end   = std::min<uint64_t>(file_pos + size, buffer.size());
+    uint64_t start = file_pos & ~(page_size - 1);
+
+    ::madvise(buffer.data() + start, end - start, MADV_WILLNEED);
+#endif
+}
+
+
+// Shared mapping of a store's file that can be extended in place.
+// On POSIX systems an address range of the maximal file size is reserved
+// at open time and the file is mapped at its beginning. Growing the file
+// maps the new tail right after the existing mapping, so pointers into
+// the file stay valid and readers are not stopped. Elsewhere the file is
+// mapped as a whole and can't grow.
+//
+// With huge pages the mapping is aligned to HUGE_PAGE_SIZE and advised
+// for transparent huge pages. Files on hugetlbfs are always mapped
+// aligned to the file system's page size.
+class MappedStoreFile {
+#ifdef MMA_POSIX
+    int fd_{-1};
+    uint8_t* base_{};
+    uint64_t reserved_{};
+    uint64_t alignment_{};
+    int prot_{};
+    bool advise_huge_pages_{};
+#else
+    std::unique_ptr<boost::interprocess::file_mapping> file_;
+    boost::interprocess::mapped_region region_;
+#endif
+    uint64_t size_{};
+
+public:
+    MappedStoreFile() = default;
+
+    MappedStoreFile(const MappedStoreFile&) = delete;
+    MappedStoreFile& operator=(const MappedStoreFile&) = delete;
+
+    ~MappedStoreFile() noexcept {
+        close();
+    }
+
+    bool is_open() const noexcept {
+        return size_ > 0;
+    }
+
+    Span<uint8_t> buffer() const noexcept
+    {
+#ifdef MMA_POSIX
+        return Span<uint8_t>(base_, size_);
+#else
+        return Span<uint8_t>(static_cast<uint8_t*>(region_.get_address()), size_);
+#endif
+    }
+
+    void open(const char* file_name, uint64_t size, bool writable, uint64_t max_size, bool huge_pages = false)
+    {
+#ifdef MMA_POSIX
+        fd_ = ::open(file_name, writable ? O_RDWR : O_RDONLY);
+        if (fd_ < 0) {
+            MEMORIA_MAKE_GENERIC_ERROR("Can't open file {}: {}", file_name, std::strerror(errno)).do_throw();
+        }
+
+        uint64_t hugetlb_page_size = hugetlbfs_page_size(fd_);
+        advise_huge_pages_ = huge_pages && !hugetlb_page_size;
+
+        alignment_ = page_size();
+        if (hugetlb_page_size) {
+            alignment_ = hugetlb_page_size;
+        }
+        else if (huge_pages) {
+            alignment_ = HUGE_PAGE_SIZE;
+        }
+
+        reserved_ = align_up(std::max(size, max_size));
+        prot_ = writable ? PROT_READ | PROT_WRITE : PROT_READ;
+
+        reserve(file_name);
+
+        map_range(0, size);
+        size_ = size;
+#else
+        auto mode = writable ? boost::interprocess::read_write : boost::interprocess::read_only;
+        file_   = std::make_unique<boost::interprocess::file_mapping>(file_name, mode);
+        region_ = boost::interprocess::mapped_region(*file_.get(), mode, 0, size);
+        size_   = size;
+#endif
+    }
+
+    // Extends the file to the new size and maps the added range.
+    // Returns false if the file can't grow beyond its current size.
+    bool grow(uint64_t new_size)
+    {
+#ifdef MMA_POSIX
+        if (new_size <= size_) {
+            return true;
+        }
+
+        if (new_size > reserved_) {
+            return false;
+        }
+
+        int res = ::posix_fallocate(fd_, size_, new_size - size_);
+        if (res) {
+            MEMORIA_MAKE_GENERIC_ERROR(
+                "Can't extend store's file from {} to {} bytes: {}", size_, new_size, std::strerror(res)
+            ).do_throw();
+        }
+
+        map_range(size_, new_size);
+        size_ = new_size;
+
+        return true;
+#else
+        return new_size <= size_;
+#endif
+    }
+
+    bool flush(uint64_t file_pos, uint64_t size, bool async)
+    {
+#ifdef MMA_POSIX
+        uint64_t start = file_pos & ~(page_size() - 1);
+        return ::msync(base_ + start, file_pos + size - start, async ? MS_ASYNC : MS_SYNC) == 0;
+#else
+        return region_.flush(file_pos, size, async);
+#endif
+    }
+
+    void close() noexcept
+    {
+#ifdef MMA_POSIX
+        if (base_) {
+            ::munmap(base_, reserved_);
+            base_ = nullptr;
+        }
+
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+#else
+        region_ = boost::interprocess::mapped_region();
+        file_.reset();
+#endif
+        size_ = 0;
+    }
+
+private:
+#ifdef MMA_POSIX
+    static uint64_t page_size() noexcept {
+        static const uint64_t size = static_cast<uint64_t>(::sysconf(_SC_PAGESIZE));
+        return size;
+    }
+
+    uint64_t align_up(uint64_t value) const noexcept {
+        return (value + alignment_ - 1) & ~(alignment_ - 1);
+    }
+
+    // Reserves the address range, aligned to alignment_.
+    void reserve(const char* file_name)
+    {
+        uint64_t extra = alignment_ > page_size() ? alignment_ : 0;
+
+        void* base = ::mmap(nullptr, reserved_ + extra, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (base == MAP_FAILED) {
+            int err = errno;
+            close();
+            MEMORIA_MAKE_GENERIC_ERROR(
+                "Can't reserve {} bytes of address space for file {}: {}", reserved_, file_name, std::strerror(err)
+            ).do_throw();
+        }
+
+        uintptr_t addr    = reinterpret_cast<uintptr_t>(base);
+        uintptr_t aligned = align_up(addr);
+
+        if (aligned > addr) {
+            ::munmap(base, aligned - addr);
+        }
+
+        if (extra > aligned - addr) {
+            ::munmap(reinterpret_cast<void*>(aligned + reserved_), extra - (aligned - addr));
+        }
+
+        base_ = reinterpret_cast<uint8_t*>(aligned);
+    }
+
+    // Replaces the reserved pages of the range with the file's pages.
+    void map_range(uint64_t from, uint64_t to)
+    {
+        uint64_t start = from & ~(alignment_ - 1);
+        void* addr = ::mmap(base_ + start, to - start, prot_, MAP_SHARED | MAP_FIXED, fd_, start);
+        if (addr == MAP_FAILED) {
+            MEMORIA_MAKE_GENERIC_ERROR(
+                "Can't map store's file range {}:{}: {}", start, to, std::strerror(errno)
+            ).do_throw();
+        }
+
+        if (advise_huge_pages_) {
+            advise_huge_pages(base_ + start, to - start);
+        }
+    }
+#endif
+};
 
 }
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <memoria/store/swmr/mapped/swmr_mapped_store_common.hpp>
 #include <memoria/store/swmr/common/swmr_store_readonly_snapshot_base.hpp>
 #include <memoria/core/tools/simple_2q_cache.hpp>
 #include <memoria/core/tools/uid_64.hpp>
@@ -165,7 +166,7 @@ public:
         if (existing_entry)
         {
             BlockCacheEntry* shared = *existing_entry;
-            return {shared->file_pos() * BASIC_BLOCK_SIZE, SharedBlockConstPtr{shared}};
+            return {shared->file_pos() * BASIC_BLOCK_SIZE, SharedBlockConstPtr{shared}, BlockCacheAccess::HIT};
         }
         else {
             uint64_t at;
@@ -190,7 +191,7 @@ public:
 
             block_cache_.insert(shared);
 
-            return {at * BASIC_BLOCK_SIZE, SharedBlockConstPtr{shared}};
+            return {at * BASIC_BLOCK_SIZE, SharedBlockConstPtr{shared}, BlockCacheAccess::MISS};
         }
     }
 
@@ -230,6 +231,22 @@ public:
         }
     }
 
+    virtual void prefetch_file_region(uint64_t file_pos, uint64_t size) {
+        mapped_store_advise_willneed(buffer_, file_pos, size);
+    }
+
+    // Resolving the block doesn't touch its data, and the BlockMap
+    // lookup is done once: the entry stays in the cache for the read
+    // that follows. The block's size is not known before it's read,
+    // so only its first page is requested.
+    virtual void prefetch_block(const BlockID& block_id)
+    {
+        auto resolved = resolve_block(block_id);
+        if (resolved.cache == BlockCacheAccess::MISS) {
+            prefetch_file_region(resolved.file_pos, BASIC_BLOCK_SIZE);
+        }
+    }
+
     virtual void updateBlock(Shared* block) {
     }
 
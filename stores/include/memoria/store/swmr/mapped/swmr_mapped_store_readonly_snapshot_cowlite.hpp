@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <memoria/store/swmr/mapped/swmr_mapped_store_common.hpp>
 #include <memoria/store/swmr/common/swmr_store_readonly_snapshot_base.hpp>
 
 #include <memoria/profiles/impl/cow_lite_profile.hpp>
@@ -140,6 +141,10 @@ public:
     }
 
 
+    virtual void prefetch_file_region(uint64_t file_pos, uint64_t size) {
+        mapped_store_advise_willneed(buffer_, file_pos, size);
+    }
+
     virtual void updateBlock(Shared* block) {
     }
 
@@ -28,6 +28,7 @@
 #include <boost/pool/object_pool.hpp>
 
 #include <type_traits>
+#include <unordered_map>
 
 
 
@@ -108,6 +109,11 @@ class MappedSWMRStoreWritableSnapshot<CowProfileT<ChildProfile>>:
     mutable SharedBlockCache block_cache_;
     mutable boost::object_pool<detail::MMapSBPtrPooledSharedImpl> sb_shared_pool_;
 
+    // BlockMap lookups done by read-ahead, taken by resolve_block()
+    // so that prefetched blocks are looked up once.
+    std::unordered_map<BlockID, uint64_t> prefetched_positions_;
+    static constexpr size_t MAX_PREFETCHED_POSITIONS = 1024;
+
 public:
     using Base::check;
     using Base::init_snapshot;
@@ -180,6 +186,47 @@ public:
         return buffer_.size();
     }
 
+    void memory_grown() override {
+        buffer_ = store_->file_buffer();
+    }
+
+    // Sessions share the BlockMap with the parent, accessing it
+    // under the parent's mutex. Block cache is session's own.
+    SnpSharedPtr<Base> make_write_session() override
+    {
+        MaybeError maybe_error{};
+        auto ptr = snp_make_shared<MappedSWMRStoreWritableSnapshot>(
+            maybe_error, store_, buffer_, snapshot_descriptor_
+        );
+
+        if (maybe_error) {
+            std::move(maybe_error.value()).do_throw();
+        }
+
+        ptr->blockmap_ctr_ = blockmap_ctr_;
+        return ptr;
+    }
+
+    UID64 find_in_blockmap(const BlockID& block_id)
+    {
+        return this->with_parent_lock([&]() -> UID64 {
+            auto ii = blockmap_ctr_->find(block_id.value());
+            if (ii->is_found(block_id.value())) {
+                return ii->current_value().value_t();
+            }
+            else {
+                MEMORIA_MAKE_GENERIC_ERROR("Can't find block ID {} in the BlockMap", block_id).do_throw();
+            }
+        });
+    }
+
+    void upsert_into_blockmap(const BlockID& block_id, const UID64& value)
+    {
+        this->with_parent_lock([&]{
+            blockmap_ctr_->upsert_key(block_id.value(), value);
+        });
+    }
+
 
     virtual SharedSBPtr<Superblock> new_superblock(uint64_t pos) override {
         Superblock* sb = new (buffer_.data() + pos) Superblock();
@@ -195,7 +242,7 @@ public:
         if (existing_entry)
         {
             BlockCacheEntry* shared = *existing_entry;
-            return {shared->file_pos() * BASIC_BLOCK_SIZE, SharedBlockConstPtr{shared}};
+            return {shared->file_pos() * BASIC_BLOCK_SIZE, SharedBlockConstPtr{shared}, BlockCacheAccess::HIT};
         }
         else {
             uint64_t at;
@@ -204,14 +251,8 @@ public:
             {
                 at = block_id.value().counter();
             }
-            else {
-                auto ii = blockmap_ctr_->find(block_id.value());
-                if (ii->is_found(block_id.value())) {
-                    at = ii->current_value().value_t().value();
-                }
-                else {
-                    MEMORIA_MAKE_GENERIC_ERROR("Can't find block ID {} in the BlockMap", block_id).do_throw();
-                }
+            else if (!take_prefetched_position(block_id, at)) {
+                at = find_in_blockmap(block_id).value();
             }
 
             BlockType* block = ptr_cast<BlockType>(buffer_.data() + at * BASIC_BLOCK_SIZE);
@@ -222,7 +263,7 @@ public:
 
             block_cache_.insert(shared);
 
-            return {at * BASIC_BLOCK_SIZE, SharedBlockConstPtr{shared}};
+            return {at * BASIC_BLOCK_SIZE, SharedBlockConstPtr{shared}, BlockCacheAccess::MISS};
         }
     }
 
@@ -248,15 +289,9 @@ public:
                 level = block_id.value().metadata();
             }
             else {
-                auto ii = blockmap_ctr_->find(block_id.value());
-                if (ii->is_found(block_id.value()))
-                {
-                    at = ii->current_value().value_t().value();
-                    level = ii->current_value().value_t().metadata();
-                }
-                else {
-                    MEMORIA_MAKE_GENERIC_ERROR("Can't find block ID {} in the BlockMap", block_id).do_throw();
-                }
+                UID64 value = find_in_blockmap(block_id);
+                at = value.value();
+                level = value.metadata();
             }
 
             return AllocationMetadataT::from_ln(at, 1, level);
@@ -275,7 +310,7 @@ public:
 
         if (!for_idmap) {
             id = newId();
-            blockmap_ctr_->upsert_key(id.value(), UID64{at, static_cast<uint64_t>(allocation_level(size))});
+            upsert_into_blockmap(id, UID64{at, static_cast<uint64_t>(allocation_level(size))});
         }
         else {
             id = BlockID{UID256::make_type3(UID256{}, static_cast<uint64_t>(allocation_level(size)), at)};
@@ -307,7 +342,7 @@ public:
 
         if (!for_idmap) {
             id = newId();
-            blockmap_ctr_->upsert_key(id.value(), UID64{at, static_cast<uint64_t>(allocation_level(block_size))});
+            upsert_into_blockmap(id, UID64{at, static_cast<uint64_t>(allocation_level(block_size))});
         }
         else {
             id = BlockID{UID256::make_type3(UID256{}, static_cast<uint64_t>(allocation_level(block_size)), at)};
@@ -329,6 +364,50 @@ public:
     }
 
 
+    virtual void prefetch_file_region(uint64_t file_pos, uint64_t size) override {
+        mapped_store_advise_willneed(buffer_, file_pos, size);
+    }
+
+    // Unlike in read-only snapshots, resolving a block here reads its
+    // header, so only the BlockMap lookup is done and remembered.
+    virtual void prefetch_block(const BlockID& block_id) override
+    {
+        uint64_t at;
+        if (MMA_UNLIKELY(block_id.value().is_type3())) {
+            at = block_id.value().counter();
+        }
+        else if (block_cache_.contains(block_id) || prefetched_positions_.count(block_id)) {
+            return;
+        }
+        else {
+            if (prefetched_positions_.size() >= MAX_PREFETCHED_POSITIONS) {
+                prefetched_positions_.clear();
+            }
+
+            at = find_in_blockmap(block_id).value();
+            prefetched_positions_[block_id] = at;
+        }
+
+        prefetch_file_region(at * BASIC_BLOCK_SIZE, BASIC_BLOCK_SIZE);
+    }
+
+    bool take_prefetched_position(const BlockID& block_id, uint64_t& at)
+    {
+        if (MMA_LIKELY(prefetched_positions_.empty())) {
+            return false;
+        }
+
+        auto ii = prefetched_positions_.find(block_id);
+        if (ii != prefetched_positions_.end())
+        {
+            at = ii->second;
+            prefetched_positions_.erase(ii);
+            return true;
+        }
+
+        return false;
+    }
+
     virtual void updateBlock(Shared* block) override {
     }
 
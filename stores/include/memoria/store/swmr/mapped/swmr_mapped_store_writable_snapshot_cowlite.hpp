@@ -108,6 +108,24 @@ public:
         return buffer_.size();
     }
 
+    void memory_grown() override {
+        buffer_ = store_->file_buffer();
+    }
+
+    SnpSharedPtr<Base> make_write_session() override
+    {
+        MaybeError maybe_error{};
+        auto ptr = snp_make_shared<MappedSWMRStoreWritableSnapshot>(
+            maybe_error, store_, buffer_, this->snapshot_descriptor_
+        );
+
+        if (maybe_error) {
+            std::move(maybe_error.value()).do_throw();
+        }
+
+        return ptr;
+    }
+
 
     virtual SharedSBPtr<Superblock> new_superblock(uint64_t pos) override {
         Superblock* sb = new (buffer_.data() + pos) Superblock();
@@ -192,6 +210,10 @@ public:
     }
 
 
+    virtual void prefetch_file_region(uint64_t file_pos, uint64_t size) override {
+        mapped_store_advise_willneed(buffer_, file_pos, size);
+    }
+
     virtual void updateBlock(Shared* block) override {
     }
 
@@ -44,18 +44,18 @@ void InitLiteRawSWMRStore() {
 
 
 
-SharedPtr<ISWMRStore<ApiProfileT>> open_lite_raw_swmr_store(Span<uint8_t> buffer)
+SharedPtr<ISWMRStore<ApiProfileT>> open_lite_raw_swmr_store(Span<uint8_t> buffer, const SWMRParams& params)
 {
-    auto ptr = MakeShared<SWMRLiteRawStore<Profile>>(buffer);
+    auto ptr = MakeShared<SWMRLiteRawStore<Profile>>(buffer, params);
 
     ptr->do_open_store();
 
     return ptr;
 }
 
-SharedPtr<ISWMRStore<ApiProfileT>> create_lite_raw_swmr_store(Span<uint8_t> buffer)
+SharedPtr<ISWMRStore<ApiProfileT>> create_lite_raw_swmr_store(Span<uint8_t> buffer, const SWMRParams& params)
 {
-    auto ptr = MakeShared<SWMRLiteRawStore<Profile>>(buffer);
+    auto ptr = MakeShared<SWMRLiteRawStore<Profile>>(buffer, params);
 
     ptr->init_store();
 
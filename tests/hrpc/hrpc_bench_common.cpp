@@ -0,0 +1,281 @@
+
+// Copyright 2026 Victor Smirnov
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "hrpc_bench_common.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+namespace memoria {
+
+using namespace hrpc;
+
+namespace {
+
+constexpr NamedCode ARG_VALUE = NamedCode(1, "value");
+constexpr NamedCode ARG_COUNT = NamedCode(2, "count");
+constexpr NamedCode ARG_SIZE  = NamedCode(3, "size");
+
+using Clock = std::chrono::steady_clock;
+
+int64_t elapsed_ns(Clock::time_point t0) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t0).count();
+}
+
+double per_second(size_t value, int64_t ns) {
+    return ns ? value * 1e9 / ns : 0.0;
+}
+
+Message make_payload_message(U8StringView payload)
+{
+    Message msg(hermes::HermesCtr::make_pooled());
+    msg.set_data(msg.object().ctr().make_t<Varchar>(payload).as_object());
+    return msg;
+}
+
+size_t stream_messages(const HRPCBenchConfig& cfg, size_t message_size) {
+    return std::max<size_t>(1, std::min(cfg.stream_messages_max, cfg.stream_bytes / message_size));
+}
+
+Response echo_handler(PoolSharedPtr<st::Context> context)
+{
+    int64_t value = context->request().parameters().expect(ARG_VALUE).to_i64();
+    return Response::ok(value);
+}
+
+Response sink_handler(PoolSharedPtr<st::Context> context)
+{
+    auto ch = context->input_channel(0);
+
+    int64_t cnt{};
+    Message msg;
+    while (ch->pop(msg)) {
+        cnt++;
+    }
+
+    return Response::ok(cnt);
+}
+
+Response source_handler(PoolSharedPtr<st::Context> context)
+{
+    int64_t count = context->request().parameters().expect(ARG_COUNT).to_i64();
+    int64_t size  = context->request().parameters().expect(ARG_SIZE).to_i64();
+
+    U8String payload(size, 'x');
+
+    auto ch = context->output_channel(0);
+    for (int64_t c = 0; c < count; c++) {
+        ch->push(make_payload_message(payload));
+    }
+    ch->close();
+
+    return Response::ok(count);
+}
+
+void check_response(const PoolSharedPtr<st::Call>& call)
+{
+    call->wait();
+    Response rs = call->response();
+    if (rs.status_code() != StatusCode::OK) {
+        MEMORIA_MAKE_GENERIC_ERROR("HRPC benchmark call has failed with status {}", static_cast<int>(rs.status_code())).do_throw();
+    }
+}
+
+int64_t echo_call(const PoolSharedPtr<st::Session>& session, int64_t value)
+{
+    auto rq = Request::make();
+    rq.set_parameter(ARG_VALUE, value);
+
+    auto call = session->call(BENCH_ECHO, rq);
+    check_response(call);
+
+    return call->response().result().to_i64();
+}
+
+void bench_unary_latency(U8StringView runtime, const PoolSharedPtr<st::Session>& session, const HRPCBenchConfig& cfg)
+{
+    std::vector<int64_t> latencies;
+    latencies.reserve(cfg.latency_calls);
+
+    // Warm up pools and the connection
+    for (size_t c = 0; c < std::min<size_t>(1000, cfg.latency_calls); c++) {
+        echo_call(session, c);
+    }
+
+    for (size_t c = 0; c < cfg.latency_calls; c++)
+    {
+        auto t0 = Clock::now();
+        echo_call(session, c);
+        latencies.push_back(elapsed_ns(t0));
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+
+    auto pct_us = [&](double p) {
+        size_t idx = std::min(latencies.size() - 1, static_cast<size_t>(latencies.size() * p));
+        return latencies[idx] / 1000.0;
+    };
+
+    int64_t total{};
+    for (auto ns: latencies) {
+        total += ns;
+    }
+
+    println(
+        "{{\"runtime\": \"{}\", \"workload\": \"unary_latency\", \"calls\": {}, "
+        "\"mean_us\": {:.2f}, \"p50_us\": {:.2f}, \"p99_us\": {:.2f}, \"p999_us\": {:.2f}}}",
+        runtime, latencies.size(),
+        total / 1000.0 / latencies.size(), pct_us(0.5), pct_us(0.99), pct_us(0.999)
+    );
+}
+
+void bench_unary_throughput(
+    U8StringView runtime,
+    const PoolSharedPtr<st::Session>& session,
+    const ConcurrentRunnerFn& run_concurrently,
+    const HRPCBenchConfig& cfg
+) {
+    for (size_t callers: cfg.concurrency)
+    {
+        size_t calls_per_caller = std::max<size_t>(1, cfg.throughput_calls / callers);
+
+        auto t0 = Clock::now();
+        run_concurrently(callers, [&](size_t caller) {
+            for (size_t c = 0; c < calls_per_caller; c++) {
+                echo_call(session, caller * calls_per_caller + c);
+            }
+        });
+        int64_t ns = elapsed_ns(t0);
+
+        size_t calls = calls_per_caller * callers;
+        println(
+            "{{\"runtime\": \"{}\", \"workload\": \"unary_throughput\", \"callers\": {}, "
+            "\"calls\": {}, \"time_ms\": {:.2f}, \"calls_per_sec\": {:.1f}}}",
+            runtime, callers, calls, ns / 1e6, per_second(calls, ns)
+        );
+    }
+}
+
+void print_stream_result(
+    U8StringView runtime, U8StringView workload,
+    size_t size, size_t messages, int64_t ns,
+    const st::OutputChannelStats* sender_stats = nullptr
+) {
+    // Flow control stalls are only known to the sending side
+    U8String stalls;
+    if (sender_stats) {
+        stalls = format_u8(
+            ", \"stalls\": {}, \"stall_time_ms\": {:.2f}",
+            sender_stats->stalls, sender_stats->stall_time_ns / 1e6
+        );
+    }
+
+    println(
+        "{{\"runtime\": \"{}\", \"workload\": \"{}\", \"message_size\": {}, "
+        "\"messages\": {}, \"time_ms\": {:.2f}, \"messages_per_sec\": {:.1f}, \"mb_per_sec\": {:.2f}{}}}",
+        runtime, workload, size, messages, ns / 1e6,
+        per_second(messages, ns), per_second(messages * size, ns) / (1024 * 1024),
+        stalls
+    );
+}
+
+void bench_stream_upload(U8StringView runtime, const PoolSharedPtr<st::Session>& session, const HRPCBenchConfig& cfg)
+{
+    for (size_t size: cfg.message_sizes)
+    {
+        size_t messages = stream_messages(cfg, size);
+        U8String payload(size, 'x');
+
+        auto t0 = Clock::now();
+
+        auto rq = Request::make();
+        rq.set_output_channels(1);
+
+        auto call = session->call(BENCH_SINK, rq);
+        auto ch = call->output_channel(0);
+
+        for (size_t c = 0; c < messages; c++) {
+            ch->push(make_payload_message(payload));
+        }
+
+        ch->close();
+        check_response(call);
+
+        int64_t received = call->response().result().to_i64();
+        if (received != static_cast<int64_t>(messages)) {
+            MEMORIA_MAKE_GENERIC_ERROR("Sink has received {} messages of {}", received, messages).do_throw();
+        }
+
+        auto stats = ch->stats();
+        print_stream_result(runtime, "stream_upload", size, messages, elapsed_ns(t0), &stats);
+    }
+}
+
+void bench_stream_download(U8StringView runtime, const PoolSharedPtr<st::Session>& session, const HRPCBenchConfig& cfg)
+{
+    for (size_t size: cfg.message_sizes)
+    {
+        size_t messages = stream_messages(cfg, size);
+
+        auto t0 = Clock::now();
+
+        auto rq = Request::make();
+        rq.set_input_channels(1);
+        rq.set_parameter(ARG_COUNT, static_cast<int64_t>(messages));
+        rq.set_parameter(ARG_SIZE, static_cast<int64_t>(size));
+
+        auto call = session->call(BENCH_SOURCE, rq);
+        auto ch = call->input_channel(0);
+
+        size_t received{};
+        Message msg;
+        while (ch->pop(msg)) {
+            received++;
+        }
+
+        check_response(call);
+
+        if (received != messages) {
+            MEMORIA_MAKE_GENERIC_ERROR("Source has sent {} messages of {}", received, messages).do_throw();
+        }
+
+        print_stream_result(runtime, "stream_download", size, messages, elapsed_ns(t0));
+    }
+}
+
+}
+
+
+void add_bench_handlers(const PoolSharedPtr<st::EndpointRepository>& endpoints)
+{
+    endpoints->add_handler(BENCH_ECHO, echo_handler);
+    endpoints->add_handler(BENCH_SINK, sink_handler);
+    endpoints->add_handler(BENCH_SOURCE, source_handler);
+}
+
+
+void run_hrpc_bench(
+    U8StringView runtime,
+    const PoolSharedPtr<st::Session>& session,
+    const ConcurrentRunnerFn& run_concurrently,
+    const HRPCBenchConfig& cfg
+) {
+    bench_unary_latency(runtime, session, cfg);
+    bench_unary_throughput(runtime, session, run_concurrently, cfg);
+    bench_stream_upload(runtime, session, cfg);
+    bench_stream_download(runtime, session, cfg);
+}
+
+}
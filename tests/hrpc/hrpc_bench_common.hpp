@@ -0,0 +1,59 @@
+
+// Copyright 2026 Victor Smirnov
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memoria/core/tools/uid_256.hpp>
+#include <memoria/hrpc/hrpc.hpp>
+
+#include <functional>
+#include <vector>
+
+namespace memoria {
+
+constexpr UID256 BENCH_ECHO   = UID256{293771902427694850ull, 9606938022837471981ull, 7837324776609645186ull, 121831047213526660ull};
+constexpr UID256 BENCH_SINK   = UID256{4114185786510245065ull, 14350989195731311332ull, 7484221853417291700ull, 33540736029720844ull};
+constexpr UID256 BENCH_SOURCE = UID256{11633676966634245869ull, 7556828304848081210ull, 15137103339891216758ull, 101001141668117915ull};
+
+// Runs fn(0) ... fn(n - 1) concurrently in the runtime's
+// lightweight threads and waits for all of them.
+using ConcurrentRunnerFn = std::function<void (size_t, const std::function<void (size_t)>&)>;
+
+struct HRPCBenchConfig {
+    size_t latency_calls{20000};
+    size_t throughput_calls{100000};
+    std::vector<size_t> concurrency{1, 4, 16, 64};
+
+    std::vector<size_t> message_sizes{16, 256, 4096, 65536};
+    size_t stream_bytes{64 * 1024 * 1024};
+    size_t stream_messages_max{200000};
+};
+
+void add_bench_handlers(const PoolSharedPtr<hrpc::st::EndpointRepository>& endpoints);
+
+// Runs the same workloads for every runtime over the session and prints
+// one JSON object per line for each of them:
+//
+//  * unary_latency: sequential calls, p50/p99/p999 in microseconds;
+//  * unary_throughput: calls per second from N concurrent callers;
+//  * stream_upload, stream_download: channel throughput per message size.
+void run_hrpc_bench(
+    U8StringView runtime,
+    const PoolSharedPtr<hrpc::st::Session>& session,
+    const ConcurrentRunnerFn& run_concurrently,
+    const HRPCBenchConfig& cfg = HRPCBenchConfig{}
+);
+
+}
@@ -0,0 +1,84 @@
+
+// Copyright 2026 Victor Smirnov
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memoria/hrpc/hrpc.hpp>
+
+#include <memoria/memoria_core.hpp>
+
+#include "hrpc_bench_common.hpp"
+
+#include <memoria/reactor/hrpc/hrpc.hpp>
+
+#include <memoria/reactor/reactor.hpp>
+#include <memoria/reactor/application.hpp>
+
+using namespace memoria;
+using namespace memoria::reactor;
+
+int main(int argc, char** argv, char** envp)
+{
+    InitMemoriaCoreExplicit();
+
+    return Application::run(
+        argc, argv,
+        [&]() -> int
+    {
+        ShutdownOnScopeExit hh;
+
+        in_fiber([&]{
+            auto server_endpoints = memoria::hrpc::st::EndpointRepository::make();
+            add_bench_handlers(server_endpoints);
+
+            auto server_cfg = memoria::hrpc::TCPServerSocketConfig::of_host("127.0.0.1");
+            auto server = memoria::reactor::hrpc::make_tcp_server(server_cfg, server_endpoints);
+
+            boost::fibers::fiber ff_server([&](){
+                auto conn = server->new_session();
+                conn->handle_messages();
+                conn->close();
+            });
+
+            server->listen();
+
+            auto endpoints = memoria::hrpc::st::EndpointRepository::make();
+
+            auto client_cfg = memoria::hrpc::TCPClientSocketConfig::of_host("127.0.0.1");
+            auto session = memoria::reactor::hrpc::open_tcp_session(client_cfg, endpoints);
+
+            boost::fibers::fiber ff_conn_h([=](){
+                session->handle_messages();
+            });
+
+            run_hrpc_bench("reactor", session, [](size_t n, const std::function<void (size_t)>& fn) {
+                std::vector<boost::fibers::fiber> fibers;
+                for (size_t c = 0; c < n; c++) {
+                    fibers.emplace_back([&fn, c]{
+                        fn(c);
+                    });
+                }
+
+                for (auto& ff: fibers) {
+                    ff.join();
+                }
+            });
+
+            session->close();
+            ff_conn_h.join();
+            ff_server.join();
+        }).join();
+
+        return 0;
+    });
+}
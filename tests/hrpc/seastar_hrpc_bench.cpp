@@ -0,0 +1,89 @@
+
+// Copyright 2026 Victor Smirnov
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memoria/hrpc/hrpc.hpp>
+
+#include <memoria/memoria_core.hpp>
+
+#include "hrpc_bench_common.hpp"
+
+#include <memoria/seastar/hrpc/hrpc.hpp>
+
+#include <seastar/core/app-template.hh>
+#include <seastar/core/thread.hh>
+
+using namespace memoria;
+namespace ss = ::seastar;
+
+int main(int argc, char** argv, char** envp)
+{
+    InitMemoriaCoreExplicit();
+
+    ss::app_template::seastar_options opts;
+    opts.smp_opts.memory_allocator = ss::memory_allocator::standard;
+    opts.smp_opts.smp.set_value(1);
+    opts.smp_opts.thread_affinity.set_value(false);
+
+    ss::app_template app(std::move(opts));
+
+    return app.run(
+        argc, argv,
+        [&]()
+    {
+        return ss::async([&]{
+            auto server_endpoints = hrpc::st::EndpointRepository::make();
+            add_bench_handlers(server_endpoints);
+
+            auto server_cfg = hrpc::TCPServerSocketConfig::of_host("127.0.0.1");
+            auto server = memoria::seastar::hrpc::make_tcp_server(server_cfg, server_endpoints);
+
+            ss::thread ff_server([&](){
+                auto conn = server->new_session();
+                conn->handle_messages();
+                conn->close();
+            });
+
+            server->listen();
+
+            auto endpoints = hrpc::st::EndpointRepository::make();
+
+            auto client_cfg = hrpc::TCPClientSocketConfig::of_host("127.0.0.1");
+            auto session = memoria::seastar::hrpc::open_tcp_session(client_cfg, endpoints);
+
+            ss::thread ff_conn_h([=](){
+                session->handle_messages();
+            });
+
+            run_hrpc_bench("seastar", session, [](size_t n, const std::function<void (size_t)>& fn) {
+                std::vector<ss::thread> threads;
+                for (size_t c = 0; c < n; c++) {
+                    threads.emplace_back([&fn, c]{
+                        fn(c);
+                    });
+                }
+
+                for (auto& tt: threads) {
+                    tt.join().get();
+                }
+            });
+
+            session->close();
+            ff_conn_h.join().get();
+            ff_server.join().get();
+
+            return 0;
+        });
+    });
+}
@@ -128,6 +128,11 @@ public:
         return 1;
     }
 
+    // Run the test's process with --work-stealing enabled
+    virtual bool work_stealing() const noexcept {
+        return false;
+    }
+
     template <typename T>
     void add_field_handler(const char* name, T& field)
     {
@@ -152,16 +152,24 @@ void ThreadsArgHelper::fix_thread_arg()
 
     if (test_name)
     {
-        char* threads1 = has_arg("--threads");
-        char* threads2 = has_arg("-t");
-
-        if (!(threads1 || threads2))
+        auto test = tests_registry().find_test(test_name);
+        if (test)
         {
-            auto test = tests_registry().find_test(test_name);
-            if (test)
+            auto state = test->create_state();
+
+            char* threads1 = has_arg("--threads");
+            char* threads2 = has_arg("-t");
+
+            if (!(threads1 || threads2))
             {
                 args_.insert(args_.begin() + 1, make_copy("-t"));
-                args_.insert(args_.begin() + 2, make_copy("1"));
+                args_.insert(args_.begin() + 2, make_copy(std::to_string(state->threads()).c_str()));
+            }
+
+            if (state->work_stealing() && !has_arg("--work-stealing"))
+            {
+                args_.insert(args_.begin() + 1, make_copy("--work-stealing"));
+                args_.insert(args_.begin() + 2, make_copy("true"));
             }
         }
     }
@@ -0,0 +1,134 @@
+// Copyright 2026 Victor Smirnov
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "../prototype/bt/bt_test_base.hpp"
+#include "dsl_vm_test.hpp"
+
+#include <memoria/api/multimap/multimap_api.hpp>
+#include <memoria/dsl/vm/chunk_cursor.hpp>
+
+#include <vector>
+
+namespace memoria {
+namespace tests {
+
+// VM programs over a real container: Multimap keys are
+// read directly from the leaves through ChunkCursor.
+template <
+    typename ProfileT = CoreApiProfile,
+    typename StoreT   = IMemoryStorePtr<ProfileT>
+>
+class DSLVMCtrTest: public BTTestBase<Multimap<BigInt, UTinyInt>, ProfileT, StoreT>
+{
+    using MyType = DSLVMCtrTest;
+    using Base   = BTTestBase<Multimap<BigInt, UTinyInt>, ProfileT, StoreT>;
+
+    using CtrType = Multimap<BigInt, UTinyInt>;
+
+    using Base::branch;
+    using Base::commit;
+    using Base::out;
+    using Base::getRandom;
+
+    int64_t size = 100000;
+
+public:
+    DSLVMCtrTest()
+    {
+    }
+
+    MMA_STATE_FILEDS(size)
+
+    static void init_suite(TestSuite& suite) {
+        MMA_CLASS_TESTS(suite, testMultimapKeys);
+    }
+
+    void testMultimapKeys()
+    {
+        auto snp = branch();
+        auto ctr = create<CtrType>(snp, CtrType{});
+
+        // Keys are sorted, so they are generated in order
+        std::vector<int64_t> keys;
+        int64_t key = -size;
+        for (int64_t c = 0; c < size; c++) {
+            key += 1 + getRandom(10);
+            keys.push_back(key);
+        }
+
+        std::vector<uint8_t> values{1, 2, 3};
+        size_t pos{};
+        ctr->append_entries([&](auto& buff) {
+            size_t limit = std::min<size_t>(keys.size() - pos, 8192);
+            for (size_t c = 0; c < limit; c++)
+            {
+                buff.symbols().append_run(0, 1);
+                buff.keys().append(keys[pos + c]);
+
+                buff.symbols().append_run(1, values.size());
+                buff.values().append(values);
+            }
+
+            pos += limit;
+            return pos >= keys.size();
+        });
+
+        assert_equals(keys.size(), ctr->size());
+
+        using ChunkPtrT = decltype(ctr->seek_key(0));
+        dsl::vm::ChunkCursor<ChunkPtrT> cursor(ctr->size(), [&](int64_t pos){
+            return ctr->seek_key(pos);
+        });
+
+        dsl::vm::VMCursor* cursors[] = {&cursor};
+
+        dsl::vm::Interpreter interpreter;
+        auto filtered_sum = DSLVMTest::make_filtered_sum();
+        auto chunked_count = DSLVMTest::make_chunked_count();
+
+        for (int c = 0; c < 10; c++)
+        {
+            int64_t threshold = keys[getRandom(keys.size())];
+
+            int64_t sum{}, cnt{};
+            for (int64_t kk: keys)
+            {
+                if (kk >= threshold) {
+                    sum += kk;
+                    cnt++;
+                }
+            }
+
+            dsl::vm::Value args[] = {dsl::vm::Value::of_int(threshold)};
+            assert_equals(sum, interpreter.run(filtered_sum, args, cursors).i);
+            assert_equals(cnt, interpreter.run(chunked_count, args, cursors).i);
+        }
+
+        // Keys are not doubles
+        assert_equals(true, cursor.seek(0));
+        assert_throws<ResultException>([&]{
+            cursor.column_f64(0);
+        });
+
+        assert_equals(false, cursor.seek(size));
+        assert_equals(false, cursor.next_chunk());
+        assert_equals(0, cursor.column_i64(0).size());
+
+        commit();
+    }
+};
+
+}}
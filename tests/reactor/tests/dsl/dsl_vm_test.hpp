@@ -0,0 +1,568 @@
+// Copyright 2026 Victor Smirnov
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memoria/tests/tests.hpp>
+#include <memoria/tests/assertions.hpp>
+
+#include <memoria/dsl/vm/interpreter.hpp>
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace memoria {
+namespace tests {
+
+class DSLVMTest: public TestState {
+    using MyType = DSLVMTest;
+    using Base   = TestState;
+
+    using OC = dsl::vm::OpCode;
+
+    using Program        = dsl::vm::Program;
+    using ProgramBuilder = dsl::vm::ProgramBuilder;
+    using Interpreter    = dsl::vm::Interpreter;
+    using Value          = dsl::vm::Value;
+    using VMCursor       = dsl::vm::VMCursor;
+    using ColumnarCursor = dsl::vm::ColumnarCursor;
+    using Instruction    = dsl::vm::Instruction;
+
+    static constexpr int64_t INT64_MIN_ = std::numeric_limits<int64_t>::min();
+    static constexpr int64_t INT64_MAX_ = std::numeric_limits<int64_t>::max();
+
+    int64_t rows_{10000};
+
+public:
+    using Base::getRandom;
+    using Base::out;
+
+    MMA_STATE_FILEDS(rows_);
+
+    static void init_suite(TestSuite& suite)
+    {
+        MMA_CLASS_TESTS(suite, testBuilder, testVerify, testIntegerOps, testFloatOps, testOverflow, testRegisters, testJumps, testCursor);
+    }
+
+    // sum(v for v in column 0 of cursor 0 if v >= R0), one value per iteration
+    static Program make_filtered_sum()
+    {
+        ProgramBuilder bb(1);
+        uint8_t threshold = bb.arg(0);
+
+        uint8_t sum = bb.reg(), idx = bb.reg(), len = bb.reg(), val = bb.reg();
+        uint8_t tmp = bb.reg(), one = bb.reg(), zero = bb.reg(), ok = bb.reg();
+        uint8_t col = bb.span();
+
+        auto chunk = bb.label(), elem = bb.label(), skip = bb.label();
+        auto next = bb.label(), done = bb.label();
+
+        bb.load_i(sum, 0);
+        bb.load_i(one, 1);
+        bb.load_i(zero, 0);
+        bb.emit(OC::CSEEK, ok, zero, 0);
+        bb.jf(ok, done);
+
+        bb.bind(chunk);
+        bb.emit(OC::CCOLI, col, 0, 0);
+        bb.emit(OC::SLEN, len, col);
+        bb.load_i(idx, 0);
+
+        bb.bind(elem);
+        bb.emit(OC::LTI, tmp, idx, len);
+        bb.jf(tmp, next);
+        bb.emit(OC::SGETI, val, col, idx);
+        bb.emit(OC::LTI, tmp, val, threshold);
+        bb.jt(tmp, skip);
+        bb.emit(OC::ADDI, sum, sum, val);
+        bb.bind(skip);
+        bb.emit(OC::ADDI, idx, idx, one);
+        bb.jmp(elem);
+
+        bb.bind(next);
+        bb.emit(OC::CNEXT, ok, 0, 0);
+        bb.jt(ok, chunk);
+
+        bb.bind(done);
+        bb.emit(OC::RET, sum);
+
+        return bb.build();
+    }
+
+    // count(v for v in column 0 of cursor 0 if v >= R0), one chunk per iteration
+    static Program make_chunked_count()
+    {
+        ProgramBuilder bb(1);
+        uint8_t threshold = bb.arg(0);
+
+        uint8_t cnt = bb.reg(), zero = bb.reg(), ok = bb.reg();
+        uint8_t col = bb.span();
+
+        auto chunk = bb.label(), done = bb.label();
+
+        bb.load_i(cnt, 0);
+        bb.load_i(zero, 0);
+        bb.emit(OC::CSEEK, ok, zero, 0);
+        bb.jf(ok, done);
+
+        bb.bind(chunk);
+        bb.emit(OC::CCOLI, col, 0, 0);
+        bb.emit(OC::SCNTGEI, cnt, col, threshold);
+        bb.emit(OC::CNEXT, ok, 0, 0);
+        bb.jt(ok, chunk);
+
+        bb.bind(done);
+        bb.emit(OC::RET, cnt);
+
+        return bb.build();
+    }
+
+    void testBuilder()
+    {
+        ProgramBuilder bb(2);
+        assert_equals(0, bb.arg(0));
+        assert_equals(1, bb.arg(1));
+        assert_throws<ResultException>([&]{
+            bb.arg(2);
+        });
+
+        uint8_t r0 = bb.reg(), r1 = bb.reg();
+        assert_equals(2, r0);
+        assert_equals(3, r1);
+
+        // Small values are inline, large ones go to the pool once
+        bb.load_i(r0, 100);
+        bb.load_i(r0, 1ll << 40);
+        bb.load_i(r1, 1ll << 40);
+        bb.emit(OC::ADDI, r0, r0, r1);
+        bb.emit(OC::RET, r0);
+
+        Program program = bb.build();
+        assert_equals(4, program.registers());
+        assert_equals(2, program.arguments());
+        assert_equals(0, program.spans());
+        assert_equals(1, program.constants().size());
+        assert_equals(5, program.instructions().size());
+        assert_equals(true, OC::LOADI == dsl::vm::op_of(program.instructions()[0]));
+        assert_equals(true, OC::LOADK == dsl::vm::op_of(program.instructions()[1]));
+        assert_equals(2ll << 40, run(program, {Value::of_int(0), Value::of_int(0)}).i);
+        assert_equals(false, program.disassemble().to_std_string().empty());
+
+        // Unbound labels
+        ProgramBuilder bb2;
+        auto label = bb2.label();
+        bb2.jmp(label);
+        assert_throws<ResultException>([&]{
+            bb2.build();
+        });
+
+        // A default program returns zero
+        assert_equals(0, run(Program(), {}).i);
+
+        // Header fields are 8 bits wide
+        ProgramBuilder bb3(Program::MAX_ARGUMENTS);
+        bb3.emit(OC::RET, bb3.arg(Program::MAX_ARGUMENTS - 1));
+        assert_equals(Program::MAX_ARGUMENTS, bb3.build().arguments());
+
+        assert_throws<ResultException>([&]{
+            ProgramBuilder bb4(Program::MAX_ARGUMENTS + 1);
+        });
+        assert_throws<ResultException>([&]{
+            Program::make_header(256, 0, 0);
+        });
+        assert_throws<ResultException>([&]{
+            Program::make_header(1, 256, 0);
+        });
+        assert_throws<ResultException>([&]{
+            Program::make_header(1, 0, 256);
+        });
+    }
+
+    void testVerify()
+    {
+        using dsl::vm::encode_abc;
+        using dsl::vm::encode_abx;
+        using dsl::vm::encode_asbx;
+
+        auto header = Program::make_header;
+        Instruction ret0 = encode_abc(OC::RET, 0);
+
+        auto assert_rejected = [&](std::vector<Instruction> code, std::vector<Value> constants = {}) {
+            assert_throws<ResultException>([&]{
+                Program program(code, constants);
+            });
+        };
+
+        // The reference program is valid
+        Program(std::vector<Instruction>{header(1, 0, 0), ret0}, {});
+
+        // Empty code, no header
+        assert_rejected({});
+        assert_rejected({header(1, 0, 0)});
+
+        // Unsupported version
+        assert_rejected({header(1, 0, 0) + (1u << 24), ret0});
+
+        // More arguments than registers
+        assert_rejected({header(1, 2, 0), ret0});
+
+        // Too many span registers
+        assert_rejected({header(1, 0, Program::MAX_SPANS + 1), ret0});
+
+        // Unknown opcode
+        assert_rejected({header(1, 0, 0), static_cast<Instruction>(OC::OPCODES_NUM), ret0});
+
+        // Register out of range
+        assert_rejected({header(1, 0, 0), encode_abc(OC::MOV, 0, 1), ret0});
+        assert_rejected({header(2, 0, 0), encode_abc(OC::ADDI, 0, 1, 2), ret0});
+        assert_rejected({header(1, 0, 0), encode_abc(OC::RET, 1)});
+
+        // Span register out of range
+        assert_rejected({header(1, 0, 0), encode_abc(OC::SLEN, 0, 0), ret0});
+        assert_rejected({header(1, 0, 1), encode_abc(OC::CCOLI, 1, 0, 0), ret0});
+
+        // Constant out of range
+        assert_rejected({header(1, 0, 0), encode_abx(OC::LOADK, 0, 0), ret0});
+        assert_rejected({header(1, 0, 0), encode_abx(OC::LOADK, 0, 1), ret0}, {Value::of_int(1)});
+
+        // Jumps must land inside of the code
+        assert_rejected({header(1, 0, 0), encode_asbx(OC::JMP, 0, 1), ret0});
+        assert_rejected({header(1, 0, 0), encode_asbx(OC::JMP, 0, -2), ret0});
+        assert_rejected({header(1, 0, 0), encode_asbx(OC::JT, 0, 5), ret0});
+        Program(std::vector<Instruction>{header(1, 0, 0), encode_asbx(OC::JMP, 0, 0), ret0}, {});
+        Program(std::vector<Instruction>{header(1, 0, 0), ret0, encode_asbx(OC::JMP, 0, -2)}, {});
+
+        // Execution can't fall off the end
+        assert_rejected({header(1, 0, 0), encode_abc(OC::NOP, 0)});
+        assert_rejected({header(1, 0, 0), encode_asbx(OC::JT, 0, -1)});
+    }
+
+    void testIntegerOps()
+    {
+        assert_equals(7, binop_i(OC::ADDI, 3, 4));
+        assert_equals(-1, binop_i(OC::SUBI, 3, 4));
+        assert_equals(12, binop_i(OC::MULI, 3, 4));
+        assert_equals(-3, binop_i(OC::DIVI, -7, 2));
+        assert_equals(-1, binop_i(OC::REMI, -7, 2));
+
+        assert_equals(1, binop_i(OC::LTI, 3, 4));
+        assert_equals(0, binop_i(OC::LTI, 4, 4));
+        assert_equals(1, binop_i(OC::LEI, 4, 4));
+        assert_equals(0, binop_i(OC::LEI, 5, 4));
+        assert_equals(1, binop_i(OC::EQI, 4, 4));
+        assert_equals(0, binop_i(OC::EQI, 3, 4));
+        assert_equals(1, binop_i(OC::NEI, 3, 4));
+        assert_equals(0, binop_i(OC::NEI, 4, 4));
+
+        // LOADI, LOADK, MOV, NOP
+        ProgramBuilder bb;
+        uint8_t r0 = bb.reg(), r1 = bb.reg(), r2 = bb.reg();
+        bb.load_i(r0, -32768);
+        bb.load_i(r1, 1ll << 50);
+        bb.emit(OC::NOP);
+        bb.emit(OC::MOV, r2, r1);
+        bb.emit(OC::ADDI, r2, r2, r0);
+        bb.emit(OC::RET, r2);
+        assert_equals((1ll << 50) - 32768, run(bb.build(), {}).i);
+
+        assert_throws<ResultException>([&]{
+            binop_i(OC::DIVI, 1, 0);
+        });
+
+        assert_throws<ResultException>([&]{
+            binop_i(OC::REMI, 1, 0);
+        });
+    }
+
+    void testFloatOps()
+    {
+        assert_equals(3.5, binop_f(OC::ADDF, 1.25, 2.25).f);
+        assert_equals(-1.0, binop_f(OC::SUBF, 1.25, 2.25).f);
+        assert_equals(2.5, binop_f(OC::MULF, 1.25, 2.0).f);
+        assert_equals(0.625, binop_f(OC::DIVF, 1.25, 2.0).f);
+        assert_equals(true, std::isinf(binop_f(OC::DIVF, 1.0, 0.0).f));
+
+        assert_equals(1, binop_f(OC::LTF, 1.0, 2.0).i);
+        assert_equals(0, binop_f(OC::LTF, 2.0, 2.0).i);
+        assert_equals(1, binop_f(OC::LEF, 2.0, 2.0).i);
+        assert_equals(0, binop_f(OC::LEF, 3.0, 2.0).i);
+        assert_equals(0, binop_f(OC::LTF, NAN, 2.0).i);
+
+        assert_equals(-5.0, unop(OC::I2F, Value::of_int(-5)).f);
+        assert_equals(-5, unop(OC::F2I, Value::of_float(-5.75)).i);
+        assert_equals(5, unop(OC::F2I, Value::of_float(5.75)).i);
+    }
+
+    void testOverflow()
+    {
+        // Integer arithmetic wraps around
+        assert_equals(INT64_MIN_, binop_i(OC::ADDI, INT64_MAX_, 1));
+        assert_equals(INT64_MAX_, binop_i(OC::SUBI, INT64_MIN_, 1));
+        assert_equals(0, binop_i(OC::MULI, INT64_MIN_, 2));
+        assert_equals(INT64_MIN_, binop_i(OC::DIVI, INT64_MIN_, -1));
+        assert_equals(0, binop_i(OC::REMI, INT64_MIN_, -1));
+        assert_equals(-5, binop_i(OC::DIVI, 5, -1));
+
+        // F2I is defined for [-2^63, 2^63) only
+        assert_equals(INT64_MIN_, unop(OC::F2I, Value::of_float(-9223372036854775808.0)).i);
+
+        for (double value: {double(NAN), double(INFINITY), -double(INFINITY), 9223372036854775808.0, -1e19, 1e300})
+        {
+            assert_throws<ResultException>([&]{
+                unop(OC::F2I, Value::of_float(value));
+            });
+        }
+
+        // Sums of spans wrap around too
+        std::vector<int64_t> column{INT64_MAX_, 1, 1};
+        ColumnarCursor cursor(column.size(), 2);
+        cursor.add_column(Span<const int64_t>(column.data(), column.size()));
+
+        ProgramBuilder bb;
+        uint8_t sum = bb.reg(), zero = bb.reg(), ok = bb.reg();
+        uint8_t col = bb.span();
+        bb.emit(OC::CSEEK, ok, zero, 0);
+        bb.emit(OC::CCOLI, col, 0, 0);
+        bb.emit(OC::SSUMI, sum, col);
+        bb.emit(OC::RET, sum);
+
+        VMCursor* cursors[] = {&cursor};
+        assert_equals(INT64_MIN_, run(bb.build(), {}, cursors).i);
+    }
+
+    void testRegisters()
+    {
+        // Fill the stack with garbage first
+        {
+            ProgramBuilder bb;
+            for (size_t c = 0; c < Program::MAX_REGISTERS - 1; c++) {
+                uint8_t rr = bb.reg();
+                bb.load_i(rr, -1);
+            }
+            bb.emit(OC::RET, 0);
+            assert_equals(-1, run(bb.build(), {}).i);
+        }
+
+        // Registers that are never written read as zero
+        ProgramBuilder bb(1);
+        uint8_t r0 = bb.reg(), r1 = bb.reg();
+        for (size_t c = 0; c < 100; c++) {
+            bb.reg();
+        }
+        bb.emit(OC::ADDI, r0, r0, bb.arg(0));
+        bb.emit(OC::ADDI, r0, r0, r1);
+        bb.emit(OC::RET, r0);
+
+        Program program = bb.build();
+        assert_equals(42, run(program, {Value::of_int(42)}).i);
+
+        // Arguments count must match
+        assert_throws<ResultException>([&]{
+            run(program, {});
+        });
+        assert_throws<ResultException>([&]{
+            run(program, {Value::of_int(1), Value::of_int(2)});
+        });
+    }
+
+    void testJumps()
+    {
+        // sum(1..n) with a backward jump, and a forward JT/JF
+        ProgramBuilder bb(1);
+        uint8_t n = bb.arg(0);
+        uint8_t sum = bb.reg(), idx = bb.reg(), one = bb.reg(), tmp = bb.reg();
+
+        auto loop = bb.label(), done = bb.label(), negative = bb.label();
+
+        bb.load_i(one, 1);
+        bb.emit(OC::LTI, tmp, n, sum);
+        bb.jt(tmp, negative);
+
+        bb.bind(loop);
+        bb.emit(OC::LEI, tmp, idx, n);
+        bb.jf(tmp, done);
+        bb.emit(OC::ADDI, sum, sum, idx);
+        bb.emit(OC::ADDI, idx, idx, one);
+        bb.jmp(loop);
+
+        bb.bind(negative);
+        bb.load_i(sum, -1);
+
+        bb.bind(done);
+        bb.emit(OC::RET, sum);
+
+        Program program = bb.build();
+        assert_equals(0, run(program, {Value::of_int(0)}).i);
+        assert_equals(55, run(program, {Value::of_int(10)}).i);
+        assert_equals(5000050000ll, run(program, {Value::of_int(100000)}).i);
+        assert_equals(-1, run(program, {Value::of_int(-3)}).i);
+    }
+
+    void testCursor()
+    {
+        assert_throws<ResultException>([&]{
+            ColumnarCursor cursor(100, 0);
+        });
+
+        std::vector<int64_t> ints;
+        std::vector<double> floats;
+        for (int64_t c = 0; c < rows_; c++) {
+            ints.push_back(getRandom(1000));
+            floats.push_back(getRandom(1000) / 4.0);
+        }
+
+        assert_throws<ResultException>([&]{
+            ColumnarCursor cursor(rows_ + 1, 16);
+            cursor.add_column(Span<const int64_t>(ints.data(), ints.size()));
+        });
+
+        for (size_t chunk_size: {1, 7, 256, 100000})
+        {
+            ColumnarCursor cursor(rows_, chunk_size);
+            cursor.add_column(Span<const int64_t>(ints.data(), ints.size()));
+            cursor.add_column(Span<const double>(floats.data(), floats.size()));
+
+            VMCursor* cursors[] = {&cursor};
+
+            for (int64_t threshold: {0, 500, 1000})
+            {
+                int64_t sum{}, cnt{};
+                for (int64_t value: ints)
+                {
+                    if (value >= threshold) {
+                        sum += value;
+                        cnt++;
+                    }
+                }
+
+                Value args[] = {Value::of_int(threshold)};
+                assert_equals(sum, Interpreter().run(make_filtered_sum(), args, cursors).i);
+                assert_equals(cnt, Interpreter().run(make_chunked_count(), args, cursors).i);
+            }
+
+            double fsum{};
+            for (double value: floats) {
+                fsum += value;
+            }
+
+            assert_equals(fsum, run(make_float_sum(), {}, cursors).f);
+        }
+
+        ColumnarCursor cursor(rows_, 16);
+        cursor.add_column(Span<const int64_t>(ints.data(), ints.size()));
+        VMCursor* cursors[] = {&cursor};
+
+        // Span index out of range
+        {
+            ProgramBuilder bb;
+            uint8_t val = bb.reg(), idx = bb.reg(), ok = bb.reg();
+            uint8_t col = bb.span();
+            bb.emit(OC::CSEEK, ok, idx, 0);
+            bb.emit(OC::CCOLI, col, 0, 0);
+            bb.load_i(idx, 16);
+            bb.emit(OC::SGETI, val, col, idx);
+            bb.emit(OC::RET, val);
+
+            assert_throws<ResultException>([&]{
+                run(bb.build(), {}, cursors);
+            });
+        }
+
+        // Cursor slot out of range
+        {
+            ProgramBuilder bb;
+            uint8_t ok = bb.reg();
+            bb.emit(OC::CNEXT, ok, 0, 1);
+            bb.emit(OC::RET, ok);
+
+            assert_throws<ResultException>([&]{
+                run(bb.build(), {}, cursors);
+            });
+        }
+
+        // Seeking out of range
+        {
+            ProgramBuilder bb(1);
+            uint8_t ok = bb.reg();
+            bb.emit(OC::CSEEK, ok, bb.arg(0), 0);
+            bb.emit(OC::RET, ok);
+
+            Program program = bb.build();
+            assert_equals(1, run(program, {Value::of_int(rows_ - 1)}, cursors).i);
+            assert_equals(0, run(program, {Value::of_int(rows_)}, cursors).i);
+            assert_equals(0, run(program, {Value::of_int(-1)}, cursors).i);
+        }
+    }
+
+private:
+    // sum(column 1 of cursor 0) using SGETF for the first
+    // element of each chunk and SSUMF for the rest
+    static Program make_float_sum()
+    {
+        ProgramBuilder bb;
+        uint8_t sum = bb.reg(), zero = bb.reg(), ok = bb.reg(), val = bb.reg(), len = bb.reg();
+        uint8_t col = bb.span();
+
+        auto chunk = bb.label(), done = bb.label();
+
+        bb.emit(OC::CSEEK, ok, zero, 0);
+        bb.jf(ok, done);
+
+        bb.bind(chunk);
+        bb.emit(OC::CCOLF, col, 0, 1);
+        bb.emit(OC::SLEN, len, col);
+        bb.emit(OC::SGETF, val, col, zero);
+        bb.emit(OC::SSUMF, sum, col);
+        bb.emit(OC::CNEXT, ok, 0, 0);
+        bb.jt(ok, chunk);
+
+        bb.bind(done);
+        bb.emit(OC::RET, sum);
+
+        return bb.build();
+    }
+
+    static Value run(const Program& program, std::vector<Value> args, Span<VMCursor* const> cursors = {}) {
+        return Interpreter().run(program, Span<const Value>(args.data(), args.size()), cursors);
+    }
+
+    static int64_t binop_i(OC op, int64_t a, int64_t b) {
+        return binop(op, Value::of_int(a), Value::of_int(b)).i;
+    }
+
+    static Value binop_f(OC op, double a, double b) {
+        return binop(op, Value::of_float(a), Value::of_float(b));
+    }
+
+    static Value binop(OC op, Value a, Value b)
+    {
+        ProgramBuilder bb(2);
+        uint8_t rr = bb.reg();
+        bb.emit(op, rr, bb.arg(0), bb.arg(1));
+        bb.emit(OC::RET, rr);
+        return run(bb.build(), {a, b});
+    }
+
+    static Value unop(OC op, Value a)
+    {
+        ProgramBuilder bb(1);
+        uint8_t rr = bb.reg();
+        bb.emit(op, rr, bb.arg(0));
+        bb.emit(OC::RET, rr);
+        return run(bb.build(), {a});
+    }
+};
+
+}}
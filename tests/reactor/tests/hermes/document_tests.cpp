@@ -32,6 +32,14 @@ auto document_set_test = register_test_in_suite<FnTest<HermesTestState>>("Hermes
     assert_equals(true, doc.root().value().is_varchar());
     assert_equals("Hello world", doc.root().value().as_varchar());
 
+    // Lengths of 249 and more take more than one byte
+    for (size_t len: {248, 249, 300, 70000})
+    {
+        U8String str(len, 'x');
+        doc.set_dataobject<Varchar>(str);
+        assert_equals(str, doc.root().value().as_varchar());
+    }
+
     assert_throws<ResultException>([&](){
         doc.root().value().as_double();
     });
@@ -16,6 +16,8 @@
 
 #include "test_tools.hpp"
 
+#include <memoria/core/arena/swiss_map.hpp>
+
 
 namespace memoria {
 namespace tests {
@@ -76,4 +78,113 @@ auto ldd_map_set_tests = register_test_in_suite<FnTest<HermesTestState>>("Hermes
     assert_equals(true, map.expect("Entry2").as_boolean());
 });
 
+
+auto arena_swiss_map_tests = register_test_in_suite<FnTest<HermesTestState>>("HermesTestSuite", "SwissMapPutRemove", [](auto& state){
+    arena::ArenaAllocator arena(65536);
+    auto map = arena.allocate_object_untagged<arena::SwissMap<int64_t, int64_t>>();
+
+    size_t size = 10000;
+
+    std::unordered_map<int64_t, int64_t> values;
+    auto check = [&]{
+        assert_equals(values.size(), map->size());
+
+        size_t cnt{};
+        map->for_each([&](const int64_t& key, const int64_t& value){
+            assert_equals(values.at(key), value);
+            cnt++;
+        });
+        assert_equals(values.size(), cnt);
+
+        for (auto& entry: values) {
+            auto vv = map->get(entry.first, nullptr);
+            assert_equals(true, vv != nullptr);
+            assert_equals(entry.second, *vv);
+        }
+    };
+
+    for (size_t c = 0; c < size; c++)
+    {
+        int64_t key = state.getRandom(1000000);
+        values[key] = c;
+        map->put(arena, key, c, nullptr);
+
+        if (c % 500 == 0) {
+            check();
+        }
+    }
+    check();
+
+    for (size_t c = 0; c < size; c++)
+    {
+        int64_t key = c * 3;
+        map->put(arena, key, c, nullptr);
+        values[key] = c;
+
+        key = state.getRandom(1000000);
+        map->remove(arena, key, nullptr);
+        values.erase(key);
+        assert_equals(true, map->get(key, nullptr) == nullptr);
+
+        if (c % 500 == 0) {
+            check();
+        }
+    }
+    check();
+
+    while (values.size()) {
+        int64_t key = values.begin()->first;
+        map->remove(arena, key, nullptr);
+        values.erase(key);
+    }
+
+    assert_equals(0, map->size());
+    assert_equals(0, map->capacity());
+});
+
+
+auto typed_map_put_remove_tests = register_test_in_suite<FnTest<HermesTestState>>("HermesTestSuite", "TypedMapPutRemove", [](auto& state){
+    auto doc = hermes::HermesCtrView::make_new();
+
+    auto map = doc.make_map<BigInt, hermes::Object>();
+    assert_equals(0, map.size());
+
+    size_t size = 10000;
+
+    std::unordered_map<int64_t, int64_t> values;
+    auto check = [&](auto& gmap) {
+        assert_equals(values.size(), gmap->size());
+        for (auto& entry: values) {
+            auto vv = gmap->get(static_cast<uint64_t>(entry.first));
+            assert_equals(true, vv.is_not_empty());
+            assert_equals(entry.second, vv.as_bigint());
+        }
+    };
+
+    for (size_t c = 0; c < size; c++)
+    {
+        int64_t key = state.getRandom(1000000);
+        values[key] = c;
+        map.put_t<BigInt>(key, c);
+
+        key = state.getRandom(1000000);
+        map.remove(key);
+        values.erase(key);
+        assert_equals(true, !map.get(key).has_value());
+    }
+
+    doc.set_root(map.as_object());
+    auto m0 = doc.root().value().as_generic_map();
+    check(m0);
+
+    doc.check();
+
+    // Compaction deep-copies the map's storage
+    auto doc2 = doc.compactify(false);
+    auto m1 = doc2.root().value().as_generic_map();
+    check(m1);
+
+    doc2.check();
+});
+
 }}
@@ -0,0 +1,192 @@
+// Copyright 2026 Victor Smirnov
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include "../prototype/bt/bt_test_base.hpp"
+
+#include <memoria/tests/assertions.hpp>
+
+#include <memoria/api/map/map_api.hpp>
+
+#include <map>
+
+namespace memoria {
+namespace tests {
+
+template <
+    typename ProfileT = CoreApiProfile,
+    typename StoreT   = IMemoryStorePtr<ProfileT>
+>
+class MapDiffTest: public BTTestBase<Map<BigInt, BigInt>, ProfileT, StoreT>
+{
+    using MyType = MapDiffTest;
+    using Base   = BTTestBase<Map<BigInt, BigInt>, ProfileT, StoreT>;
+
+    using Base::branch;
+    using Base::commit;
+    using Base::snapshot;
+    using Base::out;
+    using Base::getRandom;
+
+    using CtrT = Map<BigInt, BigInt>;
+
+    // key -> (old value, new value)
+    using Changes = std::map<int64_t, std::pair<Optional<int64_t>, Optional<int64_t>>>;
+
+    int64_t size = 100000;
+    int64_t changes = 1000;
+
+public:
+    MapDiffTest()
+    {
+    }
+
+    MMA_STATE_FILEDS(size, changes)
+
+    static void init_suite(TestSuite& suite) {
+        MMA_CLASS_TESTS(suite, testDiff);
+    }
+
+    template <typename Ctr>
+    Changes diff(Ctr& ctr, Ctr& from)
+    {
+        Changes result;
+        Optional<int64_t> prev_key;
+
+        ctr->diff(from, [&](auto key, auto old_value, auto new_value) {
+            if (prev_key) {
+                assert_lt(*prev_key, key);
+            }
+            prev_key = key;
+
+            result[key] = std::make_pair(
+                old_value ? Optional<int64_t>(*old_value) : Optional<int64_t>{},
+                new_value ? Optional<int64_t>(*new_value) : Optional<int64_t>{}
+            );
+            return true;
+        });
+
+        return result;
+    }
+
+    void assert_changes_equal(const Changes& expected, const Changes& actual)
+    {
+        assert_equals(expected.size(), actual.size());
+
+        auto ii = actual.begin();
+        for (const auto& entry: expected)
+        {
+            assert_equals(entry.first, ii->first);
+            assert_equals(entry.second.first.has_value(), ii->second.first.has_value());
+            assert_equals(entry.second.second.has_value(), ii->second.second.has_value());
+
+            if (entry.second.first) {
+                assert_equals(*entry.second.first, *ii->second.first);
+            }
+
+            if (entry.second.second) {
+                assert_equals(*entry.second.second, *ii->second.second);
+            }
+
+            ++ii;
+        }
+    }
+
+    void testDiff()
+    {
+        auto snp = branch();
+        auto ctr = create<CtrT>(snp, CtrT{});
+
+        std::map<int64_t, int64_t> entries;
+        for (int64_t c = 0; c < size; c++)
+        {
+            int64_t key = c * 2;
+            entries[key] = c;
+            ctr->upsert_key(key, c);
+        }
+
+        commit();
+
+        auto old_snp = snapshot();
+        auto old_ctr = find<CtrT>(old_snp, ctr->name());
+
+        assert_equals(0, diff(old_ctr, old_ctr).size());
+
+        snp = branch();
+        ctr = find<CtrT>(snp, ctr->name());
+
+        // Inserts (odd keys), updates and removals of existing
+        // keys, and inserts past the end to grow the tree.
+        Changes expected;
+        for (int64_t c = 0; c < changes; c++)
+        {
+            int32_t op = getRandom(4);
+            if (op == 0)
+            {
+                int64_t key = getRandom(size) * 2 + 1;
+                if (entries.find(key) == entries.end()) {
+                    entries[key] = c;
+                    expected[key] = std::make_pair(Optional<int64_t>{}, Optional<int64_t>{c});
+                    ctr->upsert_key(key, c);
+                }
+            }
+            else if (op == 1)
+            {
+                int64_t key = getRandom(size) * 2;
+                auto ii = entries.find(key);
+                if (ii != entries.end() && expected.find(key) == expected.end())
+                {
+                    expected[key] = std::make_pair(Optional<int64_t>{ii->second}, Optional<int64_t>{-c});
+                    ii->second = -c;
+                    ctr->upsert_key(key, -c);
+                }
+            }
+            else if (op == 2)
+            {
+                int64_t key = getRandom(size) * 2;
+                auto ii = entries.find(key);
+                if (ii != entries.end() && expected.find(key) == expected.end())
+                {
+                    expected[key] = std::make_pair(Optional<int64_t>{ii->second}, Optional<int64_t>{});
+                    entries.erase(ii);
+                    ctr->remove_key(key);
+                }
+            }
+            else {
+                int64_t key = size * 2 + c;
+                entries[key] = c;
+                expected[key] = std::make_pair(Optional<int64_t>{}, Optional<int64_t>{c});
+                ctr->upsert_key(key, c);
+            }
+        }
+
+        this->check("Store structure checking", MMA_SRC);
+
+        assert_changes_equal(expected, diff(ctr, old_ctr));
+
+        // The reverse diff swaps old and new values
+        Changes reverse;
+        for (const auto& entry: expected) {
+            reverse[entry.first] = std::make_pair(entry.second.second, entry.second.first);
+        }
+
+        assert_changes_equal(reverse, diff(old_ctr, ctr));
+
+        commit();
+    }
+};
+
+}}
@@ -0,0 +1,212 @@
+// Copyright 2026 Victor Smirnov
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include "../prototype/bt/bt_test_base.hpp"
+
+#include <memoria/tests/assertions.hpp>
+
+#include <memoria/api/map/map_api.hpp>
+
+#include <map>
+
+namespace memoria {
+namespace tests {
+
+template <
+    typename ProfileT = CoreApiProfile,
+    typename StoreT   = IMemoryStorePtr<ProfileT>
+>
+class MapFingerTest: public BTTestBase<Map<BigInt, BigInt>, ProfileT, StoreT>
+{
+    using MyType = MapFingerTest;
+    using Base   = BTTestBase<Map<BigInt, BigInt>, ProfileT, StoreT>;
+
+    using Base::branch;
+    using Base::commit;
+    using Base::out;
+    using Base::getRandom;
+
+    int64_t size = 100000;
+
+public:
+    MapFingerTest()
+    {
+    }
+
+    MMA_STATE_FILEDS(size)
+
+    static void init_suite(TestSuite& suite) {
+        MMA_CLASS_TESTS(suite, testOrdered, testRandom);
+    }
+
+    template <typename CtrT>
+    void assert_map_equals(const std::map<int64_t, int64_t>& entries, CtrT& ctr)
+    {
+        assert_equals(entries.size(), ctr->size());
+
+        auto ii = entries.begin();
+        ctr->for_each([&](auto key, auto value){
+            assert_equals(ii->first, key);
+            assert_equals(ii->second, value);
+            ++ii;
+        });
+    }
+
+    // Time-ordered inserts with lookups of recent keys,
+    // then removal in the same order.
+    void testOrdered()
+    {
+        auto snp = branch();
+        auto ctr = create<Map<BigInt, BigInt>>(snp, Map<BigInt, BigInt>{});
+        ctr->set_finger_enabled(true);
+
+        std::map<int64_t, int64_t> entries;
+        for (int64_t c = 0; c < size; c++)
+        {
+            int64_t key = c * 2;
+            entries[key] = c;
+            assert_equals(false, ctr->upsert_key(key, c));
+
+            int64_t recent = key - getRandom(std::min<int64_t>(key + 1, 1000)) / 2 * 2;
+            auto ii = ctr->find(recent);
+            assert_equals(true, ii->is_found(recent));
+            assert_equals(entries[recent], ii->current_value());
+        }
+
+        this->check("Store structure checking", MMA_SRC);
+        assert_map_equals(entries, ctr);
+
+        // Close keys: most descents start from the finger's leaf
+        // or its parent, not from the root.
+        assert_finger_pays_off(ctr->finger_stat(), static_cast<uint64_t>(size) * 2);
+
+        // Sorted merge into the existing keys
+        for (int64_t c = 0; c < size; c += 3)
+        {
+            int64_t key = c * 2 + 1;
+            entries[key] = c;
+            ctr->upsert_key(key, c);
+        }
+
+        this->check("Store structure checking", MMA_SRC);
+        assert_map_equals(entries, ctr);
+
+        commit();
+
+        // The finger is per container instance, and the first
+        // updates in a new snapshot clone the path.
+        snp = branch();
+        ctr = find<Map<BigInt, BigInt>>(snp, ctr->name());
+        ctr->set_finger_enabled(true);
+
+        for (int64_t c = 0; c < size; c++)
+        {
+            int64_t key = c * 2;
+            entries.erase(key);
+            assert_equals(true, ctr->remove_key(key));
+        }
+
+        this->check("Store structure checking", MMA_SRC);
+        assert_map_equals(entries, ctr);
+
+        assert_finger_pays_off(ctr->finger_stat(), static_cast<uint64_t>(size));
+
+        commit();
+    }
+
+    // Random point operations mixed with range removals,
+    // which bypass the finger and must reset it.
+    void testRandom()
+    {
+        auto snp = branch();
+        auto ctr = create<Map<BigInt, BigInt>>(snp, Map<BigInt, BigInt>{});
+        ctr->set_finger_enabled(true);
+
+        std::map<int64_t, int64_t> entries;
+        int64_t cursor = 0;
+
+        for (int64_t c = 0; c < size; c++)
+        {
+            // Random walk over the key space: most operations
+            // land close to the previous one.
+            cursor = std::max<int64_t>(0, cursor + getRandom(200) - 90);
+            int64_t key = getRandom(10) == 0 ? getRandom(size * 10) : cursor;
+
+            int32_t op = getRandom(10);
+            if (op < 6)
+            {
+                bool exists = entries.find(key) != entries.end();
+                entries[key] = c;
+                assert_equals(exists, ctr->upsert_key(key, c));
+            }
+            else if (op < 9)
+            {
+                bool exists = entries.erase(key) > 0;
+                assert_equals(exists, ctr->remove_key(key));
+            }
+            else {
+                auto ii = ctr->find(key);
+                auto jj = entries.find(key);
+
+                assert_equals(jj != entries.end(), ii->is_found(key));
+                if (jj != entries.end()) {
+                    assert_equals(jj->second, ii->current_value());
+                }
+            }
+
+            if (c % 10000 == 0 && entries.size() > 100)
+            {
+                int64_t from = getRandom(entries.size() - 50);
+                ctr->remove(from, from + 50);
+
+                auto ii = entries.begin();
+                std::advance(ii, from);
+                auto jj = ii;
+                std::advance(jj, 50);
+                entries.erase(ii, jj);
+
+                this->check("Store structure checking", MMA_SRC);
+            }
+        }
+
+        this->check("Store structure checking", MMA_SRC);
+        assert_map_equals(entries, ctr);
+
+        // Range removals and far jumps miss, but the
+        // random walk still hits the finger.
+        FingerStat stat = ctr->finger_stat();
+        assert_equals(static_cast<uint64_t>(size), stat.descents);
+        assert_gt(stat.hits, 0ull);
+        assert_lt(stat.levels, stat.full_levels);
+
+        commit();
+    }
+
+    void assert_finger_pays_off(const FingerStat& stat, uint64_t descents)
+    {
+        out() << "Finger: " << stat.hits << " hits of " << stat.descents
+              << " descents, levels: " << stat.levels << " of " << stat.full_levels << std::endl;
+
+        // Most descents hit, and on average they skip
+        // at least half a level each.
+        assert_equals(descents, stat.descents);
+        assert_gt(stat.hits * 2, stat.descents);
+        assert_ge(stat.full_levels, stat.levels + stat.descents / 2);
+    }
+};
+
+}}
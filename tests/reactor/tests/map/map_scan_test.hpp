@@ -0,0 +1,202 @@
+// Copyright 2026 Victor Smirnov
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include "../prototype/bt/bt_test_base.hpp"
+
+#include <memoria/tests/assertions.hpp>
+
+#include <memoria/api/map/map_api.hpp>
+#include <memoria/api/common/ctr_scan_hrpc.hpp>
+
+#include <vector>
+#include <map>
+
+namespace memoria {
+namespace tests {
+
+template <
+    typename ProfileT = CoreApiProfile,
+    typename StoreT   = IMemoryStorePtr<ProfileT>
+>
+class MapScanTest: public BTTestBase<Map<BigInt, BigInt>, ProfileT, StoreT>
+{
+    using MyType = MapScanTest;
+    using Base   = BTTestBase<Map<BigInt, BigInt>, ProfileT, StoreT>;
+
+    using Base::branch;
+    using Base::commit;
+    using Base::out;
+    using Base::getRandom;
+
+    int64_t size = 100000;
+
+public:
+    MapScanTest()
+    {
+    }
+
+    MMA_STATE_FILEDS(size)
+
+    static void init_suite(TestSuite& suite) {
+        MMA_CLASS_TESTS(suite, testKernels, testScan);
+    }
+
+    void testKernels()
+    {
+        std::vector<int64_t> data;
+        for (int64_t c = 0; c < 1000; c++) {
+            data.push_back(getRandom(2000) - 1000);
+        }
+
+        Span<const int64_t> column(data.data(), data.size());
+
+        scan::SelectionVector sel;
+        scan::select(column, 100, 900, scan::GreaterEq<int64_t>{0}, sel);
+
+        std::vector<uint32_t> expected;
+        for (size_t c = 100; c < 900; c++) {
+            if (data[c] >= 0) {
+                expected.push_back(c);
+            }
+        }
+
+        assert_equals(expected.size(), sel.size());
+        for (size_t c = 0; c < expected.size(); c++) {
+            assert_equals(expected[c], sel[c]);
+        }
+
+        scan::refine(column, scan::Less<int64_t>{500}, sel);
+
+        scan::Aggregate<int64_t> ref;
+        for (uint32_t row: expected)
+        {
+            int64_t vv = data[row];
+            if (vv < 500) {
+                ref.count++;
+                ref.sum += vv;
+                ref.min = std::min(ref.min, vv);
+                ref.max = std::max(ref.max, vv);
+            }
+        }
+
+        scan::Aggregate<int64_t> agg;
+        agg.add(column, sel);
+
+        assert_equals(ref.count, agg.count);
+        assert_equals(ref.sum, agg.sum);
+        assert_equals(ref.min, agg.min);
+        assert_equals(ref.max, agg.max);
+        assert_equals(ref.sum, scan::sum(column, sel));
+        assert_equals(ref.count, scan::count(column, 100, 900, scan::Between<int64_t>{0, 500}));
+    }
+
+    void testScan()
+    {
+        auto snp = branch();
+        auto ctr = create<Map<BigInt, BigInt>>(snp, Map<BigInt, BigInt>{});
+
+        std::map<int64_t, int64_t> entries;
+        for (int64_t c = 0; c < size; c++)
+        {
+            int64_t key = c * 3;
+            int64_t value = getRandom(1000000);
+
+            entries[key] = value;
+            ctr->upsert_key(key, value);
+        }
+
+        out() << "Size: " << ctr->size() << std::endl;
+
+        for (int c = 0; c < 100; c++)
+        {
+            int64_t from = getRandom(size * 3);
+            int64_t to = from + getRandom(size * 3 - from + 10);
+
+            scan::Aggregate<int64_t> ref;
+            for (auto ii = entries.lower_bound(from); ii != entries.end() && ii->first < to; ++ii) {
+                ref.count++;
+                ref.sum += ii->second;
+                ref.min = std::min(ref.min, ii->second);
+                ref.max = std::max(ref.max, ii->second);
+            }
+
+            auto agg = scan::map_range_aggregate(*ctr, from, to, scan::values);
+
+            assert_equals(ref.count, agg.count);
+            assert_equals(ref.sum, agg.sum);
+            assert_equals(ref.min, agg.min);
+            assert_equals(ref.max, agg.max);
+
+            // The same scan through the HRPC endpoint's handler
+            auto rq = hrpc::Request::make();
+            rq.set_parameter(scan::SCAN_FROM, from);
+            rq.set_parameter(scan::SCAN_TO, to);
+
+            auto rs_agg = scan::aggregate_from_hermes<int64_t>(scan::map_range_scan(*ctr, rq).result());
+
+            assert_equals(ref.count, rs_agg.count);
+            assert_equals(ref.sum, rs_agg.sum);
+            if (!ref.empty()) {
+                assert_equals(ref.min, rs_agg.min);
+                assert_equals(ref.max, rs_agg.max);
+            }
+        }
+
+        for (int c = 0; c < 10; c++)
+        {
+            int64_t threshold = getRandom(1000000);
+            int64_t start = getRandom(size);
+            int64_t limit = getRandom(size - start + 10);
+
+            scan::Aggregate<int64_t> ref;
+            uint64_t ref_cnt{};
+            auto ii = entries.begin();
+            std::advance(ii, start);
+            for (int64_t d = 0; d < limit && ii != entries.end(); d++, ++ii)
+            {
+                if (ii->second >= threshold) {
+                    ref.count++;
+                    ref.sum += ii->first;
+                    ref.min = std::min(ref.min, ii->first);
+                    ref.max = std::max(ref.max, ii->first);
+                    ref_cnt++;
+                }
+            }
+
+            auto agg = scan::filter_aggregate(
+                ctr->seek_entry(start), limit,
+                scan::values, scan::GreaterEq<int64_t>{threshold},
+                scan::keys
+            );
+
+            assert_equals(ref.count, agg.count);
+            assert_equals(ref.sum, agg.sum);
+            assert_equals(ref.min, agg.min);
+            assert_equals(ref.max, agg.max);
+
+            uint64_t cnt = scan::filter_count(
+                ctr->seek_entry(start), limit,
+                scan::values, scan::GreaterEq<int64_t>{threshold}
+            );
+            assert_equals(ref_cnt, cnt);
+        }
+
+        commit();
+    }
+};
+
+}}
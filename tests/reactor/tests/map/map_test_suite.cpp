@@ -15,6 +15,9 @@
 
 
 #include "map_test.hpp"
+#include "map_scan_test.hpp"
+#include "map_finger_test.hpp"
+#include "map_diff_test.hpp"
 
 namespace memoria {
 namespace tests {
@@ -23,6 +26,9 @@ namespace {
 
 auto Suite1 = register_class_suite<MapTest<UID256, UID256, UID256, UID256>>("Map.UID256");
 auto Suite2 = register_class_suite<MapTest<Varchar, Varchar, U8String, U8String>>("Map.Varchar");
+auto Suite3 = register_class_suite<MapScanTest<>>("Map.Scan");
+auto Suite4 = register_class_suite<MapFingerTest<>>("Map.Finger");
+auto Suite5 = register_class_suite<MapDiffTest<>>("Map.Diff");
 
 }
 
@@ -0,0 +1,131 @@
+// Copyright 2026 Victor Smirnov
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include "../prototype/bt/bt_test_base.hpp"
+
+#include <memoria/tests/assertions.hpp>
+
+#include <memoria/api/multimap/multimap_api.hpp>
+#include <memoria/api/common/ctr_scan.hpp>
+
+#include <vector>
+
+namespace memoria {
+namespace tests {
+
+template <
+    typename ProfileT = CoreApiProfile,
+    typename StoreT   = IMemoryStorePtr<ProfileT>
+>
+class MultimapScanTest: public BTTestBase<Multimap<BigInt, UTinyInt>, ProfileT, StoreT>
+{
+    using MyType = MultimapScanTest;
+    using Base   = BTTestBase<Multimap<BigInt, UTinyInt>, ProfileT, StoreT>;
+
+    using CtrType = Multimap<BigInt, UTinyInt>;
+
+    using Base::branch;
+    using Base::commit;
+    using Base::out;
+    using Base::getRandom;
+
+    int64_t entries = 1024;
+    int64_t mean_entry_size = 1024;
+
+public:
+    MultimapScanTest()
+    {
+    }
+
+    MMA_STATE_FILEDS(entries, mean_entry_size)
+
+    static void init_suite(TestSuite& suite) {
+        MMA_CLASS_TESTS(suite, testValuesScan);
+    }
+
+    void testValuesScan()
+    {
+        auto snp = branch();
+        auto ctr = create<CtrType>(snp, CtrType{});
+
+        // Even keys only, odd keys are missing. Large entries
+        // span many leaves.
+        std::vector<std::vector<uint8_t>> data;
+        for (int64_t c = 0; c < entries; c++)
+        {
+            std::vector<uint8_t> values;
+            size_t entry_size = getRandom(mean_entry_size * 2);
+            for (size_t v = 0; v < entry_size; v++) {
+                values.push_back(getRandom(256));
+            }
+
+            data.push_back(std::move(values));
+        }
+
+        size_t pos{};
+        ctr->append_entries([&](auto& buff) {
+            size_t limit = std::min<size_t>(data.size() - pos, 256);
+            for (size_t c = 0; c < limit; c++)
+            {
+                buff.symbols().append_run(0, 1);
+                buff.keys().append((pos + c) * 2);
+
+                buff.symbols().append_run(1, data[pos + c].size());
+                buff.values().append(data[pos + c]);
+            }
+
+            pos += limit;
+            return pos >= data.size();
+        });
+
+        assert_equals(entries, ctr->size());
+
+        for (int c = 0; c < 100; c++)
+        {
+            int64_t key = getRandom(entries);
+            uint8_t threshold = getRandom(256);
+
+            scan::Aggregate<uint8_t> ref;
+            for (uint8_t vv: data[key])
+            {
+                if (vv >= threshold) {
+                    ref.count++;
+                    ref.sum += vv;
+                    ref.min = std::min(ref.min, vv);
+                    ref.max = std::max(ref.max, vv);
+                }
+            }
+
+            auto agg = scan::multimap_values_aggregate(*ctr, key * 2, scan::GreaterEq<uint8_t>{threshold});
+
+            assert_equals(ref.count, agg.count);
+            assert_equals(ref.sum, agg.sum);
+            assert_equals(ref.min, agg.min);
+            assert_equals(ref.max, agg.max);
+
+            auto all = scan::multimap_values_aggregate(*ctr, key * 2, scan::AcceptAll<uint8_t>{});
+            assert_equals(data[key].size(), all.count);
+
+            auto missing = scan::multimap_values_aggregate(*ctr, key * 2 + 1, scan::AcceptAll<uint8_t>{});
+            assert_equals(true, missing.empty());
+        }
+
+        commit();
+    }
+};
+
+}}
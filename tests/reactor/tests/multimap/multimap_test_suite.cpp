@@ -17,6 +17,7 @@
 
 
 #include "multimap_test.hpp"
+#include "multimap_scan_test.hpp"
 
 #include <vector>
 
@@ -25,6 +26,7 @@ namespace tests {
 namespace {
 
 auto Suite3 = register_class_suite<MultimapTest<UUID, UTinyInt>>("Multimap.UUID.UTinyInt");
+auto Suite4 = register_class_suite<MultimapScanTest<>>("Multimap.Scan");
 
 
 
@@ -0,0 +1,245 @@
+// Copyright 2026 Victor Smirnov
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memoria/tests/tests.hpp>
+#include <memoria/tests/assertions.hpp>
+
+#include <memoria/core/packed/datatype_buffer/packed_prefix_coded_buffer.hpp>
+#include <memoria/core/packed/tools/packed_struct_ptrs.hpp>
+
+#include <memoria/core/strings/format.hpp>
+
+#include <vector>
+#include <algorithm>
+
+namespace memoria {
+namespace tests {
+
+class PackedPrefixBufferTest: public TestState {
+    using MyType = PackedPrefixBufferTest;
+    using Base   = TestState;
+
+    using Buffer    = PackedPrefixCodedBuffer;
+    using BufferPtr = PkdStructSPtr<Buffer>;
+    using ViewType  = typename Buffer::ViewType;
+
+    static constexpr size_t MEMBUF_SIZE = 1024*1024*4;
+
+    int64_t size_{10000};
+
+public:
+    using Base::getRandom;
+    using Base::out;
+
+    MMA_STATE_FILEDS(size_);
+
+    static void init_suite(TestSuite& suite)
+    {
+        MMA_CLASS_TESTS(suite, testAppend, testInsertRemove, testSplitMerge, testRestartIntervals);
+    }
+
+    void testAppend()
+    {
+        auto buf = create_buffer();
+        auto keys = create_keys(size_);
+
+        append(buf.get(), keys);
+
+        buf->check();
+        assert_equal(buf.get(), keys);
+        assert_find(buf.get(), keys);
+
+        size_t plain_size = (keys.size() + 1) * sizeof(psize_t);
+        for (auto& key: keys) {
+            plain_size += key.size();
+        }
+
+        out() << "Plain: " << plain_size << ", prefix coded: " << buf->data_size() << std::endl;
+        assert_lt(buf->data_size(), plain_size / 2);
+    }
+
+    void testInsertRemove()
+    {
+        auto buf = create_buffer();
+        auto keys = create_keys(size_ / 10);
+
+        std::vector<U8String> inserted;
+
+        for (auto& key: keys)
+        {
+            auto ii = std::lower_bound(inserted.begin(), inserted.end(), key);
+            size_t idx = ii - inserted.begin();
+
+            inserted.insert(ii, key);
+            buf->insert(idx, as_view(key));
+        }
+
+        buf->check();
+        assert_equal(buf.get(), inserted);
+
+        while (inserted.size() > 0)
+        {
+            size_t start = getRandom(inserted.size());
+            size_t end = std::min(inserted.size(), start + getRandom(32) + 1);
+
+            inserted.erase(inserted.begin() + start, inserted.begin() + end);
+            buf->remove(start, end);
+
+            buf->check();
+            assert_equal(buf.get(), inserted);
+        }
+
+        assert_equals(0ull, (unsigned long long)buf->data_size());
+    }
+
+    void testSplitMerge()
+    {
+        auto keys = create_keys(size_ / 10);
+
+        for (size_t split_at: {size_t(0), size_t(1), size_t(15), size_t(16), size_t(17), keys.size() / 2, keys.size()})
+        {
+            auto buf = create_buffer();
+            auto other = create_buffer();
+
+            append(buf.get(), keys);
+
+            buf->split_to(other.get(), split_at);
+
+            buf->check();
+            other->check();
+
+            std::vector<U8String> left(keys.begin(), keys.begin() + split_at);
+            std::vector<U8String> right(keys.begin() + split_at, keys.end());
+
+            assert_equal(buf.get(), left);
+            assert_equal(other.get(), right);
+
+            other->merge_with(buf.get());
+            buf->check();
+
+            std::vector<U8String> merged = left;
+            merged.insert(merged.end(), right.begin(), right.end());
+
+            assert_equal(buf.get(), merged);
+        }
+    }
+
+    void testRestartIntervals()
+    {
+        auto keys = create_keys(size_ / 10);
+
+        for (size_t interval: {1, 2, 7, 64})
+        {
+            auto buf = create_buffer();
+            buf->set_restart_interval(interval);
+
+            append(buf.get(), keys);
+
+            buf->check();
+            assert_equals(interval, buf->restart_interval());
+            assert_equals((keys.size() + interval - 1) / interval, buf->restarts());
+
+            assert_equal(buf.get(), keys);
+            assert_find(buf.get(), keys);
+        }
+    }
+
+private:
+    BufferPtr create_buffer() {
+        return MakeSharedPackedStructByBlock<Buffer>(MEMBUF_SIZE);
+    }
+
+    static ViewType as_view(const U8String& str) {
+        return ViewType(ptr_cast<const uint8_t>(str.data()), str.size());
+    }
+
+    static U8String as_string(ViewType view) {
+        return U8String(ptr_cast<const char>(view.data()), view.size());
+    }
+
+    std::vector<U8String> create_keys(size_t size)
+    {
+        const char* roots[] = {"/usr/share/doc/", "/var/lib/memoria/data/", "/home/user/projects/"};
+
+        std::vector<U8String> keys;
+        for (size_t c = 0; c < size; c++)
+        {
+            keys.push_back(format_u8(
+                "{}{:04}/{:06}/item-{}",
+                roots[getRandom(3)],
+                getRandom(50),
+                getRandom(100000),
+                getRandom(1000)
+            ));
+        }
+
+        std::sort(keys.begin(), keys.end());
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+        return keys;
+    }
+
+    void append(Buffer* buf, const std::vector<U8String>& keys)
+    {
+        std::vector<ViewType> views;
+        for (auto& key: keys) {
+            views.push_back(as_view(key));
+        }
+
+        size_t expected = buf->block_size_for_insert(buf->size(), Span<const ViewType>(views.data(), views.size()));
+
+        buf->append(Span<const ViewType>(views.data(), views.size()));
+
+        assert_equals(expected, Buffer::base_size(buf->restarts(), buf->data_size()));
+    }
+
+    void assert_equal(const Buffer* buf, const std::vector<U8String>& keys)
+    {
+        assert_equals(keys.size(), buf->size());
+
+        buf->for_each([&](size_t idx, ViewType value){
+            assert_equals(keys[idx], as_string(value));
+        });
+
+        ArenaBuffer<uint8_t> value;
+        for (size_t c = 0; c < keys.size(); c += 1 + getRandom(10))
+        {
+            buf->access(c, value);
+            assert_equals(keys[c], as_string(value.span()));
+        }
+    }
+
+    void assert_find(const Buffer* buf, const std::vector<U8String>& keys)
+    {
+        for (size_t c = 0; c < keys.size(); c++)
+        {
+            assert_equals(c, buf->find_ge(as_view(keys[c])));
+            assert_equals(true, buf->contains(as_view(keys[c])));
+
+            U8String probe = keys[c] + "!";
+            size_t expected = std::upper_bound(keys.begin(), keys.end(), probe) - keys.begin();
+            assert_equals(expected, buf->find_ge(as_view(probe)));
+        }
+
+        assert_equals(0ull, (unsigned long long)buf->find_ge(as_view("")));
+        assert_equals(keys.size(), buf->find_ge(as_view("~")));
+    }
+};
+
+#define MMA_PREFIX_BUFFER_SUITE() \
+MMA_CLASS_SUITE(PackedPrefixBufferTest, "PackedPrefixBufferSuite")
+
+}}
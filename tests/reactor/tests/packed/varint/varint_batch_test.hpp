@@ -0,0 +1,205 @@
+// Copyright 2026 Victor Smirnov
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memoria/tests/tests.hpp>
+#include <memoria/tests/assertions.hpp>
+
+#include <memoria/core/tools/varint_batch.hpp>
+#include <memoria/core/tools/i7_codec.hpp>
+#include <memoria/core/tools/exint_codec.hpp>
+#include <memoria/core/tools/u64i_56_vlen.hpp>
+#include <memoria/core/bignum/int64_codec.hpp>
+#include <memoria/core/bignum/uint64_codec.hpp>
+
+#include <vector>
+
+namespace memoria {
+namespace tests {
+
+// Batch codecs must produce exactly the same bytes as per-value
+// calls, with every kernel set the CPU supports.
+class VarintBatchTest: public TestState {
+    using MyType = VarintBatchTest;
+    using Base   = TestState;
+
+    int64_t size_{10000};
+
+public:
+    using Base::getRandom;
+    using Base::getBIRandom;
+    using Base::out;
+
+    MMA_STATE_FILEDS(size_);
+
+    static void init_suite(TestSuite& suite)
+    {
+        MMA_CLASS_TESTS(suite, testI7, testExint, testUInt64Codec, testInt64Codec, testU64_56);
+    }
+
+    void testI7()
+    {
+        for_each_isa([&]{
+            for_each_values<uint64_t>(1ull << 62, [&](const std::vector<uint64_t>& values){
+                check_codec(values, I7Codec<uint8_t, uint64_t>());
+            });
+
+            for_each_values<int64_t>(1ll << 40, [&](const std::vector<int64_t>& values){
+                check_codec(values, I7Codec<uint8_t, int64_t>());
+            });
+        });
+    }
+
+    void testExint()
+    {
+        for_each_isa([&]{
+            for_each_values<uint64_t>(1ull << 62, [&](const std::vector<uint64_t>& values){
+                check_codec(values, ExintCodec<uint8_t, uint64_t>());
+            });
+        });
+    }
+
+    void testUInt64Codec()
+    {
+        for_each_isa([&]{
+            // The codec's header covers values up to 7 bytes long
+            for_each_values<uint64_t>(1ull << 55, [&](const std::vector<uint64_t>& values){
+                check_codec(values, ValueCodec<uint64_t>());
+            });
+        });
+    }
+
+    void testInt64Codec()
+    {
+        for_each_isa([&]{
+            for_each_values<int64_t>(1ll << 62, [&](std::vector<int64_t> values){
+                for (size_t c = 0; c < values.size(); c += 3) {
+                    values[c] = -values[c];
+                }
+                check_codec(values, ValueCodec<int64_t>());
+            });
+        });
+    }
+
+    void testU64_56()
+    {
+        for_each_isa([&]{
+            for_each_values<uint64_t>(1ll << 55, [&](const std::vector<uint64_t>& values){
+                std::vector<uint8_t> expected(values.size() * 9);
+                size_t length{};
+                for (uint64_t value: values) {
+                    length += encode_u64_56_vlen(expected.data() + length, value);
+                }
+
+                std::vector<uint8_t> buffer(length);
+                assert_equals(length, encode_u64_56_vlen_n(buffer.data(), values.data(), values.size()));
+                assert_bytes(expected, buffer, length);
+
+                std::vector<uint64_t> decoded(values.size());
+                assert_equals(length, decode_u64_56_vlen_n(buffer.data(), decoded.data(), decoded.size()));
+                assert_values(values, decoded);
+            });
+        });
+    }
+
+private:
+    template <typename Fn>
+    void for_each_isa(Fn&& fn)
+    {
+        for (auto isa: {VarintBatchISA::SCALAR, VarintBatchISA::SSE42, VarintBatchISA::AVX2})
+        {
+            if (set_varint_batch_isa(isa) == isa) {
+                fn();
+            }
+        }
+
+        set_varint_batch_isa(VarintBatchISA::AVX2);
+    }
+
+    // Small values only, a mix, long values only, and runs of small
+    // values with long ones at chunk boundaries.
+    template <typename V, typename Fn>
+    void for_each_values(V max, Fn&& fn)
+    {
+        std::vector<V> values(size_);
+
+        for (auto& value: values) {
+            value = getRandom(100);
+        }
+        fn(values);
+
+        for (auto& value: values) {
+            value = getRandom(4) ? getRandom(256) : getBIRandom(max);
+        }
+        fn(values);
+
+        for (auto& value: values) {
+            value = max - getBIRandom(max / 2);
+        }
+        fn(values);
+
+        for (size_t step: {7, 8, 15, 16, 17, 31, 32, 33})
+        {
+            for (size_t c = 0; c < values.size(); c++) {
+                values[c] = c % step == step - 1 ? max - c : c % 64;
+            }
+            fn(values);
+
+            // Short batches, tails only
+            fn(std::vector<V>(values.begin(), values.begin() + step));
+        }
+    }
+
+    template <typename V, typename Codec>
+    void check_codec(const std::vector<V>& values, const Codec& codec)
+    {
+        std::vector<uint8_t> expected(values.size() * 10);
+        size_t length{};
+        for (const V& value: values) {
+            length += codec.encode(expected.data(), value, length);
+        }
+
+        // Encoding at an offset, with the exact room for the batch
+        size_t offset = 3;
+        std::vector<uint8_t> buffer(offset + length);
+        assert_equals(length, codec.encode_n(buffer.data(), values.data(), values.size(), offset));
+        assert_bytes(expected, std::vector<uint8_t>(buffer.begin() + offset, buffer.end()), length);
+
+        std::vector<V> decoded(values.size());
+        assert_equals(length, codec.decode_n(buffer.data(), decoded.data(), decoded.size(), offset));
+        assert_values(values, decoded);
+    }
+
+    void assert_bytes(const std::vector<uint8_t>& expected, const std::vector<uint8_t>& actual, size_t length)
+    {
+        for (size_t c = 0; c < length; c++) {
+            assert_equals((int32_t)expected[c], (int32_t)actual[c], "At {}", c);
+        }
+    }
+
+    template <typename V>
+    void assert_values(const std::vector<V>& expected, const std::vector<V>& actual)
+    {
+        assert_equals(expected.size(), actual.size());
+        for (size_t c = 0; c < expected.size(); c++) {
+            assert_equals(expected[c], actual[c], "At {}", c);
+        }
+    }
+};
+
+#define MMA_VARINT_BATCH_SUITE() \
+MMA_CLASS_SUITE(VarintBatchTest, "VarintBatchSuite")
+
+}}
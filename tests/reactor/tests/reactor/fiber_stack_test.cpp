@@ -0,0 +1,107 @@
+
+// Copyright 2026 Victor Smirnov
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memoria/tests/tests.hpp>
+#include <memoria/tests/assertions.hpp>
+
+#include <memoria/reactor/reactor.hpp>
+
+#include <vector>
+
+namespace memoria {
+namespace tests {
+
+using namespace memoria::reactor;
+
+namespace {
+
+__attribute__((noinline)) int32_t use_stack(int32_t depth)
+{
+    volatile uint8_t frame[1024];
+    frame[0] = depth;
+
+    if (depth > 0) {
+        return use_stack(depth - 1) + frame[0];
+    }
+
+    return frame[0];
+}
+
+}
+
+struct FiberStackTestState: TestState {
+    using Base = TestState;
+
+    size_t fibers{256};
+};
+
+auto fiber_stack_test = register_test_in_suite<FnTest<FiberStackTestState>>("ReactorSuite", "FiberStackTest", [](auto& state){
+    auto& stacks = engine().fiber_stacks();
+
+    bool probe = stacks.probe();
+    stacks.set_probe(true);
+
+    for (auto cls: {FiberStackClass::SMALL, FiberStackClass::MEDIUM, FiberStackClass::LARGE})
+    {
+        auto stats0 = stacks.stats(cls);
+
+        // Roughly a quarter of the stack.
+        int32_t depth = FiberStackPools::stack_size(cls) / 4096;
+
+        std::vector<boost::fibers::fiber> fibers;
+        for (size_t c = 0; c < state.fibers; c++)
+        {
+            fibers.push_back(in_fiber(cls, [=]{
+                use_stack(depth);
+                boost::this_fiber::yield();
+            }));
+        }
+
+        for (auto& ff: fibers) {
+            ff.join();
+        }
+
+        auto stats1 = stacks.stats(cls);
+
+        assert_equals(stats0.allocations + state.fibers, stats1.allocations);
+        assert_equals(stats0.live, stats1.live);
+        assert_ge(stats1.peak_live, state.fibers);
+
+        assert_ge(stats1.watermark, depth * 1024ull);
+        assert_lt(stats1.watermark, FiberStackPools::stack_size(cls));
+
+        engine().println(
+            "{}: stack size {}, watermark {}, pooled {}",
+            FiberStackPools::name(cls), stats1.stack_size, stats1.watermark, stats1.pooled
+        );
+    }
+
+    stacks.trim();
+
+    for (auto cls: {FiberStackClass::SMALL, FiberStackClass::MEDIUM, FiberStackClass::LARGE})
+    {
+        auto stats = stacks.stats(cls);
+        assert_le(stats.trimmed, stats.pooled);
+    }
+
+    assert_equals(FiberStackClass::SMALL == FiberStackPools::for_size(1), true);
+    assert_equals(FiberStackClass::MEDIUM == FiberStackPools::for_size(100 * 1024), true);
+    assert_equals(FiberStackClass::DEFAULT == FiberStackPools::for_size(0), true);
+    assert_equals(FiberStackClass::DEFAULT == FiberStackPools::for_size(64 * 1024 * 1024), true);
+
+    stacks.set_probe(probe);
+});
+
+}}
@@ -0,0 +1,116 @@
+// Copyright 2026 Victor Smirnov
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memoria/tests/tests.hpp>
+#include <memoria/tests/assertions.hpp>
+
+#include <memoria/reactor/reactor.hpp>
+
+#include <vector>
+
+namespace memoria {
+namespace tests {
+
+using namespace memoria::reactor;
+
+namespace {
+
+uint64_t total_messages(const std::vector<ReactorMetricsSnapshot>& snps)
+{
+    uint64_t sum{};
+    for (const auto& snp: snps) {
+        sum += snp.messages;
+    }
+    return sum;
+}
+
+uint64_t total_queue_delays(const std::vector<ReactorMetricsSnapshot>& snps)
+{
+    uint64_t sum{};
+    for (const auto& snp: snps) {
+        sum += snp.queue_delay.count;
+    }
+    return sum;
+}
+
+}
+
+auto latency_histogram_test = register_test_in_suite<FnTest<TestState>>("ReactorSuite", "LatencyHistogramTest", [](auto& state){
+    LatencyHistogram histogram;
+
+    for (uint64_t c = 1; c <= 100000; c++) {
+        histogram.record(c);
+    }
+
+    auto snp = histogram.snapshot();
+
+    assert_equals(100000ull, snp.count);
+    assert_equals(100000ull, snp.max);
+    assert_equals(5000050000ull, snp.sum);
+
+    // Relative error is below 1/16
+    for (double p: {0.5, 0.9, 0.99, 0.999})
+    {
+        uint64_t expected = static_cast<uint64_t>(p * 100000);
+        uint64_t actual = snp.percentile(p);
+
+        assert_ge(actual, expected);
+        assert_le(actual, expected + expected / 16);
+    }
+
+    assert_equals(100000ull, snp.percentile(1.0));
+
+    // Small values are exact
+    for (uint64_t c = 0; c < LatencyHistogram::SUB_BUCKETS; c++) {
+        assert_equals(c, LatencyHistogram::bucket_upper_bound(LatencyHistogram::bucket_of(c)));
+    }
+
+    auto merged = snp;
+    merged.merge(snp);
+
+    assert_equals(200000ull, merged.count);
+    assert_equals(snp.percentile(0.5), merged.percentile(0.5));
+});
+
+auto reactor_metrics_test = register_test_in_suite<FnTest<TestState>>("ReactorSuite", "ReactorMetricsTest", [](auto& state){
+    auto snps0 = collect_reactor_metrics();
+    assert_equals(static_cast<size_t>(engine().cpu_num()), snps0.size());
+
+    uint64_t fibers0 = engine().metrics().fibers_started.value();
+
+    size_t calls = 100;
+    for (size_t c = 0; c < calls; c++)
+    {
+        int cpu = static_cast<int>(c % engine().cpu_num());
+        assert_equals(cpu, engine().run_at(cpu, [&]{
+            return engine().cpu();
+        }));
+    }
+
+    in_fiber([]{
+        boost::this_fiber::yield();
+    }).join();
+
+    auto snps1 = collect_reactor_metrics();
+
+    assert_ge(total_messages(snps1) - total_messages(snps0), calls);
+    assert_ge(total_queue_delays(snps1) - total_queue_delays(snps0), calls);
+    assert_gt(engine().metrics().fibers_started.value(), fibers0);
+
+    const auto& local = snps1[engine().cpu()];
+    assert_gt(local.poll_iteration.count, 0ull);
+    assert_gt(local.fiber_run_time.count, 0ull);
+});
+
+}}
@@ -0,0 +1,116 @@
+// Copyright 2026 Victor Smirnov
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memoria/tests/tests.hpp>
+#include <memoria/tests/assertions.hpp>
+
+#include <memoria/reactor/reactor.hpp>
+
+#include <chrono>
+#include <vector>
+
+namespace memoria {
+namespace tests {
+
+using namespace memoria::reactor;
+
+namespace {
+
+SchedulingGroup get_or_create_group(const std::string& name, uint32_t shares)
+{
+    auto& registry = SchedulingGroupRegistry::instance();
+    for (size_t c = 0; c < registry.size(); c++)
+    {
+        SchedulingGroup group(static_cast<uint32_t>(c));
+        if (group.name() == name) {
+            return group;
+        }
+    }
+
+    return create_scheduling_group(name, shares);
+}
+
+}
+
+struct SchedulingGroupTestState: TestState {
+    using Base = TestState;
+
+    size_t fibers{2};
+    int64_t duration_ms{300};
+};
+
+auto scheduling_group_test = register_test_in_suite<FnTest<SchedulingGroupTestState>>("ReactorSuite", "SchedulingGroupTest", [](auto& state){
+    auto fg = get_or_create_group("test-fg", 1000);
+    auto bg = get_or_create_group("test-bg", 100);
+
+    auto main_group = engine().current_scheduling_group();
+
+    // Fibers and nested calls inherit the group
+    with_scheduling_group(bg, [&]{
+        assert_equals(bg.id(), engine().current_scheduling_group().id());
+
+        in_fiber([&]{
+            assert_equals(bg.id(), engine().current_scheduling_group().id());
+        }).join();
+    });
+
+    assert_equals(main_group.id(), engine().current_scheduling_group().id());
+
+    auto fg0 = engine().scheduling_group_stats(fg);
+    auto bg0 = engine().scheduling_group_stats(bg);
+
+    bool stop{};
+    std::vector<boost::fibers::fiber> fibers;
+    for (auto group: {fg, bg})
+    {
+        for (size_t c = 0; c < state.fibers; c++)
+        {
+            fibers.push_back(in_fiber(group, [&]{
+                volatile uint64_t acc{};
+                while (!stop)
+                {
+                    for (int i = 0; i < 1000; i++) {
+                        acc = acc * 31 + i;
+                    }
+                    maybe_yield();
+                }
+            }));
+        }
+    }
+
+    auto t0 = std::chrono::steady_clock::now();
+    while (std::chrono::steady_clock::now() - t0 < std::chrono::milliseconds(state.duration_ms)) {
+        boost::this_fiber::yield();
+    }
+
+    stop = true;
+    for (auto& ff: fibers) {
+        ff.join();
+    }
+
+    auto fg1 = engine().scheduling_group_stats(fg);
+    auto bg1 = engine().scheduling_group_stats(bg);
+
+    uint64_t fg_runtime = fg1.runtime_ns - fg0.runtime_ns;
+    uint64_t bg_runtime = bg1.runtime_ns - bg0.runtime_ns;
+
+    engine().println("fg runtime: {} us, bg runtime: {} us", fg_runtime / 1000, bg_runtime / 1000);
+
+    // Shares are 10:1, leave room for noise
+    assert_gt(bg_runtime, 0ull);
+    assert_gt(fg_runtime, bg_runtime * 3);
+    assert_gt(bg1.activations, bg0.activations);
+});
+
+}}
@@ -0,0 +1,164 @@
+// Copyright 2026 Victor Smirnov
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memoria/tests/tests.hpp>
+#include <memoria/tests/assertions.hpp>
+
+#include <memoria/reactor/reactor.hpp>
+#include <memoria/reactor/application.hpp>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace memoria {
+namespace tests {
+
+using namespace memoria::reactor;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Spins for the given time, yielding every slice_us so
+// that a started task may be resumed by another reactor.
+void spin(uint64_t work_us, uint64_t slice_us)
+{
+    auto t0 = Clock::now();
+    auto slice_start = t0;
+
+    volatile uint64_t acc{};
+    while (Clock::now() - t0 < std::chrono::microseconds(work_us))
+    {
+        for (int c = 0; c < 64; c++) {
+            acc = acc * 31 + c;
+        }
+
+        if (Clock::now() - slice_start >= std::chrono::microseconds(slice_us)) {
+            boost::this_fiber::yield();
+            slice_start = Clock::now();
+        }
+    }
+}
+
+}
+
+struct WorkStealingTestState: TestState {
+    using Base = TestState;
+
+    size_t tasks{400};
+    size_t pinned_fibers{4};
+    uint64_t work_us{200};
+    uint64_t slice_us{50};
+
+    int32_t threads() const noexcept override {
+        return 4;
+    }
+
+    bool work_stealing() const noexcept override {
+        return true;
+    }
+};
+
+auto work_stealing_test = register_test_in_suite<FnTest<WorkStealingTestState>>("ReactorSuite", "WorkStealingTest", [](auto& state){
+    int target_cpu = engine().cpu();
+
+    // Pinned fibers on the flooded reactor must stay on its thread
+    bool stop{};
+    size_t moved{};
+    size_t resumes{};
+
+    std::vector<boost::fibers::fiber> pinned;
+    for (size_t c = 0; c < state.pinned_fibers; c++)
+    {
+        pinned.push_back(in_fiber([&]{
+            auto thread_id = std::this_thread::get_id();
+            while (!stop)
+            {
+                boost::this_fiber::yield();
+                resumes++;
+                if (std::this_thread::get_id() != thread_id || engine().cpu() != target_cpu) {
+                    moved++;
+                }
+            }
+        }));
+    }
+
+    std::vector<int64_t> results(state.tasks);
+    std::vector<int> task_cpus(state.tasks, -1);
+    size_t callers_moved{};
+
+    std::vector<boost::fibers::fiber> callers;
+    for (size_t c = 0; c < state.tasks; c++)
+    {
+        callers.push_back(in_fiber(FiberStackClass::SMALL, [&, c]{
+            auto thread_id = std::this_thread::get_id();
+
+            uint64_t work_us  = state.work_us;
+            uint64_t slice_us = state.slice_us;
+
+            task_cpus[c] = engine().run_migratable_at(target_cpu, [&results, c, work_us, slice_us]{
+                spin(work_us, slice_us);
+                results[c] = static_cast<int64_t>(c) * 3;
+                return engine().cpu();
+            });
+
+            if (std::this_thread::get_id() != thread_id) {
+                callers_moved++;
+            }
+        }));
+    }
+
+    for (auto& ff: callers) {
+        ff.join();
+    }
+
+    stop = true;
+    for (auto& ff: pinned) {
+        ff.join();
+    }
+
+    std::vector<size_t> per_cpu(engine().cpu_num());
+    for (size_t c = 0; c < state.tasks; c++)
+    {
+        assert_equals(static_cast<int64_t>(c) * 3, results[c]);
+        assert_ge(task_cpus[c], 0);
+        assert_lt(task_cpus[c], engine().cpu_num());
+        per_cpu[task_cpus[c]]++;
+    }
+
+    size_t cpus_used{};
+    for (size_t c = 0; c < per_cpu.size(); c++)
+    {
+        engine().println("Tasks finished on reactor {}: {}", c, per_cpu[c]);
+        if (per_cpu[c]) {
+            cpus_used++;
+        }
+    }
+
+    assert_gt(resumes, 0ull);
+    assert_equals(0, moved);
+    assert_equals(0, callers_moved);
+
+    // Spreading is only possible if the process has been started with
+    // the state's options, not as a shared worker process.
+    if (app().is_work_stealing() && engine().cpu_num() > 1) {
+        assert_gt(cpus_used, 1ull);
+    }
+    else {
+        engine().println("Work stealing is not enabled, task spreading is not checked");
+    }
+});
+
+}}
@@ -0,0 +1,180 @@
+// Copyright 2026 Victor Smirnov
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memoria/tests/tests.hpp>
+#include <memoria/tests/assertions.hpp>
+
+#include <memoria/core/memory/huge_pages.hpp>
+
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace memoria {
+namespace tests {
+
+// Allocators are local to tests, so that the stats are not
+// affected by stores using the shared instance.
+
+auto huge_page_arena_reuse_test = register_test_in_suite<FnTest<TestState>>("HugePagesSuite", "ArenaReuseTest", [](auto& state){
+    HugePageArenaAllocator allocator;
+
+    void* p1 = allocator.allocate(100);
+    void* p2 = allocator.allocate(128);
+    assert_neq(p1, p2);
+
+    auto stats = allocator.stats();
+    assert_equals(1ull, stats.arenas);
+    assert_equals(256ull, stats.allocated);
+    assert_equals(0ull, stats.free);
+
+    // LIFO free list of the 128-byte class
+    allocator.free(p1);
+    assert_equals(p1, allocator.allocate(120));
+
+    allocator.free(p2);
+    allocator.free(p1);
+
+    stats = allocator.stats();
+    assert_equals(0ull, stats.allocated);
+    assert_equals(256ull, stats.free);
+
+    // Other classes get their own arenas
+    void* p3 = allocator.allocate(4096);
+    assert_equals(2ull, allocator.stats().arenas);
+    allocator.free(p3);
+
+    // Whole arena of one class, the first block is the freed p3.
+    // Then reuse without new arenas.
+    size_t blocks = HugePageArenaAllocator::ARENA_SIZE / 4096;
+    std::vector<void*> ptrs;
+    for (size_t c = 0; c < blocks; c++) {
+        ptrs.push_back(allocator.allocate(4096));
+        std::memset(ptrs.back(), static_cast<int>(c), 4096);
+    }
+
+    assert_equals(p3, ptrs[0]);
+    assert_equals(2ull, allocator.stats().arenas);
+
+    for (size_t c = 0; c < blocks; c++) {
+        assert_equals(static_cast<uint8_t>(c), static_cast<uint8_t*>(ptrs[c])[4095]);
+        allocator.free(ptrs[c]);
+    }
+
+    for (size_t c = 0; c < blocks; c++) {
+        ptrs[c] = allocator.allocate(4096);
+    }
+
+    assert_equals(2ull, allocator.stats().arenas);
+
+    for (void* ptr: ptrs) {
+        allocator.free(ptr);
+    }
+
+    stats = allocator.stats();
+    assert_equals(0ull, stats.allocated);
+    assert_equals(256ull + blocks * 4096, stats.free);
+});
+
+
+auto huge_page_arena_malloc_test = register_test_in_suite<FnTest<TestState>>("HugePagesSuite", "ArenaMallocTest", [](auto& state){
+    HugePageArenaAllocator allocator;
+
+    // Large blocks are malloc'ed and not counted
+    void* large = allocator.allocate(HugePageArenaAllocator::MAX_CLASS_SIZE + 1);
+    std::memset(large, 1, HugePageArenaAllocator::MAX_CLASS_SIZE + 1);
+
+    auto stats = allocator.stats();
+    assert_equals(0ull, stats.arenas);
+    assert_equals(0ull, stats.allocated);
+
+    allocator.free(large);
+
+    // Foreign malloc'ed memory, with and without arenas
+    allocator.free(::malloc(64));
+
+    void* small = allocator.allocate(64);
+    allocator.free(::malloc(64));
+    allocator.free(::malloc(HugePageArenaAllocator::MAX_CLASS_SIZE * 2));
+    allocator.free(nullptr);
+
+    stats = allocator.stats();
+    assert_equals(1ull, stats.arenas);
+    assert_equals(64ull, stats.allocated);
+    assert_equals(0ull, stats.free);
+
+    allocator.free(small);
+    assert_equals(64ull, allocator.stats().free);
+});
+
+
+auto huge_page_arena_threads_test = register_test_in_suite<FnTest<TestState>>("HugePagesSuite", "ArenaThreadsTest", [](auto& state){
+    HugePageArenaAllocator allocator;
+
+    size_t threads = 4;
+    size_t rounds  = 20000;
+
+    std::vector<size_t> errors(threads);
+    std::vector<std::thread> workers;
+
+    for (size_t t = 0; t < threads; t++)
+    {
+        workers.emplace_back([&, t]{
+            std::vector<std::pair<uint8_t*, size_t>> live;
+
+            for (size_t c = 0; c < rounds; c++)
+            {
+                size_t size = size_t(64) << ((c * 7 + t) % 8);
+                if (c % 1000 == 999) {
+                    size = HugePageArenaAllocator::MAX_CLASS_SIZE * 2;
+                }
+
+                uint8_t* ptr = static_cast<uint8_t*>(allocator.allocate(size));
+                std::memset(ptr, static_cast<int>(t + 1), size);
+                live.emplace_back(ptr, size);
+
+                // Free the older half, checking that no one
+                // else has written over the blocks.
+                if (live.size() == 64)
+                {
+                    for (size_t d = 0; d < 32; d++)
+                    {
+                        auto [blk, blk_size] = live[d];
+                        if (blk[0] != t + 1 || blk[blk_size - 1] != t + 1) {
+                            errors[t]++;
+                        }
+                        allocator.free(blk);
+                    }
+                    live.erase(live.begin(), live.begin() + 32);
+                }
+            }
+
+            for (auto [blk, blk_size]: live) {
+                allocator.free(blk);
+            }
+        });
+    }
+
+    for (auto& worker: workers) {
+        worker.join();
+    }
+
+    for (size_t t = 0; t < threads; t++) {
+        assert_equals(0ull, errors[t]);
+    }
+
+    assert_equals(0ull, allocator.stats().allocated);
+});
+
+}}
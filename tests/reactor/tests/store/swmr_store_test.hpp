@@ -19,9 +19,13 @@
 #include "../prototype/bt/bt_test_base.hpp"
 
 #include <memoria/core/tools/random.hpp>
+#include <memoria/store/common/block_codec.hpp>
+#include <memoria/core/tools/cow.hpp>
+#include <memoria/core/tools/uid_64.hpp>
 
 #include "store_tools.hpp"
 
+#include <thread>
 #include <vector>
 
 namespace memoria {
@@ -38,13 +42,100 @@ class SWMRStoreTest: public TestState
 
     size_t size_{1000000};
 
+    using CtrType = Set<Varchar>;
+    using CtrID   = ApiProfileCtrID<CoreApiProfile>;
+
+    // Path of the file in the test's working directory,
+    // the file is removed if it exists.
+    U8String new_store_file(const char* name = "file.mma2") const
+    {
+        auto wd = Base::working_directory_;
+        wd.append(name);
+
+        U8String file = wd.string();
+        boost::filesystem::remove(file.data());
+        return file;
+    }
+
+    CheckResultConsumerFn errors_counter(size_t& errors) const
+    {
+        return [&errors, this](CheckSeverity, const hermes::HermesCtr& doc){
+            out() << doc.to_string() << std::endl;
+            errors++;
+        };
+    }
+
+    template <typename StorePtrT>
+    void assert_store_is_consistent(StorePtrT& store) const
+    {
+        size_t errors{};
+        store->check(errors_counter(errors));
+        assert_equals(0, errors);
+    }
+
+    static U8String random_entry() {
+        return format_u8("Cool String ABCDEFGH :: {}", getBIRandomG());
+    }
+
+    static U8String numbered_entry(size_t series, size_t idx) {
+        return format_u8("Cool String ABCDEFGH :: {} :: {}", series, idx);
+    }
+
+    // Upserts random entries, remembering them in data
+    template <typename CtrPtrT>
+    static void upsert_random(CtrPtrT& ctr, size_t entries, std::vector<U8String>& data)
+    {
+        for (size_t c = 0; c < entries; c++)
+        {
+            U8String str = random_entry();
+            ctr->upsert(str);
+            data.push_back(str);
+        }
+    }
+
+    template <typename CtrPtrT>
+    static void upsert_numbered(CtrPtrT& ctr, size_t series, size_t entries)
+    {
+        for (size_t c = 0; c < entries; c++) {
+            ctr->upsert(numbered_entry(series, c));
+        }
+    }
+
+    // Sorts and deduplicates data, then compares it with the set's content
+    template <typename CtrPtrT>
+    void assert_set_equals(std::vector<U8String>& data, CtrPtrT& ctr) const
+    {
+        std::sort(data.begin(), data.end());
+        data.erase(std::unique(data.begin(), data.end()), data.end());
+
+        assert_equals(data.size(), ctr->size());
+
+        size_t idx{};
+        ctr->for_each([&](auto key){
+            assert_equals(data[idx++], U8String(key));
+        });
+    }
+
+    // IDs of the container's leaves in key order
+    static void collect_leaf_ids(const CtrBlockPtr<CoreApiProfile>& block, std::vector<AnyID>& ids)
+    {
+        if (block->is_leaf()) {
+            ids.push_back(block->block_id());
+        }
+        else {
+            for (const auto& child: block->children()) {
+                collect_leaf_ids(child, ids);
+            }
+        }
+    }
+
 public:
     SWMRStoreTest()
     {
     }
 
     static void init_suite(TestSuite& suite) {
-        MMA_CLASS_TESTS(suite, testSWMRLite, testSWMRFull, testLMDB, testMemCoW);
+        MMA_CLASS_TESTS(suite, testSWMRLite, testSWMRFull, testLMDB, testMemCoW, testSWMRCompaction, testSWMRReadAhead, testLMDBCompression, testLMDBBlockViews, testSWMRParallelCheck, testSWMRReplication, testSWMRWriteSessions, testSWMRClonedWriteSessions, testSWMRGrowth, testSWMRIOStat);
     }
 
     void testSWMRLite()
@@ -136,8 +227,595 @@ public:
         bench.run_queries();
     }
 
+    void testSWMRCompaction()
+    {
+        using LiteBlockID = CowBlockID<UID64>;
+
+        // Leaves are taken from locality extents of 32 blocks,
+        // aligned to their size (allocation level 5).
+        constexpr uint64_t EXTENT_BLOCKS = 32;
+
+        U8String file = new_store_file();
+
+        auto run = [&](SharedPtr<ISWMRStore<CoreApiProfile>> store, bool lite) {
+            CtrID ctr_id = CtrID::make_random();
+
+            {
+                auto snp = store->begin();
+                create(snp, CtrType(), ctr_id);
+                snp->commit();
+            }
+
+            std::vector<U8String> data;
+            for (size_t cc = 0; cc < 100; cc++)
+            {
+                auto snp = store->begin();
+                auto ctr = find<CtrType>(snp, ctr_id);
+                upsert_random(ctr, 1000, data);
+                snp->commit();
+            }
+
+            {
+                auto snp = store->begin();
+                snp->compact(ctr_id);
+                snp->commit();
+            }
+
+            assert_store_is_consistent(store);
+
+            auto snp = store->open();
+            auto ctr = find<CtrType>(snp, ctr_id);
+            assert_set_equals(data, ctr);
+
+            // Block IDs of lite stores are their file positions, so the
+            // layout can be checked: leaves are contiguous within extents.
+            if (lite)
+            {
+                std::vector<AnyID> leaf_ids;
+                collect_leaf_ids(ctr->root_block(), leaf_ids);
+                assert_gt(leaf_ids.size(), EXTENT_BLOCKS);
+
+                uint64_t prev_pos = cast_to<LiteBlockID>(leaf_ids[0]).value().value();
+                size_t extents = 1;
+
+                for (size_t c = 1; c < leaf_ids.size(); c++)
+                {
+                    uint64_t pos = cast_to<LiteBlockID>(leaf_ids[c]).value().value();
+                    if (pos != prev_pos + 1)
+                    {
+                        assert_equals(0, pos % EXTENT_BLOCKS);
+                        extents++;
+                    }
+                    prev_pos = pos;
+                }
+
+                assert_le(extents, leaf_ids.size() / EXTENT_BLOCKS + 2);
+            }
+
+            store->close();
+        };
+
+        run(create_swmr_store(file, 1024), false);
+
+        file = new_store_file();
+        run(create_lite_swmr_store(file, 1024), true);
+    }
+
+    void testSWMRReadAhead()
+    {
+        U8String file = new_store_file();
+
+        auto store = create_swmr_store(file, 1024);
+        CtrID ctr_id = CtrID::make_random();
+
+        std::vector<U8String> data;
+        {
+            auto snp = store->begin();
+            auto ctr = create(snp, CtrType(), ctr_id);
+            upsert_random(ctr, 50000, data);
+            snp->commit();
+        }
+
+        auto snp = store->open();
+        auto ctr = find<CtrType>(snp, ctr_id);
+        assert_set_equals(data, ctr);
+
+        for (size_t depth: {size_t(0), size_t(1), size_t(16), size_t(1000)})
+        {
+            auto stat0 = snp->io_stat();
+
+            auto chunk = ctr->first_entry();
+            chunk->set_read_ahead(depth);
+
+            size_t expected_depth = std::min<size_t>(depth, 64);
+            size_t idx{};
+
+            while (is_valid_chunk(chunk))
+            {
+                assert_equals(expected_depth, chunk->read_ahead());
+
+                auto keys = chunk->keys();
+                for (size_t c = 0; c < keys.size(); c++) {
+                    assert_equals(data[idx++], U8String(keys[c]));
+                }
+
+                chunk = chunk->next_chunk();
+            }
+
+            assert_equals(data.size(), idx);
+
+            // Sequential scans issue read-ahead, unless it's disabled
+            auto prefetches = (snp->io_stat() - stat0).block_prefetches;
+            if (depth) {
+                assert_gt(prefetches, 0);
+            }
+            else {
+                assert_equals(0, prefetches);
+            }
+        }
+
+        // Point lookups don't step through leaves, so they
+        // must not trigger read-ahead.
+        auto stat0 = snp->io_stat();
+        for (size_t c = 0; c < 1000; c++) {
+            assert_equals(true, ctr->contains(data[getBIRandomG(data.size())]));
+        }
+        assert_equals(0, (snp->io_stat() - stat0).block_prefetches);
+
+        store->close();
+    }
+
+    void testLMDBCompression()
+    {
+        if (!io::is_block_codec_available(io::BlockCodec::LZ4)) {
+            println("LZ4 is not available, skipping");
+            return;
+        }
+
+        U8String file = new_store_file("file.mdb");
+
+        CtrID ctr_id = CtrID::make_random();
+        std::vector<U8String> data;
+
+        {
+            auto store = create_lmdb_store(file, 1024);
+            store->set_block_compression(io::BlockCompressionPolicy::leaves(io::BlockCodec::LZ4));
+
+            for (size_t cc = 0; cc < 10; cc++)
+            {
+                auto snp = store->begin();
+                auto ctr = cc ? find<CtrType>(snp, ctr_id) : create(snp, CtrType(), ctr_id);
+                upsert_random(ctr, 5000, data);
+                snp->commit();
+            }
+        }
+
+        // Compressed blocks are readable without the policy being set
+        auto store = open_lmdb_store(file);
+        auto snp = store->open();
+        auto ctr = find<CtrType>(snp, ctr_id);
+        assert_set_equals(data, ctr);
+    }
+
+    // Committed blocks are read as views into LMDB's pages, updated ones
+    // are copied, and blocks evicted from the writable snapshot's cache
+    // are reread from the transaction's own pages.
+    void testLMDBBlockViews()
+    {
+        for (bool compressed: {false, true})
+        {
+            if (compressed && !io::is_block_codec_available(io::BlockCodec::LZ4)) {
+                println("LZ4 is not available, skipping");
+                continue;
+            }
+
+            U8String file = new_store_file("file.mdb");
+
+            CtrID ctr_id = CtrID::make_random();
+            std::vector<U8String> data;
+
+            {
+                auto store = create_lmdb_store(file, 1024);
+                if (compressed) {
+                    store->set_block_compression(io::BlockCompressionPolicy::leaves(io::BlockCodec::LZ4));
+                }
+
+                // The cache is much smaller than the container,
+                // so updated blocks are evicted within the transaction.
+                store->set_block_cache_size(32);
+
+                {
+                    auto snp = store->begin();
+                    auto ctr = create(snp, CtrType(), ctr_id);
+                    upsert_random(ctr, 20000, data);
+                    snp->commit();
+                }
+
+                auto snp = store->begin();
+                auto ctr = find<CtrType>(snp, ctr_id);
+                assert_set_equals(data, ctr);
+
+                std::vector<U8String> updated;
+                for (size_t c = 0; c < data.size(); c++)
+                {
+                    if (c % 2) {
+                        updated.push_back(data[c]);
+                    }
+                    else {
+                        assert_equals(true, ctr->remove(data[c]));
+                    }
+                }
+
+                // Long entries make updated leaves grow and split
+                for (size_t c = 0; c < 5000; c++)
+                {
+                    U8String str = format_u8("Cool String ABCDEFGH :: {:0>200}", getBIRandomG());
+                    ctr->upsert(str);
+                    updated.push_back(str);
+                }
+
+                assert_set_equals(updated, ctr);
+                snp->commit();
+
+                data = std::move(updated);
+            }
+
+            auto store = open_lmdb_store(file);
+            auto snp = store->open();
+            auto ctr = find<CtrType>(snp, ctr_id);
+            assert_set_equals(data, ctr);
+        }
+    }
+
+    void testSWMRParallelCheck()
+    {
+        U8String file = new_store_file();
+
+        auto store = create_swmr_store(file, 1024);
+
+        // Many snapshots of a few containers, sharing most of their blocks
+        std::vector<CtrID> ctr_ids;
+        for (size_t cc = 0; cc < 4; cc++) {
+            ctr_ids.push_back(CtrID::make_random());
+        }
+
+        for (size_t cc = 0; cc < 50; cc++)
+        {
+            auto snp = store->begin();
+
+            for (const auto& ctr_id: ctr_ids)
+            {
+                auto ctr = cc ? find<CtrType>(snp, ctr_id) : create(snp, CtrType(), ctr_id);
+                upsert_numbered(ctr, cc, 1000);
+            }
+
+            snp->commit();
+        }
+
+        assert_store_is_consistent(store);
+
+        StoreCheckOptions options;
+        options.threads = 4;
+        options.progress_interval_ms = 10;
+
+        size_t reports{};
+        uint64_t blocks{};
+        options.progress_fn = [&](const StoreCheckProgress& progress) {
+            blocks = progress.blocks;
+            reports++;
+        };
+
+        size_t errors{};
+        store->check_parallel(errors_counter(errors), options);
+        assert_equals(0, errors);
+        assert_gt(reports, 0);
+        assert_gt(blocks, 0);
+
+        store->close();
+    }
+
+    void testSWMRReplication()
+    {
+        U8String leader_file = new_store_file("leader.mma2");
+        U8String follower_file = new_store_file("follower.mma2");
+
+        CtrID ctr_id = CtrID::make_random();
+
+        // The follower starts from a copy of the closed leader's file
+        {
+            auto store = create_swmr_store(leader_file, 1024);
+            auto snp = store->begin();
+            auto ctr = create(snp, CtrType(), ctr_id);
+            ctr->upsert("Initial entry");
+            snp->commit();
+            store->close();
+        }
+
+        boost::filesystem::copy_file(leader_file.data(), follower_file.data());
+
+        auto leader = open_swmr_store(leader_file);
+        auto follower = open_swmr_store(follower_file, SWMRParams().open_follower());
+
+        leader->set_replication_sink([&](Span<const uint8_t> record){
+            assert_equals(true, follower->apply_replication_record(record));
+        });
 
+        size_t entries = 1;
+        for (size_t cc = 0; cc < 50; cc++)
+        {
+            auto snp = leader->begin();
+            auto ctr = find<CtrType>(snp, ctr_id);
+            upsert_numbered(ctr, cc, 1000);
+            entries += 1000;
 
+            snp->commit(cc % 10 == 0 ? ConsistencyPoint::FULL : ConsistencyPoint::AUTO);
+
+            auto status = follower->replication_status();
+            assert_equals(leader->replication_status().sequence_id, status.sequence_id);
+
+            auto f_snp = follower->open();
+            auto f_ctr = find<CtrType>(f_snp, ctr_id);
+            assert_equals(entries, f_ctr->size());
+        }
+
+        leader->close();
+
+        assert_store_is_consistent(follower);
+        follower->close();
+
+        // The follower's file is a complete store
+        auto store = open_swmr_store(follower_file);
+        assert_store_is_consistent(store);
+
+        auto ctr = find<CtrType>(store->open(), ctr_id);
+        assert_equals(entries, ctr->size());
+
+        store->close();
+    }
+
+    void testSWMRWriteSessions()
+    {
+        using StorePtrT = SharedPtr<ISWMRStore<CoreApiProfile>>;
+
+        auto run = [&](StorePtrT store) {
+            std::vector<CtrID> ctr_ids;
+            for (size_t cc = 0; cc < 4; cc++) {
+                ctr_ids.push_back(CtrID::make_random());
+            }
+
+            // Containers are created in the first snapshot and
+            // updated in the following ones, session per container.
+            for (size_t ss = 0; ss < 5; ss++)
+            {
+                auto snp = store->begin();
+
+                std::vector<std::thread> threads;
+                for (const auto& ctr_id: ctr_ids)
+                {
+                    auto session = snp->open_write_session(ctr_id);
+                    threads.emplace_back([=]{
+                        auto ctr = ss ? find<CtrType>(session, ctr_id) : create(session, CtrType(), ctr_id);
+                        upsert_numbered(ctr, ss, 10000);
+
+                        if (ctr_id != ctr_ids[0]) {
+                            session->commit();
+                        }
+                    });
+                }
+
+                for (auto& thread: threads) {
+                    thread.join();
+                }
+
+                // The first session is merged by the snapshot
+                snp->commit();
+
+                assert_store_is_consistent(store);
+
+                auto r_snp = store->open();
+                for (const auto& ctr_id: ctr_ids) {
+                    auto ctr = find<CtrType>(r_snp, ctr_id);
+                    assert_equals((ss + 1) * 10000, ctr->size());
+                }
+            }
+
+            store->close();
+        };
+
+        U8String file = new_store_file();
+        run(create_swmr_store(file, 1024));
+
+        file = new_store_file();
+        run(create_lite_swmr_store(file, 1024));
+    }
+
+    // Sessions of a container and its clone update counters
+    // of the same blocks concurrently.
+    void testSWMRClonedWriteSessions()
+    {
+        using StorePtrT = SharedPtr<ISWMRStore<CoreApiProfile>>;
+
+        auto run = [&](StorePtrT store) {
+            CtrID ctr_id = CtrID::make_random();
+            CtrID clone_id = CtrID::make_random();
+
+            {
+                auto snp = store->begin();
+                auto ctr = create(snp, CtrType(), ctr_id);
+                upsert_numbered(ctr, 0, 20000);
+                snp->commit();
+            }
+
+            auto snp = store->begin();
+            snp->clone_ctr(ctr_id, clone_id);
+
+            std::vector<std::thread> threads;
+            for (const auto& id: {ctr_id, clone_id})
+            {
+                auto session = snp->open_write_session(id);
+                threads.emplace_back([=]{
+                    auto ctr = find<CtrType>(session, id);
+                    upsert_numbered(ctr, id == ctr_id ? 1 : 2, 10000);
+
+                    for (size_t c = 0; c < 5000; c++) {
+                        ctr->remove(numbered_entry(0, c));
+                    }
+
+                    session->commit();
+                });
+            }
+
+            // Snapshot's containers are not accessible until the sessions are merged
+            assert_throws<ResultException>([&](){
+                find<CtrType>(snp, ctr_id);
+            });
+
+            for (auto& thread: threads) {
+                thread.join();
+            }
+
+            snp->commit();
+
+            assert_store_is_consistent(store);
+
+            auto r_snp = store->open();
+            for (const auto& id: {ctr_id, clone_id})
+            {
+                auto ctr = find<CtrType>(r_snp, id);
+                assert_equals(25000, ctr->size());
+                assert_equals(false, ctr->contains(numbered_entry(0, 0)));
+                assert_equals(true, ctr->contains(numbered_entry(id == ctr_id ? 1 : 2, 0)));
+                assert_equals(false, ctr->contains(numbered_entry(id == ctr_id ? 2 : 1, 0)));
+            }
+            r_snp.reset();
+
+            // Removing both copies releases all shared blocks
+            {
+                auto snp = store->begin();
+                snp->drop_ctr(ctr_id);
+                snp->drop_ctr(clone_id);
+                snp->commit();
+            }
+
+            assert_store_is_consistent(store);
+            store->close();
+        };
+
+        U8String file = new_store_file();
+        run(create_swmr_store(file, 1024));
+
+        file = new_store_file();
+        run(create_lite_swmr_store(file, 1024));
+    }
+
+    void testSWMRGrowth()
+    {
+        U8String file = new_store_file();
+        CtrID ctr_id = CtrID::make_random();
+
+        auto store = create_swmr_store(file, 4);
+        uint64_t initial_size = boost::filesystem::file_size(file.data());
+
+        {
+            auto snp = store->begin();
+            auto ctr = create(snp, CtrType(), ctr_id);
+            ctr->upsert("Initial entry");
+            snp->commit();
+        }
+
+        // The reader is open while the file grows under it
+        auto r_snp = store->open();
+
+        size_t entries = 1;
+        for (size_t cc = 0; cc < 50; cc++)
+        {
+            auto snp = store->begin();
+            auto ctr = find<CtrType>(snp, ctr_id);
+            upsert_numbered(ctr, cc, 1000);
+            entries += 1000;
+            snp->commit();
+        }
+
+        assert_gt(boost::filesystem::file_size(file.data()), initial_size);
+        assert_equals(1, find<CtrType>(r_snp, ctr_id)->size());
+        r_snp.reset();
+
+        assert_store_is_consistent(store);
+        store->close();
+
+        store = open_swmr_store(file);
+        assert_store_is_consistent(store);
+        assert_equals(entries, find<CtrType>(store->open(), ctr_id)->size());
+        store->close();
+    }
+
+    void testSWMRIOStat()
+    {
+        U8String file = new_store_file();
+        CtrID ctr_id = CtrID::make_random();
+
+        auto store = create_swmr_store(file, 1024);
+
+        {
+            auto snp = store->begin();
+            auto snp_stat0 = snp->io_stat();
+            snp->start_block_access_trace();
+
+            auto ctr = create(snp, CtrType(), ctr_id);
+            upsert_numbered(ctr, 0, 10000);
+
+            auto trace = snp->stop_block_access_trace();
+            assert_gt(trace.size(), 0);
+
+            size_t updates{};
+            for (const auto& entry: trace)
+            {
+                if (entry.type != BlockAccessType::READ) {
+                    assert_equals(true, entry.ctr_id.has_value());
+                    assert_gt(entry.block_size, 0);
+                    updates++;
+                }
+            }
+
+            auto snp_stat = snp->io_stat() - snp_stat0;
+            assert_equals(updates, snp_stat.block_clones + snp_stat.block_allocations);
+            assert_gt(snp_stat.block_reads, 0);
+
+            snp->commit(ConsistencyPoint::YES);
+        }
+
+        auto stat0 = store->io_stat();
+        assert_gt(stat0.block_allocations, 0);
+        assert_gt(stat0.flushes, 0);
+        assert_gt(stat0.bytes_flushed, 0);
+
+        {
+            auto snp = store->open();
+            auto snp_stat0 = snp->io_stat();
+            snp->start_block_access_trace();
+
+            size_t entries{};
+            find<CtrType>(snp, ctr_id)->for_each([&](auto){
+                entries++;
+            });
+            assert_equals(10000, entries);
+
+            auto trace = snp->stop_block_access_trace();
+            auto snp_stat = snp->io_stat() - snp_stat0;
+
+            assert_equals(trace.size(), snp_stat.block_reads);
+            assert_equals(snp_stat.block_reads, snp_stat.cache_hits + snp_stat.cache_misses);
+            for (const auto& entry: trace) {
+                assert_equals(true, entry.type == BlockAccessType::READ);
+            }
+        }
+
+        auto stat1 = store->io_stat() - stat0;
+        assert_gt(stat1.block_reads, 0);
+        assert_equals(0, stat1.block_clones + stat1.block_allocations);
+
+        store->close();
+    }
 };
 
 
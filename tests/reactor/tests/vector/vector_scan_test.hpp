@@ -0,0 +1,144 @@
+// Copyright 2026 Victor Smirnov
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include "../prototype/bt/bt_test_base.hpp"
+
+#include <memoria/tests/assertions.hpp>
+
+#include <memoria/api/vector/vector_api.hpp>
+#include <memoria/api/common/ctr_scan_hrpc.hpp>
+
+#include <vector>
+
+namespace memoria {
+namespace tests {
+
+template <
+    typename ProfileT = CoreApiProfile,
+    typename StoreT   = IMemoryStorePtr<ProfileT>
+>
+class VectorScanTest: public BTTestBase<Vector<UTinyInt>, ProfileT, StoreT>
+{
+    using MyType = VectorScanTest;
+    using Base   = BTTestBase<Vector<UTinyInt>, ProfileT, StoreT>;
+
+    using Base::branch;
+    using Base::commit;
+    using Base::out;
+    using Base::getRandom;
+
+    int64_t size = 1024 * 1024;
+
+public:
+    VectorScanTest()
+    {
+    }
+
+    MMA_STATE_FILEDS(size)
+
+    static void init_suite(TestSuite& suite) {
+        MMA_CLASS_TESTS(suite, testScan, testHermes);
+    }
+
+    void testScan()
+    {
+        auto snp = branch();
+        auto ctr = create<Vector<UTinyInt>>(snp, Vector<UTinyInt>{});
+
+        std::vector<uint8_t> data;
+        for (int64_t c = 0; c < size; c++) {
+            data.push_back(getRandom(256));
+        }
+
+        ctr->append(Span<const uint8_t>(data.data(), data.size()));
+        assert_equals(size, ctr->size());
+
+        for (int c = 0; c < 100; c++)
+        {
+            uint64_t from = getRandom(size);
+            uint64_t to = from + getRandom(size - from + 10);
+            uint8_t threshold = getRandom(256);
+
+            scan::Aggregate<uint8_t> ref;
+            for (uint64_t d = from; d < std::min<uint64_t>(to, size); d++)
+            {
+                uint8_t vv = data[d];
+                if (vv >= threshold) {
+                    ref.count++;
+                    ref.sum += vv;
+                    ref.min = std::min(ref.min, vv);
+                    ref.max = std::max(ref.max, vv);
+                }
+            }
+
+            auto agg = scan::vector_aggregate(*ctr, from, to, scan::GreaterEq<uint8_t>{threshold});
+
+            assert_equals(ref.count, agg.count);
+            assert_equals(ref.sum, agg.sum);
+            assert_equals(ref.min, agg.min);
+            assert_equals(ref.max, agg.max);
+        }
+
+        // Empty ranges
+        assert_equals(0, scan::vector_aggregate(*ctr, 10, 10, scan::AcceptAll<uint8_t>{}).count);
+        assert_equals(0, scan::vector_aggregate(*ctr, size, size + 10, scan::AcceptAll<uint8_t>{}).count);
+
+        commit();
+    }
+
+    void testHermes()
+    {
+        auto snp = branch();
+        auto ctr = create<Vector<UTinyInt>>(snp, Vector<UTinyInt>{});
+
+        std::vector<uint8_t> data;
+        for (int64_t c = 0; c < size; c++) {
+            data.push_back(getRandom(256));
+        }
+
+        ctr->append(Span<const uint8_t>(data.data(), data.size()));
+
+        uint64_t from = getRandom(size / 2);
+        uint64_t to = from + getRandom(size / 2);
+
+        auto rq = hrpc::Request::make();
+        rq.set_parameter(scan::SCAN_FROM, static_cast<int64_t>(from));
+        rq.set_parameter(scan::SCAN_TO, static_cast<int64_t>(to));
+
+        hrpc::Response rs = scan::vector_scan(*ctr, rq);
+        assert_equals(true, rs.status_code() == hrpc::StatusCode::OK);
+
+        auto agg = scan::aggregate_from_hermes<uint8_t>(rs.result());
+        auto ref = scan::vector_aggregate(*ctr, from, to, scan::AcceptAll<uint8_t>{});
+
+        assert_equals(to - from, agg.count);
+        assert_equals(ref.count, agg.count);
+        assert_equals(ref.sum, agg.sum);
+        assert_equals(ref.min, agg.min);
+        assert_equals(ref.max, agg.max);
+
+        // Empty aggregates have no min/max
+        auto doc = hermes::HermesCtr::make_new();
+        auto empty = scan::aggregate_from_hermes<uint8_t>(scan::to_hermes(doc, scan::Aggregate<uint8_t>{}));
+        assert_equals(true, empty.empty());
+        assert_equals(0, empty.sum);
+
+        commit();
+    }
+};
+
+}}